@@ -27,10 +27,19 @@
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
 
+#include <map>
+#include <memory>
+#include <string>
+
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
 #include "vtkMPI.h"
 #endif
 
+// When executing asynchronously, meshes are deep-copied from the simulation
+// and this keeps the copies currently in use by the producers alive.
+using staged_meshes_type = std::map<std::string, conduit::Node>;
+static std::shared_ptr<staged_meshes_type> active_staged_meshes;
+
 static bool update_producer_mesh_blueprint(
   const std::string& channel_name, const conduit::Node* node)
 {
@@ -85,6 +94,18 @@ void catalyst_initialize(const conduit_node* params)
 #else
   const vtkTypeUInt64 comm = 0;
 #endif
+
+  if (cpp_params.has_path("catalyst/async"))
+  {
+    const auto& async = cpp_params["catalyst/async"];
+    const bool enabled = async.has_child("enabled") ? (async["enabled"].to_int64() != 0) : true;
+    const int queue_depth =
+      async.has_child("queue_depth") ? static_cast<int>(async["queue_depth"].to_int64()) : 1;
+    const bool skip =
+      async.has_child("backpressure") && async["backpressure"].as_string() == "skip";
+    vtkInSituInitializationHelper::SetAsynchronousExecution(enabled, queue_depth,
+      skip ? vtkInSituInitializationHelper::SKIP : vtkInSituInitializationHelper::BLOCK);
+  }
   vtkInSituInitializationHelper::Initialize(comm);
 
   if (cpp_params.has_path("catalyst/scripts"))
@@ -144,6 +165,7 @@ void catalyst_execute(const conduit_node* params)
     PARAVIEW_LOG_CATALYST_VERBOSITY(), "co-processing for timestep=%d, time=%f", timestep, time);
 
   // catalyst/channels are used to communicate meshes.
+  std::map<std::string, const conduit::Node*> meshes;
   if (root.has_child("channels"))
   {
     auto iter = root["channels"].children();
@@ -161,7 +183,7 @@ void catalyst_execute(const conduit_node* params)
         {
           vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
             "Conduit Mesh blueprint validation succeeded for channel (%s)", channel_name.c_str());
-          update_producer_mesh_blueprint(channel_name, &mesh_node);
+          meshes[channel_name] = &mesh_node;
         }
         else
         {
@@ -182,7 +204,35 @@ void catalyst_execute(const conduit_node* params)
                                                 "No meshes will be processed.");
   }
 
-  vtkInSituInitializationHelper::ExecutePipelines(timestep, time);
+  if (!vtkInSituInitializationHelper::IsAsynchronous())
+  {
+    for (const auto& item : meshes)
+    {
+      update_producer_mesh_blueprint(item.first, item.second);
+    }
+    vtkInSituInitializationHelper::ExecutePipelines(timestep, time);
+    return;
+  }
+
+  // The simulation is free to modify its buffers as soon as we return, hence
+  // the meshes are deep-copied, once the step is accepted for analysis, and
+  // handed over to the producers only when the analysis thread gets to this
+  // timestep. Skipped steps are not copied.
+  auto staged = std::make_shared<staged_meshes_type>();
+  vtkInSituInitializationHelper::ExecutePipelinesAsynchronously(timestep, time,
+    [staged]() {
+      active_staged_meshes = staged;
+      for (const auto& item : *staged)
+      {
+        update_producer_mesh_blueprint(item.first, &item.second);
+      }
+    },
+    [staged, &meshes]() {
+      for (const auto& item : meshes)
+      {
+        (*staged)[item.first].set(*item.second);
+      }
+    });
 }
 
 //-----------------------------------------------------------------------------
@@ -198,6 +248,7 @@ void catalyst_finalize(const conduit_node* params)
   }
 
   vtkInSituInitializationHelper::Finalize();
+  active_staged_meshes.reset();
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +52,43 @@ bool verify(const std::string& protocol, const conduit::Node& n)
 }
 } // namespace scripts
 
+namespace async
+{
+bool verify(const std::string& protocol, const conduit::Node& n)
+{
+  vtkVLogScopeF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "%s: verify", protocol.c_str());
+  if (!n.dtype().is_object())
+  {
+    vtkLogF(ERROR, "node must be an 'object'.");
+    return false;
+  }
+  if (n.has_child("enabled") && !n["enabled"].dtype().is_integer())
+  {
+    vtkLogF(ERROR, "'enabled' must be an integer.");
+    return false;
+  }
+  if (n.has_child("queue_depth"))
+  {
+    if (!n["queue_depth"].dtype().is_integer() || n["queue_depth"].to_int64() < 1)
+    {
+      vtkLogF(ERROR, "'queue_depth' must be a positive integer.");
+      return false;
+    }
+  }
+  if (n.has_child("backpressure"))
+  {
+    const auto& policy = n["backpressure"];
+    if (!policy.dtype().is_string() ||
+      (policy.as_string() != "block" && policy.as_string() != "skip"))
+    {
+      vtkLogF(ERROR, "'backpressure' must be either 'block' or 'skip'.");
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace async
+
 bool verify(const std::string& protocol, const conduit::Node& n)
 {
   vtkVLogScopeF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "%s: verify", protocol.c_str());
@@ -83,6 +120,13 @@ bool verify(const std::string& protocol, const conduit::Node& n)
       return false;
     }
   }
+  if (n.has_child("async"))
+  {
+    if (!async::verify(protocol + "::async", n["async"]))
+    {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -24,8 +24,14 @@
 #include "vtkSMSourceProxy.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #if VTK_MODULE_ENABLE_ParaView_PythonCatalyst
 extern "C" {
@@ -59,10 +65,38 @@ public:
   bool InExecutePipelines = false;
   int TimeStep = 0;
   double Time = 0.0;
+
+  //---------------------------------------------------------------------------
+  // Members used for asynchronous execution.
+  using ClockType = std::chrono::steady_clock;
+  struct StepInfo
+  {
+    int TimeStep;
+    double Time;
+    std::function<void()> Stage;
+    ClockType::time_point QueuedTime;
+  };
+
+  std::thread AnalysisThread;
+  std::mutex Mutex;
+  std::condition_variable Condition; // notified when the queue changes.
+  std::deque<StepInfo> Queue;
+  bool StopRequested = false;
+  AsynchronousStatistics Statistics;
+
+  // Controller for the communicator used by the simulation. This is only used
+  // to make consistent skip decisions across ranks.
+  vtkSmartPointer<vtkMultiProcessController> SimulationController;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  MPI_Comm AnalysisComm = MPI_COMM_NULL;
+#endif
 };
 
 int vtkInSituInitializationHelper::WasInitializedOnce;
 int vtkInSituInitializationHelper::WasFinalizedOnce;
+bool vtkInSituInitializationHelper::AsynchronousRequested = false;
+int vtkInSituInitializationHelper::AsynchronousQueueDepth = 1;
+int vtkInSituInitializationHelper::AsynchronousPolicy = vtkInSituInitializationHelper::BLOCK;
 vtkInSituInitializationHelper::vtkInternals* vtkInSituInitializationHelper::Internals;
 //----------------------------------------------------------------------------
 vtkInSituInitializationHelper::vtkInSituInitializationHelper()
@@ -77,12 +111,40 @@ vtkInSituInitializationHelper::~vtkInSituInitializationHelper()
 //----------------------------------------------------------------------------
 void vtkInSituInitializationHelper::Initialize(vtkTypeUInt64 comm)
 {
+  vtkSmartPointer<vtkMultiProcessController> simulationController;
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  MPI_Comm analysisComm = MPI_COMM_NULL;
   {
     vtkVLogScopeF(
       PARAVIEW_LOG_CATALYST_VERBOSITY(), "Initializing MPI communicator using 'comm' (%llu)", comm);
     // convert comm to MPI handle.
     MPI_Comm mpicomm = MPI_Comm_f2c(comm);
+    if (vtkInSituInitializationHelper::AsynchronousRequested &&
+      !vtkInSituInitializationHelper::WasInitializedOnce)
+    {
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread(&provided);
+      if (provided < MPI_THREAD_MULTIPLE)
+      {
+        vtkLogF(WARNING, "Asynchronous execution requires MPI with 'MPI_THREAD_MULTIPLE' support. "
+                         "Pipelines will be executed synchronously.");
+        vtkInSituInitializationHelper::AsynchronousRequested = false;
+      }
+      else
+      {
+        vtkMPICommunicatorOpaqueComm simOpaqueComm(&mpicomm);
+        vtkNew<vtkMPICommunicator> simCommunicator;
+        simCommunicator->InitializeExternal(&simOpaqueComm);
+        simulationController = vtkSmartPointer<vtkMPIController>::New();
+        simulationController->SetCommunicator(simCommunicator);
+
+        // the analysis uses its own communicator so that collective operations
+        // done on the analysis thread cannot interfere with those done by the
+        // simulation.
+        MPI_Comm_dup(mpicomm, &analysisComm);
+        mpicomm = analysisComm;
+      }
+    }
     vtkMPICommunicatorOpaqueComm opaqueComm(&mpicomm);
     vtkNew<vtkMPICommunicator> mpiCommunicator;
     mpiCommunicator->InitializeExternal(&opaqueComm);
@@ -122,6 +184,10 @@ void vtkInSituInitializationHelper::Initialize(vtkTypeUInt64 comm)
   // for now, I am using vtkCPCxxHelper; that class should be removed when we
   // deprecate Legacy Catalyst API.
   internals.CPCxxHelper.TakeReference(vtkCPCxxHelper::New());
+  internals.SimulationController = simulationController;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  internals.AnalysisComm = analysisComm;
+#endif
 
 #if VTK_MODULE_ENABLE_ParaView_PythonCatalyst
   // register static Python modules built, if any.
@@ -131,6 +197,38 @@ void vtkInSituInitializationHelper::Initialize(vtkTypeUInt64 comm)
   // skipping for now
   // // register static plugins
   // ParaView_paraview_plugins_initialize();
+
+  if (vtkInSituInitializationHelper::AsynchronousRequested)
+  {
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+      "Using asynchronous execution (queue depth=%d, backpressure=%s)",
+      vtkInSituInitializationHelper::AsynchronousQueueDepth,
+      vtkInSituInitializationHelper::AsynchronousPolicy == SKIP ? "skip" : "block");
+    internals.AnalysisThread =
+      std::thread(&vtkInSituInitializationHelper::AsynchronousExecutionLoop);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::SetAsynchronousExecution(
+  bool enable, int queueDepth, int policy)
+{
+  if (vtkInSituInitializationHelper::WasInitializedOnce)
+  {
+    vtkLogF(WARNING, "'SetAsynchronousExecution' must be called before 'Initialize'. Ignoring.");
+    return;
+  }
+
+  vtkInSituInitializationHelper::AsynchronousRequested = enable;
+  vtkInSituInitializationHelper::AsynchronousQueueDepth = std::max(queueDepth, 1);
+  vtkInSituInitializationHelper::AsynchronousPolicy = (policy == SKIP) ? SKIP : BLOCK;
+}
+
+//----------------------------------------------------------------------------
+bool vtkInSituInitializationHelper::IsAsynchronous()
+{
+  return vtkInSituInitializationHelper::Internals != nullptr &&
+    vtkInSituInitializationHelper::Internals->AnalysisThread.joinable();
 }
 
 //----------------------------------------------------------------------------
@@ -150,21 +248,58 @@ void vtkInSituInitializationHelper::Finalize()
     return;
   }
 
-  // finalize pipelines.
-  const auto& internals = (*vtkInSituInitializationHelper::Internals);
-  for (auto& item : internals.Pipelines)
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  if (internals.AnalysisThread.joinable())
   {
-    if (item.Initialized && !item.InitializationFailed)
+    // the analysis thread finishes all queued steps and finalizes the
+    // pipelines before exiting.
     {
-      item.Pipeline->Finalize();
+      std::lock_guard<std::mutex> lock(internals.Mutex);
+      internals.StopRequested = true;
     }
+    internals.Condition.notify_all();
+    internals.AnalysisThread.join();
+
+    const auto& stats = internals.Statistics;
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+      "Asynchronous execution: %llu steps executed, %llu skipped, blocked for %f s, "
+      "mean latency %f s, max latency %f s",
+      static_cast<unsigned long long>(stats.ExecutedSteps),
+      static_cast<unsigned long long>(stats.SkippedSteps), stats.TotalBlockedTime,
+      stats.ExecutedSteps > 0 ? stats.TotalLatency / stats.ExecutedSteps : 0.0,
+      stats.MaximumLatency);
+  }
+  else
+  {
+    vtkInSituInitializationHelper::FinalizePipelines();
+  }
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (internals.AnalysisComm != MPI_COMM_NULL)
+  {
+    vtkMultiProcessController::SetGlobalController(nullptr);
+    MPI_Comm_free(&internals.AnalysisComm);
   }
+#endif
 
   vtkInSituInitializationHelper::WasFinalizedOnce = 1;
   delete vtkInSituInitializationHelper::Internals;
   vtkInSituInitializationHelper::Internals = nullptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::FinalizePipelines()
+{
+  const auto& internals = (*vtkInSituInitializationHelper::Internals);
+  for (auto& item : internals.Pipelines)
+  {
+    if (item.Initialized && !item.InitializationFailed)
+    {
+      item.Pipeline->Finalize();
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkInSituInitializationHelper::AddPipeline(const std::string& path)
 {
@@ -289,6 +424,164 @@ bool vtkInSituInitializationHelper::ExecutePipelines(int timestep, double time)
     return false;
   }
 
+  if (vtkInSituInitializationHelper::IsAsynchronous())
+  {
+    return vtkInSituInitializationHelper::ExecutePipelinesAsynchronously(
+      timestep, time, std::function<void()>());
+  }
+
+  return vtkInSituInitializationHelper::ExecutePipelinesInternal(timestep, time);
+}
+
+//----------------------------------------------------------------------------
+bool vtkInSituInitializationHelper::ExecutePipelinesAsynchronously(int timestep, double time,
+  const std::function<void()>& stage, const std::function<void()>& copy)
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'vtkInSituInitializationHelper::ExecutePipelinesAsynchronously' cannot be "
+                   "called before 'Initialize'.");
+    return false;
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  if (!internals.AnalysisThread.joinable())
+  {
+    // not asynchronous, simply execute on the calling thread.
+    if (copy)
+    {
+      copy();
+    }
+    if (stage)
+    {
+      stage();
+    }
+    return vtkInSituInitializationHelper::ExecutePipelinesInternal(timestep, time);
+  }
+
+  if (std::this_thread::get_id() == internals.AnalysisThread.get_id())
+  {
+    vtkLogF(ERROR, "Recursive call to 'ExecutePipelinesAsynchronously' not supported!");
+    return false;
+  }
+
+  using ClockType = vtkInternals::ClockType;
+  const auto queuedTime = ClockType::now();
+  const size_t queueDepth =
+    static_cast<size_t>(vtkInSituInitializationHelper::AsynchronousQueueDepth);
+
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  if (vtkInSituInitializationHelper::AsynchronousPolicy == SKIP)
+  {
+    int full = internals.Queue.size() >= queueDepth ? 1 : 0;
+    auto controller = internals.SimulationController.GetPointer();
+    if (controller && controller->GetNumberOfProcesses() > 1)
+    {
+      // all ranks must skip the same steps, otherwise the analysis would
+      // deadlock in collective operations.
+      lock.unlock();
+      int anyFull = full;
+      controller->AllReduce(&full, &anyFull, 1, vtkCommunicator::MAX_OP);
+      full = anyFull;
+      lock.lock();
+    }
+    if (full)
+    {
+      ++internals.Statistics.SkippedSteps;
+      vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "Analysis busy, skipping timestep=%d", timestep);
+      return false;
+    }
+  }
+  else
+  {
+    internals.Condition.wait(lock, [&]() { return internals.Queue.size() < queueDepth; });
+    internals.Statistics.TotalBlockedTime +=
+      std::chrono::duration<double>(ClockType::now() - queuedTime).count();
+  }
+
+  if (copy)
+  {
+    // only the analysis thread removes steps from the queue, so there is
+    // still room for this step once the copy is done.
+    lock.unlock();
+    copy();
+    lock.lock();
+  }
+  internals.Queue.push_back(vtkInternals::StepInfo{ timestep, time, stage, queuedTime });
+  ++internals.Statistics.QueuedSteps;
+  lock.unlock();
+  internals.Condition.notify_all();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::AsynchronousExecutionLoop()
+{
+  vtkLogger::SetThreadName("Catalyst analysis");
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  using ClockType = vtkInternals::ClockType;
+  while (true)
+  {
+    vtkInternals::StepInfo step;
+    {
+      std::unique_lock<std::mutex> lock(internals.Mutex);
+      internals.Condition.wait(
+        lock, [&]() { return internals.StopRequested || !internals.Queue.empty(); });
+      if (internals.Queue.empty())
+      {
+        // stop requested and all steps have been processed.
+        break;
+      }
+      step = std::move(internals.Queue.front());
+      internals.Queue.pop_front();
+    }
+    // a slot is now available in the queue.
+    internals.Condition.notify_all();
+
+    const auto startTime = ClockType::now();
+    if (step.Stage)
+    {
+      step.Stage();
+    }
+    vtkInSituInitializationHelper::ExecutePipelinesInternal(step.TimeStep, step.Time);
+    const auto endTime = ClockType::now();
+
+    const double execution = std::chrono::duration<double>(endTime - startTime).count();
+    const double latency = std::chrono::duration<double>(endTime - step.QueuedTime).count();
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+      "Analysis for timestep=%d done (execution=%f s, latency=%f s)", step.TimeStep, execution,
+      latency);
+
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    auto& stats = internals.Statistics;
+    ++stats.ExecutedSteps;
+    stats.TotalExecutionTime += execution;
+    stats.TotalLatency += latency;
+    stats.MaximumLatency = std::max(stats.MaximumLatency, latency);
+  }
+
+  // Pipelines are finalized on this thread since that's where they were
+  // initialized and executed.
+  vtkInSituInitializationHelper::FinalizePipelines();
+}
+
+//----------------------------------------------------------------------------
+vtkInSituInitializationHelper::AsynchronousStatistics
+vtkInSituInitializationHelper::GetAsynchronousStatistics()
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    return AsynchronousStatistics();
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.Statistics;
+}
+
+//----------------------------------------------------------------------------
+bool vtkInSituInitializationHelper::ExecutePipelinesInternal(int timestep, double time)
+{
   auto& internals = (*vtkInSituInitializationHelper::Internals);
   if (internals.InExecutePipelines)
   {
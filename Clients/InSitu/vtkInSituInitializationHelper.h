@@ -26,6 +26,15 @@
  * codes includes custom Catalyst API implementations or other in situ
  * frameworks.
  *
+ * By default, `ExecutePipelines` executes the analysis pipelines synchronously
+ * on the calling thread. Asynchronous execution can be enabled using
+ * `SetAsynchronousExecution` before calling `Initialize`. In that case, all
+ * analysis is done on a dedicated thread (and, in MPI builds, on a duplicate of
+ * the communicator passed to `Initialize`) while the simulation proceeds. The
+ * data for a step must then be staged by the caller, e.g. by deep-copying it,
+ * and producers must only be updated from the `stage` callback passed to
+ * `ExecutePipelinesAsynchronously`, which is called on the analysis thread.
+ *
  * @sa vtkInitializationHelper
  *
  * @defgroup Insitu ParaView In Situ
@@ -49,7 +58,8 @@
 class vtkCPCxxHelper;
 class vtkSMSourceProxy;
 
-#include <string> // for std::string
+#include <functional> // for std::function
+#include <string>     // for std::string
 
 class VTKPVINSITU_EXPORT vtkInSituInitializationHelper : public vtkObject
 {
@@ -115,10 +125,75 @@ public:
   //@}
 
   /**
-   * Executes pipelines.
+   * Executes pipelines. When asynchronous execution is enabled, this is
+   * equivalent to calling `ExecutePipelinesAsynchronously` without a `stage`
+   * callback.
    */
   static bool ExecutePipelines(int timestep, double time);
 
+  /**
+   * Backpressure policies for asynchronous execution. With `BLOCK`, the
+   * simulation waits until the analysis can accept the step. With `SKIP`, the
+   * step is not analyzed; this decision is made consistently across all ranks.
+   */
+  enum BackpressurePolicy
+  {
+    BLOCK = 0,
+    SKIP = 1
+  };
+
+  /**
+   * Enables asynchronous execution of the analysis pipelines. This must be
+   * called before `Initialize`. `queueDepth` is the number of steps that can
+   * be waiting for the analysis while another step is being analyzed; the
+   * default of 1 corresponds to double-buffering. `policy` determines what
+   * happens when the queue is full. In MPI builds, asynchronous execution
+   * requires `MPI_THREAD_MULTIPLE` support; if that's not available,
+   * `Initialize` falls back to synchronous execution.
+   */
+  static void SetAsynchronousExecution(bool enable, int queueDepth = 1, int policy = BLOCK);
+
+  /**
+   * Returns true if the pipelines are executed asynchronously. This is only
+   * valid after `Initialize`.
+   */
+  static bool IsAsynchronous();
+
+  /**
+   * Queues a step for execution on the analysis thread. `copy`, if non-empty,
+   * is called on the calling thread once the step is accepted, just before it
+   * is queued, and should copy the simulation data needed for this step; it
+   * is not called for skipped steps. `stage`, if non-empty, is called on the
+   * analysis thread before the pipelines are executed and should update the
+   * producers using the data copied for this step. Returns false if the step
+   * was skipped because of backpressure. If asynchronous execution is not
+   * enabled, `copy`, `stage` and the pipelines are simply executed on the
+   * calling thread.
+   */
+  static bool ExecutePipelinesAsynchronously(int timestep, double time,
+    const std::function<void()>& stage,
+    const std::function<void()>& copy = std::function<void()>());
+
+  /**
+   * Statistics for asynchronous execution. All times are in seconds. Latency
+   * is measured from the time a step is queued until its analysis completes.
+   */
+  struct AsynchronousStatistics
+  {
+    vtkTypeUInt64 QueuedSteps = 0;
+    vtkTypeUInt64 ExecutedSteps = 0;
+    vtkTypeUInt64 SkippedSteps = 0;
+    double TotalBlockedTime = 0.0;
+    double TotalExecutionTime = 0.0;
+    double TotalLatency = 0.0;
+    double MaximumLatency = 0.0;
+  };
+
+  /**
+   * Returns the statistics for asynchronous execution so far.
+   */
+  static AsynchronousStatistics GetAsynchronousStatistics();
+
   //@{
   /**
    * Provides access to current time and timestep during `ExecutePipelines`
@@ -150,6 +225,14 @@ private:
   static int WasInitializedOnce;
   static int WasFinalizedOnce;
 
+  static bool AsynchronousRequested;
+  static int AsynchronousQueueDepth;
+  static int AsynchronousPolicy;
+
+  static bool ExecutePipelinesInternal(int timestep, double time);
+  static void FinalizePipelines();
+  static void AsynchronousExecutionLoop();
+
   class vtkInternals;
   static vtkInternals* Internals;
 };
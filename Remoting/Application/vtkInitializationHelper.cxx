@@ -20,6 +20,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkOutputWindow.h"
 #include "vtkPVConfig.h"
 #include "vtkPVInitializer.h"
+#include "vtkPVLogger.h"
 #include "vtkPVOptions.h"
 #include "vtkPVPluginLoader.h"
 #include "vtkPVSession.h"
@@ -187,6 +188,8 @@ void vtkInitializationHelper::Initialize(int argc, char** argv, int type, vtkPVO
     return;
   }
 
+  vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "initialize");
+
   // Verify that the version of the library that we linked against is
   // compatible with the version of the headers we compiled against.
   GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -233,20 +236,29 @@ void vtkInitializationHelper::Initialize(int argc, char** argv, int type, vtkPVO
 
   // this has to happen after process module is initialized and options have
   // been set.
-  paraview_initialize();
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "initialize modules");
+    paraview_initialize();
+  }
 
   // Set multi-server flag to vtkProcessModule
   vtkProcessModule::GetProcessModule()->SetMultipleSessionsSupport(
     options->GetMultiServerMode() != 0);
 
   // Make sure the ProxyManager get created...
-  vtkSMProxyManager::GetProxyManager();
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "create proxy manager");
+    vtkSMProxyManager::GetProxyManager();
+  }
 
   // Now load any plugins located in the PV_PLUGIN_PATH environment variable.
   // These are always loaded (not merely located).
-  vtkNew<vtkPVPluginLoader> loader;
-  loader->LoadPluginsFromPluginSearchPath();
-  loader->LoadPluginsFromPluginConfigFile();
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "load plugins");
+    vtkNew<vtkPVPluginLoader> loader;
+    loader->LoadPluginsFromPluginSearchPath();
+    loader->LoadPluginsFromPluginConfigFile();
+  }
 
   vtkInitializationHelper::SaveUserSettingsFileDuringFinalization = false;
   // Load settings files on client-processes.
@@ -254,6 +266,7 @@ void vtkInitializationHelper::Initialize(int argc, char** argv, int type, vtkPVO
     type != vtkProcessModule::PROCESS_DATA_SERVER &&
     type != vtkProcessModule::PROCESS_RENDER_SERVER)
   {
+    vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "load settings");
     vtkInitializationHelper::LoadSettings();
   }
 
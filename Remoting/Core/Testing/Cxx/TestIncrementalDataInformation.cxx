@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestIncrementalDataInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkClientServerStream.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTrivialProducer.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetSphere(int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> pd;
+  pd->DeepCopy(sphere->GetOutput());
+  return pd;
+}
+
+// Mimics a gather from the client: parameters go to the "server", which
+// gathers and replies with a stream the client deserializes.
+size_t Gather(vtkAlgorithm* producer, vtkPVDataInformation* client)
+{
+  vtkMultiProcessStream params;
+  client->CopyParametersToStream(params);
+
+  vtkNew<vtkPVDataInformation> server;
+  server->CopyParametersFromStream(params);
+  server->CopyFromObject(producer);
+
+  vtkClientServerStream css;
+  server->CopyToStream(&css);
+
+  client->Initialize();
+  client->CopyFromStream(&css);
+
+  const unsigned char* data;
+  size_t length;
+  css.GetData(&data, &length);
+  return length;
+}
+}
+
+int TestIncrementalDataInformation(int, char* [])
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  for (unsigned int cc = 0; cc < 16; ++cc)
+  {
+    mb->SetBlock(cc, GetSphere(8));
+  }
+
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(mb);
+  producer->Update();
+
+  vtkNew<vtkPVDataInformation> client;
+  client->SetPortNumber(0);
+
+  const size_t full = Gather(producer, client);
+  const vtkTypeInt64 numPoints = client->GetNumberOfPoints();
+  if (client->GetCompositeDataInformation()->GetNumberOfChildren() != 16 || numPoints <= 0)
+  {
+    cerr << "ERROR: incorrect information after first gather." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // nothing changed: only markers should be sent for the blocks.
+  const size_t unchanged = Gather(producer, client);
+  if (unchanged >= full || client->GetNumberOfPoints() != numPoints ||
+    client->GetCompositeDataInformation()->GetDataInformation(5) == nullptr)
+  {
+    cerr << "ERROR: unchanged blocks were not reused (" << unchanged << " vs " << full
+         << " bytes)." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // change a single block.
+  auto block = vtkPolyData::SafeDownCast(mb->GetBlock(5));
+  block->ShallowCopy(GetSphere(16));
+  const size_t delta = Gather(producer, client);
+
+  vtkNew<vtkPVDataInformation> reference;
+  reference->CopyFromObject(mb);
+  if (delta >= full || client->GetNumberOfPoints() != reference->GetNumberOfPoints() ||
+    client->GetCompositeDataInformation()->GetDataInformation(5)->GetNumberOfPoints() !=
+      block->GetNumberOfPoints())
+  {
+    cerr << "ERROR: incorrect information after changing a block." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // a client without previous information gets everything.
+  vtkNew<vtkPVDataInformation> other;
+  other->SetPortNumber(0);
+  Gather(producer, other);
+  if (other->GetNumberOfPoints() != reference->GetNumberOfPoints())
+  {
+    cerr << "ERROR: incorrect information for a new client." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
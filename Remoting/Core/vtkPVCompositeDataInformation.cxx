@@ -42,8 +42,19 @@ struct vtkPVCompositeDataInformationInternals
   typedef std::vector<vtkNode> VectorOfDataInformation;
 
   VectorOfDataInformation ChildrenInformation;
+
+  // Children before the last Initialize(). CopyFromStream() reuses these for
+  // the children that the sender marked as unchanged.
+  VectorOfDataInformation PreviousChildrenInformation;
 };
 
+namespace
+{
+// Written instead of a child's serialized information when the receiver
+// already has it.
+const int UNCHANGED_CHILD_MARKER = -1;
+}
+
 //----------------------------------------------------------------------------
 vtkPVCompositeDataInformation::vtkPVCompositeDataInformation()
 {
@@ -120,7 +131,11 @@ void vtkPVCompositeDataInformation::Initialize()
   this->NumberOfPieces = 0;
   this->DataIsComposite = 0;
   this->NumberOfAMRLevels = 0;
-  this->Internal->ChildrenInformation.clear();
+  if (!this->Internal->ChildrenInformation.empty())
+  {
+    this->Internal->PreviousChildrenInformation.swap(this->Internal->ChildrenInformation);
+    this->Internal->ChildrenInformation.clear();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -166,6 +181,7 @@ const char* vtkPVCompositeDataInformation::GetName(unsigned int idx)
 void vtkPVCompositeDataInformation::CopyFromObject(vtkObject* object)
 {
   this->Initialize();
+  this->Internal->PreviousChildrenInformation.clear();
 
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(object);
   if (!cds)
@@ -219,7 +235,7 @@ void vtkPVCompositeDataInformation::CopyFromObject(vtkObject* object)
     if (curDO)
     {
       childInfo = vtkSmartPointer<vtkPVDataInformation>::New();
-      childInfo->CopyFromObject(curDO);
+      childInfo->CopyFromBlock(curDO);
     }
     this->Internal->ChildrenInformation.resize(index + 1);
     this->Internal->ChildrenInformation[index].Info = childInfo;
@@ -271,7 +287,7 @@ void vtkPVCompositeDataInformation::CopyFromAMR(vtkUniformGridAMR* amr)
       vtkUniformGrid* dataset = amr->GetDataSet(level, idx);
       if (dataset)
       {
-        tempDSInfo->CopyFromObject(dataset);
+        tempDSInfo->CopyFromBlock(dataset);
         levelInfo->AddInformation(tempDSInfo.GetPointer(), 1);
       }
     }
@@ -292,6 +308,7 @@ void vtkPVCompositeDataInformation::AddInformation(vtkPVInformation* pvi)
     vtkErrorMacro("Could not cast object to data information.");
     return;
   }
+  this->Internal->PreviousChildrenInformation.clear();
 
   this->DataIsComposite = info->GetDataIsComposite();
   this->DataIsMultiPiece = info->GetDataIsMultiPiece();
@@ -354,6 +371,13 @@ void vtkPVCompositeDataInformation::AddInformation(vtkPVInformation* pvi)
 
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataInformation::CopyToStream(vtkClientServerStream* css)
+{
+  this->CopyToStreamInternal(css, nullptr, std::string());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataInformation::CopyToStreamInternal(
+  vtkClientServerStream* css, vtkPVDataInformationDigests* digests, const std::string& path)
 {
   //  vtkTimerLog::MarkStartEvent("Copying composite information to stream");
   css->Reset();
@@ -368,9 +392,10 @@ void vtkPVCompositeDataInformation::CopyToStream(vtkClientServerStream* css)
     *css << i << this->Internal->ChildrenInformation[i].Name.c_str();
     vtkPVDataInformation* dataInf = this->Internal->ChildrenInformation[i].Info;
     vtkClientServerStream dcss;
-    if (dataInf)
+    if (dataInf && !dataInf->CopyToStreamInternal(&dcss, digests, path + "/" + std::to_string(i)))
     {
-      dataInf->CopyToStream(&dcss);
+      *css << UNCHANGED_CHILD_MARKER;
+      continue;
     }
 
     size_t length;
@@ -387,6 +412,8 @@ void vtkPVCompositeDataInformation::CopyToStream(vtkClientServerStream* css)
 void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream* css)
 {
   this->Initialize();
+  vtkPVCompositeDataInformationInternals::VectorOfDataInformation previous;
+  previous.swap(this->Internal->PreviousChildrenInformation);
 
   if (!css->GetArgument(0, 0, &this->DataIsComposite))
   {
@@ -449,6 +476,17 @@ void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream*
     vtkClientServerStream dcss;
 
     msgIdx++;
+    if (css->GetArgumentType(0, msgIdx) != vtkClientServerStream::uint8_array)
+    {
+      // the sender determined that we already have this child.
+      if (childIdx >= previous.size())
+      {
+        vtkErrorMacro("Missing previous information for block " << childIdx);
+        return;
+      }
+      this->Internal->ChildrenInformation[childIdx].Info = previous[childIdx].Info;
+      continue;
+    }
     // Data information.
     if (!css->GetArgumentLength(0, msgIdx, &length))
     {
@@ -464,7 +502,12 @@ void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream*
     dcss.SetData(&*data.begin(), length);
     if (dcss.GetNumberOfMessages() > 0)
     {
-      vtkNew<vtkPVDataInformation> dataInf;
+      // reuse the previous instance, if any, so that its own children can be
+      // reused in turn.
+      vtkSmartPointer<vtkPVDataInformation> dataInf =
+        (childIdx < previous.size() && previous[childIdx].Info)
+        ? previous[childIdx].Info
+        : vtkSmartPointer<vtkPVDataInformation>::New();
       dataInf->CopyFromStream(&dcss);
       this->Internal->ChildrenInformation[childIdx].Info = dataInf;
     }
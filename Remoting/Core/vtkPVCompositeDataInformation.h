@@ -29,7 +29,10 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+#include <string> // for std::string
+
 class vtkPVDataInformation;
+class vtkPVDataInformationDigests;
 class vtkUniformGridAMR;
 
 struct vtkPVCompositeDataInformationInternals;
@@ -132,6 +135,14 @@ protected:
   friend class vtkPVDataInformation;
   vtkPVDataInformation* GetDataInformationForCompositeIndex(int* index);
 
+  /**
+   * Serialize, replacing children the receiver already has with a marker when
+   * `digests` is non-null. `path` identifies this node in the composite tree.
+   * Used by vtkPVDataInformation.
+   */
+  void CopyToStreamInternal(
+    vtkClientServerStream*, vtkPVDataInformationDigests* digests, const std::string& path);
+
 private:
   vtkPVCompositeDataInformationInternals* Internal;
 
@@ -45,6 +45,7 @@
 #include "vtkPVDataInformationHelper.h"
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkPVInformationKeys.h"
+#include "vtkPVLogger.h"
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSelection.h"
@@ -52,8 +53,10 @@
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
 #include "vtkUniformGrid.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <set>
 #include <string>
@@ -63,6 +66,84 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Information for non-composite blocks of composite datasets, valid as long
+// as the block is alive and its MTime (or its information's) is unchanged.
+struct vtkBlockInformationCacheItem
+{
+  vtkWeakPointer<vtkDataObject> Block;
+  vtkMTimeType MTime = 0;
+  vtkSmartPointer<vtkPVDataInformation> Information;
+};
+std::map<vtkDataObject*, vtkBlockInformationCacheItem> BlockInformationCache;
+size_t BlockInformationCacheInsertions = 0;
+
+//----------------------------------------------------------------------------
+// What was last sent to a client for a producer's output port, used to only
+// send the blocks that changed.
+struct vtkDeltaRecord
+{
+  vtkWeakPointer<vtkObject> Source;
+  vtkTypeUInt64 Revision = 0;
+  std::map<std::string, vtkTypeUInt64> Digests;
+};
+std::map<std::pair<vtkObject*, int>, vtkDeltaRecord> DeltaRecords;
+vtkTypeUInt64 NextDeltaRevision = 1;
+
+//----------------------------------------------------------------------------
+// 64-bit FNV-1a.
+vtkTypeUInt64 ComputeDigest(const vtkClientServerStream& stream)
+{
+  const unsigned char* data;
+  size_t length;
+  stream.GetData(&data, &length);
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (size_t cc = 0; cc < length; ++cc)
+  {
+    hash = (hash ^ data[cc]) * 1099511628211ull;
+  }
+  return hash;
+}
+}
+
+//----------------------------------------------------------------------------
+// Digests, keyed by block path, of the blocks the receiver has (`Sent`) and of
+// those being sent now (`Current`).
+class vtkPVDataInformationDigests
+{
+public:
+  std::map<std::string, vtkTypeUInt64> Sent;
+  std::map<std::string, vtkTypeUInt64> Current;
+  vtkTypeUInt64 Revision = 0;
+  vtkIdType NumberOfBlocks = 0;
+  vtkIdType NumberOfUnchangedBlocks = 0;
+
+  bool IsUnchanged(const std::string& path, vtkTypeUInt64 digest) const
+  {
+    auto iter = this->Sent.find(path);
+    return iter != this->Sent.end() && iter->second == digest;
+  }
+
+  // Since `path` is unchanged, so are all the blocks under it.
+  void KeepSubtree(const std::string& path)
+  {
+    for (auto iter = this->Sent.lower_bound(path); iter != this->Sent.end(); ++iter)
+    {
+      const std::string& key = iter->first;
+      if (key.compare(0, path.size(), path) != 0)
+      {
+        break;
+      }
+      if (key.size() == path.size() || key[path.size()] == '/')
+      {
+        this->Current.insert(*iter);
+      }
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -114,14 +195,14 @@ vtkPVDataInformation::~vtkPVDataInformation()
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828792 << this->PortNumber;
+  str << 828792 << this->PortNumber << this->ReceivedRevision;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->PortNumber;
+  str >> magic_number >> this->PortNumber >> this->DeltaBaseRevision;
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -343,7 +424,7 @@ void vtkPVDataInformation::AddFromMultiPieceDataSet(vtkCompositeDataSet* data)
     if (dobj)
     {
       vtkPVDataInformation* dinf = vtkPVDataInformation::New();
-      dinf->CopyFromObject(dobj);
+      dinf->CopyFromBlock(dobj);
       dinf->SetDataClassName(dobj->GetClassName());
       dinf->DataSetType = dobj->GetDataObjectType();
       this->AddInformation(dinf, /*addingParts=*/1);
@@ -729,6 +810,9 @@ void vtkPVDataInformation::CopyFromHyperTreeGrid(vtkHyperTreeGrid* data)
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyFromObject(vtkObject* object)
 {
+  this->ReceivedRevision = 0;
+  this->DeltaSource = nullptr;
+
   vtkDataObject* dobj = vtkDataObject::SafeDownCast(object);
   vtkInformation* info = nullptr;
   // Handle the case where the a vtkAlgorithmOutput is passed instead of
@@ -751,6 +835,7 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
       }
       info = algOutput->GetProducer()->GetOutputInformation(this->PortNumber);
       dobj = algOutput->GetProducer()->GetOutputDataObject(algOutput->GetIndex());
+      this->DeltaSource = algOutput->GetProducer();
     }
     else if (algo)
     {
@@ -768,6 +853,7 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
         return;
       }
       dobj = algo->GetOutputDataObject(this->PortNumber);
+      this->DeltaSource = algo;
     }
   }
 
@@ -851,6 +937,52 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   this->CopyCommonMetaData(dobj, info);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::CopyFromBlock(vtkDataObject* block)
+{
+  // nested composite datasets are walked as usual; their leaves are cached.
+  if (block == nullptr || vtkCompositeDataSet::SafeDownCast(block))
+  {
+    this->CopyFromObject(block);
+    return;
+  }
+
+  // forget blocks that no longer exist every now and then.
+  if (BlockInformationCacheInsertions > BlockInformationCache.size() / 2)
+  {
+    for (auto iter = BlockInformationCache.begin(); iter != BlockInformationCache.end();)
+    {
+      iter = iter->second.Block == nullptr ? BlockInformationCache.erase(iter) : std::next(iter);
+    }
+    BlockInformationCacheInsertions = 0;
+  }
+
+  const vtkMTimeType mtime = std::max(block->GetMTime(), block->GetInformation()->GetMTime());
+  auto& item = BlockInformationCache[block];
+  if (item.Block != block || item.MTime != mtime || item.Information == nullptr)
+  {
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "gathering information for block %s",
+      vtkLogIdentifier(block));
+    item.Block = block;
+    item.MTime = mtime;
+    item.Information = vtkSmartPointer<vtkPVDataInformation>::New();
+    item.Information->CopyFromObject(block);
+    ++BlockInformationCacheInsertions;
+  }
+
+  this->Initialize();
+  this->DeepCopy(item.Information);
+  this->Time = item.Information->Time;
+  this->HasTime = item.Information->HasTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::ClearBlockInformationCache()
+{
+  BlockInformationCache.clear();
+  BlockInformationCacheInsertions = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::AddInformation(vtkPVInformation* pvi)
 {
@@ -870,6 +1002,7 @@ void vtkPVDataInformation::AddInformation(vtkPVInformation* pvi, int addingParts
     vtkErrorMacro("Could not cast object to data information.");
     return;
   }
+  this->ReceivedRevision = 0;
 
   if (!addingParts)
   {
@@ -1357,6 +1490,83 @@ unsigned int vtkPVDataInformation::GetNumberOfBlockLeafs(bool skipEmpty)
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
+{
+  // Only the reply to the client is delta-encoded. Streams exchanged between
+  // ranks when collecting information are merged into new instances which have
+  // nothing to reuse.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (this->DeltaSource == nullptr || (controller && controller->GetLocalProcessId() != 0))
+  {
+    this->SerializeToStream(css, nullptr, std::string());
+    return;
+  }
+
+  for (auto iter = DeltaRecords.begin(); iter != DeltaRecords.end();)
+  {
+    iter = iter->second.Source == nullptr ? DeltaRecords.erase(iter) : std::next(iter);
+  }
+
+  auto& record = DeltaRecords[std::make_pair(this->DeltaSource, this->PortNumber)];
+  vtkPVDataInformationDigests digests;
+  if (record.Source == this->DeltaSource && record.Revision != 0 &&
+    record.Revision == this->DeltaBaseRevision)
+  {
+    // the receiver has what we sent last time.
+    digests.Sent.swap(record.Digests);
+  }
+  digests.Revision = NextDeltaRevision++;
+  this->SerializeToStream(css, &digests, std::string());
+
+  record.Source = this->DeltaSource;
+  record.Revision = digests.Revision;
+  record.Digests.swap(digests.Current);
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+    "data information revision %llu: sending %lld of %lld blocks (base revision %llu)",
+    static_cast<unsigned long long>(digests.Revision),
+    static_cast<long long>(digests.NumberOfBlocks - digests.NumberOfUnchangedBlocks),
+    static_cast<long long>(digests.NumberOfBlocks),
+    static_cast<unsigned long long>(this->DeltaBaseRevision));
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::CopyToStreamInternal(
+  vtkClientServerStream* css, vtkPVDataInformationDigests* digests, const std::string& path)
+{
+  if (digests == nullptr)
+  {
+    this->SerializeToStream(css, nullptr, path);
+    return true;
+  }
+
+  // the digest covers the whole sub-tree, so an unchanged composite block
+  // implies unchanged children.
+  vtkClientServerStream full;
+  this->SerializeToStream(&full, nullptr, path);
+  const vtkTypeUInt64 digest = ComputeDigest(full);
+  ++digests->NumberOfBlocks;
+  if (digests->IsUnchanged(path, digest))
+  {
+    ++digests->NumberOfUnchangedBlocks;
+    digests->KeepSubtree(path);
+    return false;
+  }
+
+  digests->Current[path] = digest;
+  if (this->CompositeDataInformation->GetDataIsComposite())
+  {
+    // some of the children may still be unchanged.
+    this->SerializeToStream(css, digests, path);
+  }
+  else
+  {
+    *css = full;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::SerializeToStream(
+  vtkClientServerStream* css, vtkPVDataInformationDigests* digests, const std::string& path)
 {
   css->Reset();
   *css << vtkClientServerStream::Reply;
@@ -1411,7 +1621,7 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
 
   dcss.Reset();
 
-  this->CompositeDataInformation->CopyToStream(&dcss);
+  this->CompositeDataInformation->CopyToStreamInternal(&dcss, digests, path);
   dcss.GetData(&data, &length);
   *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
 
@@ -1422,6 +1632,7 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
   *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
 
   *css << vtkClientServerStream::InsertArray(this->TimeSpan, 2);
+  *css << (digests ? digests->Revision : vtkTypeUInt64(0));
 
   *css << vtkClientServerStream::End;
 }
@@ -1711,6 +1922,11 @@ void vtkPVDataInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing timespan.");
     return;
   }
+  if (!CSS_GET_NEXT_ARGUMENT(css, 0, &this->ReceivedRevision))
+  {
+    vtkErrorMacro("Error parsing revision.");
+    return;
+  }
 
   CSS_ARGUMENT_END();
 }
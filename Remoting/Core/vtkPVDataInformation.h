@@ -33,6 +33,8 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+#include <string> // for std::string
+
 class vtkCollection;
 class vtkCompositeDataSet;
 class vtkDataObject;
@@ -44,6 +46,7 @@ class vtkInformation;
 class vtkPVArrayInformation;
 class vtkPVCompositeDataInformation;
 class vtkPVDataSetAttributesInformation;
+class vtkPVDataInformationDigests;
 class vtkPVDataInformationHelper;
 class vtkSelection;
 class vtkTable;
@@ -296,6 +299,13 @@ public:
    */
   static void RegisterHelper(const char* classname, const char* helperclassname);
 
+  /**
+   * Information for the non-composite blocks of composite datasets is cached
+   * per process, keyed by the block and its MTime, so that re-gathering only
+   * recomputes the blocks that changed. This releases the cached information.
+   */
+  static void ClearBlockInformationCache();
+
 protected:
   vtkPVDataInformation();
   ~vtkPVDataInformation() override;
@@ -314,6 +324,25 @@ protected:
   void CopyFromSelection(vtkSelection* selection);
   void CopyCommonMetaData(vtkDataObject*, vtkInformation*);
 
+  /**
+   * Same as CopyFromObject() but uses the block information cache for
+   * non-composite data objects. Used for the blocks of composite datasets.
+   */
+  void CopyFromBlock(vtkDataObject* block);
+
+  //@{
+  /**
+   * Serialization helpers for delta-encoding the information sent to the
+   * client. When `digests` is non-null, composite children that the receiver
+   * already has are replaced by a marker; CopyToStreamInternal() returns false
+   * when `this` is such a child, in which case nothing is written.
+   */
+  bool CopyToStreamInternal(
+    vtkClientServerStream*, vtkPVDataInformationDigests* digests, const std::string& path);
+  void SerializeToStream(
+    vtkClientServerStream*, vtkPVDataInformationDigests* digests, const std::string& path);
+  //@}
+
   static vtkPVDataInformationHelper* FindHelper(const char* classname);
 
   // Data information collected from remote processes.
@@ -362,6 +391,7 @@ protected:
   vtkPVArrayInformation* PointArrayInformation;
 
   friend class vtkPVDataInformationHelper;
+  friend class vtkPVDataInformationDigests;
   friend class vtkPVCompositeDataInformation;
 
 private:
@@ -369,6 +399,16 @@ private:
   void operator=(const vtkPVDataInformation&) = delete;
 
   int PortNumber = -1;
+
+  // Revision of the server-side information this instance was last filled
+  // with using CopyFromStream(); 0 if unknown. Sent to the server with the
+  // parameters so that it can only send what changed since.
+  vtkTypeUInt64 ReceivedRevision = 0;
+
+  // On the server, the revision the requester has (from the parameters) and
+  // the producer the information was gathered from.
+  vtkTypeUInt64 DeltaBaseRevision = 0;
+  vtkObject* DeltaSource = nullptr;
 };
 
 #endif
@@ -84,6 +84,7 @@ vtkPVOptions::vtkPVOptions()
   this->ForceOnscreenRendering = 0;
   this->CatalystLivePort = -1;
   this->LogStdErrVerbosity = vtkLogger::VERBOSITY_INVALID;
+  this->LogTimelineVerbosity = vtkLogger::VERBOSITY_INVALID;
   this->DisplaysAssignmentMode = vtkPVOptions::ROUNDROBIN;
   if (this->XMLParser)
   {
@@ -149,6 +150,14 @@ void vtkPVOptions::Initialize()
     "are same as those accepted for `--verbosity` argument.",
     vtkPVOptions::ALLPROCESS);
 
+  this->AddCallback("--log-timeline", nullptr, &vtkPVOptions::LogTimelineArgumentHandler, this,
+    "Record log scopes on all ranks and write them to the specified file on exit "
+    "in Chrome trace event format, which can be viewed in chrome://tracing or Perfetto. "
+    "By default, scopes with verbosity INFO(0) or lower are recorded. This may be "
+    "overridden by adding suffix `,verbosity`. Use the PARAVIEW_LOG_*_VERBOSITY "
+    "environment variables to elevate the categories of interest.",
+    vtkPVOptions::ALLPROCESS);
+
   // On occasion, one would want to force the hostname used by a particular
   // process (overriding the default detected by making System calls). This
   // option makes it possible).
@@ -371,6 +380,37 @@ int vtkPVOptions::LogArgumentHandler(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkPVOptions::LogTimelineArgumentHandler(
+  const char* vtkNotUsed(argument), const char* cvalue, void* call_data)
+{
+  if (cvalue == nullptr)
+  {
+    return 0;
+  }
+
+  std::string value(cvalue);
+  auto verbosity = vtkLogger::VERBOSITY_INFO;
+  auto separator = value.find_last_of(',');
+  if (separator != std::string::npos)
+  {
+    verbosity = vtkLogger::ConvertToVerbosity(value.substr(separator + 1).c_str());
+    if (verbosity == vtkLogger::VERBOSITY_INVALID)
+    {
+      // invalid verbosity specified.
+      return 0;
+    }
+    value = value.substr(0, separator);
+  }
+
+  // unlike `--log`, no per-rank suffix is added since the timeline is
+  // gathered and written out by the root alone.
+  auto self = reinterpret_cast<vtkPVOptions*>(call_data);
+  self->LogTimelineFileName = value;
+  self->LogTimelineVerbosity = verbosity;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVOptions::VerbosityArgumentHandler(
   const char* vtkNotUsed(argument), const char* value, void* call_data)
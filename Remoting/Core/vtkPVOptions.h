@@ -271,6 +271,16 @@ public:
   vtkGetMacro(LogStdErrVerbosity, int);
   //@}
 
+  //@{
+  /**
+   * Returns the file and verbosity chosen using `--log-timeline`. The file
+   * name is empty and the verbosity is vtkLogger::VERBOSITY_INVALID if not
+   * specified.
+   */
+  const std::string& GetLogTimelineFileName() const { return this->LogTimelineFileName; }
+  vtkGetMacro(LogTimelineVerbosity, int);
+  //@}
+
   //@{
   /**
    * Provides access to display selection. These can be interpreted as EGL
@@ -388,6 +398,8 @@ private:
   int LogStdErrVerbosity;
 
   std::vector<std::pair<std::string, int> > LogFiles;
+  std::string LogTimelineFileName;
+  int LogTimelineVerbosity;
   std::vector<std::string> Displays;
   int DisplaysAssignmentMode;
 
@@ -399,6 +411,8 @@ private:
 
   static int VerbosityArgumentHandler(const char* argument, const char* value, void* call_data);
   static int LogArgumentHandler(const char* argument, const char* value, void* call_data);
+  static int LogTimelineArgumentHandler(
+    const char* argument, const char* value, void* call_data);
   static int DisplaysArgumentHandler(const char* argument, const char* value, void* call_data);
   static int DisplaysAssignmentModeArgumentHandler(
     const char* argument, const char* value, void* call_data);
@@ -19,16 +19,63 @@
 #include "vtkClientServerStream.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <map>
 #include <vector>
 
+namespace
+{
+// Information collected for each timestep, for each output port of a
+// producer. Stored on the producer using TIME_STEP_INFORMATION_CACHE() so
+// that it goes away with it.
+class vtkTimeStepInformationCache : public vtkObject
+{
+public:
+  static vtkTimeStepInformationCache* New();
+  vtkTypeMacro(vtkTimeStepInformationCache, vtkObject);
+
+  struct PortCache
+  {
+    vtkMTimeType PipelineMTime = 0;
+    std::map<double, vtkSmartPointer<vtkPVDataInformation> > TimeSteps;
+  };
+  std::map<int, PortCache> Ports;
+
+  // Returns the cached timesteps for `port`, discarding them if the pipeline
+  // was modified since they were collected.
+  std::map<double, vtkSmartPointer<vtkPVDataInformation> >& GetTimeSteps(
+    int port, vtkMTimeType pipelineMTime)
+  {
+    PortCache& cache = this->Ports[port];
+    if (cache.PipelineMTime != pipelineMTime)
+    {
+      cache.TimeSteps.clear();
+      cache.PipelineMTime = pipelineMTime;
+    }
+    return cache.TimeSteps;
+  }
+
+protected:
+  vtkTimeStepInformationCache() = default;
+  ~vtkTimeStepInformationCache() override = default;
+
+private:
+  vtkTimeStepInformationCache(const vtkTimeStepInformationCache&) = delete;
+  void operator=(const vtkTimeStepInformationCache&) = delete;
+};
+vtkStandardNewMacro(vtkTimeStepInformationCache);
+}
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
+vtkInformationKeyMacro(vtkPVTemporalDataInformation, TIME_STEP_INFORMATION_CACHE, ObjectBase);
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
 {
@@ -36,6 +83,7 @@ vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
   this->TimeRange[0] = VTK_DOUBLE_MAX;
   this->TimeRange[1] = -VTK_DOUBLE_MAX;
   this->PortNumber = 0;
+  this->SamplingStride = 1;
 
   this->PointDataInformation = vtkPVDataSetAttributesInformation::New();
   this->CellDataInformation = vtkPVDataSetAttributesInformation::New();
@@ -116,14 +164,14 @@ void vtkPVTemporalDataInformation::Initialize()
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 829993 << this->PortNumber;
+  str << 829993 << this->PortNumber << this->SamplingStride;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->PortNumber;
+  str >> magic_number >> this->PortNumber >> this->SamplingStride;
   if (magic_number != 829993)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -186,30 +234,60 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     this->NumberOfTimeSteps = 0;
   }
 
-  std::vector<double>::iterator iter;
+  vtkAlgorithm* producer = port->GetProducer();
   vtkStreamingDemandDrivenPipeline* sddp =
-    vtkStreamingDemandDrivenPipeline::SafeDownCast(port->GetProducer()->GetExecutive());
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(producer->GetExecutive());
   if (!sddp)
   {
     vtkErrorMacro("This class expects vtkStreamingDemandDrivenPipeline.");
     return;
   }
 
+  vtkInformation* producerInfo = producer->GetInformation();
+  vtkTimeStepInformationCache* cache = vtkTimeStepInformationCache::SafeDownCast(
+    producerInfo->Get(vtkPVTemporalDataInformation::TIME_STEP_INFORMATION_CACHE()));
+  if (!cache)
+  {
+    vtkNew<vtkTimeStepInformationCache> newCache;
+    producerInfo->Set(vtkPVTemporalDataInformation::TIME_STEP_INFORMATION_CACHE(), newCache);
+    cache = newCache;
+  }
+  auto& cachedSteps = cache->GetTimeSteps(port->GetIndex(), sddp->GetPipelineMTime());
+
   double current_time = dinfo->GetTime();
-  for (iter = timesteps.begin(); iter != timesteps.end(); ++iter)
+  cachedSteps[current_time] = dinfo;
+
+  const size_t numTimeSteps = timesteps.size();
+  for (size_t cc = 0; cc < numTimeSteps; ++cc)
   {
-    if (*iter == current_time)
+    const double time = timesteps[cc];
+    if (time == current_time)
     {
       // skip the timestep already seen.
       continue;
     }
-    pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), *iter);
+
+    auto citer = cachedSteps.find(time);
+    if (citer != cachedSteps.end())
+    {
+      this->AddInformation(citer->second);
+      continue;
+    }
+
+    if (cc % this->SamplingStride != 0 && cc + 1 != numTimeSteps)
+    {
+      // not sampled.
+      continue;
+    }
+
+    pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
     sddp->Update(port->GetIndex());
 
-    dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
-    dinfo->Initialize();
-    dinfo->CopyFromObject(dobj);
-    this->AddInformation(dinfo);
+    dobj = producer->GetOutputDataObject(port->GetIndex());
+    vtkNew<vtkPVDataInformation> stepInfo;
+    stepInfo->CopyFromObject(dobj);
+    this->AddInformation(stepInfo);
+    cachedSteps[time] = stepInfo.Get();
   }
 }
 
@@ -419,6 +497,7 @@ void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << endl;
   os << indent << "TimeRange: " << this->TimeRange[0] << ", " << this->TimeRange[1] << endl;
+  os << indent << "SamplingStride: " << this->SamplingStride << endl;
 
   vtkIndent i2 = indent.GetNextIndent();
   os << indent << "PointDataInformation " << endl;
@@ -20,6 +20,14 @@
  * and hence this is not directly a subclass of vtkPVDataInformation. It
  * internally uses vtkPVDataInformation to collect information about each
  * timestep.
+ *
+ * Since gathering information over time requires updating the pipeline for
+ * each timestep, the information collected for each timestep is cached on the
+ * producer. The cache is discarded whenever the pipeline MTime changes, so
+ * subsequent gathers, e.g. repeated "rescale over all timesteps", only update
+ * the pipeline for timesteps that were not visited before. For faster but
+ * approximate results, use `SetSamplingStride` to only visit every Nth
+ * timestep that is not already cached.
 */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -28,6 +36,7 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+class vtkInformationObjectBaseKey;
 class vtkPVArrayInformation;
 class vtkPVDataSetAttributesInformation;
 
@@ -50,6 +59,17 @@ public:
   vtkSetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * When greater than 1, only every Nth timestep (along with the last one) is
+   * visited when it is not already cached, resulting in approximate ranges.
+   * Default is 1, i.e. all timesteps are visited. Like PortNumber, this can be
+   * set on the client-side before gathering the information.
+   */
+  vtkSetClampMacro(SamplingStride, int, 1, VTK_INT_MAX);
+  vtkGetMacro(SamplingStride, int);
+  //@}
+
   /**
    * Transfer information about a single object into this object.
    * This expects the \c object to be a vtkAlgorithmOutput.
@@ -149,6 +169,12 @@ protected:
   double TimeRange[2];
   int NumberOfTimeSteps;
   int PortNumber;
+  int SamplingStride;
+
+  /**
+   * Key used to cache the information for each timestep on the producer.
+   */
+  static vtkInformationObjectBaseKey* TIME_STEP_INFORMATION_CACHE();
 
 private:
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
@@ -21,6 +21,7 @@
 #include "vtkDummyController.h"
 #include "vtkFloatingPointExceptions.h"
 #include "vtkInformation.h"
+#include "vtkLogger.h"
 #include "vtkMultiThreader.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -298,6 +299,15 @@ bool vtkProcessModule::Finalize()
     vtkProcessModule::Singleton->Internals->Sessions.clear();
 
     vtkProcessModule::Singleton->InvokeEvent(vtkCommand::ExitEvent);
+
+    // this is collective, hence done while the global controller is still
+    // around.
+    auto& recorder = vtkProcessModule::Singleton->Internals->LogTimelineRecorder;
+    if (recorder)
+    {
+      recorder->Write();
+      recorder = nullptr;
+    }
   }
 
   // destroy the process-module.
@@ -533,6 +543,15 @@ void vtkProcessModule::SetOptions(vtkPVOptions* options)
   if (options)
   {
     this->SetSymmetricMPIMode(options->GetSymmetricMPIMode() != 0);
+    if (options->GetLogTimelineVerbosity() != vtkLogger::VERBOSITY_INVALID &&
+      !this->Internals->LogTimelineRecorder)
+    {
+      auto recorder = vtkSmartPointer<vtkLogTimelineRecorder>::New();
+      recorder->SetController(vtkProcessModule::GlobalController);
+      recorder->SetFileName(options->GetLogTimelineFileName().c_str());
+      recorder->SetVerbosity(options->GetLogTimelineVerbosity());
+      this->Internals->LogTimelineRecorder = recorder;
+    }
   }
 }
 
@@ -15,6 +15,7 @@
 #ifndef vtkProcessModuleInternals_h
 #define vtkProcessModuleInternals_h
 
+#include "vtkLogTimelineRecorder.h"
 #include "vtkSession.h"
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
@@ -30,6 +31,9 @@ public:
 
   typedef std::vector<vtkWeakPointer<vtkSession> > ActiveSessionStackType;
   ActiveSessionStackType ActiveSessionStack;
+
+  // created when `--log-timeline` is specified.
+  vtkSmartPointer<vtkLogTimelineRecorder> LogTimelineRecorder;
 };
 
 #endif
@@ -37,11 +37,15 @@
 #include "vtkSmartPointer.h"
 
 #include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
 
 #include <assert.h>
+#include <cstdlib>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -255,6 +259,11 @@ vtkPVSessionCore::vtkPVSessionCore()
   this->Interpreter = vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
   this->MPIMToNSocketConnection = NULL;
   this->SymmetricMPIMode = false;
+  this->CollectInformationFanIn = 2;
+  if (const char* fanIn = vtksys::SystemTools::GetEnv("PV_COLLECT_INFORMATION_FANIN"))
+  {
+    this->SetCollectInformationFanIn(atoi(fanIn));
+  }
 
   vtkPVSessionCoreInterpreterHelper* helper = vtkPVSessionCoreInterpreterHelper::New();
   helper->SetCore(this);
@@ -530,6 +539,7 @@ void vtkPVSessionCore::PushStateSatelliteCallback()
 void vtkPVSessionCore::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CollectInformationFanIn: " << this->CollectInformationFanIn << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -886,21 +896,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if (array_ptr != NULL)                                                                         \
-    {                                                                                              \
-      delete[] array_ptr;                                                                          \
-      array_ptr = NULL;                                                                            \
-    }                                                                                              \
-  }
-
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: NULL PV information!" && (info != NULL));
-
-  // STEP 0: temporary variables
   int rank = this->ParallelController->GetLocalProcessId();
   int nranks = this->ParallelController->GetNumberOfProcesses();
 
@@ -910,82 +907,89 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     return true;
   }
 
-  vtkIdType* rcvcounts = NULL;     /* significant only at rank 0 */
-  vtkIdType* offSet = NULL;        /* significant only at rank 0 */
-  int rbufsize = 0;                /* significant only at rank 0 */
-  unsigned char* rcvbuffer = NULL; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
-  {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
-  vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
-
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
+  // Reduce using a k-nomial tree (k = CollectInformationFanIn). At each level,
+  // a rank whose k-ary digit for that level is non-zero sends what it has
+  // accumulated so far to the rank with that digit cleared, and is done.
+  // Other ranks receive from up to k-1 peers in increasing rank order. Thus a
+  // rank always accumulates a contiguous range of ranks, in rank order, just
+  // like merging everything serially on the root would. Since the root only
+  // returns once every rank has contributed, no trailing barrier is needed.
+  //
+  // Each message is a list of serialized information objects. info may be
+  // NULL if the information could not be created on this satellite, in which
+  // case what is received from the children cannot be merged here and is
+  // forwarded as is, so that it still reaches the root.
+  std::vector<std::vector<unsigned char> > unmerged;
+  const vtkIdType fanIn = this->CollectInformationFanIn;
+  for (vtkIdType stride = 1; stride < nranks; stride *= fanIn)
   {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+    const int digit = static_cast<int>((rank / stride) % fanIn);
+    if (digit != 0)
     {
-      rbufsize += rcvcounts[i];
-    }
-    rcvbuffer = new unsigned char[rbufsize];
+      const int parent = static_cast<int>(rank - digit * stride);
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
-    {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      // We still need to send something, otherwise root will hang.
+      vtkClientServerStream stream;
+      const unsigned char* data = NULL;
+      size_t length = 0;
+      if (info)
+      {
+        info->CopyToStream(&stream);
+        stream.GetData(&data, &length);
+      }
+      vtkIdType count = static_cast<vtkIdType>(unmerged.size()) + (info ? 1 : 0);
+      this->ParallelController->Send(&count, 1, parent, ROOT_SATELLITE_INFO_TAG);
+      if (info)
+      {
+        vtkIdType local_length = static_cast<vtkIdType>(length);
+        this->ParallelController->Send(&local_length, 1, parent, ROOT_SATELLITE_INFO_TAG);
+        this->ParallelController->Send(data, local_length, parent, ROOT_SATELLITE_INFO_TAG);
+      }
+      for (const auto& buffer : unmerged)
+      {
+        vtkIdType buffer_length = static_cast<vtkIdType>(buffer.size());
+        this->ParallelController->Send(&buffer_length, 1, parent, ROOT_SATELLITE_INFO_TAG);
+        this->ParallelController->Send(
+          buffer.data(), buffer_length, parent, ROOT_SATELLITE_INFO_TAG);
+      }
+      return true;
     }
-  } // END if rank==0
-
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
+    for (vtkIdType cc = 1; cc < fanIn; ++cc)
     {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
-
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be NULL" && (rcvcounts == NULL));
-  assert("post: offSet should be NULL" && (offSet == NULL));
-  assert("post: rcvbuffer should be NULL" && (rcvbuffer == NULL));
-
-  // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+      const vtkIdType child = rank + cc * stride;
+      if (child >= nranks)
+      {
+        break;
+      }
+
+      vtkIdType count = 0;
+      this->ParallelController->Receive(
+        &count, 1, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+      for (vtkIdType kk = 0; kk < count; ++kk)
+      {
+        vtkIdType rcv_length = 0;
+        this->ParallelController->Receive(
+          &rcv_length, 1, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+        std::vector<unsigned char> rcvbuffer(rcv_length);
+        this->ParallelController->Receive(
+          rcvbuffer.data(), rcv_length, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+        if (info)
+        {
+          vtkClientServerStream rcvStream;
+          rcvStream.SetData(rcvbuffer.data(), rcv_length);
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&rcvStream);
+          info->AddInformation(tempInfo);
+        }
+        else
+        {
+          unmerged.push_back(std::move(rcvbuffer));
+        }
+      }
+    }
+  }
   return true;
 }
 
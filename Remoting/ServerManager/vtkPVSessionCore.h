@@ -188,6 +188,19 @@ public:
    */
   void GarbageCollectSIObject(int* clientIds, int nbClients);
 
+  //@{
+  /**
+   * Fan-in of the reduction tree used to collect vtkPVInformation across MPI
+   * ranks in `GatherInformation`. Each rank merges results from up to
+   * `CollectInformationFanIn - 1` peers per level of the tree, so gathering
+   * takes O(log(P)) steps rather than P-1 serial merges on the root. The
+   * default is 2 unless overridden by the `PV_COLLECT_INFORMATION_FANIN`
+   * environment variable. This must be the same on all ranks.
+   */
+  vtkSetClampMacro(CollectInformationFanIn, int, 2, VTK_INT_MAX);
+  vtkGetMacro(CollectInformationFanIn, int);
+  //@}
+
 protected:
   vtkPVSessionCore();
   ~vtkPVSessionCore() override;
@@ -254,6 +267,8 @@ private:
   // Local counter for global Ids
   vtkTypeUInt32 LocalGlobalID;
 
+  int CollectInformationFanIn;
+
   ostream* LogStream;
 };
 
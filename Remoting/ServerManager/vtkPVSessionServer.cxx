@@ -537,22 +537,43 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     {
       std::string string;
       stream >> string;
-      vtkSMMessage msg;
-      msg.ParseFromString(string);
-
-      //      cout << "=================================" << endl;
-      //      msg.PrintDebugString();
-      //      cout << "=================================" << endl;
+      this->PushStateInternal(string);
+    }
+    break;
 
-      // Do we skip the processing ?
-      if (!this->Internal->StoreShareOnly(&msg))
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      // A batch is a sequence of one-way messages (PUSH, REGISTER_SI or
+      // UNREGISTER_SI) that must be processed in order.
+      while (!stream.Empty())
       {
-        this->PushState(&msg);
+        int subtype;
+        std::string string;
+        stream >> subtype >> string;
+        if (subtype == vtkPVSessionServer::PUSH)
+        {
+          this->PushStateInternal(string);
+        }
+        else if (subtype == vtkPVSessionServer::REGISTER_SI ||
+          subtype == vtkPVSessionServer::UNREGISTER_SI)
+        {
+          vtkSMMessage msg;
+          msg.ParseFromString(string);
+          if (subtype == vtkPVSessionServer::REGISTER_SI)
+          {
+            this->RegisterSIObject(&msg);
+          }
+          else
+          {
+            this->UnRegisterSIObject(&msg);
+          }
+        }
+        else
+        {
+          vtkErrorMacro("Unexpected message in batch: " << subtype);
+          break;
+        }
       }
-
-      // Notify when ProxyManager state has changed
-      // or any other state change
-      this->NotifyOtherClients(&msg);
     }
     break;
 
@@ -625,6 +646,27 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::PushStateInternal(const std::string& data)
+{
+  vtkSMMessage msg;
+  msg.ParseFromString(data);
+
+  //      cout << "=================================" << endl;
+  //      msg.PrintDebugString();
+  //      cout << "=================================" << endl;
+
+  // Do we skip the processing ?
+  if (!this->Internal->StoreShareOnly(&msg))
+  {
+    this->PushState(&msg);
+  }
+
+  // Notify when ProxyManager state has changed
+  // or any other state change
+  this->NotifyOtherClients(&msg);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::SendLastResultToClient()
 {
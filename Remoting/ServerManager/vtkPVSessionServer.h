@@ -28,6 +28,8 @@
 #include "vtkPVSessionBase.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 
+#include <string> // for std::string
+
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
 
@@ -83,6 +85,7 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    PUSH_BATCH = 19,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
@@ -151,6 +154,11 @@ protected:
    */
   void SendLastResultToClient();
 
+  /**
+   * Called when client triggers PushState() with the serialized message.
+   */
+  void PushStateInternal(const std::string& data);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
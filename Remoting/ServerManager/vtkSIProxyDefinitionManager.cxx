@@ -20,11 +20,13 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVConfig.h"
+#include "vtkPVLogger.h"
 #include "vtkPVPlugin.h"
 #include "vtkPVPluginTracker.h"
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVServerManagerPluginInterface.h"
 #include "vtkPVSession.h"
+#include "vtkPVXMLBinarySerializer.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
@@ -35,13 +37,17 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <fstream>
+#include <iomanip>
 #include <map>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -50,11 +56,107 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+bool CacheDirectoryInitialized = false;
+std::string CacheDirectory;
+
+std::string& GetCacheDirectoryInternal()
+{
+  if (!CacheDirectoryInitialized)
+  {
+    CacheDirectoryInitialized = true;
+    if (const char* envval = vtksys::SystemTools::GetEnv("PARAVIEW_PROXY_DEFINITION_CACHE_DIR"))
+    {
+      CacheDirectory = envval;
+    }
+  }
+  return CacheDirectory;
+}
+
+// Returns the name of the cache file for the given XML contents. The name is
+// derived from a hash of the contents so that modified XMLs never match stale
+// cache entries.
+std::string GetCacheFileName(const std::string& directory, const char* xmlContent)
+{
+  // 64-bit FNV-1a
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  size_t length = 0;
+  for (const char* ptr = xmlContent; *ptr != '\0'; ++ptr, ++length)
+  {
+    hash ^= static_cast<unsigned char>(*ptr);
+    hash *= 1099511628211ull;
+  }
+
+  std::ostringstream name;
+  name << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << "-"
+       << std::dec << length << ".pvxb";
+  return name.str();
+}
+
+vtkSmartPointer<vtkPVXMLElement> ReadCacheFile(const std::string& fname)
+{
+  std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    return nullptr;
+  }
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  if (size <= 0)
+  {
+    return nullptr;
+  }
+
+  std::vector<char> buffer(static_cast<size_t>(size));
+  if (!file.read(buffer.data(), size))
+  {
+    return nullptr;
+  }
+  return vtkPVXMLBinarySerializer::Deserialize(buffer.data(), buffer.size());
+}
+
+void WriteCacheFile(const std::string& directory, const std::string& fname, vtkPVXMLElement* root)
+{
+  std::vector<char> buffer;
+  if (!vtkPVXMLBinarySerializer::Serialize(root, buffer) ||
+    !vtksys::SystemTools::MakeDirectory(directory))
+  {
+    return;
+  }
+
+  // Several processes may be populating the cache at the same time, so write
+  // to a unique temporary file first and then move it in place.
+  std::random_device rd;
+  const std::string tmpname = fname + "." + std::to_string(rd()) + ".tmp";
+  {
+    std::ofstream file(tmpname.c_str(), std::ios::out | std::ios::binary);
+    if (!file || !file.write(buffer.data(), buffer.size()))
+    {
+      vtkVLogF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "failed to write cache file '%s'",
+        tmpname.c_str());
+      file.close();
+      vtksys::SystemTools::RemoveFile(tmpname);
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpname, fname))
+  {
+    vtksys::SystemTools::RemoveFile(tmpname);
+  }
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
   // Keep State Flag of the ProcessType
   bool EnableXMLProxyDefinitionUpdate;
+  // Keep track of parsed XMLs read from or added to the cache.
+  int NumberOfCacheHits = 0;
+  int NumberOfCacheMisses = 0;
   // Keep track of ServerManager definition
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
@@ -423,6 +525,7 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
   this->InternalsFlatten = new vtkInternals;
 
   vtkPVPluginTracker* tracker = vtkPVPluginTracker::GetInstance();
+  vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "load proxy definitions");
 
   // Load the core xmls.
   // These are loaded from the vtkPVInitializerPlugin plugin.
@@ -449,6 +552,13 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
     this->HandlePlugin(plugin);
   }
 
+  if (!GetCacheDirectoryInternal().empty())
+  {
+    vtkVLogF(PARAVIEW_LOG_STARTUP_VERBOSITY(),
+      "proxy definition cache '%s': %d hit(s), %d miss(es)", GetCacheDirectoryInternal().c_str(),
+      this->Internals->NumberOfCacheHits, this->Internals->NumberOfCacheMisses);
+  }
+
   // Register with the plugin tracker, so that when new plugins are loaded,
   // we parse the XML if provided and automatically add it to the proxy
   // definitions.
@@ -765,9 +875,48 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints)
 {
+  vtkSmartPointer<vtkPVXMLElement> root;
+  root.TakeReference(this->ParseConfigurationXML(xmlContent));
+  return root != nullptr && this->LoadConfigurationXML(root, attachHints);
+}
+
+//---------------------------------------------------------------------------
+vtkPVXMLElement* vtkSIProxyDefinitionManager::ParseConfigurationXML(const char* xmlContent)
+{
+  if (!xmlContent)
+  {
+    return nullptr;
+  }
+
+  const std::string& directory = GetCacheDirectoryInternal();
+  std::string fname;
+  if (!directory.empty())
+  {
+    fname = GetCacheFileName(directory, xmlContent);
+    if (auto cached = ReadCacheFile(fname))
+    {
+      ++this->Internals->NumberOfCacheHits;
+      cached->Register(this);
+      return cached;
+    }
+  }
+
   vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+  if (!parser->Parse(xmlContent))
+  {
+    return nullptr;
+  }
+
+  vtkPVXMLElement* root = parser->GetRootElement();
+  if (!fname.empty())
+  {
+    // must be cached before anything modifies the tree e.g. hints being
+    // attached in LoadConfigurationXML.
+    ++this->Internals->NumberOfCacheMisses;
+    WriteCacheFile(directory, fname, root);
+  }
+  root->Register(this);
+  return root;
 }
 
 //---------------------------------------------------------------------------
@@ -1185,6 +1334,8 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
     dynamic_cast<vtkPVServerManagerPluginInterface*>(plugin);
   if (smplugin)
   {
+    vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "load proxy definitions from '%s'",
+      plugin->GetPluginName());
     std::vector<std::string> xmls;
     smplugin->GetXMLs(xmls);
 
@@ -1277,6 +1428,18 @@ void vtkSIProxyDefinitionManager::PatchXMLProperty(vtkPVXMLElement* propElement)
     propElement->RemoveNestedElement(informationHelper);
   }
 }
+//----------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetCacheDirectory(const char* dir)
+{
+  GetCacheDirectoryInternal() = dir ? dir : "";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkSIProxyDefinitionManager::GetCacheDirectory()
+{
+  return GetCacheDirectoryInternal().c_str();
+}
+
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSIProxyDefinitionManager::GetReservedGlobalID()
 {
@@ -37,6 +37,13 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * Parsing the server manager configuration XMLs can take a noticeable part of
+ * the startup time of every process. When a cache directory is set (see
+ * SetCacheDirectory), each configuration XML is parsed once and its parsed
+ * form is saved in the cache directory using vtkPVXMLBinarySerializer.
+ * Subsequent loads of identical XML contents, in this process or in any other
+ * process sharing the cache directory, are read from the cache instead.
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -69,6 +76,19 @@ public:
    */
   static void PatchXMLProperty(vtkPVXMLElement* propElement);
 
+  //@{
+  /**
+   * Set/Get the directory used to cache parsed server manager configuration
+   * XMLs. The cache is disabled when set to nullptr or an empty string.
+   * Defaults to the value of the `PARAVIEW_PROXY_DEFINITION_CACHE_DIR`
+   * environment variable. Since the core XMLs are loaded when the
+   * vtkSIProxyDefinitionManager is created, this must be set before the proxy
+   * manager is initialized to affect those.
+   */
+  static void SetCacheDirectory(const char* dir);
+  static const char* GetCacheDirectory();
+  //@}
+
   //@{
   /**
    * Returns a registered proxy definition or return a NULL otherwise.
@@ -270,6 +290,13 @@ protected:
   bool LoadConfigurationXMLFromString(const char* xmlContent, bool attachShowInMenuHints);
   //@}
 
+  /**
+   * Parses configuration XML contents, using the cache directory if set. The
+   * caller must release the reference to the returned vtkPVXMLElement.
+   * Returns nullptr if the contents cannot be parsed.
+   */
+  vtkPVXMLElement* ParseConfigurationXML(const char* xmlContent);
+
   //@{
   /**
    * Callback called when a plugin is loaded.
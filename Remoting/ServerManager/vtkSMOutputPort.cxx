@@ -46,6 +46,7 @@ vtkSMOutputPort::vtkSMOutputPort()
   this->ClassNameInformationValid = 0;
   this->DataInformationValid = false;
   this->TemporalDataInformationValid = false;
+  this->TemporalDataInformationSamplingStride = 1;
   this->PortIndex = 0;
   this->SourceProxy = 0;
   this->CompoundSourceProxy = 0;
@@ -79,9 +80,16 @@ vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation()
 {
-  if (!this->TemporalDataInformationValid)
+  return this->GetTemporalDataInformation(1);
+}
+
+//----------------------------------------------------------------------------
+vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation(int samplingStride)
+{
+  if (!this->TemporalDataInformationValid ||
+    this->TemporalDataInformationSamplingStride != samplingStride)
   {
-    this->GatherTemporalDataInformation();
+    this->GatherTemporalDataInformation(samplingStride);
   }
   return this->TemporalDataInformation;
 }
@@ -143,6 +151,12 @@ void vtkSMOutputPort::GatherDataInformation()
 
 //----------------------------------------------------------------------------
 void vtkSMOutputPort::GatherTemporalDataInformation()
+{
+  this->GatherTemporalDataInformation(1);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::GatherTemporalDataInformation(int samplingStride)
 {
   if (!this->SourceProxy)
   {
@@ -153,9 +167,11 @@ void vtkSMOutputPort::GatherTemporalDataInformation()
   this->SourceProxy->GetSession()->PrepareProgress();
   this->TemporalDataInformation->Initialize();
   this->TemporalDataInformation->SetPortNumber(this->PortIndex);
+  this->TemporalDataInformation->SetSamplingStride(samplingStride);
   this->SourceProxy->GatherInformation(this->TemporalDataInformation);
 
   this->TemporalDataInformationValid = true;
+  this->TemporalDataInformationSamplingStride = samplingStride;
   this->SourceProxy->GetSession()->CleanupPendingProgress();
 }
 
@@ -65,6 +65,13 @@ public:
    */
   virtual vtkPVTemporalDataInformation* GetTemporalDataInformation();
 
+  /**
+   * Same as GetTemporalDataInformation() except that only every Nth timestep
+   * not already cached on the server is visited, resulting in faster but
+   * approximate information. See vtkPVTemporalDataInformation::SetSamplingStride.
+   */
+  virtual vtkPVTemporalDataInformation* GetTemporalDataInformation(int samplingStride);
+
   /**
    * If available, returns the data assembly associated with the data produced
    * on this port. This is collected alongside DataInformation and hence all
@@ -124,6 +131,7 @@ protected:
    * Get temporal information from the server.
    */
   virtual void GatherTemporalDataInformation();
+  virtual void GatherTemporalDataInformation(int samplingStride);
 
   void SetSourceProxy(vtkSMSourceProxy* src);
 
@@ -154,6 +162,7 @@ protected:
 
   vtkPVTemporalDataInformation* TemporalDataInformation;
   bool TemporalDataInformationValid;
+  int TemporalDataInformationSamplingStride;
 
 private:
   vtkSMOutputPort(const vtkSMOutputPort&) = delete;
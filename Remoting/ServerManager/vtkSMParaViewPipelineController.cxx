@@ -297,6 +297,8 @@ bool vtkSMParaViewPipelineController::InitializeSession(vtkSMSession* session)
   vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
   assert(pxm);
 
+  vtkSMSession::vtkScopedPushBatch batch(session);
+
   //---------------------------------------------------------------------------
   // If the session is a collaborative session, we need to fetch the state from
   // server before we start creating "essential" proxies. This is a no-op if not
@@ -511,6 +513,7 @@ bool vtkSMParaViewPipelineController::RegisterPipelineProxy(
   }
 
   SM_SCOPED_TRACE(RegisterPipelineProxy).arg("proxy", proxy);
+  vtkSMSession::vtkScopedPushBatch batch(proxy->GetSession());
 
   // Register proxies created for proxy list domains.
   this->RegisterProxiesForProxyListDomains(proxy);
@@ -603,6 +606,7 @@ bool vtkSMParaViewPipelineController::RegisterViewProxy(vtkSMProxy* proxy, const
   }
 
   SM_SCOPED_TRACE(RegisterViewProxy).arg("proxy", proxy);
+  vtkSMSession::vtkScopedPushBatch batch(proxy->GetSession());
 
   // Register proxies created for proxy list domains.
   this->RegisterProxiesForProxyListDomains(proxy);
@@ -1098,6 +1102,10 @@ bool vtkSMParaViewPipelineController::PostInitializeProxy(vtkSMProxy* proxy)
   vtkTimeStamp ts = titer->second;
   this->Internals->InitializationTimeStamps.erase(titer);
 
+  // Coalesce the property pushes resulting from resetting properties to their
+  // defaults.
+  vtkSMSession::vtkScopedPushBatch batch(proxy->GetSession());
+
   // ensure everything is up-to-date.
   proxy->UpdateVTKObjects();
 
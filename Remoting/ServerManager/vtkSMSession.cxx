@@ -222,6 +222,25 @@ void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedPushBatch::vtkScopedPushBatch(vtkSMSession* session)
+  : Session(session)
+{
+  if (this->Session)
+  {
+    this->Session->BeginPushBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedPushBatch::~vtkScopedPushBatch()
+{
+  if (this->Session)
+  {
+    this->Session->EndPushBatch();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::Disconnect(vtkSMSession* session)
 {
@@ -145,6 +145,44 @@ public:
    */
   void PushState(vtkSMMessage* msg) override;
 
+  //@{
+  /**
+   * Begin/End a batch of state pushes. While a batch is active, sessions that
+   * communicate with remote processes may coalesce the messages sent by
+   * PushState() and deliver them together at the end of the batch, or
+   * earlier, when any other request that depends on the remote state is
+   * made. Calls can be nested, messages are only delivered when the outermost
+   * batch ends. The default implementation does nothing since the state is
+   * always pushed locally. Prefer using vtkScopedPushBatch to ensure that
+   * calls are balanced.
+   */
+  virtual void BeginPushBatch() {}
+  virtual void EndPushBatch() {}
+  //@}
+
+  /**
+   * Helper class to call session->BeginPushBatch() in constructor and
+   * session->EndPushBatch() in destructor.
+   * @code
+   * {
+   *    vtkSMSession::vtkScopedPushBatch batch(session);
+   *    ...
+   * }
+   * @endcode
+   */
+  class VTKREMOTINGSERVERMANAGER_EXPORT vtkScopedPushBatch
+  {
+    vtkSMSession* Session;
+
+  public:
+    vtkScopedPushBatch(vtkSMSession* session);
+    ~vtkScopedPushBatch();
+
+  private:
+    vtkScopedPushBatch(const vtkScopedPushBatch&) = delete;
+    void operator=(const vtkScopedPushBatch&) = delete;
+  };
+
   /**
    * Sends the message to all clients.
    */
@@ -24,6 +24,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVConfig.h"
 #include "vtkPVMultiClientsInformation.h"
+#include "vtkPVLogger.h"
 #include "vtkPVOptions.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVServerInformation.h"
@@ -44,6 +45,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 #include <assert.h>
@@ -60,6 +62,29 @@ void RMICallback(
   vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
+
+// When batching, pending messages are flushed once they exceed this size to
+// keep the memory overhead bounded.
+const size_t MaxPushBatchSize = 16 * 1024 * 1024;
+};
+
+class vtkSMSessionClient::vtkInternals
+{
+public:
+  struct PendingBatchType
+  {
+    vtkMultiProcessStream Stream;
+    vtkTypeUInt64 Count = 0;
+  };
+
+  int PushBatchDepth = 0;
+
+  // Batches for the data-server and render-server, respectively.
+  PendingBatchType PendingBatches[2];
+  size_t PendingSize = 0;
+
+  vtkTypeUInt64 NumberOfPushBatches = 0;
+  vtkTypeUInt64 NumberOfBatchedMessages = 0;
 };
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
@@ -92,6 +117,7 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->Internals = new vtkSMSessionClient::vtkInternals();
 }
 
 //----------------------------------------------------------------------------
@@ -120,11 +146,17 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = NULL;
+  delete this->Internals;
+  this->Internals = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // Callers may communicate with the servers directly, so ensure that the
+  // servers are up-to-date.
+  this->FlushPushBatch();
+
   switch (processType)
   {
     case CLIENT:
@@ -447,6 +479,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushPushBatch();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -465,6 +498,7 @@ void vtkSMSessionClient::CloseSession()
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PreDisconnection()
 {
+  this->FlushPushBatch();
   this->NoMoreDelete = true;
 }
 
@@ -499,29 +533,19 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
-  int num_controllers = 0;
-  vtkMultiProcessController* controllers[2] = { NULL, NULL };
+  vtkTypeUInt32 servers = 0;
 
   if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->DataServerController;
+    servers |= vtkPVSession::DATA_SERVER;
   }
   if ((location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->RenderServerController;
+    servers |= vtkPVSession::RENDER_SERVER;
   }
-  if (num_controllers > 0)
+  if (servers != 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::PUSH);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-    }
+    this->SendToServers(vtkPVSessionServer::PUSH, servers, message->SerializeAsString());
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -530,7 +554,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 
     // For collaboration purpose we might need to share the proxy state with
     // other clients
-    if (num_controllers == 0 && this->IsMultiClients())
+    if (servers == 0 && this->IsMultiClients())
     {
       vtkSMRemoteObject* remoteObject =
         vtkSMRemoteObject::SafeDownCast(this->GetRemoteObject(message->global_id()));
@@ -552,13 +576,8 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendToServers(
+          vtkPVSessionServer::PUSH, vtkPVSession::DATA_SERVER, msg.SerializeAsString());
       }
       else if (!remoteObject)
       {
@@ -583,6 +602,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -639,6 +659,7 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  this->FlushPushBatch();
   location = this->GetRealLocation(location);
 
   vtkMultiProcessController* controllers[2] = { NULL, NULL };
@@ -682,6 +703,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -730,6 +752,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPushBatch();
   this->StartBusyWork();
   if (this->RenderServerController == NULL)
   {
@@ -833,28 +856,18 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
 
-  vtkMultiProcessController* controllers[2] = { NULL, NULL };
-  int num_controllers = 0;
+  vtkTypeUInt32 servers = 0;
   if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->DataServerController;
+    servers |= vtkPVSession::DATA_SERVER;
   }
   if ((location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->RenderServerController;
+    servers |= vtkPVSession::RENDER_SERVER;
   }
-  if (num_controllers > 0)
+  if (servers != 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::UNREGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-    }
+    this->SendToServers(vtkPVSessionServer::UNREGISTER_SI, servers, message->SerializeAsString());
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -874,31 +887,18 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
 
-  vtkMultiProcessController* controllers[2] = { NULL, NULL };
-  int num_controllers = 0;
+  vtkTypeUInt32 servers = 0;
   if ((location & (vtkPVSession::DATA_SERVER | vtkPVSession::DATA_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->DataServerController;
+    servers |= vtkPVSession::DATA_SERVER;
   }
   if ((location & (vtkPVSession::RENDER_SERVER | vtkPVSession::RENDER_SERVER_ROOT)) != 0)
   {
-    controllers[num_controllers++] = this->RenderServerController;
+    servers |= vtkPVSession::RENDER_SERVER;
   }
-  if (num_controllers > 0)
+  if (servers != 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::REGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    for (int cc = 0; cc < num_controllers; cc++)
-    {
-      if (controllers[cc] != NULL)
-      {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      }
-    }
+    this->SendToServers(vtkPVSessionServer::REGISTER_SI, servers, message->SerializeAsString());
   }
 
   if ((location & vtkPVSession::CLIENT) != 0)
@@ -911,6 +911,133 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfPushBatches: " << this->Internals->NumberOfPushBatches << endl;
+  os << indent << "NumberOfBatchedMessages: " << this->Internals->NumberOfBatchedMessages << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendToServers(int type, vtkTypeUInt32 servers, const std::string& data)
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  const bool targets[2] = { (servers & vtkPVSession::DATA_SERVER) != 0,
+    (servers & vtkPVSession::RENDER_SERVER) != 0 };
+
+  auto& internals = (*this->Internals);
+  if (internals.PushBatchDepth > 0)
+  {
+    for (int cc = 0; cc < 2; ++cc)
+    {
+      if (targets[cc])
+      {
+        auto& batch = internals.PendingBatches[cc];
+        if (batch.Count == 0)
+        {
+          batch.Stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH);
+        }
+        batch.Stream << type << data;
+        ++batch.Count;
+        internals.PendingSize += data.size();
+      }
+    }
+    if (internals.PendingSize >= MaxPushBatchSize)
+    {
+      this->FlushPushBatch();
+    }
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << type << data;
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    if (targets[cc] && controllers[cc] != NULL)
+    {
+      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushPushBatch()
+{
+  auto& internals = (*this->Internals);
+  if (internals.PendingSize == 0 && internals.PendingBatches[0].Count == 0 &&
+    internals.PendingBatches[1].Count == 0)
+  {
+    return;
+  }
+
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    auto& batch = internals.PendingBatches[cc];
+    if (batch.Count > 0 && controllers[cc] != NULL)
+    {
+      std::vector<unsigned char> raw_message;
+      batch.Stream.GetRawData(raw_message);
+      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+
+      ++internals.NumberOfPushBatches;
+      internals.NumberOfBatchedMessages += batch.Count;
+      vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "pushed batch of %llu messages (%zu bytes)",
+        static_cast<unsigned long long>(batch.Count), raw_message.size());
+    }
+    batch.Stream.Reset();
+    batch.Count = 0;
+  }
+  internals.PendingSize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::BeginPushBatch()
+{
+  ++this->Internals->PushBatchDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::EndPushBatch()
+{
+  auto& internals = (*this->Internals);
+  if (internals.PushBatchDepth <= 0)
+  {
+    vtkWarningMacro("EndPushBatch() called without matching BeginPushBatch().");
+    return;
+  }
+  if (--internals.PushBatchDepth == 0)
+  {
+    this->FlushPushBatch();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkSMSessionClient::GetNumberOfPushBatches()
+{
+  return this->Internals->NumberOfPushBatches;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkSMSessionClient::GetNumberOfBatchedMessages()
+{
+  return this->Internals->NumberOfBatchedMessages;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkSMSessionClient::GetNumberOfMergedMessages()
+{
+  return this->Internals->NumberOfBatchedMessages - this->Internals->NumberOfPushBatches;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::ResetPushBatchStatistics()
+{
+  this->Internals->NumberOfPushBatches = 0;
+  this->Internals->NumberOfBatchedMessages = 0;
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
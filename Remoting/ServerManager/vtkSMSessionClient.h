@@ -26,6 +26,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string> // for std::string
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -108,6 +110,33 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   //@}
 
+  //@{
+  /**
+   * Overridden to coalesce the one-way messages sent to the server(s) by
+   * PushState(), RegisterSIObject() and UnRegisterSIObject() while a batch is
+   * active. Such messages are delivered using a single RMI per server when the
+   * outermost batch ends or when any request that needs the server to be
+   * up-to-date (e.g. PullState(), ExecuteStream(), GatherInformation()) is
+   * made.
+   */
+  void BeginPushBatch() override;
+  void EndPushBatch() override;
+  //@}
+
+  //@{
+  /**
+   * Statistics about batched messages. `NumberOfPushBatches` is the number of
+   * RMIs used to deliver batches and `NumberOfBatchedMessages` is the total
+   * number of messages delivered in those batches. `NumberOfMergedMessages`
+   * is the number of round trips saved by batching i.e. the difference between
+   * the two.
+   */
+  vtkTypeUInt64 GetNumberOfPushBatches();
+  vtkTypeUInt64 GetNumberOfBatchedMessages();
+  vtkTypeUInt64 GetNumberOfMergedMessages();
+  void ResetPushBatchStatistics();
+  //@}
+
   //@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -239,6 +268,19 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Sends a one-way message of the given `type` (vtkPVSessionServer::PUSH,
+   * REGISTER_SI or UNREGISTER_SI) to the servers identified by `servers`
+   * (vtkPVSession::DATA_SERVER and/or vtkPVSession::RENDER_SERVER). If a push
+   * batch is active, the message is queued instead.
+   */
+  void SendToServers(int type, vtkTypeUInt32 servers, const std::string& data);
+
+  /**
+   * Delivers all messages queued in the current push batch, if any.
+   */
+  void FlushPushBatch();
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -280,6 +322,9 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
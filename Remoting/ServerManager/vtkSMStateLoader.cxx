@@ -539,6 +539,10 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
     return 0;
   }
 
+  // Coalesce the state pushed to the server(s) while the proxies are created
+  // and their properties are set.
+  vtkSMSession::vtkScopedPushBatch batch(this->GetSession());
+
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
@@ -28,6 +28,7 @@
 #endif
 
 #if VTK_MODULE_ENABLE_ParaView_RemotingViews
+#include "vtkPVDataDeliveryManager.h"
 #include "vtkPVXYChartView.h"
 #include "vtkSMChartSeriesSelectionDomain.h"
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
@@ -169,6 +170,9 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   if (this->AnimationGeometryCacheLimit != val)
   {
     this->AnimationGeometryCacheLimit = val;
+#if VTK_MODULE_ENABLE_ParaView_RemotingViews
+    vtkPVDataDeliveryManager::SetCacheSizeLimit(val);
+#endif
     this->Modified();
   }
 }
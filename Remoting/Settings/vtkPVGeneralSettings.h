@@ -146,7 +146,11 @@ public:
 
   //@{
   /**
-   * Set the animation cache limit in KBs.
+   * Set the animation cache limit in KBs. When caching geometry for animation,
+   * least recently used cached geometry is evicted when the cache on a rank
+   * exceeds this limit. 0 implies no limit.
+   *
+   * @sa vtkPVDataDeliveryManager::SetCacheSizeLimit
    */
   void SetAnimationGeometryCacheLimit(unsigned long val);
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
@@ -45,7 +45,13 @@
 
 #include <IceT.h>
 #include <IceTGL.h>
+#include <algorithm>
+#include <array>
 #include <assert.h>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
 
 #include "vtkCompositeZPassFS.h"
 #include "vtkOpenGLHelper.h"
@@ -112,6 +118,187 @@ void MergeCubeAxesBounds(double bounds[6], const vtkRenderState* rState)
 
   bbox.GetBounds(bounds);
 }
+
+IceTEnum GetIceTStrategy(int strategy)
+{
+  switch (strategy)
+  {
+    case vtkIceTCompositePass::STRATEGY_SEQUENTIAL:
+      return ICET_STRATEGY_SEQUENTIAL;
+    case vtkIceTCompositePass::STRATEGY_DIRECT:
+      return ICET_STRATEGY_DIRECT;
+    case vtkIceTCompositePass::STRATEGY_SPLIT:
+      return ICET_STRATEGY_SPLIT;
+    case vtkIceTCompositePass::STRATEGY_VTREE:
+      return ICET_STRATEGY_VTREE;
+    case vtkIceTCompositePass::STRATEGY_REDUCE:
+    default:
+      return ICET_STRATEGY_REDUCE;
+  }
+}
+
+IceTEnum GetIceTSingleImageStrategy(int strategy)
+{
+  switch (strategy)
+  {
+    case vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_BSWAP:
+      return ICET_SINGLE_IMAGE_STRATEGY_BSWAP;
+    case vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_RADIXK:
+      return ICET_SINGLE_IMAGE_STRATEGY_RADIXK;
+    case vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_TREE:
+      return ICET_SINGLE_IMAGE_STRATEGY_TREE;
+    case vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_BSWAP_FOLDING:
+      return ICET_SINGLE_IMAGE_STRATEGY_BSWAP_FOLDING;
+    case vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_AUTOMATIC:
+    default:
+      return ICET_SINGLE_IMAGE_STRATEGY_AUTOMATIC;
+  }
+}
+};
+
+// Keeps track of the composite times measured for each single image strategy
+// when SingleImageStrategy is SINGLE_IMAGE_STRATEGY_ADAPTIVE. Since the times
+// fed to `Update` are reduced over all ranks, every rank makes the same choice.
+// Measurements are kept for each image size and number of ranks: interactive
+// renders use a reduced image size and alternate with still renders, which
+// must not restart the trials every time.
+class vtkIceTCompositePass::vtkAdaptiveStrategy
+{
+public:
+  // number of frames each candidate is rendered with before picking one. The
+  // fastest of these frames is used, which discards warm up costs.
+  static const int NumberOfTrialFrames = 3;
+
+  // when the running average of the selected strategy exceeds its measured
+  // time by this factor, the candidates are tried again.
+  static constexpr double DriftFactor = 2.0;
+
+  // measurements are discarded when there are more configurations than this,
+  // which only happens when the window is resized a lot.
+  static const size_t MaximumNumberOfConfigurations = 16;
+
+  struct vtkMeasurements
+  {
+    std::vector<int> Candidates;
+    std::vector<double> Times;
+    size_t Trial = 0;
+    int TrialFrame = 0;
+    int Selected = vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_AUTOMATIC;
+    double Reference = 0.0;
+    double Average = 0.0;
+    int Size[2] = { 0, 0 };
+    int NumberOfRanks = 0;
+
+    void Initialize(int width, int height, int numRanks)
+    {
+      this->Size[0] = width;
+      this->Size[1] = height;
+      this->NumberOfRanks = numRanks;
+
+      // Order the candidates so that the first trial frames are rendered with
+      // the strategy most likely to win: the tree strategy does well with few
+      // ranks and small images while radix-k scales best with many ranks or
+      // large images.
+      const double numPixels = static_cast<double>(width) * height;
+      this->Candidates.clear();
+      if (numRanks <= 2)
+      {
+        // all strategies exchange the same two half images.
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_TREE);
+      }
+      else if (numRanks <= 8 && numPixels <= 1024.0 * 1024.0)
+      {
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_TREE);
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_BSWAP);
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_RADIXK);
+      }
+      else
+      {
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_RADIXK);
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_BSWAP);
+        this->Candidates.push_back(vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_TREE);
+      }
+      this->Restart();
+    }
+
+    void Restart()
+    {
+      this->Times.assign(this->Candidates.size(), VTK_DOUBLE_MAX);
+      this->Trial = 0;
+      this->TrialFrame = 0;
+      this->Selected = this->Candidates[0];
+    }
+
+    int GetStrategy() const
+    {
+      return this->Trial < this->Candidates.size() ? this->Candidates[this->Trial]
+                                                   : this->Selected;
+    }
+
+    void Update(double time)
+    {
+      if (this->Trial < this->Candidates.size())
+      {
+        this->Times[this->Trial] = std::min(this->Times[this->Trial], time);
+        if (++this->TrialFrame < NumberOfTrialFrames)
+        {
+          return;
+        }
+        this->TrialFrame = 0;
+        if (++this->Trial == this->Candidates.size())
+        {
+          const auto iter = std::min_element(this->Times.begin(), this->Times.end());
+          this->Selected = this->Candidates[std::distance(this->Times.begin(), iter)];
+          this->Reference = this->Average = *iter;
+          vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+            "adaptive compositing selected single image strategy %d (%g s) for %dx%d on %d ranks",
+            this->Selected, this->Reference, this->Size[0], this->Size[1], this->NumberOfRanks);
+        }
+        return;
+      }
+
+      this->Average = 0.8 * this->Average + 0.2 * time;
+      if (this->Candidates.size() > 1 && this->Reference > 0.0 &&
+        this->Average > DriftFactor * this->Reference)
+      {
+        vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+          "composite time drifted from %g s to %g s; re-evaluating strategies", this->Reference,
+          this->Average);
+        this->Restart();
+      }
+    }
+  };
+
+  std::map<std::array<int, 3>, vtkMeasurements> Configurations;
+  vtkMeasurements* Current = nullptr;
+  int Last = vtkIceTCompositePass::SINGLE_IMAGE_STRATEGY_AUTOMATIC;
+
+  // selects the measurements used by `GetStrategy` and `Update`.
+  void Initialize(int width, int height, int numRanks)
+  {
+    const std::array<int, 3> key = { { width, height, numRanks } };
+    auto iter = this->Configurations.find(key);
+    if (iter == this->Configurations.end())
+    {
+      if (this->Configurations.size() >= MaximumNumberOfConfigurations)
+      {
+        this->Configurations.clear();
+      }
+      iter = this->Configurations.insert(std::make_pair(key, vtkMeasurements())).first;
+      iter->second.Initialize(width, height, numRanks);
+    }
+    this->Current = &iter->second;
+  }
+
+  int GetStrategy() const { return this->Current->GetStrategy(); }
+
+  void Update(double time)
+  {
+    if (this->Current)
+    {
+      this->Current->Update(time);
+    }
+  }
 };
 
 vtkStandardNewMacro(vtkIceTCompositePass);
@@ -139,6 +326,11 @@ vtkIceTCompositePass::vtkIceTCompositePass()
   this->RenderEmptyImages = false;
   this->UseOrderedCompositing = false;
 
+  this->CompositeStrategy = STRATEGY_DEFAULT;
+  this->SingleImageStrategy = SINGLE_IMAGE_STRATEGY_AUTOMATIC;
+  this->LastCompositeTime = 0.0;
+  this->AdaptiveStrategy.reset(new vtkIceTCompositePass::vtkAdaptiveStrategy());
+
   this->LastRenderedRGBAColors.reset(new vtkSynchronizedRenderers::vtkRawImage());
 
   this->PBO = 0;
@@ -198,6 +390,12 @@ void vtkIceTCompositePass::ReleaseGraphicsResources(vtkWindow* window)
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkIceTCompositePass::GetLastSingleImageStrategy() const
+{
+  return this->AdaptiveStrategy->Last;
+}
+
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
 {
@@ -213,18 +411,34 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
   // need to pass appropriate tile parameters to IceT.
   this->UpdateTileInformation(render_state);
 
-  // Set IceT compositing strategy.
-  if ((this->TileDimensions[0] == 1) && (this->TileDimensions[1] == 1))
+  const bool use_ordered_compositing =
+    (this->OrderedCompositingHelper && this->UseOrderedCompositing);
+
+  // Set IceT compositing strategy. The split and vtree strategies do not
+  // support ordered compositing, hence fallback to the default ones.
+  const bool single_tile = (this->TileDimensions[0] == 1) && (this->TileDimensions[1] == 1);
+  int strategy = this->CompositeStrategy;
+  if (use_ordered_compositing && (strategy == STRATEGY_SPLIT || strategy == STRATEGY_VTREE))
   {
-    icetStrategy(ICET_STRATEGY_SEQUENTIAL);
+    strategy = STRATEGY_DEFAULT;
   }
-  else
+  if (strategy == STRATEGY_DEFAULT)
   {
-    icetStrategy(ICET_STRATEGY_REDUCE);
+    strategy = single_tile ? STRATEGY_SEQUENTIAL : STRATEGY_REDUCE;
   }
+  icetStrategy(GetIceTStrategy(strategy));
 
-  const bool use_ordered_compositing =
-    (this->OrderedCompositingHelper && this->UseOrderedCompositing);
+  // Set the strategy used to composite each tile.
+  int single_image_strategy = this->SingleImageStrategy;
+  if (single_image_strategy == SINGLE_IMAGE_STRATEGY_ADAPTIVE)
+  {
+    const int* size = context->GetActualSize();
+    this->AdaptiveStrategy->Initialize(size[0] / this->ImageReductionFactor,
+      size[1] / this->ImageReductionFactor, this->Controller->GetNumberOfProcesses());
+    single_image_strategy = this->AdaptiveStrategy->GetStrategy();
+  }
+  this->AdaptiveStrategy->Last = single_image_strategy;
+  icetSingleImageStrategy(GetIceTSingleImageStrategy(single_image_strategy));
 
   IceTEnum const format =
     this->EnableFloatValuePass ? ICET_IMAGE_COLOR_RGBA_FLOAT : ICET_IMAGE_COLOR_RGBA_UBYTE;
@@ -460,6 +674,14 @@ void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
   double val = 0.;
   icetGetDoublev(ICET_COMPOSITE_TIME, &val);
   vtkTimerLog::InsertTimedEvent("ICET_COMPOSITE_TIME", val, 0);
+  this->LastCompositeTime = val;
+  if (this->SingleImageStrategy == SINGLE_IMAGE_STRATEGY_ADAPTIVE)
+  {
+    // icetDrawFrame is collective, so is this.
+    double max_val = val;
+    this->Controller->AllReduce(&val, &max_val, 1, vtkCommunicator::MAX_OP);
+    this->AdaptiveStrategy->Update(max_val);
+  }
   icetGetDoublev(ICET_BLEND_TIME, &val);
   vtkTimerLog::InsertTimedEvent("ICET_BLEND_TIME", val, 0);
   icetGetDoublev(ICET_COMPRESS_TIME, &val);
@@ -880,6 +1102,8 @@ void vtkIceTCompositePass::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ImageReductionFactor: " << this->ImageReductionFactor << endl;
   os << indent << "OrderedCompositingHelper: " << this->OrderedCompositingHelper << endl;
   os << indent << "UseOrderedCompositing: " << this->UseOrderedCompositing << endl;
+  os << indent << "CompositeStrategy: " << this->CompositeStrategy << endl;
+  os << indent << "SingleImageStrategy: " << this->SingleImageStrategy << endl;
   os << indent << "DisplayRGBAResults: " << this->DisplayRGBAResults << endl;
   os << indent << "DisplayDepthResults: " << this->DisplayDepthResults << endl;
 }
@@ -172,6 +172,67 @@ public:
   vtkBooleanMacro(UseOrderedCompositing, bool);
   //@}
 
+  enum CompositeStrategyModes
+  {
+    STRATEGY_DEFAULT = 0,
+    STRATEGY_SEQUENTIAL = 1,
+    STRATEGY_DIRECT = 2,
+    STRATEGY_SPLIT = 3,
+    STRATEGY_REDUCE = 4,
+    STRATEGY_VTREE = 5
+  };
+
+  enum SingleImageStrategyModes
+  {
+    SINGLE_IMAGE_STRATEGY_AUTOMATIC = 0,
+    SINGLE_IMAGE_STRATEGY_BSWAP = 1,
+    SINGLE_IMAGE_STRATEGY_RADIXK = 2,
+    SINGLE_IMAGE_STRATEGY_TREE = 3,
+    SINGLE_IMAGE_STRATEGY_BSWAP_FOLDING = 4,
+    SINGLE_IMAGE_STRATEGY_ADAPTIVE = 5
+  };
+
+  //@{
+  /**
+   * Set/Get the IceT strategy used to composite tiles. STRATEGY_DEFAULT
+   * (initial value) uses `ICET_STRATEGY_SEQUENTIAL` for a single tile and
+   * `ICET_STRATEGY_REDUCE` for tile-displays.
+   */
+  vtkSetClampMacro(CompositeStrategy, int, STRATEGY_DEFAULT, STRATEGY_VTREE);
+  vtkGetMacro(CompositeStrategy, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the IceT strategy used to composite a single tile. Initial value
+   * is SINGLE_IMAGE_STRATEGY_AUTOMATIC which lets IceT pick one based on the
+   * number of processes.
+   *
+   * SINGLE_IMAGE_STRATEGY_ADAPTIVE picks the strategy based on measurements
+   * instead. The candidate strategies are tried in turn for a few frames and
+   * the one with the smallest `ICET_COMPOSITE_TIME` (maximum over all ranks)
+   * is used for subsequent frames. The measurements are discarded and the
+   * candidates tried again when the image size changes or when the composite
+   * time of the selected strategy drifts well above what was measured for it.
+   */
+  vtkSetClampMacro(
+    SingleImageStrategy, int, SINGLE_IMAGE_STRATEGY_AUTOMATIC, SINGLE_IMAGE_STRATEGY_ADAPTIVE);
+  vtkGetMacro(SingleImageStrategy, int);
+  //@}
+
+  /**
+   * Returns the single image strategy used for the last frame. This is only
+   * different from `GetSingleImageStrategy` when SingleImageStrategy is
+   * SINGLE_IMAGE_STRATEGY_ADAPTIVE.
+   */
+  int GetLastSingleImageStrategy() const;
+
+  /**
+   * Returns the `ICET_COMPOSITE_TIME` for the last frame on this rank, in
+   * seconds.
+   */
+  vtkGetMacro(LastCompositeTime, double);
+
   /**
    * Returns the last rendered tile from this process, if any.
    * Image is invalid if tile is not available on the current process.
@@ -280,6 +341,10 @@ protected:
 
   int ImageReductionFactor;
 
+  int CompositeStrategy;
+  int SingleImageStrategy;
+  double LastCompositeTime;
+
   bool DisplayRGBAResults;
   bool DisplayDepthResults;
 
@@ -300,6 +365,9 @@ private:
   vtkNew<vtkMatrix4x4> ModelView;
   vtkNew<vtkMatrix4x4> Projection;
   vtkNew<vtkMatrix4x4> IceTProjection;
+
+  class vtkAdaptiveStrategy;
+  std::unique_ptr<vtkAdaptiveStrategy> AdaptiveStrategy;
 };
 
 #endif
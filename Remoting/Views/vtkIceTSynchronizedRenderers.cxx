@@ -125,6 +125,18 @@ void vtkIceTSynchronizedRenderers::SetRenderEmptyImages(bool useREI)
   this->IceTCompositePass->SetRenderEmptyImages(useREI);
 }
 
+//----------------------------------------------------------------------------
+void vtkIceTSynchronizedRenderers::SetCompositeStrategy(int strategy)
+{
+  this->IceTCompositePass->SetCompositeStrategy(strategy);
+}
+
+//----------------------------------------------------------------------------
+void vtkIceTSynchronizedRenderers::SetSingleImageStrategy(int strategy)
+{
+  this->IceTCompositePass->SetSingleImageStrategy(strategy);
+}
+
 //----------------------------------------------------------------------------
 void vtkIceTSynchronizedRenderers::SetImageReductionFactor(int val)
 {
@@ -136,6 +136,14 @@ public:
    */
   void SetRenderEmptyImages(bool);
 
+  /**
+   * Set the IceT compositing strategies. Refer to
+   * vtkIceTCompositePass::SetCompositeStrategy and
+   * vtkIceTCompositePass::SetSingleImageStrategy.
+   */
+  void SetCompositeStrategy(int);
+  void SetSingleImageStrategy(int);
+
   //@{
   /**
    * Get/Set geometry rendering pass. This pass is used to render the geometry.
@@ -15,20 +15,124 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkCompositeMultiProcessController.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkPVConfig.h"
+#include "vtkPVLogger.h"
+#include "vtkSmartPointer.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <set>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+enum
+{
+  START_RENDER_TAG = 0x023431,
+  END_RENDER_TAG = 0x023430
+};
+
+enum FrameFlags
+{
+  // the image is a difference against the reference image.
+  DELTA_FRAME = 0x1,
+  // the image must be kept as the reference for future delta frames.
+  REFERENCE_FRAME = 0x2
+};
+
+// Box filter `input` by `factor` in each direction.
+void Downsample(vtkUnsignedCharArray* input, int width, int height, int factor,
+  vtkSynchronizedRenderers::vtkRawImage& output)
+{
+  const int numComps = input->GetNumberOfComponents();
+  const int outWidth = std::max(width / factor, 1);
+  const int outHeight = std::max(height / factor, 1);
+  output.Resize(outWidth, outHeight, numComps);
+
+  const unsigned char* in = input->GetPointer(0);
+  unsigned char* out = output.GetRawPtr()->GetPointer(0);
+  std::vector<unsigned int> sums(numComps);
+  for (int j = 0; j < outHeight; ++j)
+  {
+    const int jmax = std::min((j + 1) * factor, height);
+    for (int i = 0; i < outWidth; ++i)
+    {
+      const int imax = std::min((i + 1) * factor, width);
+      std::fill(sums.begin(), sums.end(), 0u);
+      for (int y = j * factor; y < jmax; ++y)
+      {
+        const unsigned char* row = in + (static_cast<vtkIdType>(y) * width) * numComps;
+        for (int x = i * factor; x < imax; ++x)
+        {
+          for (int c = 0; c < numComps; ++c)
+          {
+            sums[c] += row[x * numComps + c];
+          }
+        }
+      }
+      const unsigned int count =
+        static_cast<unsigned int>((jmax - j * factor) * (imax - i * factor));
+      unsigned char* pixel = out + (static_cast<vtkIdType>(j) * outWidth + i) * numComps;
+      for (int c = 0; c < numComps; ++c)
+      {
+        pixel[c] = static_cast<unsigned char>((sums[c] + count / 2) / count);
+      }
+    }
+  }
+  output.MarkValid();
+}
+
+// XOR `input` with `reference` into `output`. Returns the number of bytes
+// that are identical in `input` and `reference`.
+vtkIdType Difference(vtkUnsignedCharArray* input, vtkUnsignedCharArray* reference,
+  vtkUnsignedCharArray* output)
+{
+  const vtkIdType numValues = input->GetNumberOfValues();
+  output->SetNumberOfComponents(input->GetNumberOfComponents());
+  output->SetNumberOfTuples(input->GetNumberOfTuples());
+  const unsigned char* a = input->GetPointer(0);
+  const unsigned char* b = reference->GetPointer(0);
+  unsigned char* out = output->GetPointer(0);
+  vtkIdType identical = 0;
+  for (vtkIdType cc = 0; cc < numValues; ++cc)
+  {
+    out[cc] = a[cc] ^ b[cc];
+    identical += (out[cc] == 0) ? 1 : 0;
+  }
+  return identical;
+}
+}
+
+class vtkPVClientServerSynchronizedRenderers::vtkInternals
+{
+public:
+  struct vtkReference
+  {
+    vtkNew<vtkUnsignedCharArray> Image;
+    int Size[3] = { 0, 0, 0 };
+  };
+
+  // reference images for delta frames, keyed by the id of the client
+  // connection. The client only has one, with id 0.
+  std::map<int, vtkReference> References;
+};
 
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
 vtkCxxSetObjectMacro(vtkPVClientServerSynchronizedRenderers, Compressor, vtkImageCompressor);
@@ -37,6 +141,17 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(NULL)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , ProgressiveStreaming(false)
+  , TargetFrameTime(0.1)
+  , MaximumProgressiveFactor(8)
+  , DeltaEncoding(false)
+  , ProgressiveFactor(1)
+  , LastProgressiveFactor(1)
+  , EstimatedThroughput(0.0)
+  , EstimatedServerTime(0.0)
+  , EstimatedBytesPerPixel(0.0)
+  , LastFullResolutionPixels(0)
+  , Internals(new vtkInternals())
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -45,6 +160,114 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
 vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers()
 {
   this->SetCompressor(NULL);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::GetReferenceImage(int*& size)
+{
+  // in collaboration mode, the server renders for several clients and each
+  // of them reconstructs delta frames against the last image it received.
+  auto& references = this->Internals->References;
+  int id = 0;
+  if (auto composite =
+        vtkCompositeMultiProcessController::SafeDownCast(this->ParallelController))
+  {
+    id = composite->GetActiveControllerID();
+
+    // forget about clients that disconnected.
+    std::set<int> connected;
+    for (int cc = 0, max = composite->GetNumberOfControllers(); cc < max; ++cc)
+    {
+      connected.insert(composite->GetControllerId(cc));
+    }
+    for (auto iter = references.begin(); iter != references.end();)
+    {
+      iter = connected.count(iter->first) ? std::next(iter) : references.erase(iter);
+    }
+  }
+
+  auto& reference = references[id];
+  size = reference.Size;
+  return reference.Image;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->Superclass::MasterStartRender();
+
+  // tell the server how much to downsample the image it is about to render.
+  if (this->ProgressiveStreaming)
+  {
+    int factor = this->ComputeProgressiveFactor();
+    this->ParallelController->Send(&factor, 1, 1, START_RENDER_TAG);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
+{
+  this->Superclass::SlaveStartRender();
+  this->ProgressiveFactor = 1;
+  if (this->ProgressiveStreaming)
+  {
+    this->ParallelController->Receive(&this->ProgressiveFactor, 1, 1, START_RENDER_TAG);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVClientServerSynchronizedRenderers::ComputeProgressiveFactor()
+{
+  // still renders are always delivered at full resolution; they are the
+  // refinement of the coarse images delivered while interacting.
+  if (!this->ProgressiveStreaming || this->LossLessCompression ||
+    this->EstimatedThroughput <= 0.0 || this->EstimatedBytesPerPixel <= 0.0 ||
+    this->LastFullResolutionPixels <= 0)
+  {
+    return 1;
+  }
+
+  // part of the frame budget is spent by the server rendering the frame and
+  // by the round trip; the rest is available to transfer the image.
+  const double budget = std::max(
+    this->TargetFrameTime - this->EstimatedServerTime, 0.25 * this->TargetFrameTime);
+  const double fullTransferTime =
+    this->EstimatedBytesPerPixel * this->LastFullResolutionPixels / this->EstimatedThroughput;
+  const int factor = static_cast<int>(std::ceil(std::sqrt(fullTransferTime / budget)));
+  return std::max(1, std::min(factor, this->MaximumProgressiveFactor));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::UpdateEstimates(
+  double serverTime, double transferTime, vtkIdType bytes, int width, int height, int factor)
+{
+  // small images are dominated by latency and would underestimate throughput.
+  if (bytes >= 16384 && transferTime > 0.0)
+  {
+    const double throughput = bytes / transferTime;
+    this->EstimatedThroughput = this->EstimatedThroughput > 0.0
+      ? 0.5 * (this->EstimatedThroughput + throughput)
+      : throughput;
+  }
+  this->EstimatedServerTime = this->EstimatedServerTime > 0.0
+    ? 0.5 * (this->EstimatedServerTime + serverTime)
+    : serverTime;
+
+  // compression ratios of interactive and still renders differ, only track
+  // the one of interactive renders.
+  const vtkIdType numPixels = static_cast<vtkIdType>(width) * height;
+  if (!this->LossLessCompression && numPixels > 0)
+  {
+    this->EstimatedBytesPerPixel = static_cast<double>(bytes) / numPixels;
+    this->LastFullResolutionPixels = numPixels * factor * factor;
+  }
+  this->LastProgressiveFactor = factor;
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "received %dx%d image (factor %d, %lld bytes) in %.4fs, server %.4fs, throughput %.1f MB/s",
+    width, height, factor, static_cast<long long>(bytes), transferTime, serverTime,
+    this->EstimatedThroughput / (1024.0 * 1024.0));
 }
 
 //----------------------------------------------------------------------------
@@ -56,22 +279,47 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 
   vtkRawImage& rawImage = this->Image;
 
-  int header[4];
-  this->ParallelController->Receive(header, 4, 1, 0x023430);
+  const double startTime = vtkTimerLog::GetUniversalTime();
+  int header[6];
+  this->ParallelController->Receive(header, 6, 1, END_RENDER_TAG);
+  const double headerTime = vtkTimerLog::GetUniversalTime();
   if (header[0] > 0)
   {
     rawImage.Resize(header[1], header[2], header[3]);
+    vtkIdType bytes = rawImage.GetRawPtr()->GetNumberOfValues();
     if (this->Compressor)
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
-      this->ParallelController->Receive(data, 1, 0x023430);
+      this->ParallelController->Receive(data, 1, END_RENDER_TAG);
+      bytes = data->GetNumberOfValues();
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
     }
     else
     {
-      this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
+      this->ParallelController->Receive(rawImage.GetRawPtr(), 1, END_RENDER_TAG);
+    }
+    this->UpdateEstimates(headerTime - startTime, vtkTimerLog::GetUniversalTime() - headerTime,
+      bytes, header[1], header[2], header[5]);
+
+    vtkUnsignedCharArray* pixels = rawImage.GetRawPtr();
+    int* referenceSize = nullptr;
+    vtkUnsignedCharArray* reference = this->GetReferenceImage(referenceSize);
+    if ((header[4] & DELTA_FRAME) != 0)
+    {
+      if (referenceSize[0] != header[1] || referenceSize[1] != header[2] ||
+        referenceSize[2] != header[3])
+      {
+        vtkErrorMacro("Received a delta frame without a matching reference image.");
+        return;
+      }
+      Difference(pixels, reference, pixels);
+    }
+    if ((header[4] & REFERENCE_FRAME) != 0)
+    {
+      reference->DeepCopy(pixels);
+      std::copy(header + 1, header + 4, referenceSize);
     }
     rawImage.MarkValid();
   }
@@ -83,27 +331,69 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   assert(this->ParallelController->IsA("vtkSocketController") ||
     this->ParallelController->IsA("vtkCompositeMultiProcessController"));
 
-  vtkRawImage& rawImage = this->CaptureRenderedImage();
+  vtkRawImage& capturedImage = this->CaptureRenderedImage();
+  vtkRawImage* image = &capturedImage;
+
+  int factor = 1;
+  if (capturedImage.IsValid() && this->ProgressiveFactor > 1 && !this->LossLessCompression)
+  {
+    factor = this->ProgressiveFactor;
+    Downsample(capturedImage.GetRawPtr(), capturedImage.GetWidth(), capturedImage.GetHeight(),
+      factor, this->CoarseImage);
+    image = &this->CoarseImage;
+  }
+
+  int header[6];
+  header[0] = image->IsValid() ? 1 : 0;
+  header[1] = image->GetWidth();
+  header[2] = image->GetHeight();
+  header[3] = image->IsValid() ? image->GetRawPtr()->GetNumberOfComponents() : 0;
+  header[4] = 0;
+  header[5] = factor;
 
-  int header[4];
-  header[0] = rawImage.IsValid() ? 1 : 0;
-  header[1] = rawImage.GetWidth();
-  header[2] = rawImage.GetHeight();
-  header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
+  vtkUnsignedCharArray* pixels = image->IsValid() ? image->GetRawPtr() : nullptr;
+  vtkSmartPointer<vtkUnsignedCharArray> delta;
+
+  // delta frames are only possible when the client reconstructs the exact
+  // same image as the one rendered.
+  const bool lossless = this->Compressor == nullptr ||
+    (this->LossLessCompression && !this->Compressor->IsA("vtkNvPipeCompressor"));
+  if (pixels && this->DeltaEncoding && lossless)
+  {
+    int* referenceSize = nullptr;
+    vtkUnsignedCharArray* reference = this->GetReferenceImage(referenceSize);
+    if (referenceSize[0] == header[1] && referenceSize[1] == header[2] &&
+      referenceSize[2] == header[3])
+    {
+      delta = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      const vtkIdType identical = Difference(pixels, reference, delta);
+      if (2 * identical >= pixels->GetNumberOfValues())
+      {
+        header[4] |= DELTA_FRAME;
+      }
+    }
+    header[4] |= REFERENCE_FRAME;
+    reference->DeepCopy(pixels);
+    std::copy(header + 1, header + 4, referenceSize);
+    if ((header[4] & DELTA_FRAME) != 0)
+    {
+      pixels = delta;
+    }
+  }
 
   // send the image to the client.
-  this->ParallelController->Send(header, 4, 1, 0x023430);
+  this->ParallelController->Send(header, 6, 1, END_RENDER_TAG);
 
-  if (rawImage.IsValid())
+  if (pixels)
   {
     if (this->Compressor)
     {
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
+      this->ParallelController->Send(this->Compress(pixels), 1, END_RENDER_TAG);
     }
     else
     {
-      this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
+      this->ParallelController->Send(pixels, 1, END_RENDER_TAG);
     }
   }
 }
@@ -217,4 +507,11 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LossLessCompression: " << this->LossLessCompression << endl;
+  os << indent << "ProgressiveStreaming: " << this->ProgressiveStreaming << endl;
+  os << indent << "TargetFrameTime: " << this->TargetFrameTime << endl;
+  os << indent << "MaximumProgressiveFactor: " << this->MaximumProgressiveFactor << endl;
+  os << indent << "DeltaEncoding: " << this->DeltaEncoding << endl;
+  os << indent << "LastProgressiveFactor: " << this->LastProgressiveFactor << endl;
+  os << indent << "EstimatedThroughput: " << this->EstimatedThroughput << endl;
 }
@@ -19,6 +19,22 @@
  * vtkPVClientServerSynchronizedRenderers is similar to
  * vtkClientServerSynchronizedRenderers except that it optionally uses image
  * compressors to compress the image before transmitting.
+ *
+ * Two optional features reduce the bandwidth needed to deliver images:
+ *
+ * \li When `ProgressiveStreaming` is enabled, the client measures the
+ *     throughput of the connection and the time the server takes to answer
+ *     each frame. For interactive (lossy) renders, it then asks the server to
+ *     downsample images so that the transfer fits within
+ *     `TargetFrameTime`. The coarse image is stretched to the viewport on the
+ *     client. The full resolution image is sent by the still render that
+ *     follows the interaction.
+ * \li When `DeltaEncoding` is enabled, lossless images that have the same
+ *     size as the last lossless image delivered are sent as a difference
+ *     against it when that compresses better, i.e. when most pixels did not
+ *     change, as is typical when animating with a fixed camera or changing
+ *     colors. The server keeps one reference image per client, so this also
+ *     works when several clients are connected in collaboration mode.
 */
 
 #ifndef vtkPVClientServerSynchronizedRenderers_h
@@ -59,6 +75,58 @@ public:
    */
   virtual void ConfigureCompressor(const char* stream);
 
+  //@{
+  /**
+   * Enable/disable downsampling of interactive renders based on the measured
+   * throughput of the connection. When enabled, the client sends the factor
+   * to use with every render, hence this must be set to the same value on the
+   * client and the server, as vtkPVRenderView does. Default is false.
+   */
+  vtkSetMacro(ProgressiveStreaming, bool);
+  vtkGetMacro(ProgressiveStreaming, bool);
+  vtkBooleanMacro(ProgressiveStreaming, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the time, in seconds, an interactive frame should take to be
+   * delivered when `ProgressiveStreaming` is enabled. Default is 0.1.
+   */
+  vtkSetClampMacro(TargetFrameTime, double, 0.001, VTK_DOUBLE_MAX);
+  vtkGetMacro(TargetFrameTime, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum downsampling factor used by `ProgressiveStreaming`.
+   * Default is 8.
+   */
+  vtkSetClampMacro(MaximumProgressiveFactor, int, 1, 50);
+  vtkGetMacro(MaximumProgressiveFactor, int);
+  //@}
+
+  //@{
+  /**
+   * Enable/disable encoding lossless images as a difference against the last
+   * lossless image delivered. Only the value set on the server matters.
+   * Default is false.
+   */
+  vtkSetMacro(DeltaEncoding, bool);
+  vtkGetMacro(DeltaEncoding, bool);
+  vtkBooleanMacro(DeltaEncoding, bool);
+  //@}
+
+  /**
+   * Returns the downsampling factor of the last image delivered.
+   */
+  vtkGetMacro(LastProgressiveFactor, int);
+
+  /**
+   * Returns the throughput of the connection in bytes per second, as
+   * measured on the client, or 0 when unknown.
+   */
+  vtkGetMacro(EstimatedThroughput, double);
+
 protected:
   vtkPVClientServerSynchronizedRenderers();
   ~vtkPVClientServerSynchronizedRenderers() override;
@@ -74,14 +142,51 @@ protected:
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
   void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
+  void MasterStartRender() override;
+  void SlaveStartRender() override;
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
+  /**
+   * Returns the downsampling factor the server should use for the next
+   * frame, based on the measurements of previous frames.
+   */
+  int ComputeProgressiveFactor();
+
+  /**
+   * Updates the estimates used by ComputeProgressiveFactor() once a frame
+   * has been received.
+   */
+  void UpdateEstimates(
+    double serverTime, double transferTime, vtkIdType bytes, int width, int height, int factor);
+
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  bool ProgressiveStreaming;
+  double TargetFrameTime;
+  int MaximumProgressiveFactor;
+  bool DeltaEncoding;
+
+  int ProgressiveFactor;
+  int LastProgressiveFactor;
+  double EstimatedThroughput;
+  double EstimatedServerTime;
+  double EstimatedBytesPerPixel;
+  vtkIdType LastFullResolutionPixels;
+
+  vtkRawImage CoarseImage;
+
+  /**
+   * Returns the reference image used for delta frames exchanged with the
+   * client currently being rendered for, creating it if needed.
+   */
+  vtkUnsignedCharArray* GetReferenceImage(int*& size);
 
 private:
+  class vtkInternals;
+  vtkInternals* Internals;
+
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
   void operator=(const vtkPVClientServerSynchronizedRenderers&) = delete;
 };
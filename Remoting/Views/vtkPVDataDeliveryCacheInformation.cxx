@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataDeliveryCacheInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataDeliveryCacheInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVView.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkPVDataDeliveryCacheInformation);
+//----------------------------------------------------------------------------
+vtkPVDataDeliveryCacheInformation::vtkPVDataDeliveryCacheInformation()
+  : Hits(0)
+  , Misses(0)
+  , Evictions(0)
+  , CacheSize(0)
+  , MaximumProcessCacheSize(0)
+  , CacheSizeLimit(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataDeliveryCacheInformation::~vtkPVDataDeliveryCacheInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryCacheInformation::CopyFromObject(vtkObject* object)
+{
+  vtkPVView* view = vtkPVView::SafeDownCast(object);
+  if (!view)
+  {
+    vtkErrorMacro("Incorrect object: " << (object ? object->GetClassName() : "(null)"));
+    return;
+  }
+
+  this->Hits = this->Misses = this->Evictions = this->CacheSize = 0;
+  this->MaximumProcessCacheSize = vtkPVDataDeliveryManager::GetTotalCacheSize();
+  this->CacheSizeLimit = vtkPVDataDeliveryManager::GetCacheSizeLimit();
+  if (auto mgr = view->GetDeliveryManager())
+  {
+    this->Hits = mgr->GetCacheHits();
+    this->Misses = mgr->GetCacheMisses();
+    this->Evictions = mgr->GetCacheEvictions();
+    this->CacheSize = mgr->GetCacheSize();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryCacheInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVDataDeliveryCacheInformation::SafeDownCast(info);
+  if (!other)
+  {
+    return;
+  }
+
+  this->Hits += other->Hits;
+  this->Misses += other->Misses;
+  this->Evictions += other->Evictions;
+  this->CacheSize += other->CacheSize;
+  this->MaximumProcessCacheSize =
+    std::max(this->MaximumProcessCacheSize, other->MaximumProcessCacheSize);
+  this->CacheSizeLimit = std::max(this->CacheSizeLimit, other->CacheSizeLimit);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryCacheInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->Hits << this->Misses << this->Evictions
+       << this->CacheSize << this->MaximumProcessCacheSize << this->CacheSizeLimit
+       << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryCacheInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  css->GetArgument(0, 0, &this->Hits);
+  css->GetArgument(0, 1, &this->Misses);
+  css->GetArgument(0, 2, &this->Evictions);
+  css->GetArgument(0, 3, &this->CacheSize);
+  css->GetArgument(0, 4, &this->MaximumProcessCacheSize);
+  css->GetArgument(0, 5, &this->CacheSizeLimit);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryCacheInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Hits: " << this->Hits << endl;
+  os << indent << "Misses: " << this->Misses << endl;
+  os << indent << "Evictions: " << this->Evictions << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "MaximumProcessCacheSize: " << this->MaximumProcessCacheSize << endl;
+  os << indent << "CacheSizeLimit: " << this->CacheSizeLimit << endl;
+}
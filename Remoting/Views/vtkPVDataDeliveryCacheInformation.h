@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataDeliveryCacheInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVDataDeliveryCacheInformation
+ * @brief   information about data cached by a view's delivery manager.
+ *
+ * vtkPVDataDeliveryCacheInformation collects cache statistics from the
+ * vtkPVDataDeliveryManager of a vtkPVView, e.g. when caching geometry for
+ * animation playback. Statistics are summed over all ranks, except
+ * `MaximumProcessCacheSize` which is the largest process-wide cache size on
+ * any rank and is typically compared against
+ * vtkPVDataDeliveryManager::GetCacheSizeLimit() to size the cache.
+ * All sizes are in kilobytes.
+ */
+
+#ifndef vtkPVDataDeliveryCacheInformation_h
+#define vtkPVDataDeliveryCacheInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVDataDeliveryCacheInformation : public vtkPVInformation
+{
+public:
+  static vtkPVDataDeliveryCacheInformation* New();
+  vtkTypeMacro(vtkPVDataDeliveryCacheInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation* info) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  //@{
+  /**
+   * Access the collected statistics.
+   */
+  vtkGetMacro(Hits, vtkTypeUInt64);
+  vtkGetMacro(Misses, vtkTypeUInt64);
+  vtkGetMacro(Evictions, vtkTypeUInt64);
+  vtkGetMacro(CacheSize, vtkTypeUInt64);
+  vtkGetMacro(MaximumProcessCacheSize, vtkTypeUInt64);
+  vtkGetMacro(CacheSizeLimit, vtkTypeUInt64);
+  //@}
+
+protected:
+  vtkPVDataDeliveryCacheInformation();
+  ~vtkPVDataDeliveryCacheInformation() override;
+
+  vtkTypeUInt64 Hits;
+  vtkTypeUInt64 Misses;
+  vtkTypeUInt64 Evictions;
+  vtkTypeUInt64 CacheSize;
+  vtkTypeUInt64 MaximumProcessCacheSize;
+  vtkTypeUInt64 CacheSizeLimit;
+
+private:
+  vtkPVDataDeliveryCacheInformation(const vtkPVDataDeliveryCacheInformation&) = delete;
+  void operator=(const vtkPVDataDeliveryCacheInformation&) = delete;
+};
+
+#endif
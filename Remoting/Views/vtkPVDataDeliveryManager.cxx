@@ -25,6 +25,113 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <list>
+#include <map>
+#include <utility>
+
+//*****************************************************************************
+// vtkCacheLRU keeps track of all data cached by all delivery managers in this
+// process, in the order they were last used. When the total size exceeds the
+// limit, the least recently used entries that are not currently in use by
+// their representation are evicted.
+class vtkPVDataDeliveryManager::vtkInternals::vtkCacheLRU
+{
+public:
+  typedef std::pair<vtkItem*, double> KeyType;
+
+  static vtkCacheLRU& GetInstance()
+  {
+    static vtkCacheLRU instance;
+    return instance;
+  }
+
+  void Update(vtkItem* item, double cacheKey)
+  {
+    const KeyType key(item, cacheKey);
+    const vtkTypeUInt64 size = item->GetCacheEntrySize(cacheKey);
+    auto iter = this->Entries.find(key);
+    if (iter != this->Entries.end())
+    {
+      this->TotalSize -= iter->second.second;
+      iter->second.second = size;
+      this->Order.splice(this->Order.begin(), this->Order, iter->second.first);
+    }
+    else
+    {
+      this->Order.push_front(key);
+      this->Entries[key] = std::make_pair(this->Order.begin(), size);
+    }
+    this->TotalSize += size;
+    this->Evict(key);
+  }
+
+  void Remove(vtkItem* item, double cacheKey)
+  {
+    auto iter = this->Entries.find(KeyType(item, cacheKey));
+    if (iter != this->Entries.end())
+    {
+      this->TotalSize -= iter->second.second;
+      this->Order.erase(iter->second.first);
+      this->Entries.erase(iter);
+    }
+  }
+
+  // Evict least recently used entries until the total size is within the
+  // limit. `keep` is never evicted.
+  void Evict(const KeyType& keep = KeyType(nullptr, 0.0))
+  {
+    if (this->Limit == 0)
+    {
+      return;
+    }
+
+    auto iter = this->Order.end();
+    while (this->TotalSize > this->Limit && iter != this->Order.begin())
+    {
+      --iter;
+      const KeyType key = *iter;
+      vtkItem* item = key.first;
+      vtkInternals* owner = item->GetOwner();
+      if (key == keep || owner->IsCurrentCacheKey(item->GetReprId(), key.second))
+      {
+        continue;
+      }
+
+      auto entry = this->Entries.find(key);
+      assert(entry != this->Entries.end());
+      this->TotalSize -= entry->second.second;
+      this->Entries.erase(entry);
+      iter = this->Order.erase(iter);
+      owner->CacheEvictions++;
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "evicted cached data (key=%g)", key.second);
+      item->EvictCacheEntry(key.second);
+    }
+  }
+
+  // Total size of cached data, in KiB.
+  vtkTypeUInt64 TotalSize{ 0 };
+
+  // Size limit in KiB. 0 implies no limit.
+  unsigned long Limit{ 0 };
+
+private:
+  // Front is most recently used.
+  std::list<KeyType> Order;
+  std::map<KeyType, std::pair<std::list<KeyType>::iterator, vtkTypeUInt64> > Entries;
+};
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::vtkInternals::CacheEntryUpdated(vtkItem* item, double cacheKey)
+{
+  vtkCacheLRU::GetInstance().Update(item, cacheKey);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::vtkInternals::CacheEntryRemoved(vtkItem* item, double cacheKey)
+{
+  vtkCacheLRU::GetInstance().Remove(item, cacheKey);
+}
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
@@ -152,6 +259,16 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
+  if (val)
+  {
+    ++this->Internals->CacheHits;
+    // mark as recently used.
+    this->Internals->CacheEntryUpdated(item, cacheKey);
+  }
+  else
+  {
+    ++this->Internals->CacheMisses;
+  }
 
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
@@ -297,8 +414,67 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SetCacheSizeLimit(unsigned long kbs)
+{
+  auto& lru = vtkInternals::vtkCacheLRU::GetInstance();
+  if (lru.Limit != kbs)
+  {
+    lru.Limit = kbs;
+    lru.Evict();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVDataDeliveryManager::GetCacheSizeLimit()
+{
+  return vtkInternals::vtkCacheLRU::GetInstance().Limit;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetTotalCacheSize()
+{
+  return vtkInternals::vtkCacheLRU::GetInstance().TotalSize;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheSize() const
+{
+  return this->Internals->GetCacheSize();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheHits() const
+{
+  return this->Internals->CacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMisses() const
+{
+  return this->Internals->CacheMisses;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheEvictions() const
+{
+  return this->Internals->CacheEvictions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ResetCacheStatistics()
+{
+  this->Internals->CacheHits = 0;
+  this->Internals->CacheMisses = 0;
+  this->Internals->CacheEvictions = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheHits: " << this->GetCacheHits() << endl;
+  os << indent << "CacheMisses: " << this->GetCacheMisses() << endl;
+  os << indent << "CacheEvictions: " << this->GetCacheEvictions() << endl;
+  os << indent << "CacheSize: " << this->GetCacheSize() << endl;
 }
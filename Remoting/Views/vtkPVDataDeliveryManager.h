@@ -107,6 +107,38 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  //@{
+  /**
+   * Limit, in kilobytes, for the data cached by all delivery managers in this
+   * process e.g. geometry cached for animation playback. When exceeded, the
+   * least recently used cached data that is not currently being shown by its
+   * representation is evicted. 0 (default) implies no limit.
+   */
+  static void SetCacheSizeLimit(unsigned long kbs);
+  static unsigned long GetCacheSizeLimit();
+  //@}
+
+  /**
+   * Returns the size, in kilobytes, of the data cached by all delivery
+   * managers in this process.
+   */
+  static vtkTypeUInt64 GetTotalCacheSize();
+
+  //@{
+  /**
+   * Cache statistics for this delivery manager. A hit or miss is recorded each
+   * time a representation checks if data is available for its current cache
+   * key. `GetCacheSize` returns the size, in kilobytes, of data held by this
+   * delivery manager. Use vtkPVDataDeliveryCacheInformation to gather these
+   * across ranks.
+   */
+  vtkTypeUInt64 GetCacheHits() const;
+  vtkTypeUInt64 GetCacheMisses() const;
+  vtkTypeUInt64 GetCacheEvictions() const;
+  vtkTypeUInt64 GetCacheSize() const;
+  void ResetCacheStatistics();
+  //@}
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -28,6 +28,7 @@
 #include "vtkWeakPointer.h"
 
 #include <cassert>
+#include <list>
 #include <map>
 #include <numeric>
 #include <queue>
@@ -62,6 +63,21 @@ class vtkPVDataDeliveryManager::vtkInternals
   }
 
 public:
+  class vtkItem;
+  class vtkCacheLRU;
+
+  // Cache statistics for this delivery manager.
+  vtkTypeUInt64 CacheHits{ 0 };
+  vtkTypeUInt64 CacheMisses{ 0 };
+  vtkTypeUInt64 CacheEvictions{ 0 };
+
+  // These are called by vtkItem when data cached for a specific cache-key is
+  // changed or removed to keep the process-wide LRU (vtkCacheLRU) up-to-date.
+  // Updating an entry may evict other entries if the cache size limit is
+  // exceeded. Defined in vtkPVDataDeliveryManager.cxx.
+  void CacheEntryUpdated(vtkItem* item, double cacheKey);
+  void CacheEntryRemoved(vtkItem* item, double cacheKey);
+
   struct vtkRepresentedData
   {
     // Data object produced by the representation.
@@ -82,6 +98,10 @@ public:
   {
     vtkNew<vtkPVTrivialProducer> Producer;
 
+    // Identify this item in the owner's ItemsMap.
+    vtkInternals* Owner{ nullptr };
+    unsigned int ReprId{ 0 };
+
     // Store of data generated by the representation for rendering.
     // The store keeps data at various stages of the pipeline along with
     // relevant cache, as appropriate.
@@ -91,8 +111,61 @@ public:
 
   public:
     vtkItem() {}
+    ~vtkItem() { this->ClearCache(); }
 
-    void ClearCache() { this->Data.clear(); }
+    void SetOwner(vtkInternals* owner, unsigned int reprId)
+    {
+      this->Owner = owner;
+      this->ReprId = reprId;
+    }
+    vtkInternals* GetOwner() const { return this->Owner; }
+    unsigned int GetReprId() const { return this->ReprId; }
+
+    void ClearCache()
+    {
+      if (this->Owner)
+      {
+        for (const auto& pair : this->Data)
+        {
+          this->Owner->CacheEntryRemoved(this, pair.first);
+        }
+      }
+      this->Data.clear();
+    }
+
+    // Called by vtkCacheLRU to evict the data cached for the key.
+    void EvictCacheEntry(double cacheKey) { this->Data.erase(cacheKey); }
+
+    // Returns the memory (in KiB) used by data cached for the key, including
+    // data delivered to this process.
+    vtkTypeUInt64 GetCacheEntrySize(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return 0;
+      }
+      const auto& store = iter->second;
+      vtkTypeUInt64 size = store.ActualMemorySize;
+      for (const auto& pair : store.DeliveredDataObjects)
+      {
+        if (pair.second != nullptr && pair.second != store.DataObject)
+        {
+          size += pair.second->GetActualMemorySize();
+        }
+      }
+      return size;
+    }
+
+    vtkTypeUInt64 GetCacheSize() const
+    {
+      vtkTypeUInt64 size = 0;
+      for (const auto& pair : this->Data)
+      {
+        size += this->GetCacheEntrySize(pair.first);
+      }
+      return size;
+    }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
     {
@@ -125,12 +198,21 @@ public:
       ts.Modified();
       store.TimeStamp = ts;
       this->TimeStamp = ts;
+
+      if (this->Owner)
+      {
+        this->Owner->CacheEntryUpdated(this, cacheKey);
+      }
     }
 
     void SetActualMemorySize(unsigned long size, double cacheKey)
     {
       auto& store = this->Data[cacheKey];
       store.ActualMemorySize = size;
+      if (this->Owner)
+      {
+        this->Owner->CacheEntryUpdated(this, cacheKey);
+      }
     }
 
     unsigned long GetActualMemorySize(double cacheKey) const
@@ -156,6 +238,10 @@ public:
     {
       auto& store = this->Data[cacheKey];
       store.DeliveredDataObjects[dataKey] = data;
+      if (this->Owner)
+      {
+        this->Owner->CacheEntryUpdated(this, cacheKey);
+      }
     }
 
     vtkPVTrivialProducer* GetProducer(int dataKey, double cacheKey)
@@ -223,6 +309,8 @@ public:
     else if (create_if_needed)
     {
       std::pair<vtkItem, vtkItem>& itemsPair = this->ItemsMap[key];
+      itemsPair.first.SetOwner(this, index);
+      itemsPair.second.SetOwner(this, index);
       return use_second ? &(itemsPair.second) : &(itemsPair.first);
     }
     return NULL;
@@ -272,6 +360,25 @@ public:
     return size;
   }
 
+  // Returns true if the cache key is the one currently in use by the
+  // representation. Such cache entries are never evicted.
+  bool IsCurrentCacheKey(unsigned int id, double cacheKey) const
+  {
+    auto riter = this->RepresentationsMap.find(id);
+    return (riter != this->RepresentationsMap.end() && riter->second.GetPointer() != nullptr &&
+      riter->second->GetCacheKey() == cacheKey);
+  }
+
+  vtkTypeUInt64 GetCacheSize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      size += ipair.second.first.GetCacheSize() + ipair.second.second.GetCacheSize();
+    }
+    return size;
+  }
+
   bool IsRepresentationVisible(unsigned int id) const
   {
     RepresentationsMapType::const_iterator riter = this->RepresentationsMap.find(id);
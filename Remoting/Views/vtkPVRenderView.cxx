@@ -380,6 +380,8 @@ vtkPVRenderView::vtkPVRenderView()
   this->Selector->SetView(this); // not reference counted.
   this->NeedsOrderedCompositing = false;
   this->RenderEmptyImages = false;
+  this->CompositeStrategy = 0;
+  this->SingleImageStrategy = 0;
   this->UseFXAA = false;
   this->DistributedRenderingRequired = false;
   this->NonDistributedRenderingRequired = false;
@@ -1524,6 +1526,8 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 
   // enable render empty images if it was requested
   this->SynchronizedRenderers->SetRenderEmptyImages(this->GetRenderEmptyImages());
+  this->SynchronizedRenderers->SetCompositeStrategy(this->CompositeStrategy);
+  this->SynchronizedRenderers->SetSingleImageStrategy(this->SingleImageStrategy);
 
   // Render each representation with available geometry.
   // This is the pass where representations get an opportunity to get the
@@ -2253,6 +2257,24 @@ void vtkPVRenderView::ConfigureCompressor(const char* configuration)
   this->SynchronizedRenderers->ConfigureCompressor(configuration);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetProgressiveImageStreaming(bool val)
+{
+  this->SynchronizedRenderers->SetProgressiveImageStreaming(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetTargetInteractiveFrameTime(double val)
+{
+  this->SynchronizedRenderers->SetTargetInteractiveFrameTime(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetImageDeltaEncoding(bool val)
+{
+  this->SynchronizedRenderers->SetImageDeltaEncoding(val);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::InvalidateCachedSelection()
 {
@@ -280,6 +280,19 @@ public:
    */
   void ConfigureCompressor(const char* configuration);
 
+  //@{
+  /**
+   * Configure how images are streamed from the server to the client.
+   * See vtkPVClientServerSynchronizedRenderers::SetProgressiveStreaming(),
+   * vtkPVClientServerSynchronizedRenderers::SetTargetFrameTime() and
+   * vtkPVClientServerSynchronizedRenderers::SetDeltaEncoding() for details.
+   * \note CallOnAllProcesses
+   */
+  void SetProgressiveImageStreaming(bool);
+  void SetTargetInteractiveFrameTime(double);
+  void SetImageDeltaEncoding(bool);
+  //@}
+
   /**
    * Resets the clipping range. One does not need to call this directly ever. It
    * is called periodically by the vtkRenderer to reset the camera range.
@@ -789,6 +802,28 @@ public:
    */
   bool GetRenderEmptyImages();
 
+  //@{
+  /**
+   * Set/Get the IceT strategy used to composite images when doing distributed
+   * rendering. Values are from vtkIceTCompositePass::CompositeStrategyModes.
+   * Default is 0 i.e. pick a strategy based on the tile configuration.
+   */
+  vtkSetMacro(CompositeStrategy, int);
+  vtkGetMacro(CompositeStrategy, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the IceT strategy used to composite a single tile when doing
+   * distributed rendering. Values are from
+   * vtkIceTCompositePass::SingleImageStrategyModes. Default is 0 i.e. let IceT
+   * pick one based on the number of ranks. Use 5 to pick one by measuring the
+   * composite time of recent frames.
+   */
+  vtkSetMacro(SingleImageStrategy, int);
+  vtkGetMacro(SingleImageStrategy, int);
+  //@}
+
   //@{
   /**
    * Enable/disable FXAA antialiasing.
@@ -1180,6 +1215,8 @@ protected:
   bool UseInteractiveRenderingForScreenshots;
   bool NeedsOrderedCompositing;
   bool RenderEmptyImages;
+  int CompositeStrategy;
+  int SingleImageStrategy;
 
   bool UseFXAA;
   vtkNew<vtkFXAAOptions> FXAAOptions;
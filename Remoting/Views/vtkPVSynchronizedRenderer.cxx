@@ -253,6 +253,51 @@ void vtkPVSynchronizedRenderer::ConfigureCompressor(const char* configuration)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetProgressiveImageStreaming(bool val)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetProgressiveStreaming(val);
+  }
+  else
+  {
+    vtkDebugMacro("Not in client-server mode.");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetTargetInteractiveFrameTime(double val)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetTargetFrameTime(val);
+  }
+  else
+  {
+    vtkDebugMacro("Not in client-server mode.");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetImageDeltaEncoding(bool val)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetDeltaEncoding(val);
+  }
+  else
+  {
+    vtkDebugMacro("Not in client-server mode.");
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::SetImageProcessingPass(vtkImageProcessingPass* pass)
 {
@@ -314,6 +359,44 @@ void vtkPVSynchronizedRenderer::SetRenderEmptyImages(bool useREI)
 #endif
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetCompositeStrategy(int strategy)
+{
+  if (this->ParallelSynchronizer == 0)
+  {
+    return;
+  }
+#if VTK_MODULE_ENABLE_ParaView_icet
+  vtkIceTSynchronizedRenderers* sync =
+    vtkIceTSynchronizedRenderers::SafeDownCast(this->ParallelSynchronizer);
+  if (sync)
+  {
+    sync->SetCompositeStrategy(strategy);
+  }
+#else
+  static_cast<void>(strategy); // unused warning when MPI is off.
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetSingleImageStrategy(int strategy)
+{
+  if (this->ParallelSynchronizer == 0)
+  {
+    return;
+  }
+#if VTK_MODULE_ENABLE_ParaView_icet
+  vtkIceTSynchronizedRenderers* sync =
+    vtkIceTSynchronizedRenderers::SafeDownCast(this->ParallelSynchronizer);
+  if (sync)
+  {
+    sync->SetSingleImageStrategy(strategy);
+  }
+#else
+  static_cast<void>(strategy); // unused warning when MPI is off.
+#endif
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::SetNVPipeSupport(bool enable)
 {
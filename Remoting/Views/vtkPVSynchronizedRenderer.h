@@ -138,6 +138,18 @@ public:
   void SetLossLessCompression(bool);
   //@}
 
+  //@{
+  /**
+   * Passes the image streaming options to the client-server synchronizer, if
+   * any. See vtkPVClientServerSynchronizedRenderers::SetProgressiveStreaming(),
+   * vtkPVClientServerSynchronizedRenderers::SetTargetFrameTime() and
+   * vtkPVClientServerSynchronizedRenderers::SetDeltaEncoding().
+   */
+  void SetProgressiveImageStreaming(bool);
+  void SetTargetInteractiveFrameTime(double);
+  void SetImageDeltaEncoding(bool);
+  //@}
+
   /**
    * Activates or de-activated the use of Depth Buffer in an ImageProcessingPass
    */
@@ -148,6 +160,14 @@ public:
    */
   void SetRenderEmptyImages(bool);
 
+  /**
+   * Set the IceT compositing strategies. Refer to
+   * vtkIceTCompositePass::SetCompositeStrategy and
+   * vtkIceTCompositePass::SetSingleImageStrategy.
+   */
+  void SetCompositeStrategy(int);
+  void SetSingleImageStrategy(int);
+
   /**
    * Enable/Disable NVPipe
    */
@@ -259,6 +259,13 @@ bool vtkSMPVRepresentationProxy::RescaleTransferFunctionToDataRangeOverTime()
 //----------------------------------------------------------------------------
 bool vtkSMPVRepresentationProxy::RescaleTransferFunctionToDataRangeOverTime(
   const char* arrayname, int attribute_type)
+{
+  return this->RescaleTransferFunctionToDataRangeOverTime(arrayname, attribute_type, 1);
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMPVRepresentationProxy::RescaleTransferFunctionToDataRangeOverTime(
+  const char* arrayname, int attribute_type, int samplingStride)
 {
   vtkSMPropertyHelper inputHelper(this->GetProperty("Input"));
   vtkSMSourceProxy* inputProxy = vtkSMSourceProxy::SafeDownCast(inputHelper.GetAsProxy());
@@ -271,7 +278,7 @@ bool vtkSMPVRepresentationProxy::RescaleTransferFunctionToDataRangeOverTime(
   }
 
   vtkPVTemporalDataInformation* dataInfo =
-    inputProxy->GetOutputPort(port)->GetTemporalDataInformation();
+    inputProxy->GetOutputPort(port)->GetTemporalDataInformation(samplingStride);
   vtkPVArrayInformation* info = dataInfo->GetArrayInformation(arrayname, attribute_type);
   return info ? this->RescaleTransferFunctionToDataRange(info) : false;
 }
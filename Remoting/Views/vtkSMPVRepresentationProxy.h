@@ -182,6 +182,14 @@ public:
   virtual bool RescaleTransferFunctionToDataRangeOverTime(
     const char* arrayname, int attribute_type);
 
+  /**
+   * Same as RescaleTransferFunctionToDataRangeOverTime(const char*, int) except
+   * that only every Nth timestep is visited, unless its range is already known
+   * from an earlier rescale. This is faster, but the range is approximate.
+   */
+  virtual bool RescaleTransferFunctionToDataRangeOverTime(
+    const char* arrayname, int attribute_type, int samplingStride);
+
   //@{
   /**
    * Safely call RescaleTransferFunctionToDataRangeOverTime() after casting the proxy to
@@ -27,6 +27,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
+#include "vtkCommunicator.h"
 #include "vtkDataArraySelection.h"
 #include "vtkMath.h"
 // Data sets
@@ -1030,6 +1031,9 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->CacheDualGrid = 1;
+  this->HelperInputMTime = 0;
+  this->HelperModified = false;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1052,6 +1056,11 @@ vtkAMRDualClip::~vtkAMRDualClip()
     delete this->BlockLocator;
     this->BlockLocator = 0;
   }
+  if (this->Helper)
+  {
+    this->Helper->Delete();
+    this->Helper = 0;
+  }
   this->SetController(NULL);
 }
 
@@ -1064,6 +1073,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "CacheDualGrid: " << this->CacheDualGrid << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1159,30 +1169,51 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
-  if (this->Helper)
-  {
-    this->Helper->Delete();
+  vtkMultiProcessController* controller =
+    this->EnableMultiProcessCommunication ? this->Controller : NULL;
+
+  // The dual grid only depends on the input and on these options.
+  int rebuild = (!this->CacheDualGrid || !this->Helper || this->HelperModified ||
+    this->HelperInput != hbdsInput || this->HelperInputMTime != hbdsInput->GetMTime() ||
+    this->Helper->GetEnableDegenerateCells() != this->EnableDegenerateCells ||
+    this->Helper->GetController() != controller);
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  { // Initialize communicates, all processes have to agree.
+    int localRebuild = rebuild;
+    controller->AllReduce(&localRebuild, &rebuild, 1, vtkCommunicator::MAX_OP);
   }
 
-  this->Helper = vtkAMRDualGridHelper::New();
-  this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
-  if (this->EnableMultiProcessCommunication)
+  if (rebuild)
   {
-    this->Helper->SetController(this->Controller);
+    if (this->Helper)
+    {
+      this->Helper->Delete();
+    }
+
+    this->Helper = vtkAMRDualGridHelper::New();
+    this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
+    this->Helper->SetController(controller);
+
+    // @TODO: Check if this is the right thing to do.
+    this->Helper->Initialize(hbdsInput);
+    this->HelperInput = hbdsInput;
+    this->HelperInputMTime = hbdsInput->GetMTime();
+    this->HelperArrayName.clear();
+    this->HelperModified = false;
   }
-  else
+  // The level masks below use the array of the last SetupData call.
+  if (rebuild || this->HelperArrayName != arrayNameToProcess)
   {
-    this->Helper->SetController(NULL);
+    this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+    this->HelperArrayName = arrayNameToProcess;
   }
 
-  // @TODO: Check if this is the right thing to do.
-  this->Helper->Initialize(hbdsInput);
-  this->Helper->SetupData(hbdsInput, arrayNameToProcess);
-
   if (this->Controller && this->Controller->GetNumberOfProcesses() > 1 &&
     this->EnableDegenerateCells)
   {
     this->DistributeLevelMasks();
+    // Receiving the level masks writes into the ghost values of the blocks.
+    this->HelperModified = true;
   }
 
   vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
@@ -1207,8 +1238,19 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   int numBlocks;
   int blockId;
 
+  // ProcessBlock uses the center region bit to mark processed blocks.
+  std::vector<unsigned char> centerRegionBits;
+
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
+  {
+    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      centerRegionBits.push_back(this->Helper->GetBlock(level, blockId)->RegionBits[1][1][1]);
+    }
+  }
+  for (int level = 0; level < numLevels; ++level)
   {
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (blockId = 0; blockId < numBlocks; ++blockId)
@@ -1218,6 +1260,24 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
     }
   }
 
+  // Leave the blocks as SetupData left them so that the dual grid can be
+  // used again.
+  size_t blockIndex = 0;
+  for (int level = 0; level < numLevels; ++level)
+  {
+    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (blockId = 0; blockId < numBlocks; ++blockId, ++blockIndex)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->UserData)
+      {
+        delete static_cast<vtkAMRDualClipLocator*>(block->UserData);
+        block->UserData = 0;
+      }
+      block->RegionBits[1][1][1] = centerRegionBits[blockIndex];
+    }
+  }
+
   this->BlockIdCellArray->Delete();
   this->BlockIdCellArray = 0;
   this->LevelMaskPointArray->Delete();
@@ -1233,8 +1293,11 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   this->Cells = 0;
 
   mpds->Delete();
-  this->Helper->Delete();
-  this->Helper = 0;
+  if (!this->CacheDualGrid)
+  {
+    this->Helper->Delete();
+    this->Helper = 0;
+  }
 
   return mbdsOutput0;
 }
@@ -28,6 +28,8 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include "vtkWeakPointer.h"                //needed for vtkWeakPointer
+#include <string>                          //needed for std::string
 
 class vtkDataSet;
 class vtkImageData;
@@ -85,6 +87,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * When on (default), the dual grid built for the input is kept after the
+   * execution and reused while the input and the options it depends on are
+   * unchanged, so that changing the iso value only reruns the clipping pass.
+   * The dual grid is rebuilt when the level masks had to be exchanged between
+   * processes since this modifies the ghost values it holds.
+   */
+  vtkSetMacro(CacheDualGrid, int);
+  vtkGetMacro(CacheDualGrid, int);
+  vtkBooleanMacro(CacheDualGrid, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,6 +114,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int CacheDualGrid;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -150,6 +166,12 @@ protected:
 
   vtkAMRDualClipLocator* BlockLocator;
 
+  // State of the cached dual grid, see CacheDualGrid.
+  vtkWeakPointer<vtkNonOverlappingAMR> HelperInput;
+  vtkMTimeType HelperInputMTime;
+  std::string HelperArrayName;
+  bool HelperModified;
+
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
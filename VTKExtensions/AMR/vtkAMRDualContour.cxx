@@ -25,9 +25,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
+#include "vtkArrayDispatch.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataArraySelection.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
@@ -44,6 +48,7 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <ctime>
 #include <math.h>
 
@@ -623,6 +628,8 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->CacheDualGrid = 1;
+  this->HelperInputMTime = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -645,6 +652,11 @@ vtkAMRDualContour::~vtkAMRDualContour()
     delete this->BlockLocator;
     this->BlockLocator = 0;
   }
+  if (this->Helper)
+  {
+    this->Helper->Delete();
+    this->Helper = 0;
+  }
   this->SetController(NULL);
 }
 
@@ -661,6 +673,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "CacheDualGrid: " << this->CacheDualGrid << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -755,6 +768,25 @@ int vtkAMRDualContour::RequestData(vtkInformation* vtkNotUsed(request),
 
 void vtkAMRDualContour::InitializeRequest(vtkNonOverlappingAMR* hbdsInput)
 {
+  vtkMultiProcessController* controller =
+    this->EnableMultiProcessCommunication ? this->Controller : NULL;
+
+  // The dual grid only depends on the input and on these options.
+  int rebuild = (!this->CacheDualGrid || !this->Helper || this->HelperInput != hbdsInput ||
+    this->HelperInputMTime != hbdsInput->GetMTime() ||
+    this->Helper->GetEnableDegenerateCells() != this->EnableDegenerateCells ||
+    this->Helper->GetSkipGhostCopy() != this->SkipGhostCopy ||
+    this->Helper->GetController() != controller);
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  { // Initialize communicates, all processes have to agree.
+    int localRebuild = rebuild;
+    controller->AllReduce(&localRebuild, &rebuild, 1, vtkCommunicator::MAX_OP);
+  }
+  if (!rebuild)
+  {
+    return;
+  }
+
   if (this->Helper)
   {
     this->Helper->Delete();
@@ -763,27 +795,105 @@ void vtkAMRDualContour::InitializeRequest(vtkNonOverlappingAMR* hbdsInput)
   this->Helper = vtkAMRDualGridHelper::New();
   this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
   this->Helper->SetSkipGhostCopy(this->SkipGhostCopy);
-  if (this->EnableMultiProcessCommunication)
+  this->Helper->SetController(controller);
+  this->Helper->Initialize(hbdsInput);
+
+  this->HelperInput = hbdsInput;
+  this->HelperInputMTime = hbdsInput->GetMTime();
+  this->HelperArrays.clear();
+}
+
+void vtkAMRDualContour::FinalizeRequest()
+{
+  if (!this->CacheDualGrid)
   {
-    this->Helper->SetController(this->Controller);
+    this->Helper->Delete();
+    this->Helper = 0;
   }
-  else
+}
+
+namespace
+{
+// Tells whether any/all values of a block are above the iso value, comparing
+// them the same way ProcessDualCell() computes the cube cases.
+struct vtkAMRDualContourClassifyWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double isoValue, bool& anyAbove, bool& allAbove)
   {
-    this->Helper->SetController(NULL);
+    anyAbove = false;
+    allAbove = true;
+    for (const auto tuple : vtk::DataArrayTupleRange(array))
+    {
+      if (static_cast<double>(tuple[0]) > isoValue)
+      {
+        anyAbove = true;
+      }
+      else
+      {
+        allAbove = false;
+      }
+      if (anyAbove && !allAbove)
+      {
+        return;
+      }
+    }
   }
-  this->Helper->Initialize(hbdsInput);
-}
+};
 
-void vtkAMRDualContour::FinalizeRequest()
+// Flags the blocks that may have dual cells producing a surface. A block is
+// skipped when all its cube cases are 0, or all are 255 and the block has no
+// boundary to cap. Blocks without image or array are left to ProcessBlock().
+struct vtkAMRDualContourClassifyBlocks
 {
-  this->Helper->Delete();
-  this->Helper = 0;
+  const std::vector<vtkAMRDualGridHelperBlock*>& Blocks;
+  const char* ArrayName;
+  double IsoValue;
+  std::vector<unsigned char>& Active;
+
+  vtkAMRDualContourClassifyBlocks(const std::vector<vtkAMRDualGridHelperBlock*>& blocks,
+    const char* arrayName, double isoValue, std::vector<unsigned char>& active)
+    : Blocks(blocks)
+    , ArrayName(arrayName)
+    , IsoValue(isoValue)
+    , Active(active)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkAMRDualContourClassifyWorker worker;
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Blocks[cc];
+      vtkDataArray* array =
+        block->Image ? block->Image->GetCellData()->GetArray(this->ArrayName) : nullptr;
+      if (!array || array->GetNumberOfTuples() == 0)
+      {
+        this->Active[cc] = 1;
+        continue;
+      }
+      bool anyAbove, allAbove;
+      if (!vtkArrayDispatch::Dispatch::Execute(array, worker, this->IsoValue, anyAbove, allAbove))
+      {
+        worker(array, this->IsoValue, anyAbove, allAbove);
+      }
+      this->Active[cc] = (anyAbove && !(allAbove && block->BoundaryBits == 0)) ? 1 : 0;
+    }
+  }
+};
 }
 
 vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
 {
-  this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+  // Ghost values are exchanged once per array for a given dual grid.
+  if (std::find(this->HelperArrays.begin(), this->HelperArrays.end(), arrayNameToProcess) ==
+    this->HelperArrays.end())
+  {
+    this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+    this->HelperArrays.push_back(arrayNameToProcess);
+  }
 
   vtkMultiBlockDataSet* mbdsOutput0 = vtkMultiBlockDataSet::New();
   mbdsOutput0->SetNumberOfBlocks(1);
@@ -808,18 +918,58 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
-
-  // Add each block.
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      blocks.push_back(this->Helper->GetBlock(level, blockId));
+      blockIds.push_back(blockId);
+    }
+  }
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+
+  // ProcessBlock uses the center region bit to mark processed blocks.
+  std::vector<unsigned char> centerRegionBits(numberOfBlocks);
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    centerRegionBits[cc] = blocks[cc]->RegionBits[1][1][1];
+  }
+
+  // Find the blocks the surface goes through. This is independent for each
+  // block, unlike the meshing which shares points between neighbors.
+  std::vector<unsigned char> active(numberOfBlocks, 1);
+  vtkAMRDualContourClassifyBlocks classifier(blocks, arrayNameToProcess, this->IsoValue, active);
+  vtkSMPTools::For(0, numberOfBlocks, classifier);
+
+  // Add each block.
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    if (active[cc])
+    {
+      this->ProcessBlock(blocks[cc], blockIds[cc], arrayNameToProcess);
+    }
+    else
+    {
+      this->SkipBlock(blocks[cc]);
     }
   }
 
+  // Leave the blocks as SetupData left them so that the dual grid can be
+  // used again.
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    vtkAMRDualGridHelperBlock* block = blocks[cc];
+    if (block->UserData)
+    {
+      delete static_cast<vtkAMRDualContourEdgeLocator*>(block->UserData);
+      block->UserData = 0;
+    }
+    block->RegionBits[1][1][1] = centerRegionBits[cc];
+  }
+
   this->FinalizeCopyAttributes(this->Mesh);
   this->BlockIdCellArray->Delete();
   this->BlockIdCellArray = 0;
@@ -1034,6 +1184,22 @@ void vtkAMRDualContour::ProcessBlock(
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::SkipBlock(vtkAMRDualGridHelperBlock* block)
+{
+  if (!this->EnableMergePoints || block->Image == 0)
+  {
+    return;
+  }
+  // Pass on the point ids received from processed neighbors.
+  this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+  this->ShareBlockLocatorWithNeighbors(block);
+  delete this->BlockLocator;
+  this->BlockLocator = 0;
+  block->UserData = 0;
+  block->RegionBits[1][1][1] = 0;
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 void vtkDualGridContourCastCornerValues(T* ptr, vtkIdType offsets[8], double values[8])
@@ -33,6 +33,7 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include "vtkWeakPointer.h"                //needed for vtkWeakPointer
 #include <string>
 #include <vector>
 
@@ -114,6 +115,19 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   //@}
 
+  //@{
+  /**
+   * When on (default), the dual grid built for the input (block layout,
+   * region ownership and ghost values exchanged between processes) is kept
+   * after the execution and reused while the input and the options it
+   * depends on are unchanged. Changing the iso value then only reruns the
+   * contouring pass.
+   */
+  vtkSetMacro(CacheDualGrid, int);
+  vtkGetMacro(CacheDualGrid, int);
+  vtkBooleanMacro(CacheDualGrid, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -130,6 +144,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int CacheDualGrid;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -156,6 +171,12 @@ protected:
 
   void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
 
+  /**
+   * Does the bookkeeping of ProcessBlock() (sharing the point locator with
+   * the neighbors) for a block known to produce no surface.
+   */
+  void SkipBlock(vtkAMRDualGridHelperBlock* block);
+
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
     vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
@@ -198,6 +219,11 @@ protected:
 
   vtkAMRDualContourEdgeLocator* BlockLocator;
 
+  // State of the cached dual grid, see CacheDualGrid.
+  vtkWeakPointer<vtkNonOverlappingAMR> HelperInput;
+  vtkMTimeType HelperInputMTime;
+  std::vector<std::string> HelperArrays;
+
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
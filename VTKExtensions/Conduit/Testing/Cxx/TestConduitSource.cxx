@@ -13,7 +13,9 @@
 
 =========================================================================*/
 
+#include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkCellType.h"
 #include "vtkConduitSource.h"
 #include "vtkImageData.h"
 #include "vtkLogger.h"
@@ -28,6 +30,8 @@
 
 #include <conduit_blueprint.hpp>
 
+#include <vector>
+
 #define VERIFY(x, ...)                                                                             \
   if ((x) == false)                                                                                \
   {                                                                                                \
@@ -125,12 +129,88 @@ bool ValidateMeshTypeUnstructured()
   VERIFY(ug->GetCellData()->GetArray("field") != nullptr, "missing 'field' cell-data array");
   return true;
 }
+
+bool ValidateMeshTypeMixed()
+{
+  // a quad and a triangle sharing an edge.
+  conduit::Node mesh;
+  mesh["coordsets/coords/type"] = "explicit";
+  mesh["coordsets/coords/values/x"].set(std::vector<conduit::float64>{ 0, 1, 2, 0, 1 });
+  mesh["coordsets/coords/values/y"].set(std::vector<conduit::float64>{ 0, 0, 0, 1, 1 });
+  mesh["topologies/mesh/type"] = "unstructured";
+  mesh["topologies/mesh/coordset"] = "coords";
+  mesh["topologies/mesh/elements/shape"] = "mixed";
+  mesh["topologies/mesh/elements/shape_map/quad"] = VTK_QUAD;
+  mesh["topologies/mesh/elements/shape_map/tri"] = VTK_TRIANGLE;
+  mesh["topologies/mesh/elements/shapes"].set(
+    std::vector<conduit::uint8>{ VTK_QUAD, VTK_TRIANGLE });
+  mesh["topologies/mesh/elements/connectivity"].set(
+    std::vector<conduit::int32>{ 0, 1, 4, 3, 1, 2, 4 });
+  mesh["topologies/mesh/elements/sizes"].set(std::vector<conduit::int32>{ 4, 3 });
+  mesh["topologies/mesh/elements/offsets"].set(std::vector<conduit::int32>{ 0, 4 });
+
+  auto pds = vtkPartitionedDataSet::SafeDownCast(Convert(mesh));
+  VERIFY(pds != nullptr && pds->GetNumberOfPartitions() == 1, "expected 1 partition");
+  auto ug = vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0));
+  VERIFY(ug != nullptr, "missing partition 0");
+  VERIFY(ug->GetNumberOfCells() == 2, "incorrect number of cells, expected 2, got %lld",
+    ug->GetNumberOfCells());
+  VERIFY(ug->GetCellType(0) == VTK_QUAD && ug->GetCellType(1) == VTK_TRIANGLE,
+    "incorrect cell types");
+  VERIFY(ug->GetCell(1)->GetPointId(2) == 4, "incorrect connectivity");
+  return true;
+}
+
+bool ValidateMeshTypePolyhedral()
+{
+  // a unit cube described by its 6 faces.
+  conduit::Node mesh;
+  mesh["coordsets/coords/type"] = "explicit";
+  mesh["coordsets/coords/values/x"].set(std::vector<conduit::float64>{ 0, 1, 1, 0, 0, 1, 1, 0 });
+  mesh["coordsets/coords/values/y"].set(std::vector<conduit::float64>{ 0, 0, 1, 1, 0, 0, 1, 1 });
+  mesh["coordsets/coords/values/z"].set(std::vector<conduit::float64>{ 0, 0, 0, 0, 1, 1, 1, 1 });
+  mesh["topologies/mesh/type"] = "unstructured";
+  mesh["topologies/mesh/coordset"] = "coords";
+  mesh["topologies/mesh/elements/shape"] = "polyhedral";
+  mesh["topologies/mesh/elements/connectivity"].set(
+    std::vector<conduit::int32>{ 0, 1, 2, 3, 4, 5 });
+  mesh["topologies/mesh/elements/sizes"].set(std::vector<conduit::int32>{ 6 });
+  mesh["topologies/mesh/elements/offsets"].set(std::vector<conduit::int32>{ 0 });
+  mesh["topologies/mesh/subelements/shape"] = "polygonal";
+  mesh["topologies/mesh/subelements/connectivity"].set(std::vector<conduit::int32>{
+    0, 3, 2, 1, 4, 5, 6, 7, 0, 1, 5, 4, 1, 2, 6, 5, 2, 3, 7, 6, 3, 0, 4, 7 });
+  mesh["topologies/mesh/subelements/sizes"].set(std::vector<conduit::int32>{ 4, 4, 4, 4, 4, 4 });
+  mesh["topologies/mesh/subelements/offsets"].set(
+    std::vector<conduit::int32>{ 0, 4, 8, 12, 16, 20 });
+
+  auto pds = vtkPartitionedDataSet::SafeDownCast(Convert(mesh));
+  VERIFY(pds != nullptr && pds->GetNumberOfPartitions() == 1, "expected 1 partition");
+  auto ug = vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0));
+  VERIFY(ug != nullptr, "missing partition 0");
+  VERIFY(ug->GetNumberOfCells() == 1 && ug->GetCellType(0) == VTK_POLYHEDRON,
+    "expected a single polyhedron");
+  VERIFY(ug->GetCell(0)->GetNumberOfPoints() == 8, "incorrect number of points, expected 8");
+  VERIFY(ug->GetCell(0)->GetNumberOfFaces() == 6, "incorrect number of faces, expected 6");
+  return true;
+}
+
+bool ValidateMultiDomain()
+{
+  conduit::Node mesh;
+  conduit::blueprint::mesh::examples::spiral(3, mesh);
+  auto pds = vtkPartitionedDataSet::SafeDownCast(Convert(mesh));
+  VERIFY(pds != nullptr, "incorrect data type, expected vtkPartitionedDataSet");
+  VERIFY(pds->GetNumberOfPartitions() == 3, "incorrect number of partitions, expected 3, got %d",
+    pds->GetNumberOfPartitions());
+  return true;
+}
 }
 
 int TestConduitSource(int, char* [])
 {
   return ValidateMeshTypeUniform() && ValidateMeshTypeRectilinear() &&
-      ValidateMeshTypeStructured() && ValidateMeshTypeUnstructured()
+      ValidateMeshTypeStructured() && ValidateMeshTypeUnstructured() && ValidateMeshTypeMixed() &&
+      ValidateMeshTypePolyhedral() && ValidateMultiDomain()
     ? EXIT_SUCCESS
     : EXIT_FAILURE;
 }
@@ -18,6 +18,7 @@
 #include "vtkCellArray.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkSOADataArrayTemplate.h"
 #include "vtkTypeFloat32Array.h"
 #include "vtkTypeFloat64Array.h"
@@ -34,6 +35,7 @@
 #include <conduit_blueprint_mcarray.hpp>
 #include <conduit_cpp_to_c.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace internals
@@ -201,6 +203,78 @@ conduit::index_t GetTypeId(conduit::index_t type, bool force_signed)
   }
 }
 
+//----------------------------------------------------------------------------
+int GetVTKType(conduit::index_t type)
+{
+  switch (type)
+  {
+    case conduit::DataType::INT8_ID:
+      return VTK_TYPE_INT8;
+    case conduit::DataType::INT16_ID:
+      return VTK_TYPE_INT16;
+    case conduit::DataType::INT32_ID:
+      return VTK_TYPE_INT32;
+    case conduit::DataType::INT64_ID:
+      return VTK_TYPE_INT64;
+    case conduit::DataType::UINT8_ID:
+      return VTK_TYPE_UINT8;
+    case conduit::DataType::UINT16_ID:
+      return VTK_TYPE_UINT16;
+    case conduit::DataType::UINT32_ID:
+      return VTK_TYPE_UINT32;
+    case conduit::DataType::UINT64_ID:
+      return VTK_TYPE_UINT64;
+    case conduit::DataType::FLOAT32_ID:
+      return VTK_TYPE_FLOAT32;
+    case conduit::DataType::FLOAT64_ID:
+      return VTK_TYPE_FLOAT64;
+    default:
+      return VTK_VOID;
+  }
+}
+
+//----------------------------------------------------------------------------
+// internal: deep-copies each component of an mcarray into an AOS array.
+struct DeepCopyAOSImpl
+{
+  const conduit::Node& MCArray;
+  conduit::index_t TypeId;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    using ValueType = typename ArrayT::ValueType;
+    const int numComps = array->GetNumberOfComponents();
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    ValueType* out = array->GetPointer(0);
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      // `to_data_type` gives us compact values of the target type irrespective
+      // of the source type, offset or stride.
+      conduit::Node compact;
+      this->MCArray.child(cc).to_data_type(this->TypeId, compact);
+      const ValueType* in = reinterpret_cast<const ValueType*>(compact.element_ptr(0));
+      for (vtkIdType tt = 0; tt < numTuples; ++tt)
+      {
+        out[tt * numComps + cc] = in[tt];
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// internal: create vtkCellArray offsets of the same type as the connectivity.
+template <typename ArrayT>
+vtkSmartPointer<ArrayT> CreateOffsets(const std::vector<vtkTypeInt64>& offsets)
+{
+  using ValueType = typename ArrayT::ValueType;
+  auto array = vtkSmartPointer<ArrayT>::New();
+  array->SetNumberOfTuples(static_cast<vtkIdType>(offsets.size()));
+  std::transform(offsets.begin(), offsets.end(), array->GetPointer(0),
+    [](vtkTypeInt64 value) { return static_cast<ValueType>(value); });
+  return array;
+}
+
 } // internals
 
 vtkStandardNewMacro(vtkConduitArrayUtilities);
@@ -263,35 +337,30 @@ vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
     return nullptr;
   }
 
-  // confirm that all components have same type. we don't support mixed component types currently.
-  // we can easily by deep copying, but we won't until needed.
-
+  // components with mismatched types, or with a layout that VTK arrays cannot
+  // reference, are deep-copied.
+  bool mismatched_types = false;
   for (conduit::index_t cc = 1; cc < mcarray.number_of_children(); ++cc)
   {
-    auto& dtype0 = mcarray.child(0).dtype();
-    auto& dtypeCC = mcarray.child(cc).dtype();
-    if (dtype0.id() != dtypeCC.id())
+    if (mcarray.child(0).dtype().id() != mcarray.child(cc).dtype().id())
     {
-      vtkLogF(ERROR,
-        "mismatched component types for component 0 (%s) and %ld (%s); currently not supported.",
-        dtype0.name().c_str(), cc, dtypeCC.name().c_str());
-      return nullptr;
+      mismatched_types = true;
+      break;
     }
   }
 
-  if (conduit::blueprint::mcarray::is_interleaved(mcarray))
+  if (!mismatched_types && conduit::blueprint::mcarray::is_interleaved(mcarray))
   {
     return vtkConduitArrayUtilities::MCArrayToVTKAOSArray(conduit::c_node(&mcarray), force_signed);
   }
-  else if (internals::is_contiguous(mcarray))
+  else if (!mismatched_types && internals::is_contiguous(mcarray))
   {
     return vtkConduitArrayUtilities::MCArrayToVTKSOAArray(conduit::c_node(&mcarray), force_signed);
   }
   else
   {
-    // TODO: we can do a deep-copy in this case, so we can still handle it quite easily when needed.
-    vtkLogF(ERROR, "unsupported array layout.");
-    return nullptr;
+    return vtkConduitArrayUtilities::MCArrayToVTKDeepCopyArray(
+      conduit::c_node(&mcarray), force_signed);
   }
 }
 
@@ -407,6 +476,55 @@ vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKSOAArray(
   }
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::MCArrayToVTKDeepCopyArray(
+  const conduit_node* c_mcarray, bool force_signed)
+{
+  const conduit::Node& mcarray = (*conduit::cpp_node(c_mcarray));
+  const int num_components = static_cast<int>(mcarray.number_of_children());
+  const vtkIdType num_tuples =
+    static_cast<vtkIdType>(mcarray.child(0).dtype().number_of_elements());
+
+  // pick a type that can hold all components; mismatched component types are
+  // promoted to 64-bit.
+  auto type_id = internals::GetTypeId(mcarray.child(0).dtype().id(), force_signed);
+  for (conduit::index_t cc = 1; cc < mcarray.number_of_children(); ++cc)
+  {
+    auto& dtypeCC = mcarray.child(cc).dtype();
+    if (internals::GetTypeId(dtypeCC.id(), force_signed) != type_id)
+    {
+      type_id = (dtypeCC.is_floating_point() || conduit::DataType(type_id, 1).is_floating_point())
+        ? conduit::DataType::FLOAT64_ID
+        : conduit::DataType::INT64_ID;
+    }
+  }
+
+  const int vtk_type = internals::GetVTKType(type_id);
+  if (vtk_type == VTK_VOID)
+  {
+    vtkLogF(ERROR, "unsupported data type '%s' ", mcarray.child(0).dtype().name().c_str());
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkDataArray::CreateDataArray(vtk_type));
+  array->SetNumberOfComponents(num_components);
+  array->SetNumberOfTuples(num_tuples);
+
+  internals::DeepCopyAOSImpl worker{ mcarray, type_id };
+  using Dispatch = vtkArrayDispatch::DispatchByArray<internals::AOSArrays>;
+  if (!Dispatch::Execute(array, worker))
+  {
+    vtkLogF(ERROR, "failed to deep-copy '%s'.", mcarray.path().c_str());
+    return nullptr;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+    "zero-copy not possible for '%s'; deep-copied %lld bytes.", mcarray.path().c_str(),
+    static_cast<long long>(array->GetDataSize() * array->GetDataTypeSize()));
+  return array;
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataArray> vtkConduitArrayUtilities::SetNumberOfComponents(
   vtkDataArray* array, int num_components)
@@ -450,6 +568,114 @@ vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::MCArrayToVTKCellArray(
   return cellArray;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::O2MRelationToVTKCellArray(
+  const conduit_node* c_o2mrelation, const std::string& leafname)
+{
+  const conduit::Node& o2mrelation = (*conduit::cpp_node(c_o2mrelation));
+  const bool has_sizes = o2mrelation.has_child("sizes");
+  const bool has_offsets = o2mrelation.has_child("offsets");
+  if (!o2mrelation.has_child(leafname) || (!has_sizes && !has_offsets))
+  {
+    vtkLogF(ERROR, "invalid o2mrelation, expected '%s' with 'sizes' or 'offsets'.",
+      leafname.c_str());
+    return nullptr;
+  }
+
+  const conduit::Node& leaf = o2mrelation[leafname];
+  const vtkTypeInt64 num_ids = static_cast<vtkTypeInt64>(leaf.dtype().number_of_elements());
+
+  conduit::Node sizes, offsets;
+  if (has_sizes)
+  {
+    o2mrelation["sizes"].to_int64_array(sizes);
+  }
+  if (has_offsets)
+  {
+    o2mrelation["offsets"].to_int64_array(offsets);
+  }
+  const vtkIdType num_cells = static_cast<vtkIdType>(
+    has_sizes ? sizes.dtype().number_of_elements() : offsets.dtype().number_of_elements());
+  if (has_sizes && has_offsets && offsets.dtype().number_of_elements() != num_cells)
+  {
+    vtkLogF(ERROR, "mismatched 'sizes' and 'offsets' lengths.");
+    return nullptr;
+  }
+  const conduit::int64* sizes_ptr = (has_sizes && num_cells > 0) ? sizes.as_int64_ptr() : nullptr;
+  const conduit::int64* offsets_ptr =
+    (has_offsets && num_cells > 0) ? offsets.as_int64_ptr() : nullptr;
+
+  // `vtk_offsets` are the offsets for the cells once packed back-to-back; when
+  // the node already stores them that way, the ids can be used as-is.
+  std::vector<vtkTypeInt64> vtk_offsets(num_cells + 1, 0);
+  bool packed = true;
+  for (vtkIdType cc = 0; cc < num_cells; ++cc)
+  {
+    const vtkTypeInt64 start = offsets_ptr ? offsets_ptr[cc] : vtk_offsets[cc];
+    const vtkTypeInt64 size = sizes_ptr
+      ? sizes_ptr[cc]
+      : ((cc + 1 < num_cells ? offsets_ptr[cc + 1] : num_ids) - start);
+    if (start < 0 || size < 0 || start + size > num_ids)
+    {
+      vtkLogF(ERROR, "element %lld is out of range.", static_cast<long long>(cc));
+      return nullptr;
+    }
+    packed = packed && (start == vtk_offsets[cc]);
+    vtk_offsets[cc + 1] = vtk_offsets[cc] + size;
+  }
+  packed = packed && (vtk_offsets[num_cells] == num_ids);
+
+  vtkNew<vtkCellArray> cellArray;
+  if (packed)
+  {
+    auto connectivity = vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
+      conduit::c_node(&leaf), /*force_signed*/ true);
+    bool shared = false;
+    if (auto conn32 = vtkTypeInt32Array::SafeDownCast(connectivity))
+    {
+      shared =
+        cellArray->SetData(internals::CreateOffsets<vtkTypeInt32Array>(vtk_offsets), conn32);
+    }
+    else if (auto conn64 = vtkTypeInt64Array::SafeDownCast(connectivity))
+    {
+      shared =
+        cellArray->SetData(internals::CreateOffsets<vtkTypeInt64Array>(vtk_offsets), conn64);
+    }
+    if (shared)
+    {
+      vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+        "'%s': shared %lld ids, rebuilt offsets (%lld bytes).", leaf.path().c_str(),
+        static_cast<long long>(num_ids),
+        static_cast<long long>(cellArray->GetOffsetsArray()->GetDataSize() *
+          cellArray->GetOffsetsArray()->GetDataTypeSize()));
+      return cellArray;
+    }
+  }
+
+  // the ids are either not packed or not of a type vtkCellArray can reference;
+  // gather them into 64-bit storage.
+  conduit::Node ids;
+  leaf.to_int64_array(ids);
+  vtkNew<vtkTypeInt64Array> connectivity;
+  connectivity->SetNumberOfTuples(static_cast<vtkIdType>(vtk_offsets[num_cells]));
+  if (num_ids > 0)
+  {
+    const conduit::int64* ids_ptr = ids.as_int64_ptr();
+    vtkTypeInt64* out = connectivity->GetPointer(0);
+    for (vtkIdType cc = 0; cc < num_cells; ++cc)
+    {
+      const vtkTypeInt64 start = offsets_ptr ? offsets_ptr[cc] : vtk_offsets[cc];
+      std::copy(ids_ptr + start, ids_ptr + start + (vtk_offsets[cc + 1] - vtk_offsets[cc]),
+        out + vtk_offsets[cc]);
+    }
+  }
+  cellArray->SetData(internals::CreateOffsets<vtkTypeInt64Array>(vtk_offsets), connectivity);
+  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+    "zero-copy not possible for '%s'; deep-copied %lld bytes.", leaf.path().c_str(),
+    static_cast<long long>(sizeof(vtkTypeInt64) * (vtk_offsets[num_cells] + num_cells + 1)));
+  return cellArray;
+}
+
 //----------------------------------------------------------------------------
 void vtkConduitArrayUtilities::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -19,8 +19,9 @@
  *
  * vtkConduitArrayUtilities is intended to convert Conduit nodes satisfying the
  * `mcarray` protocol to VTK arrays. It uses zero-copy, as much as possible.
- * Currently implementation fails if zero-copy is not possible. In future, that
- * may be changed to do a deep-copy (with appropriate warnings) if necessary.
+ * When zero-copy is not possible, e.g. for strided components or components
+ * with mismatched types, the values are deep-copied instead and the number of
+ * bytes copied is logged using `PARAVIEW_LOG_CATALYST_VERBOSITY()`.
  *
  * This is primarily designed for use by vtkConduitSource.
  */
@@ -65,6 +66,20 @@ public:
   static vtkSmartPointer<vtkCellArray> MCArrayToVTKCellArray(
     vtkIdType cellSize, const conduit_node* mcarray);
 
+  /**
+   * Converts a node in the conduit `o2mrelation` protocol, such as the
+   * `elements` of a polygonal or mixed unstructured topology, to vtkCellArray.
+   * `leafname` is the name of the child holding the point ids, typically
+   * "connectivity". The node must provide `sizes`, `offsets` or both.
+   *
+   * The point ids are shared with the node when they are 32 or 64 bit integers
+   * (signed or not) and the elements are stored back-to-back; otherwise they
+   * are deep-copied. vtkCellArray expects one more offset than the number of
+   * cells, hence the offsets are always rebuilt.
+   */
+  static vtkSmartPointer<vtkCellArray> O2MRelationToVTKCellArray(
+    const conduit_node* o2mrelation, const std::string& leafname);
+
   /**
    * If the number of components in the array does not match the target, a new
    * array is created.
@@ -82,6 +97,8 @@ protected:
     const conduit_node* mcarray, bool force_signed);
   static vtkSmartPointer<vtkDataArray> MCArrayToVTKSOAArray(
     const conduit_node* mcarray, bool force_signed);
+  static vtkSmartPointer<vtkDataArray> MCArrayToVTKDeepCopyArray(
+    const conduit_node* mcarray, bool force_signed);
 
 private:
   vtkConduitArrayUtilities(const vtkConduitArrayUtilities&) = delete;
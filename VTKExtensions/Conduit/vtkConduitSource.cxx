@@ -18,17 +18,20 @@
 #include "vtkConduitArrayUtilities.h"
 #include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <conduit.hpp>
@@ -36,6 +39,9 @@
 #include <conduit_cpp_to_c.hpp>
 
 #include <algorithm>
+#include <map>
+#include <vector>
+
 namespace internals
 {
 
@@ -81,6 +87,22 @@ int GetCellType(const std::string& shape)
   {
     return VTK_HEXAHEDRON;
   }
+  else if (shape == "wedge")
+  {
+    return VTK_WEDGE;
+  }
+  else if (shape == "pyramid")
+  {
+    return VTK_PYRAMID;
+  }
+  else if (shape == "polygonal")
+  {
+    return VTK_POLYGON;
+  }
+  else if (shape == "polyhedral")
+  {
+    return VTK_POLYHEDRON;
+  }
   else
   {
     throw std::runtime_error("unsupported shape " + shape);
@@ -102,6 +124,10 @@ static vtkIdType GetNumberOfPointsInCellType(int vtk_cell_type)
     case VTK_QUAD:
     case VTK_TETRA:
       return 4;
+    case VTK_PYRAMID:
+      return 5;
+    case VTK_WEDGE:
+      return 6;
     case VTK_HEXAHEDRON:
       return 8;
     default:
@@ -136,6 +162,202 @@ vtkSmartPointer<vtkPoints> CreatePoints(const conduit::Node& coords)
   return pts;
 }
 
+//----------------------------------------------------------------------------
+// internal: 64-bit view of the `connectivity`, `sizes` and `offsets` of an
+// unstructured topology's elements (or subelements).
+class O2MRelation
+{
+public:
+  O2MRelation(const conduit::Node& elements)
+  {
+    elements["connectivity"].to_int64_array(this->Ids);
+    if (elements.has_child("sizes"))
+    {
+      elements["sizes"].to_int64_array(this->Sizes);
+      this->NumberOfElements = static_cast<vtkIdType>(this->Sizes.dtype().number_of_elements());
+    }
+    if (elements.has_child("offsets"))
+    {
+      elements["offsets"].to_int64_array(this->Offsets);
+      this->NumberOfElements = static_cast<vtkIdType>(this->Offsets.dtype().number_of_elements());
+    }
+    if (this->Sizes.dtype().is_empty() && this->Offsets.dtype().is_empty())
+    {
+      throw std::runtime_error("missing 'sizes' or 'offsets'");
+    }
+
+    // fill in whichever of `sizes` or `offsets` was omitted.
+    const auto numIds = static_cast<conduit::int64>(this->Ids.dtype().number_of_elements());
+    if (this->Offsets.dtype().is_empty())
+    {
+      this->Offsets.set(conduit::DataType::int64(this->NumberOfElements));
+      conduit::int64 offset = 0;
+      for (vtkIdType cc = 0; cc < this->NumberOfElements; ++cc)
+      {
+        this->Offsets.as_int64_ptr()[cc] = offset;
+        offset += this->Sizes.as_int64_ptr()[cc];
+      }
+    }
+    else if (this->Sizes.dtype().is_empty())
+    {
+      this->Sizes.set(conduit::DataType::int64(this->NumberOfElements));
+      for (vtkIdType cc = 0; cc < this->NumberOfElements; ++cc)
+      {
+        const auto next =
+          cc + 1 < this->NumberOfElements ? this->Offsets.as_int64_ptr()[cc + 1] : numIds;
+        this->Sizes.as_int64_ptr()[cc] = next - this->Offsets.as_int64_ptr()[cc];
+      }
+    }
+
+    for (vtkIdType cc = 0; cc < this->NumberOfElements; ++cc)
+    {
+      if (this->GetSize(cc) < 0 || this->Offsets.as_int64_ptr()[cc] < 0 ||
+        this->Offsets.as_int64_ptr()[cc] + this->GetSize(cc) > numIds)
+      {
+        throw std::runtime_error("element " + std::to_string(cc) + " is out of range");
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfElements() const { return this->NumberOfElements; }
+  vtkIdType GetSize(vtkIdType idx) const
+  {
+    return static_cast<vtkIdType>(this->Sizes.as_int64_ptr()[idx]);
+  }
+  const conduit::int64* GetIds(vtkIdType idx) const
+  {
+    return this->Ids.as_int64_ptr() + this->Offsets.as_int64_ptr()[idx];
+  }
+
+private:
+  conduit::Node Ids;
+  conduit::Node Sizes;
+  conduit::Node Offsets;
+  vtkIdType NumberOfElements = 0;
+};
+
+//----------------------------------------------------------------------------
+vtkIdType GetNumberOfBytes(vtkDataArray* array)
+{
+  return array ? array->GetDataSize() * array->GetDataTypeSize() : 0;
+}
+
+//----------------------------------------------------------------------------
+// internal: cell types for a "mixed" topology. `shapes` is used directly when
+// it is an uint8 array and `shape_map` maps each shape to its VTK cell type.
+vtkSmartPointer<vtkUnsignedCharArray> GetMixedCellTypes(const conduit::Node& elements)
+{
+  std::map<conduit::int64, unsigned char> shapeMap;
+  bool identity = true;
+  auto iter = elements["shape_map"].children();
+  while (iter.has_next())
+  {
+    const auto& child = iter.next();
+    const int vtk_cell_type = GetCellType(iter.name());
+    if (vtk_cell_type == VTK_POLYHEDRON)
+    {
+      throw std::runtime_error("'polyhedral' shapes in 'mixed' topologies are not supported");
+    }
+    shapeMap[child.to_int64()] = static_cast<unsigned char>(vtk_cell_type);
+    identity = identity && (child.to_int64() == vtk_cell_type);
+  }
+
+  const auto& shapes = elements["shapes"];
+  if (identity && shapes.dtype().is_uint8())
+  {
+    auto array = vtkConduitArrayUtilities::MCArrayToVTKArray(&shapes, "types");
+    if (auto types = vtkUnsignedCharArray::SafeDownCast(array))
+    {
+      return types;
+    }
+  }
+
+  conduit::Node shapes64;
+  shapes.to_int64_array(shapes64);
+  const auto numCells = static_cast<vtkIdType>(shapes64.dtype().number_of_elements());
+  auto types = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  types->SetNumberOfTuples(numCells);
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    auto siter = shapeMap.find(shapes64.as_int64_ptr()[cc]);
+    if (siter == shapeMap.end())
+    {
+      throw std::runtime_error("shape id missing in 'shape_map' for element " + std::to_string(cc));
+    }
+    types->SetValue(cc, siter->second);
+  }
+  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+    "zero-copy not possible for '%s'; deep-copied %lld bytes.", shapes.path().c_str(),
+    static_cast<long long>(GetNumberOfBytes(types)));
+  return types;
+}
+
+//----------------------------------------------------------------------------
+// internal: convert a "polyhedral" topology. VTK needs both the unique points
+// of each cell and a face stream, neither of which Blueprint stores, so this
+// always deep-copies.
+void SetPolyhedralCells(
+  vtkUnstructuredGrid* ug, const conduit::Node& elements, const conduit::Node& subelements)
+{
+  if (subelements["shape"].as_string() != "polygonal")
+  {
+    throw std::runtime_error("polyhedral 'subelements' must be 'polygonal'");
+  }
+
+  const O2MRelation cells(elements);
+  const O2MRelation faces(subelements);
+  const vtkIdType numCells = cells.GetNumberOfElements();
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(numCells);
+  types->FillValue(VTK_POLYHEDRON);
+
+  vtkNew<vtkIdTypeArray> faceLocations;
+  faceLocations->SetNumberOfTuples(numCells);
+
+  vtkNew<vtkIdTypeArray> faceStream;
+  vtkNew<vtkCellArray> cellArray;
+  cellArray->AllocateEstimate(numCells, 8);
+
+  std::vector<vtkIdType> cellPoints;
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    faceLocations->SetValue(cc, faceStream->GetNumberOfValues());
+    faceStream->InsertNextValue(cells.GetSize(cc));
+    cellPoints.clear();
+
+    const conduit::int64* faceIds = cells.GetIds(cc);
+    for (vtkIdType ff = 0, numFaces = cells.GetSize(cc); ff < numFaces; ++ff)
+    {
+      const vtkIdType faceId = static_cast<vtkIdType>(faceIds[ff]);
+      if (faceId < 0 || faceId >= faces.GetNumberOfElements())
+      {
+        throw std::runtime_error("invalid face id " + std::to_string(faceId));
+      }
+
+      const conduit::int64* ptIds = faces.GetIds(faceId);
+      faceStream->InsertNextValue(faces.GetSize(faceId));
+      for (vtkIdType pp = 0, numPts = faces.GetSize(faceId); pp < numPts; ++pp)
+      {
+        const vtkIdType ptId = static_cast<vtkIdType>(ptIds[pp]);
+        faceStream->InsertNextValue(ptId);
+        if (std::find(cellPoints.begin(), cellPoints.end(), ptId) == cellPoints.end())
+        {
+          cellPoints.push_back(ptId);
+        }
+      }
+    }
+    cellArray->InsertNextCell(static_cast<vtkIdType>(cellPoints.size()), cellPoints.data());
+  }
+
+  ug->SetCells(types, cellArray, faceLocations, faceStream);
+  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+    "zero-copy not possible for polyhedral '%s'; deep-copied %lld bytes.", elements.path().c_str(),
+    static_cast<long long>(GetNumberOfBytes(types) + GetNumberOfBytes(faceLocations) +
+      GetNumberOfBytes(faceStream) + GetNumberOfBytes(cellArray->GetOffsetsArray()) +
+      GetNumberOfBytes(cellArray->GetConnectivityArray())));
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataSet> GetMesh(
   const conduit::Node& topologyNode, const conduit::Node& coordsets)
@@ -202,11 +424,45 @@ vtkSmartPointer<vtkDataSet> GetMesh(
   {
     vtkNew<vtkUnstructuredGrid> ug;
     ug->SetPoints(CreatePoints(coords));
-    const auto vtk_cell_type = GetCellType(topologyNode["elements/shape"].as_string());
-    const auto cell_size = GetNumberOfPointsInCellType(vtk_cell_type);
-    auto cellArray = vtkConduitArrayUtilities::MCArrayToVTKCellArray(
-      cell_size, &topologyNode["elements/connectivity"]);
-    ug->SetCells(vtk_cell_type, cellArray);
+    const auto& elements = topologyNode["elements"];
+    const auto shape = elements["shape"].as_string();
+    if (shape == "mixed")
+    {
+      auto types = GetMixedCellTypes(elements);
+      auto cellArray =
+        vtkConduitArrayUtilities::O2MRelationToVTKCellArray(&elements, "connectivity");
+      if (cellArray == nullptr)
+      {
+        throw std::runtime_error("failed to convert 'mixed' elements!");
+      }
+      if (types->GetNumberOfTuples() != cellArray->GetNumberOfCells())
+      {
+        throw std::runtime_error("mismatched 'shapes' and element count!");
+      }
+      ug->SetCells(types, cellArray);
+    }
+    else if (shape == "polyhedral")
+    {
+      SetPolyhedralCells(ug, elements, topologyNode["subelements"]);
+    }
+    else if (shape == "polygonal")
+    {
+      auto cellArray =
+        vtkConduitArrayUtilities::O2MRelationToVTKCellArray(&elements, "connectivity");
+      if (cellArray == nullptr)
+      {
+        throw std::runtime_error("failed to convert 'polygonal' elements!");
+      }
+      ug->SetCells(VTK_POLYGON, cellArray);
+    }
+    else
+    {
+      const auto vtk_cell_type = GetCellType(shape);
+      const auto cell_size = GetNumberOfPointsInCellType(vtk_cell_type);
+      auto cellArray =
+        vtkConduitArrayUtilities::MCArrayToVTKCellArray(cell_size, &elements["connectivity"]);
+      ug->SetCells(vtk_cell_type, cellArray);
+    }
     return ug;
   }
   else
@@ -215,6 +471,70 @@ vtkSmartPointer<vtkDataSet> GetMesh(
   }
 }
 
+//----------------------------------------------------------------------------
+// internal: add partitions for the topologies (and fields) of a single domain.
+bool AddDomain(const conduit::Node& node, vtkPartitionedDataSet* output)
+{
+  std::map<std::string, vtkSmartPointer<vtkDataSet> > datasets;
+
+  // process "topologies".
+  const auto& topologies = node["topologies"];
+  auto iter = topologies.children();
+  while (iter.has_next())
+  {
+    iter.next();
+    try
+    {
+      if (auto ds = GetMesh(iter.node(), node["coordsets"]))
+      {
+        auto idx = output->GetNumberOfPartitions();
+        output->SetPartition(idx, ds);
+        output->GetMetaData(idx)->Set(vtkCompositeDataSet::NAME(), iter.name().c_str());
+        datasets[iter.name()] = ds;
+      }
+    }
+    catch (std::exception& e)
+    {
+      vtkLogF(ERROR, "failed to process '../topologies/%s'.", iter.name().c_str());
+      vtkLogF(ERROR, "ERROR: \n%s\n", e.what());
+      return false;
+    }
+  }
+
+  // process "fields"
+  if (!node.has_path("fields"))
+  {
+    return true;
+  }
+
+  const auto& fields = node["fields"];
+  iter = fields.children();
+  while (iter.has_next())
+  {
+    auto& fieldNode = iter.next();
+    const auto fieldname = iter.name();
+    try
+    {
+      auto dataset = datasets.at(fieldNode["topology"].as_string());
+      const auto vtk_association = GetAssociation(fieldNode["association"].as_string());
+      auto dsa = dataset->GetAttributes(vtk_association);
+      auto array = vtkConduitArrayUtilities::MCArrayToVTKArray(&fieldNode["values"], fieldname);
+      if (array->GetNumberOfTuples() != dataset->GetNumberOfElements(vtk_association))
+      {
+        throw std::runtime_error("mismatched tuple count!");
+      }
+      dsa->AddArray(array);
+    }
+    catch (std::exception& e)
+    {
+      vtkLogF(ERROR, "failed to process '../fields/%s'.", fieldname.c_str());
+      vtkLogF(ERROR, "ERROR: \n%s\n", e.what());
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace internals
 
 class vtkConduitSource::vtkInternals
@@ -277,64 +597,21 @@ int vtkConduitSource::RequestData(
     return 0;
   }
 
-  std::map<std::string, vtkSmartPointer<vtkDataSet> > datasets;
-
-  // process "topologies".
-  auto& topologies = node["topologies"];
-  auto iter = topologies.children();
-  while (iter.has_next())
+  // a multi-domain mesh is a list (or object) of single-domain meshes; each
+  // domain adds a partition per topology.
+  if (conduit::blueprint::mesh::is_multi_domain(node))
   {
-    iter.next();
-    try
+    auto iter = node.children();
+    while (iter.has_next())
     {
-      if (auto ds = internals::GetMesh(iter.node(), node["coordsets"]))
+      if (!internals::AddDomain(iter.next(), output))
       {
-        auto idx = output->GetNumberOfPartitions();
-        output->SetPartition(idx, ds);
-        output->GetMetaData(idx)->Set(vtkCompositeDataSet::NAME(), iter.name().c_str());
-        datasets[iter.name()] = ds;
+        return 0;
       }
     }
-    catch (std::exception& e)
-    {
-      vtkLogF(ERROR, "failed to process '../topologies/%s'.", iter.name().c_str());
-      vtkLogF(ERROR, "ERROR: \n%s\n", e.what());
-      return 0;
-    }
-  }
-
-  // process "fields"
-  if (!node.has_path("fields"))
-  {
     return 1;
   }
-
-  auto& fields = node["fields"];
-  iter = fields.children();
-  while (iter.has_next())
-  {
-    auto& fieldNode = iter.next();
-    const auto fieldname = iter.name();
-    try
-    {
-      auto dataset = datasets.at(fieldNode["topology"].as_string());
-      const auto vtk_association = internals::GetAssociation(fieldNode["association"].as_string());
-      auto dsa = dataset->GetAttributes(vtk_association);
-      auto array = vtkConduitArrayUtilities::MCArrayToVTKArray(&fieldNode["values"], fieldname);
-      if (array->GetNumberOfTuples() != dataset->GetNumberOfElements(vtk_association))
-      {
-        throw std::runtime_error("mismatched tuple count!");
-      }
-      dsa->AddArray(array);
-    }
-    catch (std::exception& e)
-    {
-      vtkLogF(ERROR, "failed to process '../fields/%s'.", fieldname.c_str());
-      vtkLogF(ERROR, "ERROR: \n%s\n", e.what());
-      return 0;
-    }
-  }
-  return 1;
+  return internals::AddDomain(node, output) ? 1 : 0;
 }
 
 //----------------------------------------------------------------------------
@@ -23,7 +23,15 @@
  * to describe computational mesh and associated meta-data.
  *
  * vtkConduitSource currently produces a `vtkParitionedDataSet`. This makes it
- * easier to support mesh definitions with sub-domains.
+ * easier to support mesh definitions with sub-domains. Multi-domain meshes
+ * add a partition per topology for each domain.
+ *
+ * Unstructured topologies may use any single shape, including "polygonal", as
+ * well as "mixed" (`shape_map`, `shapes`, `sizes`, `offsets`) and "polyhedral"
+ * (polygonal `subelements`) shapes. Arrays are shared with the Conduit node
+ * whenever their layout allows; otherwise they are deep-copied and the bytes
+ * copied are logged using `PARAVIEW_LOG_CATALYST_VERBOSITY()`. Polyhedral
+ * topologies are always deep-copied since VTK needs a face stream.
  *
  * @sa vtkConduitArrayUtilities
  */
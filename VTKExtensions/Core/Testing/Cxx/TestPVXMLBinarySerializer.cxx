@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVXMLBinarySerializer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVXMLBinarySerializer.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+
+#include <string>
+#include <vector>
+
+int TestPVXMLBinarySerializer(int, char* [])
+{
+  const char* xml = "<ServerManagerConfiguration>"
+                    "  <ProxyGroup name=\"sources\">"
+                    "    <SourceProxy name=\"Sphere\" class=\"vtkSphereSource\">"
+                    "      <DoubleVectorProperty name=\"Radius\" command=\"SetRadius\""
+                    "                            number_of_elements=\"1\" default_values=\"0.5\">"
+                    "        <DoubleRangeDomain name=\"range\" min=\"0\" />"
+                    "      </DoubleVectorProperty>"
+                    "      <Documentation>Creates a &lt;sphere&gt;.</Documentation>"
+                    "    </SourceProxy>"
+                    "  </ProxyGroup>"
+                    "</ServerManagerConfiguration>";
+
+  auto root = vtkPVXMLParser::ParseXML(xml);
+  if (!root)
+  {
+    cerr << "ERROR: failed to parse the XML." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<char> buffer;
+  if (!vtkPVXMLBinarySerializer::Serialize(root, buffer) || buffer.empty())
+  {
+    cerr << "ERROR: failed to serialize the XML." << endl;
+    return EXIT_FAILURE;
+  }
+
+  auto copy = vtkPVXMLBinarySerializer::Deserialize(buffer.data(), buffer.size());
+  if (!copy || !copy->Equals(root))
+  {
+    cerr << "ERROR: deserialized XML does not match the original." << endl;
+    return EXIT_FAILURE;
+  }
+
+  auto proxy = copy->GetNestedElement(0)->GetNestedElement(0);
+  if (std::string(proxy->GetName()) != "SourceProxy" ||
+    std::string(proxy->GetId()) != root->GetNestedElement(0)->GetNestedElement(0)->GetId())
+  {
+    cerr << "ERROR: unexpected name or id for the deserialized proxy element." << endl;
+    return EXIT_FAILURE;
+  }
+  if (proxy->GetNumberOfAttributes() != 2 || std::string(proxy->GetAttributeName(1)) != "class" ||
+    std::string(proxy->GetAttributeValue(1)) != "vtkSphereSource")
+  {
+    cerr << "ERROR: unexpected attributes for the deserialized proxy element." << endl;
+    return EXIT_FAILURE;
+  }
+  auto doc = proxy->FindNestedElementByName("Documentation");
+  if (!doc || std::string(doc->GetCharacterData()) != "Creates a <sphere>.")
+  {
+    cerr << "ERROR: unexpected character data for the deserialized element." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // truncated or corrupt buffers must be rejected.
+  std::vector<char> corrupt(buffer);
+  corrupt[0] = 'x';
+  if (vtkPVXMLBinarySerializer::Deserialize(buffer.data(), buffer.size() - 1) != nullptr ||
+    vtkPVXMLBinarySerializer::Deserialize(corrupt.data(), corrupt.size()) != nullptr ||
+    vtkPVXMLBinarySerializer::Deserialize(xml, strlen(xml)) != nullptr)
+  {
+    cerr << "ERROR: truncated or corrupt buffer was deserialized." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,364 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLogTimelineRecorder.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLogTimelineRecorder.h"
+
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+enum
+{
+  CLOCK_SYNC_TAG = 78230,
+  CLOCK_OFFSET_TAG = 78231
+};
+
+// number of round trips used to estimate the clock offset of each rank. The
+// sample with the shortest round trip is the most accurate one.
+const int NumberOfClockSamples = 8;
+
+// microseconds on a monotonic clock.
+double Now()
+{
+  using namespace std::chrono;
+  return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+}
+
+std::string EscapeJSON(const std::string& str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+          result += buffer;
+        }
+        else
+        {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+}
+
+class vtkLogTimelineRecorder::vtkInternals
+{
+public:
+  struct Event
+  {
+    char Phase; // 'B'egin, 'E'nd or 'i'nstant.
+    double Time;
+    unsigned int Thread;
+    std::string Name;
+  };
+
+  std::mutex Mutex;
+  std::vector<Event> Events;
+  std::map<std::thread::id, unsigned int> ThreadIndices;
+  std::vector<std::string> ThreadNames;
+  std::vector<int> ThreadDepths;
+  std::string CallbackName;
+
+  static void OnMessage(void* userData, const vtkLogger::Message& message)
+  {
+    auto self = reinterpret_cast<vtkInternals*>(userData);
+    const double now = Now();
+
+    Event event;
+    event.Time = now;
+    if (message.prefix && strcmp(message.prefix, "{ ") == 0)
+    {
+      event.Phase = 'B';
+      event.Name = message.message ? message.message : "";
+    }
+    else if (message.prefix && strcmp(message.prefix, "} ") == 0)
+    {
+      event.Phase = 'E';
+    }
+    else
+    {
+      event.Phase = 'i';
+      event.Name = message.message ? message.message : "";
+    }
+
+    std::lock_guard<std::mutex> lock(self->Mutex);
+    const auto tid = std::this_thread::get_id();
+    auto iter = self->ThreadIndices.find(tid);
+    if (iter == self->ThreadIndices.end())
+    {
+      const unsigned int index = static_cast<unsigned int>(self->ThreadNames.size());
+      iter = self->ThreadIndices.insert(std::make_pair(tid, index)).first;
+      self->ThreadNames.push_back(vtkLogger::GetThreadName());
+      self->ThreadDepths.push_back(0);
+    }
+    event.Thread = iter->second;
+
+    // skip ends of scopes that were entered before recording started.
+    int& depth = self->ThreadDepths[event.Thread];
+    if (event.Phase == 'B')
+    {
+      ++depth;
+    }
+    else if (event.Phase == 'E')
+    {
+      if (depth == 0)
+      {
+        return;
+      }
+      --depth;
+    }
+    self->Events.push_back(std::move(event));
+  }
+
+  // Returns the events as a comma separated list of JSON objects. `offset` is
+  // subtracted from all timestamps.
+  std::string GetEventsAsJSON(int rank, double offset)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::ostringstream json;
+    json.precision(3);
+    json << std::fixed;
+    json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+         << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+    json << ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" << rank
+         << ",\"args\":{\"sort_index\":" << rank << "}}";
+    for (size_t cc = 0; cc < this->ThreadNames.size(); ++cc)
+    {
+      json << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":" << cc
+           << ",\"args\":{\"name\":\"" << EscapeJSON(this->ThreadNames[cc]) << "\"}}";
+    }
+    for (const auto& event : this->Events)
+    {
+      json << ",\n{\"ph\":\"" << event.Phase << "\",\"pid\":" << rank << ",\"tid\":" << event.Thread
+           << ",\"ts\":" << (event.Time - offset);
+      if (event.Phase != 'E')
+      {
+        json << ",\"name\":\"" << EscapeJSON(event.Name) << "\",\"cat\":\"paraview\"";
+      }
+      if (event.Phase == 'i')
+      {
+        json << ",\"s\":\"t\"";
+      }
+      json << "}";
+    }
+    return json.str();
+  }
+};
+
+vtkStandardNewMacro(vtkLogTimelineRecorder);
+vtkCxxSetObjectMacro(vtkLogTimelineRecorder, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkLogTimelineRecorder::vtkLogTimelineRecorder()
+  : Verbosity(vtkLogger::VERBOSITY_INVALID)
+  , Controller(nullptr)
+  , FileName(nullptr)
+  , Internals(new vtkLogTimelineRecorder::vtkInternals())
+{
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkLogTimelineRecorder::~vtkLogTimelineRecorder()
+{
+  if (!this->Internals->CallbackName.empty())
+  {
+    vtkLogger::RemoveCallback(this->Internals->CallbackName.c_str());
+  }
+  this->SetController(nullptr);
+  this->SetFileName(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTimelineRecorder::SetVerbosity(int verbosity)
+{
+  if (this->Verbosity == verbosity)
+  {
+    return;
+  }
+
+  this->Verbosity = verbosity;
+  auto& internals = (*this->Internals);
+  if (!internals.CallbackName.empty())
+  {
+    vtkLogger::RemoveCallback(internals.CallbackName.c_str());
+    internals.CallbackName.clear();
+  }
+
+  if (verbosity > vtkLogger::VERBOSITY_INVALID && verbosity <= vtkLogger::VERBOSITY_MAX)
+  {
+    std::ostringstream name;
+    name << "log-timeline_" << this;
+    internals.CallbackName = name.str();
+    vtkLogger::AddCallback(internals.CallbackName.c_str(), &vtkInternals::OnMessage,
+      this->Internals, static_cast<vtkLogger::Verbosity>(verbosity));
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLogTimelineRecorder::GetNumberOfEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkIdType>(this->Internals->Events.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTimelineRecorder::ClearEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Events.clear();
+  std::fill(this->Internals->ThreadDepths.begin(), this->Internals->ThreadDepths.end(), 0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkLogTimelineRecorder::Write()
+{
+  auto controller = this->Controller;
+  const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+
+  // Estimate the offset between the clock on this rank and the clock on the
+  // root (Cristian's algorithm). The root pings each rank in turn and keeps
+  // the reply with the shortest round trip.
+  double offset = 0.0;
+  if (numRanks > 1)
+  {
+    if (rank == 0)
+    {
+      for (int cc = 1; cc < numRanks; ++cc)
+      {
+        double bestRoundTrip = -1.0;
+        double bestOffset = 0.0;
+        for (int sample = 0; sample < NumberOfClockSamples; ++sample)
+        {
+          const double t0 = Now();
+          double remote = t0;
+          controller->Send(&remote, 1, cc, CLOCK_SYNC_TAG);
+          controller->Receive(&remote, 1, cc, CLOCK_SYNC_TAG);
+          const double t1 = Now();
+          if (bestRoundTrip < 0 || (t1 - t0) < bestRoundTrip)
+          {
+            bestRoundTrip = t1 - t0;
+            bestOffset = remote - 0.5 * (t0 + t1);
+          }
+        }
+        controller->Send(&bestOffset, 1, cc, CLOCK_OFFSET_TAG);
+      }
+    }
+    else
+    {
+      for (int sample = 0; sample < NumberOfClockSamples; ++sample)
+      {
+        double value;
+        controller->Receive(&value, 1, 0, CLOCK_SYNC_TAG);
+        value = Now();
+        controller->Send(&value, 1, 0, CLOCK_SYNC_TAG);
+      }
+      controller->Receive(&offset, 1, 0, CLOCK_OFFSET_TAG);
+    }
+  }
+
+  const std::string local = this->Internals->GetEventsAsJSON(rank, offset);
+  std::vector<std::string> fragments;
+  if (numRanks > 1)
+  {
+    vtkMultiProcessStream stream;
+    stream << local;
+    std::vector<vtkMultiProcessStream> streams;
+    controller->Gather(stream, streams, 0);
+    for (auto& item : streams)
+    {
+      std::string fragment;
+      item >> fragment;
+      fragments.push_back(std::move(fragment));
+    }
+  }
+  else
+  {
+    fragments.push_back(local);
+  }
+
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  if (this->FileName == nullptr || this->FileName[0] == '\0')
+  {
+    vtkErrorMacro("No filename specified.");
+    return false;
+  }
+
+  std::ofstream file(this->FileName);
+  if (!file)
+  {
+    vtkErrorMacro("Failed to open '" << this->FileName << "' for writing.");
+    return false;
+  }
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (size_t cc = 0; cc < fragments.size(); ++cc)
+  {
+    file << (cc > 0 ? ",\n" : "") << fragments[cc];
+  }
+  file << "\n]}\n";
+  vtkLogF(INFO, "Wrote timeline to '%s'", this->FileName);
+  return file.good();
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTimelineRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Verbosity: " << this->Verbosity << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(nullptr)") << endl;
+}
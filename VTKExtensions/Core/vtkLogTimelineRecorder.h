@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLogTimelineRecorder.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLogTimelineRecorder
+ * @brief   records log scopes as a timeline in Chrome trace event format.
+ *
+ * vtkLogTimelineRecorder listens to vtkLogger messages at or below the
+ * verbosity specified using `SetVerbosity` and records the start and end of
+ * every log scope (e.g. `vtkVLogScopeF`) along with the thread it was
+ * entered on. Plain log messages are recorded as instant events.
+ *
+ * `Write` saves the recorded events as a JSON file using the Chrome trace
+ * event format, which can be loaded in `chrome://tracing` or
+ * [Perfetto](https://ui.perfetto.dev). `Write` is a collective operation on
+ * the controller: events from all ranks are gathered on the root and written
+ * to a single file, with each rank shown as a separate process. Since clocks
+ * are not synchronized across nodes, the root estimates the clock offset of
+ * each rank with a few round-trip messages and shifts that rank's events
+ * onto its own clock.
+ *
+ * Since `vtkLogger` only generates scope messages for scopes at or below the
+ * requested verbosity, the categories of interest must be elevated using
+ * vtkPVLogger, e.g. `vtkPVLogger::SetRenderingVerbosity(vtkLogger::VERBOSITY_INFO)`
+ * or the `PARAVIEW_LOG_RENDERING_VERBOSITY` environment variable.
+ */
+
+#ifndef vtkLogTimelineRecorder_h
+#define vtkLogTimelineRecorder_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkLogTimelineRecorder : public vtkObject
+{
+public:
+  static vtkLogTimelineRecorder* New();
+  vtkTypeMacro(vtkLogTimelineRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the verbosity of the messages to record. Messages and scopes with
+   * verbosity less than or equal to this verbosity are recorded. Set to
+   * `vtkLogger::VERBOSITY_INVALID` (default) to stop recording.
+   */
+  void SetVerbosity(int verbosity);
+  vtkGetMacro(Verbosity, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the controller used to gather events in `Write`. Defaults to the
+   * global controller.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the file to write to.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  /**
+   * Returns the number of events recorded on this process.
+   */
+  vtkIdType GetNumberOfEvents();
+
+  /**
+   * Discard all events recorded on this process.
+   */
+  void ClearEvents();
+
+  /**
+   * Gathers the events recorded on all ranks and writes them to `FileName`
+   * on the root. Must be called on all ranks of the controller. Returns false
+   * if the file could not be written on the root.
+   */
+  bool Write();
+
+protected:
+  vtkLogTimelineRecorder();
+  ~vtkLogTimelineRecorder() override;
+
+  int Verbosity;
+  vtkMultiProcessController* Controller;
+  char* FileName;
+
+private:
+  vtkLogTimelineRecorder(const vtkLogTimelineRecorder&) = delete;
+  void operator=(const vtkLogTimelineRecorder&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
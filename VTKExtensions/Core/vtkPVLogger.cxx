@@ -79,6 +79,7 @@ static const int RenderingVerbosityKey = 4;
 static const int ApplicationVerbosityKey = 5;
 static const int ExecutionVerbosityKey = 6;
 static const int CatalystVerbosityKey = 7;
+static const int StartupVerbosityKey = 8;
 }
 
 //----------------------------------------------------------------------------
@@ -236,6 +237,25 @@ void vtkPVLogger::SetCatalystVerbosity(vtkLogger::Verbosity value)
   }
 }
 
+//----------------------------------------------------------------------------
+vtkLogger::Verbosity vtkPVLogger::GetStartupVerbosity()
+{
+  return get_verbosity(StartupVerbosityKey, "PARAVIEW_LOG_STARTUP_VERBOSITY");
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetStartupVerbosity(vtkLogger::Verbosity value)
+{
+  if (value > vtkLogger::VERBOSITY_INVALID && value <= vtkLogger::VERBOSITY_MAX)
+  {
+    set_verbosity(StartupVerbosityKey, value);
+  }
+  else
+  {
+    vtkLogF(WARNING, "ignoring invalid verbosity %d", value);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVLogger::PrintSelf(ostream& os, vtkIndent indent)
 {
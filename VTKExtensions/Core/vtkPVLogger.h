@@ -145,6 +145,20 @@ public:
   static void SetCatalystVerbosity(vtkLogger::Verbosity value);
   //@}
 
+  //@{
+  /**
+   * Verbosity level for log messages related to application and server
+   * startup, such as loading plugins and proxy definitions. Startup phases
+   * are logged as scopes so that the time spent in each phase is reported.
+   *
+   * Default level is `vtkLogger::VERBOSITY_TRACE` unless overridden by calling
+   * `SetStartupVerbosity` or by setting the environment variable
+   * `PARAVIEW_LOG_STARTUP_VERBOSITY` to the expected verbosity level.
+   */
+  static vtkLogger::Verbosity GetStartupVerbosity();
+  static void SetStartupVerbosity(vtkLogger::Verbosity value);
+  //@}
+
   //@{
   /**
    * Change default verbosity to use for all ParaView categories defined here if
@@ -235,4 +249,14 @@ private:
  * @endcode
  */
 #define PARAVIEW_LOG_CATALYST_VERBOSITY() vtkPVLogger::GetCatalystVerbosity()
+
+/**
+ * Macro to use for verbosity when logging startup messages. Same as calling
+ * vtkPVLogger::GetStartupVerbosity() e.g.
+ *
+ * @code{cpp}
+ *  vtkVLogScopeF(PARAVIEW_LOG_STARTUP_VERBOSITY(), "load plugins");
+ * @endcode
+ */
+#define PARAVIEW_LOG_STARTUP_VERBOSITY() vtkPVLogger::GetStartupVerbosity()
 #endif
@@ -0,0 +1,325 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinarySerializer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVXMLBinarySerializer.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkPVXMLElement.h"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+const char Signature[8] = { 'v', 't', 'k', 'P', 'V', 'X', 'B', '1' };
+const vtkTypeUInt32 FormatVersion = 1;
+const vtkTypeUInt32 ByteOrderMark = 0x01020304;
+
+// index used for null strings.
+const vtkTypeUInt32 NullString = 0xffffffff;
+
+// elements are never nested this deep in practice; this only protects
+// against corrupt buffers.
+const int MaximumDepth = 512;
+
+struct Header
+{
+  char Signature[8];
+  vtkTypeUInt32 ByteOrder;
+  vtkTypeUInt32 Version;
+  vtkTypeUInt32 NumberOfStrings;
+  vtkTypeUInt32 NumberOfElements;
+};
+
+class Writer
+{
+public:
+  std::vector<char>& Buffer;
+  std::vector<vtkTypeUInt32> Records;
+  std::vector<const char*> Strings;
+  std::unordered_map<std::string, vtkTypeUInt32> StringIndices;
+  vtkTypeUInt32 NumberOfElements = 0;
+
+  Writer(std::vector<char>& buffer)
+    : Buffer(buffer)
+  {
+  }
+
+  vtkTypeUInt32 GetStringIndex(const char* str)
+  {
+    if (str == nullptr)
+    {
+      return NullString;
+    }
+    const vtkTypeUInt32 next = static_cast<vtkTypeUInt32>(this->Strings.size());
+    auto result = this->StringIndices.emplace(str, next);
+    if (result.second)
+    {
+      this->Strings.push_back(result.first->first.c_str());
+    }
+    return result.first->second;
+  }
+
+  void Add(vtkPVXMLElement* element)
+  {
+    ++this->NumberOfElements;
+    this->Records.push_back(this->GetStringIndex(element->GetName()));
+    this->Records.push_back(this->GetStringIndex(element->GetId()));
+    this->Records.push_back(this->GetStringIndex(element->GetCharacterData()));
+
+    const unsigned int numAttributes = element->GetNumberOfAttributes();
+    this->Records.push_back(numAttributes);
+    for (unsigned int cc = 0; cc < numAttributes; ++cc)
+    {
+      this->Records.push_back(this->GetStringIndex(element->GetAttributeName(cc)));
+      this->Records.push_back(this->GetStringIndex(element->GetAttributeValue(cc)));
+    }
+
+    const unsigned int numChildren = element->GetNumberOfNestedElements();
+    this->Records.push_back(numChildren);
+    for (unsigned int cc = 0; cc < numChildren; ++cc)
+    {
+      this->Add(element->GetNestedElement(cc));
+    }
+  }
+
+  void Append(const void* data, size_t length)
+  {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    this->Buffer.insert(this->Buffer.end(), bytes, bytes + length);
+  }
+
+  void Finalize()
+  {
+    Header header;
+    memcpy(header.Signature, Signature, sizeof(Signature));
+    header.ByteOrder = ByteOrderMark;
+    header.Version = FormatVersion;
+    header.NumberOfStrings = static_cast<vtkTypeUInt32>(this->Strings.size());
+    header.NumberOfElements = this->NumberOfElements;
+
+    size_t total = sizeof(Header) + this->Records.size() * sizeof(vtkTypeUInt32);
+    for (const char* str : this->Strings)
+    {
+      total += sizeof(vtkTypeUInt32) + strlen(str);
+    }
+
+    this->Buffer.clear();
+    this->Buffer.reserve(total);
+    this->Append(&header, sizeof(Header));
+    for (const char* str : this->Strings)
+    {
+      const vtkTypeUInt32 length = static_cast<vtkTypeUInt32>(strlen(str));
+      this->Append(&length, sizeof(length));
+      this->Append(str, length);
+    }
+    this->Append(this->Records.data(), this->Records.size() * sizeof(vtkTypeUInt32));
+  }
+};
+
+class Reader
+{
+public:
+  const char* Position;
+  const char* End;
+  std::vector<std::string> Strings;
+
+  Reader(const char* buffer, size_t length)
+    : Position(buffer)
+    , End(buffer + length)
+  {
+  }
+
+  bool Read(void* data, size_t length)
+  {
+    if (static_cast<size_t>(this->End - this->Position) < length)
+    {
+      return false;
+    }
+    memcpy(data, this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  bool ReadUInt32(vtkTypeUInt32& value) { return this->Read(&value, sizeof(value)); }
+
+  bool ReadString(vtkTypeUInt32& index, const char*& str)
+  {
+    if (!this->ReadUInt32(index))
+    {
+      return false;
+    }
+    if (index == NullString)
+    {
+      str = nullptr;
+      return true;
+    }
+    if (index >= this->Strings.size())
+    {
+      return false;
+    }
+    str = this->Strings[index].c_str();
+    return true;
+  }
+
+  bool ReadStrings(vtkTypeUInt32 count)
+  {
+    this->Strings.resize(count);
+    for (auto& str : this->Strings)
+    {
+      vtkTypeUInt32 length;
+      if (!this->ReadUInt32(length) || static_cast<size_t>(this->End - this->Position) < length)
+      {
+        return false;
+      }
+      str.assign(this->Position, length);
+      this->Position += length;
+    }
+    return true;
+  }
+};
+}
+
+// Needs access to the protected API of vtkPVXMLElement, hence not in the
+// anonymous namespace.
+class vtkPVXMLBinarySerializer::vtkElementReader
+{
+public:
+  static vtkSmartPointer<vtkPVXMLElement> ReadElement(Reader& reader, int depth)
+  {
+    if (depth > MaximumDepth)
+    {
+      return nullptr;
+    }
+
+    vtkTypeUInt32 index;
+    const char *name, *id, *cdata;
+    if (!reader.ReadString(index, name) || !reader.ReadString(index, id) ||
+      !reader.ReadString(index, cdata))
+    {
+      return nullptr;
+    }
+
+    auto element = vtkSmartPointer<vtkPVXMLElement>::New();
+    element->SetName(name);
+    element->SetId(id);
+    if (cdata && cdata[0] != '\0')
+    {
+      element->AddCharacterData(cdata, static_cast<int>(strlen(cdata)));
+    }
+
+    vtkTypeUInt32 numAttributes;
+    if (!reader.ReadUInt32(numAttributes))
+    {
+      return nullptr;
+    }
+    for (vtkTypeUInt32 cc = 0; cc < numAttributes; ++cc)
+    {
+      const char *attrName, *attrValue;
+      if (!reader.ReadString(index, attrName) || !reader.ReadString(index, attrValue) ||
+        attrName == nullptr || attrValue == nullptr)
+      {
+        return nullptr;
+      }
+      element->AddAttribute(attrName, attrValue);
+    }
+
+    vtkTypeUInt32 numChildren;
+    if (!reader.ReadUInt32(numChildren))
+    {
+      return nullptr;
+    }
+    for (vtkTypeUInt32 cc = 0; cc < numChildren; ++cc)
+    {
+      auto child = vtkElementReader::ReadElement(reader, depth + 1);
+      if (!child)
+      {
+        return nullptr;
+      }
+      element->AddNestedElement(child);
+    }
+    return element;
+  }
+};
+
+vtkStandardNewMacro(vtkPVXMLBinarySerializer);
+//----------------------------------------------------------------------------
+vtkPVXMLBinarySerializer::vtkPVXMLBinarySerializer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLBinarySerializer::~vtkPVXMLBinarySerializer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkPVXMLBinarySerializer::GetFormatVersion()
+{
+  return FormatVersion;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVXMLBinarySerializer::Serialize(vtkPVXMLElement* root, std::vector<char>& buffer)
+{
+  if (root == nullptr)
+  {
+    return false;
+  }
+
+  Writer writer(buffer);
+  writer.Add(root);
+  writer.Finalize();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPVXMLElement> vtkPVXMLBinarySerializer::Deserialize(
+  const char* buffer, size_t length)
+{
+  if (buffer == nullptr)
+  {
+    return nullptr;
+  }
+
+  Reader reader(buffer, length);
+  Header header;
+  if (!reader.Read(&header, sizeof(Header)) ||
+    memcmp(header.Signature, Signature, sizeof(Signature)) != 0 ||
+    header.ByteOrder != ByteOrderMark || header.Version != FormatVersion ||
+    header.NumberOfElements == 0)
+  {
+    return nullptr;
+  }
+
+  if (!reader.ReadStrings(header.NumberOfStrings))
+  {
+    return nullptr;
+  }
+
+  auto root = vtkElementReader::ReadElement(reader, 0);
+  if (!root || reader.Position != reader.End)
+  {
+    // either corrupt or trailing garbage.
+    return nullptr;
+  }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLBinarySerializer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
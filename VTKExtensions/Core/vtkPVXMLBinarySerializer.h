@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinarySerializer.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVXMLBinarySerializer
+ * @brief   compact binary encoding for vtkPVXMLElement trees.
+ *
+ * vtkPVXMLBinarySerializer converts a vtkPVXMLElement tree to and from a
+ * compact binary buffer. Rebuilding a tree from that buffer is much cheaper
+ * than parsing the equivalent XML, since there is no tokenization, entity
+ * decoding or attribute splitting to do. This is used to cache parsed
+ * server-manager configuration XMLs (see vtkSIProxyDefinitionManager).
+ *
+ * The buffer is a single contiguous block with no pointers in it. It starts
+ * with a header, followed by a table of unique strings and then the
+ * elements in depth-first order, each referencing the string table by
+ * index. Since the buffer uses the native byte order, the header records
+ * the byte order and the format version. `Deserialize` rejects buffers that
+ * don't match.
+ */
+
+#ifndef vtkPVXMLBinarySerializer_h
+#define vtkPVXMLBinarySerializer_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkSmartPointer.h"              // for vtkSmartPointer
+
+#include <vector> // for std::vector
+
+class vtkPVXMLElement;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVXMLBinarySerializer : public vtkObject
+{
+public:
+  static vtkPVXMLBinarySerializer* New();
+  vtkTypeMacro(vtkPVXMLBinarySerializer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Serialize the tree rooted at `root` into `buffer`. Any existing contents
+   * of `buffer` are replaced. Returns false if `root` is nullptr.
+   */
+  static bool Serialize(vtkPVXMLElement* root, std::vector<char>& buffer);
+
+  /**
+   * Rebuild a tree from a buffer created by `Serialize`. Returns nullptr if
+   * the buffer is truncated, corrupt or was created with an incompatible
+   * format version or byte order.
+   */
+  static vtkSmartPointer<vtkPVXMLElement> Deserialize(const char* buffer, size_t length);
+
+  /**
+   * Version number of the binary format. It is incremented every time the
+   * format changes so that stale buffers can be detected.
+   */
+  static vtkTypeUInt32 GetFormatVersion();
+
+protected:
+  vtkPVXMLBinarySerializer();
+  ~vtkPVXMLBinarySerializer() override;
+
+private:
+  vtkPVXMLBinarySerializer(const vtkPVXMLBinarySerializer&) = delete;
+  void operator=(const vtkPVXMLBinarySerializer&) = delete;
+
+  class vtkElementReader;
+};
+
+#endif
@@ -28,6 +28,7 @@
 #include <string> // for std::string
 
 class vtkCollection;
+class vtkPVXMLBinarySerializer;
 class vtkPVXMLParser;
 
 struct vtkPVXMLElementInternals;
@@ -82,6 +83,16 @@ public:
    */
   const char* GetCharacterData();
 
+  //@{
+  /**
+   * Access the attributes of this element by index, in the order in which
+   * they were added.
+   */
+  unsigned int GetNumberOfAttributes();
+  const char* GetAttributeName(unsigned int index);
+  const char* GetAttributeValue(unsigned int index);
+  //@}
+
   //@{
   /**
    * Get the attribute with the given name converted to a scalar
@@ -285,6 +296,7 @@ protected:
   vtkPVXMLElement* LookupElementUpScope(const char* id);
   void SetParent(vtkPVXMLElement* parent);
 
+  friend class vtkPVXMLBinarySerializer;
   friend class vtkPVXMLParser;
 
 private:
@@ -0,0 +1,318 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVQuerySelector.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVQuerySelector.h"
+#include "vtkPointData.h"
+#include "vtkSelectionNode.h"
+#include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int NumberOfBlocks = 4;
+const char* InsidednessArrayName = "__vtkInsidedness__";
+
+// Each block is a 5x5x5 image. The point array "Pressure" spans
+// [100 * block, 100 * block + 99] so that range based skipping applies.
+// The cell array "Velocity" has 3 components, and "Temperature" is missing
+// on the last block.
+vtkSmartPointer<vtkMultiBlockDataSet> CreateInput()
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(NumberOfBlocks);
+  for (int block = 0; block < NumberOfBlocks; ++block)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(5, 5, 5);
+    image->SetOrigin(4.0 * block, 0, 0);
+
+    vtkNew<vtkDoubleArray> pressure;
+    pressure->SetName("Pressure");
+    pressure->SetNumberOfTuples(image->GetNumberOfPoints());
+    for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+    {
+      pressure->SetValue(cc, 100.0 * block + (cc % 100));
+    }
+    if (block == 2)
+    {
+      pressure->SetValue(7, std::numeric_limits<double>::quiet_NaN());
+    }
+    image->GetPointData()->AddArray(pressure);
+
+    vtkNew<vtkFloatArray> velocity;
+    velocity->SetName("Velocity");
+    velocity->SetNumberOfComponents(3);
+    velocity->SetNumberOfTuples(image->GetNumberOfCells());
+    for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+    {
+      velocity->SetTypedComponent(cc, 0, static_cast<float>(block));
+      velocity->SetTypedComponent(cc, 1, 0.25f * (cc % 4));
+      velocity->SetTypedComponent(cc, 2, -1.0f * (cc % 3));
+    }
+    image->GetCellData()->AddArray(velocity);
+
+    if (block < NumberOfBlocks - 1)
+    {
+      vtkNew<vtkIntArray> temperature;
+      temperature->SetName("Temperature (K)");
+      temperature->SetNumberOfTuples(image->GetNumberOfCells());
+      for (vtkIdType cc = 0; cc < image->GetNumberOfCells(); ++cc)
+      {
+        temperature->SetValue(cc, static_cast<int>(cc % 7));
+      }
+      image->GetCellData()->AddArray(temperature);
+    }
+    mb->SetBlock(block, image);
+  }
+  return mb;
+}
+
+double Pressure(vtkImageData* image, vtkIdType id)
+{
+  return image->GetPointData()->GetArray("Pressure")->GetComponent(id, 0);
+}
+
+double Velocity(vtkImageData* image, vtkIdType id, int comp)
+{
+  return image->GetCellData()->GetArray("Velocity")->GetComponent(id, comp);
+}
+
+double VelocityMagnitude(vtkImageData* image, vtkIdType id)
+{
+  double sum = 0.0;
+  for (int comp = 0; comp < 3; ++comp)
+  {
+    sum += Velocity(image, id, comp) * Velocity(image, id, comp);
+  }
+  return std::sqrt(sum);
+}
+
+using Predicate = std::function<bool(vtkImageData*, vtkIdType)>;
+
+class ErrorObserver : public vtkCommand
+{
+public:
+  static ErrorObserver* New() { return new ErrorObserver; }
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->NumberOfErrors; }
+  int NumberOfErrors = 0;
+};
+
+// Runs `query` with the selector and compares the selected elements of each
+// block with `expected`, i.e. what the Python query would select.
+bool TestQuery(vtkMultiBlockDataSet* input, int fieldType, const char* query,
+  const Predicate& expected, int expectedSkippedBlocks, bool inverse = false)
+{
+  vtkNew<vtkSelectionNode> node;
+  node->SetContentType(vtkSelectionNode::QUERY);
+  node->SetFieldType(fieldType);
+  node->SetQueryString(query);
+  if (inverse)
+  {
+    node->GetProperties()->Set(vtkSelectionNode::INVERSE(), 1);
+  }
+
+  vtkNew<vtkPVQuerySelector> selector;
+  selector->SetInsidednessArrayName(InsidednessArrayName);
+  selector->Initialize(node);
+  if (!selector->GetQueryCompiled())
+  {
+    cerr << "Query '" << query << "' was not compiled." << endl;
+    return false;
+  }
+
+  vtkNew<vtkMultiBlockDataSet> output;
+  output->SetNumberOfBlocks(input->GetNumberOfBlocks());
+  for (unsigned int block = 0; block < input->GetNumberOfBlocks(); ++block)
+  {
+    vtkNew<vtkImageData> copy;
+    copy->ShallowCopy(input->GetBlock(block));
+    output->SetBlock(block, copy);
+  }
+  selector->Execute(input, output);
+
+  const int attributeType =
+    fieldType == vtkSelectionNode::POINT ? vtkDataObject::POINT : vtkDataObject::CELL;
+  for (unsigned int block = 0; block < input->GetNumberOfBlocks(); ++block)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(input->GetBlock(block));
+    vtkSignedCharArray* inside = vtkSignedCharArray::SafeDownCast(
+      output->GetBlock(block)->GetAttributes(attributeType)->GetArray(InsidednessArrayName));
+    const vtkIdType numElements = image->GetNumberOfElements(attributeType);
+    if (!inside || inside->GetNumberOfTuples() != numElements)
+    {
+      cerr << "Query '" << query << "': missing insidedness array on block " << block << endl;
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < numElements; ++cc)
+    {
+      const bool selected = expected(image, cc) != inverse;
+      if ((inside->GetValue(cc) != 0) != selected)
+      {
+        cerr << "Query '" << query << "': element " << cc << " of block " << block
+             << " should " << (selected ? "" : "not ") << "be selected." << endl;
+        return false;
+      }
+    }
+  }
+
+  if (selector->GetNumberOfSkippedBlocks() != expectedSkippedBlocks)
+  {
+    cerr << "Query '" << query << "': expected " << expectedSkippedBlocks
+         << " skipped blocks, got " << selector->GetNumberOfSkippedBlocks() << endl;
+    return false;
+  }
+  return true;
+}
+
+// Checks that `query` is not compiled and, without fallback selector, that
+// executing it reports an error.
+bool TestUnsupportedQuery(vtkMultiBlockDataSet* input, const char* query)
+{
+  vtkNew<vtkSelectionNode> node;
+  node->SetContentType(vtkSelectionNode::QUERY);
+  node->SetFieldType(vtkSelectionNode::POINT);
+  node->SetQueryString(query);
+
+  vtkNew<vtkPVQuerySelector> selector;
+  selector->SetInsidednessArrayName(InsidednessArrayName);
+  selector->Initialize(node);
+  if (selector->GetQueryCompiled())
+  {
+    cerr << "Query '" << query << "' should not be compiled." << endl;
+    return false;
+  }
+
+  vtkNew<ErrorObserver> observer;
+  selector->AddObserver(vtkCommand::ErrorEvent, observer);
+  vtkNew<vtkMultiBlockDataSet> output;
+  output->CopyStructure(input);
+  selector->Execute(input, output);
+  if (observer->NumberOfErrors != 1)
+  {
+    cerr << "Query '" << query << "' should report an error without fallback selector." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVQuerySelector(int, char*[])
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> input = CreateInput();
+  const int POINT = vtkSelectionNode::POINT;
+  const int CELL = vtkSelectionNode::CELL;
+
+  // Comparisons on point data.
+  expect(TestQuery(input, POINT, "Pressure >= 250",
+           [](vtkImageData* image, vtkIdType id) { return Pressure(image, id) >= 250; }, 2),
+    "'>=' failed.");
+  expect(TestQuery(input, POINT, "Pressure == 342",
+           [](vtkImageData* image, vtkIdType id) { return Pressure(image, id) == 342; }, 3),
+    "'==' failed.");
+  expect(TestQuery(input, POINT, "Pressure != 5",
+           [](vtkImageData* image, vtkIdType id) { return !(Pressure(image, id) == 5); }, 0),
+    "'!=' failed.");
+
+  // "is between" and "is one of" as generated by the Find Data panel.
+  expect(TestQuery(input, POINT, "(Pressure > 110) & (Pressure < 140)",
+           [](vtkImageData* image, vtkIdType id) {
+             return Pressure(image, id) > 110 && Pressure(image, id) < 140;
+           },
+           3),
+    "in range failed.");
+  expect(TestQuery(input, POINT, "(Pressure == 5) | (Pressure == 305)",
+           [](vtkImageData* image, vtkIdType id) {
+             return Pressure(image, id) == 5 || Pressure(image, id) == 305;
+           },
+           2),
+    "'|' failed.");
+  expect(TestQuery(input, POINT, "in1d(Pressure, [3, 120, 399])",
+           [](vtkImageData* image, vtkIdType id) {
+             const double p = Pressure(image, id);
+             return p == 3 || p == 120 || p == 399;
+           },
+           1),
+    "in1d failed.");
+  expect(TestQuery(input, POINT, "~(Pressure < 300) & (id < 10)",
+           [](vtkImageData* image, vtkIdType id) {
+             return !(Pressure(image, id) < 300) && id < 10;
+           },
+           0),
+    "'~' failed.");
+  expect(TestQuery(input, POINT, "isnan(Pressure)",
+           [](vtkImageData* image, vtkIdType id) { return std::isnan(Pressure(image, id)); }, 0),
+    "isnan failed.");
+
+  // Skipped blocks are selected when the selection is inverted.
+  expect(TestQuery(input, POINT, "Pressure >= 250",
+           [](vtkImageData* image, vtkIdType id) { return Pressure(image, id) >= 250; }, 2, true),
+    "inverse selection failed.");
+
+  // Multi-component and magnitude on cell data.
+  expect(TestQuery(input, CELL, "Velocity[:,0] >= 2",
+           [](vtkImageData* image, vtkIdType id) { return Velocity(image, id, 0) >= 2; }, 2),
+    "component query failed.");
+  expect(TestQuery(input, CELL, "(Velocity[:,1] <= 0.25) & (Velocity[:,2] == -2)",
+           [](vtkImageData* image, vtkIdType id) {
+             return Velocity(image, id, 1) <= 0.25 && Velocity(image, id, 2) == -2;
+           },
+           0),
+    "multiple component query failed.");
+  expect(TestQuery(input, CELL, "mag(Velocity) > 3",
+           [](vtkImageData* image, vtkIdType id) { return VelocityMagnitude(image, id) > 3; }, 3),
+    "magnitude query failed.");
+
+  // Names are sanitized the same way as in Python, missing arrays select
+  // nothing in the block.
+  expect(TestQuery(input, CELL, "TemperatureK == 4",
+           [](vtkImageData* image, vtkIdType id) {
+             vtkDataArray* array = image->GetCellData()->GetArray("Temperature (K)");
+             return array && array->GetComponent(id, 0) == 4;
+           },
+           0),
+    "sanitized name query failed.");
+
+  // Queries that are malformed or need Python.
+  expect(TestUnsupportedQuery(input, "Pressure >"), "malformed query compiled.");
+  expect(TestUnsupportedQuery(input, "(Pressure > 1"), "unbalanced query compiled.");
+  expect(TestUnsupportedQuery(input, "Pressure > 1 && Pressure < 5"), "'&&' query compiled.");
+  expect(TestUnsupportedQuery(input, "1 < Pressure < 5"), "chained comparison compiled.");
+  expect(TestUnsupportedQuery(input, "Pressure == max(Pressure)"), "max() query compiled.");
+  expect(TestUnsupportedQuery(input, "Pressure > 1j"), "complex number compiled.");
+  expect(TestUnsupportedQuery(input, "Pr\xc3\xa9ssure > 1"), "non-ASCII name compiled.");
+
+  return EXIT_SUCCESS;
+}
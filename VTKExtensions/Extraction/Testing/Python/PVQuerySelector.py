@@ -0,0 +1,104 @@
+# Compares the selection computed by vtkPVQuerySelector with the one computed
+# by the Python selector for the queries the Find Data panel generates.
+
+from paraview.modules.vtkPVVTKExtensionsExtraction import vtkPVQuerySelector
+from paraview.modules.vtkPVVTKExtensionsExtractionPython import vtkPythonSelector
+from paraview.vtk import vtkDataObject, vtkSelectionNode
+from vtkmodules.vtkCommonCore import vtkDoubleArray, vtkFloatArray, vtkIntArray
+from vtkmodules.vtkCommonDataModel import vtkImageData, vtkMultiBlockDataSet
+
+insidednessArrayName = "__vtkInsidedness__"
+
+def create_input():
+    """Returns 4 blocks with disjoint "Pressure" ranges so that the native
+    selector skips blocks. "Temperature (K)" is missing on the last block."""
+    mb = vtkMultiBlockDataSet()
+    mb.SetNumberOfBlocks(4)
+    for block in range(4):
+        image = vtkImageData()
+        image.SetDimensions(5, 5, 5)
+        image.SetOrigin(4.0 * block, 0, 0)
+
+        pressure = vtkDoubleArray()
+        pressure.SetName("Pressure")
+        pressure.SetNumberOfTuples(image.GetNumberOfPoints())
+        for cc in range(image.GetNumberOfPoints()):
+            pressure.SetValue(cc, 100.0 * block + (cc % 100))
+        if block == 2:
+            pressure.SetValue(7, float("nan"))
+        image.GetPointData().AddArray(pressure)
+
+        velocity = vtkFloatArray()
+        velocity.SetName("Velocity")
+        velocity.SetNumberOfComponents(3)
+        velocity.SetNumberOfTuples(image.GetNumberOfCells())
+        for cc in range(image.GetNumberOfCells()):
+            velocity.SetTuple3(cc, block, 0.25 * (cc % 4), -1.0 * (cc % 3))
+        image.GetCellData().AddArray(velocity)
+
+        if block < 3:
+            temperature = vtkIntArray()
+            temperature.SetName("Temperature (K)")
+            temperature.SetNumberOfTuples(image.GetNumberOfCells())
+            for cc in range(image.GetNumberOfCells()):
+                temperature.SetValue(cc, cc % 7)
+            image.GetCellData().AddArray(temperature)
+        mb.SetBlock(block, image)
+    return mb
+
+def select(selector, node, dataset):
+    """Returns the selected element ids of each block."""
+    output = vtkMultiBlockDataSet()
+    output.SetNumberOfBlocks(dataset.GetNumberOfBlocks())
+    for block in range(dataset.GetNumberOfBlocks()):
+        copy = vtkImageData()
+        copy.ShallowCopy(dataset.GetBlock(block))
+        output.SetBlock(block, copy)
+
+    selector.SetInsidednessArrayName(insidednessArrayName)
+    selector.Initialize(node)
+    selector.Execute(dataset, output)
+
+    if node.GetFieldType() == vtkSelectionNode.POINT:
+        attributeType = vtkDataObject.POINT
+    else:
+        attributeType = vtkDataObject.CELL
+    result = []
+    for block in range(output.GetNumberOfBlocks()):
+        # the Python selector adds no array to blocks missing an array.
+        inside = output.GetBlock(block).GetAttributes(attributeType).GetArray(insidednessArrayName)
+        ids = []
+        if inside:
+            ids = [cc for cc in range(inside.GetNumberOfTuples()) if inside.GetValue(cc)]
+        result.append(ids)
+    return result
+
+queries = [
+    (vtkSelectionNode.POINT, "Pressure >= 250"),
+    (vtkSelectionNode.POINT, "Pressure == 342"),
+    (vtkSelectionNode.POINT, "Pressure <= 10"),
+    (vtkSelectionNode.POINT, "(Pressure > 110) & (Pressure < 140)"),
+    (vtkSelectionNode.POINT, "(Pressure == 5) | (Pressure == 305)"),
+    (vtkSelectionNode.POINT, "~(Pressure < 300) & (id < 10)"),
+    (vtkSelectionNode.POINT, "isnan(Pressure)"),
+    (vtkSelectionNode.CELL, "Velocity[:,0] >= 2"),
+    (vtkSelectionNode.CELL, "(Velocity[:,1] <= 0.25) & (Velocity[:,2] == -2)"),
+    (vtkSelectionNode.CELL, "mag(Velocity) > 3"),
+    (vtkSelectionNode.CELL, "TemperatureK == 4"),
+]
+
+dataset = create_input()
+for fieldType, query in queries:
+    node = vtkSelectionNode()
+    node.SetContentType(vtkSelectionNode.QUERY)
+    node.SetFieldType(fieldType)
+    node.SetQueryString(query)
+
+    native = vtkPVQuerySelector()
+    expected = select(vtkPythonSelector(), node, dataset)
+    result = select(native, node, dataset)
+    if not native.GetQueryCompiled():
+        raise RuntimeError("Query '%s' was not compiled." % query)
+    if result != expected:
+        raise RuntimeError("Query '%s' selected %r instead of %r." % (query, result, expected))
+    print("'%s': %d blocks skipped" % (query, native.GetNumberOfSkippedBlocks()))
@@ -28,6 +28,7 @@
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVQuerySelector.h"
 #include "vtkPointData.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
@@ -292,13 +293,13 @@ vtkSmartPointer<vtkSelector> vtkPVExtractSelection::NewSelectionOperator(
 {
   if (type == vtkSelectionNode::QUERY)
   {
-// Return a query operator
+    // Return a query operator. Queries the native selector cannot compile are
+    // evaluated in Python, when available.
+    auto selector = vtkSmartPointer<vtkPVQuerySelector>::New();
 #if VTK_MODULE_ENABLE_ParaView_VTKExtensionsExtractionPython
-    return vtkSmartPointer<vtkPythonSelector>::New();
-#else
-    vtkErrorMacro(<< "vtkSelectionNode::QUERY is supported only when Python is enabled.");
-    return nullptr;
+    selector->SetFallbackSelector(vtkSmartPointer<vtkPythonSelector>::New());
 #endif
+    return selector;
   }
   else
   {
@@ -0,0 +1,1072 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVQuerySelector.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVQuerySelector.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkSMPTools.h"
+#include "vtkSelectionNode.h"
+#include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Number of elements evaluated at once.
+constexpr vtkIdType ChunkSize = 1024;
+
+// Number of elements in a parallel task.
+constexpr vtkIdType TaskSize = 64 * ChunkSize;
+
+//----------------------------------------------------------------------------
+// Same rules as paraview.make_name_valid() used by the Python calculator.
+std::string SanitizeName(const char* name)
+{
+  std::string result;
+  for (size_t cc = 0; name && name[cc]; ++cc)
+  {
+    if (isalnum(static_cast<unsigned char>(name[cc])) || name[cc] == '_')
+    {
+      result += name[cc];
+    }
+  }
+  if (!result.empty() && !isalpha(static_cast<unsigned char>(result[0])))
+  {
+    result = "a" + result;
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+enum CompareOperator
+{
+  EQ,
+  NE,
+  LT,
+  LE,
+  GT,
+  GE
+};
+
+// Component values with a special meaning.
+enum
+{
+  MAGNITUDE = -1,
+  SINGLE_COMPONENT = -2
+};
+
+// A value used in a predicate: a number or an array (component).
+struct Operand
+{
+  bool IsConstant = true;
+  double Value = 0.0;
+
+  // For arrays, index in Program::Arrays.
+  int Slot = -1;
+};
+
+// Array referenced by the query.
+struct ArrayReference
+{
+  std::string Name;
+  int Component = SINGLE_COMPONENT;
+};
+
+struct Node
+{
+  enum NodeType
+  {
+    COMPARE,
+    IN_SET,
+    IS_NAN,
+    AND,
+    OR,
+    NOT
+  };
+
+  NodeType Type = COMPARE;
+  int Operator = EQ;
+  Operand Left;
+  Operand Right;
+  std::vector<double> Values; // sorted, for IN_SET
+  std::unique_ptr<Node> A;
+  std::unique_ptr<Node> B;
+};
+
+//----------------------------------------------------------------------------
+// Recursive-descent parser for the subset of the Python calculator syntax
+// supported natively. Operator precedence follows Python: comparisons bind
+// looser than `|`, which binds looser than `&`, which binds looser than `~`.
+// Anything else makes the parse fail so that the query goes to Python.
+class Parser
+{
+public:
+  Parser(const char* text, std::vector<ArrayReference>& arrays)
+    : Text(text)
+    , Pos(0)
+    , Arrays(arrays)
+  {
+  }
+
+  std::unique_ptr<Node> Parse()
+  {
+    Term term;
+    if (!this->ParseComparison(term) || !term.Predicate)
+    {
+      return nullptr;
+    }
+    this->SkipSpaces();
+    if (this->Text[this->Pos] != '\0')
+    {
+      return nullptr;
+    }
+    return std::move(term.Predicate);
+  }
+
+private:
+  // Either a predicate (boolean mask) or an operand.
+  struct Term
+  {
+    std::unique_ptr<Node> Predicate;
+    Operand Value;
+  };
+
+  void SkipSpaces()
+  {
+    while (isspace(static_cast<unsigned char>(this->Text[this->Pos])))
+    {
+      ++this->Pos;
+    }
+  }
+
+  bool Accept(const char* token)
+  {
+    this->SkipSpaces();
+    const size_t len = strlen(token);
+    if (strncmp(this->Text + this->Pos, token, len) == 0)
+    {
+      this->Pos += len;
+      return true;
+    }
+    return false;
+  }
+
+  bool ParseIdentifier(std::string& name)
+  {
+    this->SkipSpaces();
+    const char* start = this->Text + this->Pos;
+    if (!isalpha(static_cast<unsigned char>(*start)) && *start != '_')
+    {
+      return false;
+    }
+    size_t len = 0;
+    while (isalnum(static_cast<unsigned char>(start[len])) || start[len] == '_')
+    {
+      ++len;
+    }
+    name.assign(start, len);
+    this->Pos += len;
+    return true;
+  }
+
+  bool ParseNumber(double& value)
+  {
+    this->SkipSpaces();
+    bool negative = false;
+    if (this->Text[this->Pos] == '-' || this->Text[this->Pos] == '+')
+    {
+      negative = this->Text[this->Pos] == '-';
+      ++this->Pos;
+      this->SkipSpaces();
+    }
+    const char* start = this->Text + this->Pos;
+    if (!isdigit(static_cast<unsigned char>(*start)) &&
+      !(*start == '.' && isdigit(static_cast<unsigned char>(start[1]))))
+    {
+      return false;
+    }
+    char* end = nullptr;
+    value = strtod(start, &end);
+    // reject suffixes such as complex numbers (`1j`) or attributes.
+    if (end == start || isalpha(static_cast<unsigned char>(*end)) || *end == '_' || *end == '.')
+    {
+      return false;
+    }
+    this->Pos += end - start;
+    value = negative ? -value : value;
+    return true;
+  }
+
+  bool ParseCompareOperator(int& op)
+  {
+    this->SkipSpaces();
+    static const std::pair<const char*, int> operators[] = { { "==", EQ }, { "!=", NE },
+      { "<=", LE }, { ">=", GE }, { "<", LT }, { ">", GT } };
+    for (const auto& candidate : operators)
+    {
+      if (this->Accept(candidate.first))
+      {
+        op = candidate.second;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ParseComparison(Term& result)
+  {
+    Term lhs;
+    if (!this->ParseOr(lhs))
+    {
+      return false;
+    }
+    int op;
+    if (!this->ParseCompareOperator(op))
+    {
+      result = std::move(lhs);
+      return true;
+    }
+    Term rhs;
+    if (!this->ParseOr(rhs) || lhs.Predicate || rhs.Predicate ||
+      (lhs.Value.IsConstant && rhs.Value.IsConstant))
+    {
+      return false;
+    }
+    int chained;
+    if (this->ParseCompareOperator(chained))
+    {
+      // chained comparisons are ambiguous on arrays.
+      return false;
+    }
+    result.Predicate.reset(new Node());
+    result.Predicate->Type = Node::COMPARE;
+    result.Predicate->Operator = op;
+    result.Predicate->Left = lhs.Value;
+    result.Predicate->Right = rhs.Value;
+    return true;
+  }
+
+  bool ParseOr(Term& result)
+  {
+    if (!this->ParseAnd(result))
+    {
+      return false;
+    }
+    while (this->Accept("|"))
+    {
+      Term rhs;
+      if (!this->ParseAnd(rhs) || !result.Predicate || !rhs.Predicate)
+      {
+        return false;
+      }
+      std::unique_ptr<Node> node(new Node());
+      node->Type = Node::OR;
+      node->A = std::move(result.Predicate);
+      node->B = std::move(rhs.Predicate);
+      result.Predicate = std::move(node);
+    }
+    return true;
+  }
+
+  bool ParseAnd(Term& result)
+  {
+    if (!this->ParseUnary(result))
+    {
+      return false;
+    }
+    while (this->Accept("&"))
+    {
+      Term rhs;
+      if (!this->ParseUnary(rhs) || !result.Predicate || !rhs.Predicate)
+      {
+        return false;
+      }
+      std::unique_ptr<Node> node(new Node());
+      node->Type = Node::AND;
+      node->A = std::move(result.Predicate);
+      node->B = std::move(rhs.Predicate);
+      result.Predicate = std::move(node);
+    }
+    return true;
+  }
+
+  bool ParseUnary(Term& result)
+  {
+    if (this->Accept("~"))
+    {
+      Term operand;
+      if (!this->ParseUnary(operand) || !operand.Predicate)
+      {
+        return false;
+      }
+      result.Predicate.reset(new Node());
+      result.Predicate->Type = Node::NOT;
+      result.Predicate->A = std::move(operand.Predicate);
+      return true;
+    }
+    return this->ParsePrimary(result);
+  }
+
+  bool ParseArray(Operand& operand)
+  {
+    std::string name;
+    if (!this->ParseIdentifier(name) || this->IsReserved(name))
+    {
+      return false;
+    }
+    ArrayReference ref;
+    ref.Name = name;
+    if (this->Accept("["))
+    {
+      double comp;
+      if (!this->Accept(":") || !this->Accept(",") || !this->ParseNumber(comp) ||
+        !this->Accept("]") || comp < 0 || comp != std::floor(comp))
+      {
+        return false;
+      }
+      ref.Component = static_cast<int>(comp);
+    }
+    operand.IsConstant = false;
+    operand.Slot = this->AddArray(ref);
+    return true;
+  }
+
+  bool ParsePrimary(Term& result)
+  {
+    this->SkipSpaces();
+    if (this->Accept("("))
+    {
+      return this->ParseComparison(result) && this->Accept(")");
+    }
+
+    const size_t start = this->Pos;
+    if (this->ParseNumber(result.Value.Value))
+    {
+      result.Value.IsConstant = true;
+      return true;
+    }
+    this->Pos = start;
+
+    std::string name;
+    if (!this->ParseIdentifier(name))
+    {
+      return false;
+    }
+    if (!this->Accept("("))
+    {
+      this->Pos = start;
+      return this->ParseArray(result.Value);
+    }
+
+    if (name == "mag")
+    {
+      std::string arrayName;
+      if (!this->ParseIdentifier(arrayName) || this->IsReserved(arrayName) || !this->Accept(")"))
+      {
+        return false;
+      }
+      ArrayReference ref;
+      ref.Name = arrayName;
+      ref.Component = MAGNITUDE;
+      result.Value.IsConstant = false;
+      result.Value.Slot = this->AddArray(ref);
+      return true;
+    }
+    if (name == "isnan")
+    {
+      Term arg;
+      if (!this->ParseOr(arg) || arg.Predicate || arg.Value.IsConstant || !this->Accept(")"))
+      {
+        return false;
+      }
+      result.Predicate.reset(new Node());
+      result.Predicate->Type = Node::IS_NAN;
+      result.Predicate->Left = arg.Value;
+      return true;
+    }
+    if (name == "in1d" || name == "isin")
+    {
+      Term arg;
+      if (!this->ParseOr(arg) || arg.Predicate || arg.Value.IsConstant || !this->Accept(",") ||
+        !this->Accept("["))
+      {
+        return false;
+      }
+      std::vector<double> values;
+      double value;
+      while (this->ParseNumber(value))
+      {
+        values.push_back(value);
+        if (!this->Accept(","))
+        {
+          break;
+        }
+      }
+      if (!this->Accept("]") || !this->Accept(")"))
+      {
+        return false;
+      }
+      std::sort(values.begin(), values.end());
+      result.Predicate.reset(new Node());
+      result.Predicate->Type = Node::IN_SET;
+      result.Predicate->Left = arg.Value;
+      result.Predicate->Values = std::move(values);
+      return true;
+    }
+    return false;
+  }
+
+  // Names that mean something else to the Python calculator.
+  bool IsReserved(const std::string& name) const
+  {
+    static const std::set<std::string> reserved = { "and", "or", "not", "in", "is", "if", "else",
+      "for", "lambda", "None", "True", "False", "points", "inputs", "pi", "e", "inf", "nan", "np",
+      "numpy" };
+    return reserved.find(name) != reserved.end();
+  }
+
+  int AddArray(const ArrayReference& ref)
+  {
+    for (size_t cc = 0; cc < this->Arrays.size(); ++cc)
+    {
+      if (this->Arrays[cc].Name == ref.Name && this->Arrays[cc].Component == ref.Component)
+      {
+        return static_cast<int>(cc);
+      }
+    }
+    this->Arrays.push_back(ref);
+    return static_cast<int>(this->Arrays.size() - 1);
+  }
+
+  const char* Text;
+  size_t Pos;
+  std::vector<ArrayReference>& Arrays;
+};
+
+//----------------------------------------------------------------------------
+// An array reference resolved for a given block.
+struct Binding
+{
+  vtkDataArray* Array = nullptr; // nullptr for the element index
+  int Component = 0;
+  double Range[2] = { 0.0, 0.0 };
+};
+
+struct Block
+{
+  vtkIdType NumberOfElements = 0;
+  std::vector<Binding> Bindings;
+  vtkSignedCharArray* Inside = nullptr;
+  bool Evaluate = false;
+};
+
+struct FetchWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, int comp, double* out) const
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    const vtkIdType count = end - begin;
+    if (comp == MAGNITUDE)
+    {
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        double sum = 0.0;
+        for (const auto value : tuples[t])
+        {
+          sum += static_cast<double>(value) * static_cast<double>(value);
+        }
+        out[t] = std::sqrt(sum);
+      }
+    }
+    else
+    {
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        out[t] = static_cast<double>(tuples[t][comp]);
+      }
+    }
+  }
+};
+
+void Fetch(const Operand& operand, const Block& block, vtkIdType begin, vtkIdType end, double* out)
+{
+  const vtkIdType count = end - begin;
+  if (operand.IsConstant)
+  {
+    std::fill(out, out + count, operand.Value);
+    return;
+  }
+  const Binding& binding = block.Bindings[operand.Slot];
+  if (!binding.Array)
+  {
+    for (vtkIdType t = 0; t < count; ++t)
+    {
+      out[t] = static_cast<double>(begin + t);
+    }
+    return;
+  }
+  FetchWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        binding.Array, worker, begin, end, binding.Component, out))
+  {
+    worker(binding.Array, begin, end, binding.Component, out);
+  }
+}
+
+template <typename Op>
+void Compare(const double* a, const double* b, vtkIdType count, unsigned char* mask, Op op)
+{
+  for (vtkIdType t = 0; t < count; ++t)
+  {
+    mask[t] = op(a[t], b[t]) ? 1 : 0;
+  }
+}
+
+// Evaluates `node` on elements [begin, end) of the block.
+void Evaluate(const Node* node, const Block& block, vtkIdType begin, vtkIdType end,
+  unsigned char* mask)
+{
+  const vtkIdType count = end - begin;
+  switch (node->Type)
+  {
+    case Node::COMPARE:
+    {
+      std::vector<double> a(count), b(count);
+      Fetch(node->Left, block, begin, end, a.data());
+      Fetch(node->Right, block, begin, end, b.data());
+      switch (node->Operator)
+      {
+        case EQ:
+          Compare(a.data(), b.data(), count, mask, std::equal_to<double>());
+          break;
+        case NE:
+          Compare(a.data(), b.data(), count, mask, std::not_equal_to<double>());
+          break;
+        case LT:
+          Compare(a.data(), b.data(), count, mask, std::less<double>());
+          break;
+        case LE:
+          Compare(a.data(), b.data(), count, mask, std::less_equal<double>());
+          break;
+        case GT:
+          Compare(a.data(), b.data(), count, mask, std::greater<double>());
+          break;
+        case GE:
+          Compare(a.data(), b.data(), count, mask, std::greater_equal<double>());
+          break;
+      }
+      break;
+    }
+
+    case Node::IN_SET:
+    {
+      std::vector<double> a(count);
+      Fetch(node->Left, block, begin, end, a.data());
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        mask[t] = std::binary_search(node->Values.begin(), node->Values.end(), a[t]) ? 1 : 0;
+      }
+      break;
+    }
+
+    case Node::IS_NAN:
+    {
+      std::vector<double> a(count);
+      Fetch(node->Left, block, begin, end, a.data());
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        mask[t] = std::isnan(a[t]) ? 1 : 0;
+      }
+      break;
+    }
+
+    case Node::AND:
+    case Node::OR:
+    {
+      const bool isAnd = node->Type == Node::AND;
+      Evaluate(node->A.get(), block, begin, end, mask);
+      // skip the second operand when the first one decides the result.
+      const unsigned char decided = isAnd ? 0 : 1;
+      if (std::all_of(mask, mask + count, [decided](unsigned char v) { return v == decided; }))
+      {
+        break;
+      }
+      std::vector<unsigned char> other(count);
+      Evaluate(node->B.get(), block, begin, end, other.data());
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        mask[t] = isAnd ? (mask[t] & other[t]) : (mask[t] | other[t]);
+      }
+      break;
+    }
+
+    case Node::NOT:
+      Evaluate(node->A.get(), block, begin, end, mask);
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        mask[t] = mask[t] ? 0 : 1;
+      }
+      break;
+  }
+}
+
+void OperandRange(const Operand& operand, const Block& block, double range[2])
+{
+  if (operand.IsConstant)
+  {
+    range[0] = range[1] = operand.Value;
+  }
+  else
+  {
+    range[0] = block.Bindings[operand.Slot].Range[0];
+    range[1] = block.Bindings[operand.Slot].Range[1];
+  }
+}
+
+// Returns false when the array ranges show that no element of the block can
+// satisfy `node`. Array ranges ignore NaNs, so this is conservative for
+// predicates NaN values may satisfy.
+bool CanMatch(const Node* node, const Block& block)
+{
+  switch (node->Type)
+  {
+    case Node::COMPARE:
+    {
+      double a[2], b[2];
+      OperandRange(node->Left, block, a);
+      OperandRange(node->Right, block, b);
+      if (std::isnan(a[0]) || std::isnan(a[1]) || std::isnan(b[0]) || std::isnan(b[1]))
+      {
+        return true;
+      }
+      switch (node->Operator)
+      {
+        case EQ:
+          return a[0] <= b[1] && b[0] <= a[1];
+        case LT:
+          return a[0] < b[1];
+        case LE:
+          return a[0] <= b[1];
+        case GT:
+          return a[1] > b[0];
+        case GE:
+          return a[1] >= b[0];
+        default:
+          return true;
+      }
+    }
+
+    case Node::IN_SET:
+    {
+      double a[2];
+      OperandRange(node->Left, block, a);
+      if (std::isnan(a[0]) || std::isnan(a[1]))
+      {
+        return true;
+      }
+      auto iter = std::lower_bound(node->Values.begin(), node->Values.end(), a[0]);
+      return iter != node->Values.end() && *iter <= a[1];
+    }
+
+    case Node::AND:
+      return CanMatch(node->A.get(), block) && CanMatch(node->B.get(), block);
+
+    case Node::OR:
+      return CanMatch(node->A.get(), block) || CanMatch(node->B.get(), block);
+
+    default:
+      return true;
+  }
+}
+
+// Computes the ranges of the arrays used by the query. Each array is handled
+// by a single thread since vtkDataArray::GetRange() caches the range in the
+// array information.
+struct RangeWorker
+{
+  struct Entry
+  {
+    vtkDataArray* Array;
+    std::map<int, std::array<double, 2> > Ranges;
+  };
+  std::vector<Entry>* Entries;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      Entry& entry = (*this->Entries)[cc];
+      for (auto& range : entry.Ranges)
+      {
+        entry.Array->GetRange(range.second.data(), range.first);
+      }
+    }
+  }
+};
+
+struct EvaluateWorker
+{
+  struct Task
+  {
+    size_t BlockIndex;
+    vtkIdType Begin;
+    vtkIdType End;
+  };
+  const Node* Root;
+  const std::vector<Block>* Blocks;
+  const std::vector<Task>* Tasks;
+  bool Inverse;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char> mask(ChunkSize);
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const Task& task = (*this->Tasks)[cc];
+      const Block& block = (*this->Blocks)[task.BlockIndex];
+      signed char* inside = block.Inside->GetPointer(0);
+      for (vtkIdType chunk = task.Begin; chunk < task.End; chunk += ChunkSize)
+      {
+        const vtkIdType chunkEnd = std::min(chunk + ChunkSize, task.End);
+        Evaluate(this->Root, block, chunk, chunkEnd, mask.data());
+        for (vtkIdType t = chunk; t < chunkEnd; ++t)
+        {
+          const bool selected = mask[t - chunk] != 0;
+          inside[t] = (selected != this->Inverse) ? 1 : 0;
+        }
+      }
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkPVQuerySelector::vtkInternals
+{
+public:
+  std::unique_ptr<Node> Root;
+  std::vector<ArrayReference> Arrays;
+  int AttributeType = vtkDataObject::CELL;
+
+  void Compile(vtkSelectionNode* node)
+  {
+    this->Root.reset();
+    this->Arrays.clear();
+    const char* query = node ? node->GetQueryString() : nullptr;
+    if (!query)
+    {
+      return;
+    }
+    switch (node->GetFieldType())
+    {
+      case vtkSelectionNode::CELL:
+        this->AttributeType = vtkDataObject::CELL;
+        break;
+      case vtkSelectionNode::POINT:
+        this->AttributeType = vtkDataObject::POINT;
+        break;
+      case vtkSelectionNode::ROW:
+        this->AttributeType = vtkDataObject::ROW;
+        break;
+      default:
+        return;
+    }
+    Parser parser(query, this->Arrays);
+    this->Root = parser.Parse();
+    if (!this->Root)
+    {
+      this->Arrays.clear();
+    }
+  }
+
+  // Resolves the arrays of the query for `dobj`. Returns false when an array
+  // is missing or cannot be used, in which case nothing is selected in the
+  // block, like the Python path does for arrays missing on a block.
+  bool Bind(vtkDataObject* dobj, Block& block) const
+  {
+    vtkDataSetAttributes* dsa = dobj->GetAttributes(this->AttributeType);
+    if (!dsa)
+    {
+      return false;
+    }
+    std::map<std::string, vtkAbstractArray*> arrays;
+    for (int cc = 0; cc < dsa->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = dsa->GetAbstractArray(cc);
+      if (array && array->GetName())
+      {
+        arrays[SanitizeName(array->GetName())] = array;
+      }
+    }
+
+    block.Bindings.resize(this->Arrays.size());
+    for (size_t cc = 0; cc < this->Arrays.size(); ++cc)
+    {
+      const ArrayReference& ref = this->Arrays[cc];
+      Binding& binding = block.Bindings[cc];
+      auto iter = arrays.find(ref.Name);
+      if (iter == arrays.end())
+      {
+        if (ref.Name != "id" || ref.Component != SINGLE_COMPONENT)
+        {
+          return false;
+        }
+        binding.Array = nullptr;
+        binding.Range[0] = 0;
+        binding.Range[1] = static_cast<double>(block.NumberOfElements - 1);
+        continue;
+      }
+      binding.Array = vtkDataArray::SafeDownCast(iter->second);
+      if (!binding.Array)
+      {
+        return false;
+      }
+      const int numComps = binding.Array->GetNumberOfComponents();
+      if (ref.Component == SINGLE_COMPONENT)
+      {
+        if (numComps != 1)
+        {
+          return false;
+        }
+        binding.Component = 0;
+      }
+      else if (ref.Component >= numComps)
+      {
+        return false;
+      }
+      else
+      {
+        binding.Component = ref.Component;
+      }
+    }
+    return true;
+  }
+};
+
+vtkStandardNewMacro(vtkPVQuerySelector);
+//----------------------------------------------------------------------------
+vtkPVQuerySelector::vtkPVQuerySelector()
+  : UseZoneMaps(true)
+  , NumberOfSkippedBlocks(0)
+  , Internals(new vtkPVQuerySelector::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVQuerySelector::~vtkPVQuerySelector()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVQuerySelector::SetFallbackSelector(vtkSelector* selector)
+{
+  if (this->FallbackSelector != selector)
+  {
+    this->FallbackSelector = selector;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVQuerySelector::GetQueryCompiled() const
+{
+  return this->Internals->Root != nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVQuerySelector::Initialize(vtkSelectionNode* node)
+{
+  this->Superclass::Initialize(node);
+  this->Internals->Compile(node);
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "query '%s' %s",
+    (node && node->GetQueryString()) ? node->GetQueryString() : "",
+    this->Internals->Root ? "compiled" : "not compiled, using fallback selector");
+  if (!this->Internals->Root && this->FallbackSelector)
+  {
+    this->FallbackSelector->Initialize(node);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVQuerySelector::Execute(vtkDataObject* input, vtkDataObject* output)
+{
+  assert(input != nullptr);
+  assert(output != nullptr);
+  assert(this->Node != nullptr);
+
+  auto& internals = *this->Internals;
+  this->NumberOfSkippedBlocks = 0;
+  if (!internals.Root)
+  {
+    if (this->FallbackSelector)
+    {
+      this->FallbackSelector->SetInsidednessArrayName(this->InsidednessArrayName.c_str());
+      this->FallbackSelector->Execute(input, output);
+    }
+    else
+    {
+      vtkErrorMacro("Query '" << (this->Node->GetQueryString() ? this->Node->GetQueryString() : "")
+                              << "' is supported only when Python is enabled.");
+    }
+    return;
+  }
+
+  // Collect the (input, output) leaves.
+  std::vector<std::pair<vtkDataObject*, vtkDataObject*> > leaves;
+  vtkCompositeDataSet* cdInput = vtkCompositeDataSet::SafeDownCast(input);
+  vtkCompositeDataSet* cdOutput = vtkCompositeDataSet::SafeDownCast(output);
+  if (cdInput && cdOutput)
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cdInput->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataObject* outBlock = cdOutput->GetDataSet(iter);
+      if (outBlock)
+      {
+        leaves.push_back(std::make_pair(iter->GetCurrentDataObject(), outBlock));
+      }
+    }
+  }
+  else if (!cdInput && !cdOutput)
+  {
+    leaves.push_back(std::make_pair(input, output));
+  }
+
+  vtkInformation* properties = this->Node->GetProperties();
+  const bool inverse =
+    properties->Has(vtkSelectionNode::INVERSE()) && properties->Get(vtkSelectionNode::INVERSE());
+
+  // Bind arrays and add the insidedness arrays to the output.
+  std::vector<Block> blocks(leaves.size());
+  for (size_t cc = 0; cc < leaves.size(); ++cc)
+  {
+    Block& block = blocks[cc];
+    block.NumberOfElements = leaves[cc].first->GetNumberOfElements(internals.AttributeType);
+    block.Evaluate = internals.Bind(leaves[cc].first, block);
+
+    vtkNew<vtkSignedCharArray> inside;
+    inside->SetName(this->InsidednessArrayName.c_str());
+    inside->SetNumberOfTuples(block.NumberOfElements);
+    if (vtkDataSetAttributes* dsa = leaves[cc].second->GetAttributes(internals.AttributeType))
+    {
+      dsa->AddArray(inside);
+    }
+    block.Inside = inside;
+  }
+
+  // Use the array ranges to skip blocks that cannot match.
+  if (this->UseZoneMaps)
+  {
+    std::vector<RangeWorker::Entry> entries;
+    std::map<vtkDataArray*, size_t> entryIndex;
+    for (const Block& block : blocks)
+    {
+      for (const Binding& binding : block.Bindings)
+      {
+        if (block.Evaluate && binding.Array)
+        {
+          auto iter = entryIndex.find(binding.Array);
+          if (iter == entryIndex.end())
+          {
+            iter = entryIndex.insert(std::make_pair(binding.Array, entries.size())).first;
+            entries.push_back(RangeWorker::Entry{ binding.Array, {} });
+          }
+          // MAGNITUDE is -1, which GetRange() uses for the L2 norm range.
+          entries[iter->second].Ranges[binding.Component] = { { 0.0, 0.0 } };
+        }
+      }
+    }
+    RangeWorker rangeWorker{ &entries };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(entries.size()), 1, rangeWorker);
+
+    for (Block& block : blocks)
+    {
+      for (Binding& binding : block.Bindings)
+      {
+        if (block.Evaluate && binding.Array)
+        {
+          const auto& range = entries[entryIndex[binding.Array]].Ranges[binding.Component];
+          binding.Range[0] = range[0];
+          binding.Range[1] = range[1];
+        }
+      }
+    }
+  }
+
+  std::vector<EvaluateWorker::Task> tasks;
+  for (size_t cc = 0; cc < blocks.size(); ++cc)
+  {
+    Block& block = blocks[cc];
+    if (block.Evaluate && this->UseZoneMaps && block.NumberOfElements > 0 &&
+      !CanMatch(internals.Root.get(), block))
+    {
+      block.Inside->FillValue(inverse ? 1 : 0);
+      ++this->NumberOfSkippedBlocks;
+      continue;
+    }
+    if (!block.Evaluate)
+    {
+      block.Inside->FillValue(0);
+      continue;
+    }
+    for (vtkIdType begin = 0; begin < block.NumberOfElements; begin += TaskSize)
+    {
+      tasks.push_back(EvaluateWorker::Task{ cc, begin,
+        std::min(begin + TaskSize, block.NumberOfElements) });
+    }
+  }
+
+  EvaluateWorker worker{ internals.Root.get(), &blocks, &tasks, inverse };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, worker);
+
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "evaluated query on %d blocks (%d skipped using array ranges) in %d tasks",
+    static_cast<int>(blocks.size()), static_cast<int>(this->NumberOfSkippedBlocks),
+    static_cast<int>(tasks.size()));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVQuerySelector::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseZoneMaps: " << this->UseZoneMaps << endl;
+  os << indent << "QueryCompiled: " << this->GetQueryCompiled() << endl;
+  os << indent << "NumberOfSkippedBlocks: " << this->NumberOfSkippedBlocks << endl;
+  os << indent << "FallbackSelector: " << this->FallbackSelector.GetPointer() << endl;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVQuerySelector.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVQuerySelector
+ * @brief Select cells/points/rows using compiled query expressions
+ *
+ * vtkPVQuerySelector evaluates the query string of a vtkSelectionNode::QUERY
+ * selection node without going through Python. It supports the expressions
+ * generated by the Find Data panel: comparisons (`==`, `!=`, `<`, `<=`, `>`,
+ * `>=`) between arrays, array components (`name[:,1]`), magnitudes
+ * (`mag(name)`), the element index (`id`) and numbers, `isnan(...)`,
+ * `in1d(x, [v0, v1, ...])` / `isin(...)`, and their combinations with `&`,
+ * `|`, `~` and parentheses. Array names are matched the same way the Python
+ * calculator does, i.e. after removing characters that are not valid in a
+ * Python identifier.
+ *
+ * Blocks are evaluated in parallel using vtkSMPTools. Before evaluating a
+ * block, the ranges of the arrays used by the query are checked and blocks
+ * that cannot contain any matching element are skipped. The ranges come from
+ * vtkDataArray::GetRange(), which caches them with the array, so repeated
+ * queries on unchanged data do not rescan those arrays.
+ *
+ * Queries that cannot be compiled (e.g. `pressure == max(pressure)`) are
+ * forwarded to the fallback selector, if any. This decision only depends on
+ * the query string so that all ranks take the same path.
+ */
+
+#ifndef vtkPVQuerySelector_h
+#define vtkPVQuerySelector_h
+
+#include "vtkPVVTKExtensionsExtractionModule.h" //needed for exports
+#include "vtkSelector.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+class VTKPVVTKEXTENSIONSEXTRACTION_EXPORT vtkPVQuerySelector : public vtkSelector
+{
+public:
+  static vtkPVQuerySelector* New();
+  vtkTypeMacro(vtkPVQuerySelector, vtkSelector);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Overridden to compile the query string of the node.
+   */
+  void Initialize(vtkSelectionNode* node) override;
+
+  /**
+   * Overridden to evaluate the compiled query, or to delegate to the
+   * fallback selector if the query could not be compiled.
+   */
+  void Execute(vtkDataObject* input, vtkDataObject* output) override;
+
+  //@{
+  /**
+   * Get/Set the selector used for queries that cannot be compiled, typically
+   * a vtkPythonSelector.
+   */
+  void SetFallbackSelector(vtkSelector* selector);
+  vtkSelector* GetFallbackSelector() const { return this->FallbackSelector; }
+  //@}
+
+  //@{
+  /**
+   * When on (default), blocks whose array ranges show that no element can
+   * match the query are skipped.
+   */
+  vtkSetMacro(UseZoneMaps, bool);
+  vtkGetMacro(UseZoneMaps, bool);
+  vtkBooleanMacro(UseZoneMaps, bool);
+  //@}
+
+  /**
+   * Returns true if the query of the node passed to Initialize() was
+   * compiled and will be evaluated without the fallback selector.
+   */
+  bool GetQueryCompiled() const;
+
+  /**
+   * Returns the number of blocks skipped, thanks to the array ranges, by the
+   * last call to Execute().
+   */
+  vtkGetMacro(NumberOfSkippedBlocks, vtkIdType);
+
+protected:
+  vtkPVQuerySelector();
+  ~vtkPVQuerySelector() override;
+
+  /**
+   * Implementing this is required by the superclass.
+   */
+  bool ComputeSelectedElements(vtkDataObject*, vtkSignedCharArray*) override { return false; }
+
+  vtkSmartPointer<vtkSelector> FallbackSelector;
+  bool UseZoneMaps;
+  vtkIdType NumberOfSkippedBlocks;
+
+private:
+  vtkPVQuerySelector(const vtkPVQuerySelector&) = delete;
+  void operator=(const vtkPVQuerySelector&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVArrayCalculatorVectorized.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the vectorized evaluation of vtkPVArrayCalculator matches the
+// vtkFunctionParser based evaluation. Use --benchmark=<number of points> to
+// report timings for both.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateInput(vtkIdType numPoints)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkFloatArray> velocity;
+  velocity->SetName("V");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(numPoints);
+  vtkNew<vtkDoubleArray> rho;
+  rho->SetName("rho");
+  rho->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> temperature;
+  temperature->SetName("T");
+  temperature->SetNumberOfTuples(numPoints);
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    const double x = 0.001 * cc;
+    points->SetPoint(cc, x, std::sin(x), std::cos(x));
+    const float v[3] = { static_cast<float>(std::cos(x)), static_cast<float>(x), 0.5f };
+    velocity->SetTypedTuple(cc, v);
+    rho->SetValue(cc, std::sin(3 * x));
+    temperature->SetValue(cc, static_cast<int>(cc % 97) - 40);
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->GetPointData()->AddArray(velocity);
+  pd->GetPointData()->AddArray(rho);
+  pd->GetPointData()->AddArray(temperature);
+  return pd;
+}
+
+vtkSmartPointer<vtkDataArray> Evaluate(
+  vtkPolyData* input, const std::string& expression, bool vectorized, double* elapsed = nullptr)
+{
+  vtkNew<vtkPVArrayCalculator> calc;
+  calc->SetInputData(input);
+  calc->SetFunction(expression.c_str());
+  calc->SetResultArrayName("Result");
+  calc->SetReplaceInvalidValues(1);
+  calc->SetReplacementValue(-1.0);
+  calc->SetUseVectorizedEvaluation(vectorized);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  calc->Update();
+  timer->StopTimer();
+  if (elapsed)
+  {
+    *elapsed = timer->GetElapsedTime();
+  }
+  auto output = vtkPolyData::SafeDownCast(calc->GetOutputDataObject(0));
+  return output ? output->GetPointData()->GetArray("Result") : nullptr;
+}
+
+bool Compare(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!expected || !actual ||
+    expected->GetNumberOfComponents() != actual->GetNumberOfComponents() ||
+    expected->GetNumberOfTuples() != actual->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType t = 0; t < expected->GetNumberOfTuples(); ++t)
+  {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+      const double e = expected->GetComponent(t, c);
+      const double a = actual->GetComponent(t, c);
+      if (std::fabs(e - a) > 1e-9 * std::max(1.0, std::fabs(e)))
+      {
+        cerr << "Mismatch at tuple " << t << " component " << c << ": " << e << " != " << a
+             << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVArrayCalculatorVectorized(int argc, char* argv[])
+{
+  int benchmarkSize = 0;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument("--benchmark", argT::EQUAL_ARGUMENT, &benchmarkSize,
+    "Optionally specify the number of points used to compare the timings.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return EXIT_FAILURE;
+  }
+
+  auto input = CreateInput(10000);
+  const char* expressions[] = { "mag(V)*rho", "V*2+coords", "2*V-coords*rho",
+    "sqrt(abs(T))-rho^2", "norm(V).iHat + V_X*T", "cross(V,coords)", "-rho^2/(T+1)",
+    "ln(rho) + asin(rho*2)", "max(rho, 0.5) - min(coordsX, coordsY)",
+    "exp(-abs(rho))*sign(T)*cos(coordsZ)", "floor(coordsX)+ceil(rho)+tanh(T)",
+    // not supported by the vectorized evaluation, uses the fallback.
+    "if(rho > 0, rho, -rho)" };
+
+  for (const char* expression : expressions)
+  {
+    auto expected = Evaluate(input, expression, false);
+    auto actual = Evaluate(input, expression, true);
+    if (!Compare(expected, actual))
+    {
+      cerr << "Results differ for `" << expression << "`" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (benchmarkSize <= 0)
+  {
+    return EXIT_SUCCESS;
+  }
+
+  auto large = CreateInput(benchmarkSize);
+  double parserTime = 0.0, vectorizedTime = 0.0;
+  auto expected = Evaluate(large, "mag(V)*rho", false, &parserTime);
+  auto actual = Evaluate(large, "mag(V)*rho", true, &vectorizedTime);
+  vtk_assert(Compare(expected, actual));
+  cout << "mag(V)*rho over " << large->GetNumberOfPoints()
+       << " points: vtkFunctionParser: " << parserTime << "s, vectorized: " << vectorizedTime
+       << "s" << endl;
+  return EXIT_SUCCESS;
+}
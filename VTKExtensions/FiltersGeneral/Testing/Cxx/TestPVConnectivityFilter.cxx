@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVConnectivityFilter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVConnectivityFilter.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <vector>
+
+namespace
+{
+// Unit hexahedra of the whole dataset, with the piece they belong to. Each
+// piece holds 4 consecutive cells of a strip spanning all pieces, so that
+// pieces that are not neighbors are only connected through the others. A
+// second strip is split between the first two pieces and each piece also has
+// an isolated cell.
+struct Cell
+{
+  int X;
+  int Y;
+  int Piece;
+};
+
+std::vector<Cell> CreateCells(int numPieces)
+{
+  std::vector<Cell> cells;
+  for (int x = 0; x < 4 * numPieces; ++x)
+  {
+    cells.push_back(Cell{ x, 0, x / 4 });
+  }
+  cells.push_back(Cell{ 3, 2, 0 });
+  cells.push_back(Cell{ 4, 2, std::min(1, numPieces - 1) });
+  for (int piece = 0; piece < numPieces; ++piece)
+  {
+    cells.push_back(Cell{ 4 * piece + 1, 4, piece });
+  }
+  return cells;
+}
+
+// Creates the cells of `piece`, or all cells when `piece` is negative. The
+// "CellIndex" cell array holds the index of each cell in the whole dataset.
+vtkSmartPointer<vtkUnstructuredGrid> CreatePiece(const std::vector<Cell>& cells, int piece)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> cellIndex;
+  cellIndex->SetName("CellIndex");
+  auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  ug->Allocate();
+
+  std::map<std::array<int, 3>, vtkIdType> pointIds;
+  for (size_t cc = 0; cc < cells.size(); ++cc)
+  {
+    const Cell& cell = cells[cc];
+    if (piece >= 0 && cell.Piece != piece)
+    {
+      continue;
+    }
+    static const int corners[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+      { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+    vtkIdType ids[8];
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      const std::array<int, 3> key = { { cell.X + corners[corner][0],
+        cell.Y + corners[corner][1], corners[corner][2] } };
+      auto iter = pointIds.find(key);
+      if (iter == pointIds.end())
+      {
+        const vtkIdType id = points->InsertNextPoint(key[0], key[1], key[2]);
+        iter = pointIds.insert(std::make_pair(key, id)).first;
+      }
+      ids[corner] = iter->second;
+    }
+    ug->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+    cellIndex->InsertNextValue(static_cast<vtkIdType>(cc));
+  }
+  ug->SetPoints(points);
+  ug->GetCellData()->AddArray(cellIndex);
+  return ug;
+}
+
+// Returns the region of each cell of the whole dataset, indexed by
+// "CellIndex".
+std::vector<vtkIdType> GetCellRegions(
+  vtkMultiProcessController* controller, vtkPointSet* output, size_t numCells)
+{
+  vtkNew<vtkIdTypeArray> local;
+  local->SetNumberOfComponents(2);
+  vtkIdTypeArray* cellIndex =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("CellIndex"));
+  vtkIdTypeArray* regions =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("RegionId"));
+  if (cellIndex && regions)
+  {
+    for (vtkIdType cc = 0; cc < output->GetNumberOfCells(); ++cc)
+    {
+      const vtkIdType tuple[2] = { cellIndex->GetValue(cc), regions->GetValue(cc) };
+      local->InsertNextTypedTuple(tuple);
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> all;
+  if (controller)
+  {
+    controller->AllGatherV(local, all);
+  }
+  else
+  {
+    all->DeepCopy(local);
+  }
+
+  std::vector<vtkIdType> result(numCells, -1);
+  for (vtkIdType cc = 0; cc < all->GetNumberOfTuples(); ++cc)
+  {
+    result[all->GetTypedComponent(cc, 0)] = all->GetTypedComponent(cc, 1);
+  }
+  return result;
+}
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "Rank " << myRank << ", line " << __LINE__ << ": " msg << endl;                        \
+    return false;                                                                                  \
+  }
+
+bool TestConnectivity(vtkMultiProcessController* controller)
+{
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+  const std::vector<Cell> cells = CreateCells(numRanks);
+
+  // Serial reference on the whole dataset.
+  vtkNew<vtkPVConnectivityFilter> serialFilter;
+  serialFilter->SetResolveRegionsAcrossProcesses(false);
+  serialFilter->SetInputData(CreatePiece(cells, -1));
+  serialFilter->Update();
+  const std::vector<vtkIdType> expected = GetCellRegions(
+    nullptr, vtkPointSet::SafeDownCast(serialFilter->GetOutputDataObject(0)), cells.size());
+  expect(serialFilter->GetNumberOfExtractedRegions() == 2 + numRanks,
+    "unexpected number of regions in serial.");
+
+  vtkNew<vtkPVConnectivityFilter> filter;
+  filter->SetController(controller);
+  filter->SetInputData(CreatePiece(cells, myRank));
+  filter->Update();
+  const std::vector<vtkIdType> result = GetCellRegions(
+    controller, vtkPointSet::SafeDownCast(filter->GetOutputDataObject(0)), cells.size());
+
+  expect(filter->GetNumberOfExtractedRegions() == serialFilter->GetNumberOfExtractedRegions(),
+    "number of regions does not match the serial result.");
+
+  // Global region ids are consistent if they define the same partition of
+  // the cells as the serial ones.
+  std::map<vtkIdType, vtkIdType> serialToParallel;
+  std::map<vtkIdType, vtkIdType> parallelToSerial;
+  for (size_t cc = 0; cc < cells.size(); ++cc)
+  {
+    expect(result[cc] >= 0 && result[cc] < filter->GetNumberOfExtractedRegions(),
+      "missing or invalid region id.");
+    auto iter = serialToParallel.insert(std::make_pair(expected[cc], result[cc])).first;
+    expect(iter->second == result[cc], "region is split across processes.");
+    iter = parallelToSerial.insert(std::make_pair(result[cc], expected[cc])).first;
+    expect(iter->second == expected[cc], "regions are merged across processes.");
+  }
+
+  // The first strip spans all processes, the first and the last one only
+  // being connected through the others.
+  expect(result[0] == result[4 * numRanks - 1], "strip spanning all processes is split.");
+
+  // It is the largest region once the pieces are merged.
+  filter->SetExtractionModeToLargestRegion();
+  filter->Update();
+  vtkIdType numCells =
+    vtkPointSet::SafeDownCast(filter->GetOutputDataObject(0))->GetNumberOfCells();
+  vtkIdType totalCells = 0;
+  controller->AllReduce(&numCells, &totalCells, 1, vtkCommunicator::SUM_OP);
+  expect(totalCells == 4 * numRanks, "wrong number of cells in the largest region.");
+  return true;
+}
+}
+
+int TestPVConnectivityFilter(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestConnectivity(contr) ? 1 : 0;
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -18,69 +18,74 @@
 #include "vtkObjectFactory.h"
 
 vtkStandardNewMacro(vtkPEquivalenceSet);
+vtkCxxSetObjectMacro(vtkPEquivalenceSet, Controller, vtkMultiProcessController);
 
 vtkPEquivalenceSet::vtkPEquivalenceSet()
 {
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
 vtkPEquivalenceSet::~vtkPEquivalenceSet()
 {
+  this->SetController(nullptr);
 }
 
 void vtkPEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
 }
 
 int vtkPEquivalenceSet::ResolveEquivalences()
 {
-  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  vtkMultiProcessController* controller = this->Controller;
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return this->Superclass::ResolveEquivalences();
+  }
   int myProc = controller->GetLocalProcessId();
   int numProcs = controller->GetNumberOfProcesses();
 
   vtkIntArray* workingSet = vtkIntArray::New();
   workingSet->SetNumberOfComponents(1);
 
+  // Tree reduction onto process 0. The upper half of the active processes
+  // sends its set to the lower half until a single process is left.
   int tag = 475893745;
-  int pivot = (numProcs + 1) / 2;
-  while (pivot > 0 && myProc < (pivot * 2))
+  int active = numProcs;
+  while (active > 1)
   {
+    int pivot = (active + 1) / 2;
     int tuples;
-    if (myProc >= pivot)
+    if (myProc >= pivot && myProc < active)
     {
       tuples = this->EquivalenceArray->GetNumberOfTuples();
       controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
       controller->Send(this->EquivalenceArray, myProc - pivot, tag + pivot + 1);
     }
-    else if ((myProc + pivot) < numProcs)
+    else if ((myProc + pivot) < active)
     {
       controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
       workingSet->SetNumberOfTuples(tuples);
 
       controller->Receive(workingSet, myProc + pivot, tag + pivot + 1);
-      while (workingSet->GetNumberOfTuples() > this->EquivalenceArray->GetNumberOfTuples())
-      {
-        this->EquivalenceArray->InsertNextTuple1(0);
-      }
+      // Each member references an id equal to or smaller than itself, so
+      // merging the received set is the same as adding one equivalence per
+      // member. This keeps the links already recorded here.
       for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
       {
         int workingVal = workingSet->GetValue(i);
-        if (workingVal == 0)
-        {
-          continue;
-        }
-        int existingVal = this->EquivalenceArray->GetValue(i);
-        this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
+        if (workingVal != i)
         {
-          this->EquateInternal(existingVal, workingVal);
+          this->AddEquivalence(i, workingVal);
         }
       }
     }
-    pivot /= 2;
+    active = pivot;
   }
+  workingSet->Delete();
   controller->Broadcast(this->EquivalenceArray, 0);
 
-  this->Superclass::ResolveEquivalences();
-  return 1;
+  return this->Superclass::ResolveEquivalences();
 }
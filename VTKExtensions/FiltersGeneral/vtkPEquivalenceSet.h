@@ -17,6 +17,9 @@
  * @brief   distributed method of Equivalence
  *
  * Same as EquivalenceSet, but resolving is a global operation.
+ * Every process must call ResolveEquivalences(). Equivalences added on any
+ * process are merged before the set ids are made sequential, so all
+ * processes end up with the same resolved map.
  * .SEE vtkEquivalenceSet
 */
 
@@ -26,6 +29,8 @@
 #include "vtkEquivalenceSet.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
 
+class vtkMultiProcessController;
+
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPEquivalenceSet : public vtkEquivalenceSet
 {
 public:
@@ -36,10 +41,21 @@ public:
   // Globally equivalent set IDs are reassigned to be sequential.
   int ResolveEquivalences() override;
 
+  //@{
+  /**
+   * Get/Set the controller used to merge the equivalences. Defaults to the
+   * global controller.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
 protected:
   vtkPEquivalenceSet();
   ~vtkPEquivalenceSet() override;
 
+  vtkMultiProcessController* Controller;
+
 private:
   vtkPEquivalenceSet(const vtkPEquivalenceSet&) = delete;
   void operator=(const vtkPEquivalenceSet&) = delete;
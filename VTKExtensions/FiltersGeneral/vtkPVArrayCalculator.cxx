@@ -14,9 +14,11 @@
 =========================================================================*/
 #include "vtkPVArrayCalculator.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkFunctionParser.h"
@@ -25,14 +27,27 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
+#include "vtkPVLogger.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -69,6 +84,790 @@ public:
     this->Calc->AddScalarVariable(name.c_str(), this->ArrayName, this->Component);
   }
 };
+
+//----------------------------------------------------------------------------
+// Compiled evaluation of calculator expressions.
+//
+// The expression is parsed once into a list of instructions, each one writing
+// a register that holds `ChunkSize` tuples stored component by component.
+// Evaluation then runs every instruction as a tight loop over a chunk of
+// contiguous doubles, with chunks distributed over threads by vtkSMPTools.
+// Only the subset of the vtkFunctionParser syntax listed in `FunctionNames`
+// and the + - * / ^ . operators are supported; anything else makes the
+// compilation fail and the caller falls back to vtkArrayCalculator.
+namespace vectorized
+{
+constexpr vtkIdType ChunkSize = 1024;
+
+enum class OpCode
+{
+  Load,
+  Constant,
+  Negate,
+  Add,
+  Subtract,
+  Multiply,
+  ScaleVector,
+  Divide,
+  Power,
+  Dot,
+  Cross,
+  Magnitude,
+  Normalize,
+  Min,
+  Max,
+  Function
+};
+
+enum class FunctionId
+{
+  Abs,
+  Ceil,
+  Floor,
+  Sign,
+  Exp,
+  Ln,
+  Log10,
+  Sqrt,
+  Sin,
+  Cos,
+  Tan,
+  Asin,
+  Acos,
+  Atan,
+  Sinh,
+  Cosh,
+  Tanh,
+  Mag,
+  Norm,
+  Cross,
+  Min,
+  Max
+};
+
+const std::map<std::string, FunctionId>& FunctionNames()
+{
+  static const std::map<std::string, FunctionId> names = { { "abs", FunctionId::Abs },
+    { "ceil", FunctionId::Ceil }, { "floor", FunctionId::Floor }, { "sign", FunctionId::Sign },
+    { "exp", FunctionId::Exp }, { "ln", FunctionId::Ln }, { "log10", FunctionId::Log10 },
+    { "sqrt", FunctionId::Sqrt }, { "sin", FunctionId::Sin }, { "cos", FunctionId::Cos },
+    { "tan", FunctionId::Tan }, { "asin", FunctionId::Asin }, { "acos", FunctionId::Acos },
+    { "atan", FunctionId::Atan }, { "sinh", FunctionId::Sinh }, { "cosh", FunctionId::Cosh },
+    { "tanh", FunctionId::Tanh }, { "mag", FunctionId::Mag }, { "norm", FunctionId::Norm },
+    { "cross", FunctionId::Cross }, { "min", FunctionId::Min }, { "max", FunctionId::Max } };
+  return names;
+}
+
+struct Instruction
+{
+  OpCode Op = OpCode::Constant;
+  FunctionId Function = FunctionId::Abs;
+  int Dest = -1;
+  int A = -1;
+  int B = -1;
+  int Width = 1;
+  int Input = -1;
+  double Value[3] = { 0.0, 0.0, 0.0 };
+};
+
+// A variable known to the calculator. `Array` is null when the array is
+// missing from the current input.
+struct Binding
+{
+  vtkDataArray* Array = nullptr;
+  int Components[3] = { 0, 0, 0 };
+  int Width = 1;
+};
+
+struct Program
+{
+  std::vector<Instruction> Instructions;
+  std::vector<Binding> Inputs;
+  std::vector<int> Widths;
+  int Result = -1;
+};
+
+//----------------------------------------------------------------------------
+class Compiler
+{
+public:
+  Compiler(const std::string& expression, const std::map<std::string, Binding>& variables)
+    : Variables(variables)
+  {
+    // like vtkFunctionParser, ignore spaces except within quoted names.
+    bool quoted = false;
+    for (char c : expression)
+    {
+      quoted = (c == '"') ? !quoted : quoted;
+      if (quoted || !std::isspace(static_cast<unsigned char>(c)))
+      {
+        this->Text.push_back(c);
+      }
+    }
+  }
+
+  bool Compile(Program& program)
+  {
+    this->Target = &program;
+    this->Pos = 0;
+    program.Result = this->ParseExpression();
+    return program.Result >= 0 && this->Pos == this->Text.size();
+  }
+
+private:
+  int Width(int reg) const { return this->Target->Widths[reg]; }
+
+  int Emit(Instruction inst)
+  {
+    inst.Dest = static_cast<int>(this->Target->Widths.size());
+    this->Target->Widths.push_back(inst.Width);
+    this->Target->Instructions.push_back(inst);
+    return inst.Dest;
+  }
+
+  int EmitBinary(OpCode op, int a, int b, int width)
+  {
+    Instruction inst;
+    inst.Op = op;
+    inst.A = a;
+    inst.B = b;
+    inst.Width = width;
+    return this->Emit(inst);
+  }
+
+  bool Accept(char c)
+  {
+    if (this->Pos < this->Text.size() && this->Text[this->Pos] == c)
+    {
+      ++this->Pos;
+      return true;
+    }
+    return false;
+  }
+
+  // expression := term (('+' | '-') term)*
+  int ParseExpression()
+  {
+    int lhs = this->ParseTerm();
+    while (lhs >= 0 && this->Pos < this->Text.size())
+    {
+      const char op = this->Text[this->Pos];
+      if (op != '+' && op != '-')
+      {
+        break;
+      }
+      ++this->Pos;
+      const int rhs = this->ParseTerm();
+      if (rhs < 0 || this->Width(lhs) != this->Width(rhs))
+      {
+        return -1;
+      }
+      lhs = this->EmitBinary(
+        op == '+' ? OpCode::Add : OpCode::Subtract, lhs, rhs, this->Width(lhs));
+    }
+    return lhs;
+  }
+
+  // term := unary (('*' | '/' | '.') unary)*
+  int ParseTerm()
+  {
+    int lhs = this->ParseUnary();
+    while (lhs >= 0 && this->Pos < this->Text.size())
+    {
+      const char op = this->Text[this->Pos];
+      if (op != '*' && op != '/' && op != '.')
+      {
+        break;
+      }
+      ++this->Pos;
+      const int rhs = this->ParseUnary();
+      if (rhs < 0)
+      {
+        return -1;
+      }
+      const int wl = this->Width(lhs);
+      const int wr = this->Width(rhs);
+      if (op == '*' && wl == 1 && wr == 1)
+      {
+        lhs = this->EmitBinary(OpCode::Multiply, lhs, rhs, 1);
+      }
+      else if (op == '*' && wl != wr)
+      {
+        // scalar times vector, in either order.
+        lhs = wl == 1 ? this->EmitBinary(OpCode::ScaleVector, lhs, rhs, 3)
+                      : this->EmitBinary(OpCode::ScaleVector, rhs, lhs, 3);
+      }
+      else if (op == '/' && wl == 1 && wr == 1)
+      {
+        lhs = this->EmitBinary(OpCode::Divide, lhs, rhs, 1);
+      }
+      else if (op == '.' && wl == 3 && wr == 3)
+      {
+        lhs = this->EmitBinary(OpCode::Dot, lhs, rhs, 1);
+      }
+      else
+      {
+        return -1;
+      }
+    }
+    return lhs;
+  }
+
+  // unary := '-' unary | power
+  int ParseUnary()
+  {
+    if (this->Accept('-'))
+    {
+      const int operand = this->ParseUnary();
+      return operand < 0 ? -1
+                         : this->EmitBinary(OpCode::Negate, operand, -1, this->Width(operand));
+    }
+    return this->ParsePower();
+  }
+
+  // power := primary ('^' unary)?
+  int ParsePower()
+  {
+    const int base = this->ParsePrimary();
+    if (base < 0 || !this->Accept('^'))
+    {
+      return base;
+    }
+    const int exponent = this->ParseUnary();
+    if (exponent < 0 || this->Width(base) != 1 || this->Width(exponent) != 1)
+    {
+      return -1;
+    }
+    return this->EmitBinary(OpCode::Power, base, exponent, 1);
+  }
+
+  int ParsePrimary()
+  {
+    if (this->Pos >= this->Text.size())
+    {
+      return -1;
+    }
+    if (this->Accept('('))
+    {
+      const int inner = this->ParseExpression();
+      return (inner >= 0 && this->Accept(')')) ? inner : -1;
+    }
+
+    const char* start = this->Text.c_str() + this->Pos;
+    if (std::isdigit(static_cast<unsigned char>(*start)) ||
+      (*start == '.' && std::isdigit(static_cast<unsigned char>(start[1]))))
+    {
+      char* end = nullptr;
+      Instruction inst;
+      inst.Op = OpCode::Constant;
+      inst.Value[0] = std::strtod(start, &end);
+      this->Pos += static_cast<size_t>(end - start);
+      return this->Emit(inst);
+    }
+
+    // longest registered variable name, function name or constant wins, as
+    // variable names may start with or contain function names.
+    size_t variableLength = 0;
+    const Binding* variable = nullptr;
+    std::string variableName;
+    for (const auto& item : this->Variables)
+    {
+      if (item.first.size() > variableLength &&
+        this->Text.compare(this->Pos, item.first.size(), item.first) == 0)
+      {
+        variableLength = item.first.size();
+        variable = &item.second;
+        variableName = item.first;
+      }
+    }
+    size_t functionLength = 0;
+    FunctionId function = FunctionId::Abs;
+    for (const auto& item : FunctionNames())
+    {
+      const size_t length = item.first.size();
+      if (length > functionLength && this->Text.compare(this->Pos, length, item.first) == 0 &&
+        this->Pos + length < this->Text.size() && this->Text[this->Pos + length] == '(')
+      {
+        functionLength = length;
+        function = item.second;
+      }
+    }
+    static const char* hats[3] = { "iHat", "jHat", "kHat" };
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (variableLength < 4 && functionLength < 4 &&
+        this->Text.compare(this->Pos, 4, hats[cc]) == 0)
+      {
+        this->Pos += 4;
+        Instruction inst;
+        inst.Op = OpCode::Constant;
+        inst.Width = 3;
+        inst.Value[cc] = 1.0;
+        return this->Emit(inst);
+      }
+    }
+
+    if (functionLength > 0 && functionLength >= variableLength)
+    {
+      this->Pos += functionLength + 1;
+      return this->ParseFunction(function);
+    }
+    if (variable == nullptr || variable->Array == nullptr)
+    {
+      return -1;
+    }
+    this->Pos += variableLength;
+
+    // load each variable once.
+    auto loaded = this->Loaded.find(variableName);
+    if (loaded != this->Loaded.end())
+    {
+      return loaded->second;
+    }
+    Instruction inst;
+    inst.Op = OpCode::Load;
+    inst.Width = variable->Width;
+    inst.Input = static_cast<int>(this->Target->Inputs.size());
+    this->Target->Inputs.push_back(*variable);
+    const int reg = this->Emit(inst);
+    this->Loaded[variableName] = reg;
+    return reg;
+  }
+
+  int ParseFunction(FunctionId function)
+  {
+    std::vector<int> args;
+    do
+    {
+      const int arg = this->ParseExpression();
+      if (arg < 0)
+      {
+        return -1;
+      }
+      args.push_back(arg);
+    } while (this->Accept(','));
+    if (!this->Accept(')'))
+    {
+      return -1;
+    }
+
+    switch (function)
+    {
+      case FunctionId::Mag:
+        return (args.size() == 1 && this->Width(args[0]) == 3)
+          ? this->EmitBinary(OpCode::Magnitude, args[0], -1, 1)
+          : -1;
+      case FunctionId::Norm:
+        return (args.size() == 1 && this->Width(args[0]) == 3)
+          ? this->EmitBinary(OpCode::Normalize, args[0], -1, 3)
+          : -1;
+      case FunctionId::Cross:
+        return (args.size() == 2 && this->Width(args[0]) == 3 && this->Width(args[1]) == 3)
+          ? this->EmitBinary(OpCode::Cross, args[0], args[1], 3)
+          : -1;
+      case FunctionId::Min:
+      case FunctionId::Max:
+        return (args.size() == 2 && this->Width(args[0]) == 1 && this->Width(args[1]) == 1)
+          ? this->EmitBinary(
+              function == FunctionId::Min ? OpCode::Min : OpCode::Max, args[0], args[1], 1)
+          : -1;
+      default:
+        break;
+    }
+    if (args.size() != 1 || this->Width(args[0]) != 1)
+    {
+      return -1;
+    }
+    Instruction inst;
+    inst.Op = OpCode::Function;
+    inst.Function = function;
+    inst.A = args[0];
+    return this->Emit(inst);
+  }
+
+  const std::map<std::string, Binding>& Variables;
+  std::map<std::string, int> Loaded;
+  std::string Text;
+  size_t Pos = 0;
+  Program* Target = nullptr;
+};
+
+//----------------------------------------------------------------------------
+// Copies the selected components of tuples [begin, begin + count) into a
+// register.
+struct GatherWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, vtkIdType begin, vtkIdType count, const Binding& binding, double* dest) const
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, begin + count);
+    for (int c = 0; c < binding.Width; ++c)
+    {
+      const int comp = binding.Components[c];
+      double* out = dest + c * ChunkSize;
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        out[t] = static_cast<double>(tuples[t][comp]);
+      }
+    }
+  }
+};
+
+// Copies a register into tuples [begin, begin + count) of the result array.
+struct ScatterWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, vtkIdType begin, vtkIdType count, int width, const double* src) const
+  {
+    using ValueType = vtk::GetAPIType<ArrayT>;
+    auto tuples = vtk::DataArrayTupleRange(array, begin, begin + count);
+    for (int c = 0; c < width; ++c)
+    {
+      const double* in = src + c * ChunkSize;
+      for (vtkIdType t = 0; t < count; ++t)
+      {
+        tuples[t][c] = static_cast<ValueType>(in[t]);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+class Evaluator
+{
+public:
+  Evaluator(const Program& program, vtkDataArray* result, bool replace, double replacement)
+    : Prog(program)
+    , Result(result)
+    , Replace(replace)
+    , Replacement(replacement)
+    , Invalid(false)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Registers.Local().resize(this->Prog.Widths.size() * 3 * ChunkSize);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double* registers = this->Registers.Local().data();
+    for (vtkIdType chunk = begin; chunk < end && !this->Invalid; chunk += ChunkSize)
+    {
+      const vtkIdType count = std::min(ChunkSize, end - chunk);
+      vtkIdType invalid = 0;
+      for (const Instruction& inst : this->Prog.Instructions)
+      {
+        invalid += this->Execute(inst, registers, chunk, count);
+      }
+      if (invalid > 0 && !this->Replace)
+      {
+        // let vtkFunctionParser report the error.
+        this->Invalid = true;
+        return;
+      }
+
+      ScatterWorker scatter;
+      const double* result = registers + this->Prog.Result * 3 * ChunkSize;
+      const int width = this->Prog.Widths[this->Prog.Result];
+      if (!vtkArrayDispatch::Dispatch::Execute(this->Result, scatter, chunk, count, width, result))
+      {
+        scatter(this->Result, chunk, count, width, result);
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  bool Execute(vtkIdType numTuples)
+  {
+    vtkSMPTools::For(0, numTuples, 16 * ChunkSize, *this);
+    return !this->Invalid;
+  }
+
+private:
+  // Returns the number of values that were invalid, i.e. that vtkFunctionParser
+  // would either report as errors or substitute with the replacement value.
+  vtkIdType Execute(const Instruction& inst, double* registers, vtkIdType begin, vtkIdType count)
+  {
+    double* d = registers + inst.Dest * 3 * ChunkSize;
+    const double* a = inst.A >= 0 ? registers + inst.A * 3 * ChunkSize : nullptr;
+    const double* b = inst.B >= 0 ? registers + inst.B * 3 * ChunkSize : nullptr;
+    const double r = this->Replacement;
+    const vtkIdType n = count;
+    const vtkIdType cs = ChunkSize;
+    vtkIdType invalid = 0;
+
+    switch (inst.Op)
+    {
+      case OpCode::Load:
+      {
+        const Binding& binding = this->Prog.Inputs[inst.Input];
+        GatherWorker gather;
+        if (!vtkArrayDispatch::Dispatch::Execute(binding.Array, gather, begin, n, binding, d))
+        {
+          gather(binding.Array, begin, n, binding, d);
+        }
+        break;
+      }
+      case OpCode::Constant:
+        for (int c = 0; c < inst.Width; ++c)
+        {
+          std::fill(d + c * cs, d + c * cs + n, inst.Value[c]);
+        }
+        break;
+      case OpCode::Negate:
+        for (vtkIdType i = 0; i < inst.Width * cs; i += cs)
+        {
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            d[i + t] = -a[i + t];
+          }
+        }
+        break;
+      case OpCode::Add:
+        for (vtkIdType i = 0; i < inst.Width * cs; i += cs)
+        {
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            d[i + t] = a[i + t] + b[i + t];
+          }
+        }
+        break;
+      case OpCode::Subtract:
+        for (vtkIdType i = 0; i < inst.Width * cs; i += cs)
+        {
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            d[i + t] = a[i + t] - b[i + t];
+          }
+        }
+        break;
+      case OpCode::Multiply:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = a[t] * b[t];
+        }
+        break;
+      case OpCode::ScaleVector:
+        for (vtkIdType i = 0; i < 3 * cs; i += cs)
+        {
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            d[i + t] = a[t] * b[i + t];
+          }
+        }
+        break;
+      case OpCode::Divide:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (b[t] == 0.0);
+          invalid += bad;
+          d[t] = bad ? r : a[t] / b[t];
+        }
+        break;
+      case OpCode::Power:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] < 0.0 && b[t] != std::floor(b[t]));
+          invalid += bad;
+          d[t] = bad ? r : std::pow(a[t], b[t]);
+        }
+        break;
+      case OpCode::Dot:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = a[t] * b[t] + a[cs + t] * b[cs + t] + a[2 * cs + t] * b[2 * cs + t];
+        }
+        break;
+      case OpCode::Cross:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = a[cs + t] * b[2 * cs + t] - a[2 * cs + t] * b[cs + t];
+          d[cs + t] = a[2 * cs + t] * b[t] - a[t] * b[2 * cs + t];
+          d[2 * cs + t] = a[t] * b[cs + t] - a[cs + t] * b[t];
+        }
+        break;
+      case OpCode::Magnitude:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::sqrt(a[t] * a[t] + a[cs + t] * a[cs + t] + a[2 * cs + t] * a[2 * cs + t]);
+        }
+        break;
+      case OpCode::Normalize:
+      {
+        bool zero = false;
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const double mag =
+            std::sqrt(a[t] * a[t] + a[cs + t] * a[cs + t] + a[2 * cs + t] * a[2 * cs + t]);
+          // zero vectors are left to vtkFunctionParser.
+          zero = zero || mag == 0.0;
+          d[t] = a[t] / mag;
+          d[cs + t] = a[cs + t] / mag;
+          d[2 * cs + t] = a[2 * cs + t] / mag;
+        }
+        if (zero)
+        {
+          this->Invalid = true;
+        }
+        break;
+      }
+      case OpCode::Min:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::min(a[t], b[t]);
+        }
+        break;
+      case OpCode::Max:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::max(a[t], b[t]);
+        }
+        break;
+      case OpCode::Function:
+        invalid += this->ExecuteFunction(inst.Function, a, d, n);
+        break;
+    }
+    return invalid;
+  }
+
+  vtkIdType ExecuteFunction(FunctionId function, const double* a, double* d, vtkIdType n)
+  {
+    const double r = this->Replacement;
+    vtkIdType invalid = 0;
+    switch (function)
+    {
+      case FunctionId::Abs:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::fabs(a[t]);
+        }
+        break;
+      case FunctionId::Ceil:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::ceil(a[t]);
+        }
+        break;
+      case FunctionId::Floor:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::floor(a[t]);
+        }
+        break;
+      case FunctionId::Sign:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = (a[t] > 0.0) ? 1.0 : ((a[t] < 0.0) ? -1.0 : 0.0);
+        }
+        break;
+      case FunctionId::Exp:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::exp(a[t]);
+        }
+        break;
+      case FunctionId::Ln:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] <= 0.0);
+          invalid += bad;
+          d[t] = bad ? r : std::log(a[t]);
+        }
+        break;
+      case FunctionId::Log10:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] <= 0.0);
+          invalid += bad;
+          d[t] = bad ? r : std::log10(a[t]);
+        }
+        break;
+      case FunctionId::Sqrt:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] < 0.0);
+          invalid += bad;
+          d[t] = bad ? r : std::sqrt(a[t]);
+        }
+        break;
+      case FunctionId::Sin:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::sin(a[t]);
+        }
+        break;
+      case FunctionId::Cos:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::cos(a[t]);
+        }
+        break;
+      case FunctionId::Tan:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::tan(a[t]);
+        }
+        break;
+      case FunctionId::Asin:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] < -1.0 || a[t] > 1.0);
+          invalid += bad;
+          d[t] = bad ? r : std::asin(a[t]);
+        }
+        break;
+      case FunctionId::Acos:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const bool bad = (a[t] < -1.0 || a[t] > 1.0);
+          invalid += bad;
+          d[t] = bad ? r : std::acos(a[t]);
+        }
+        break;
+      case FunctionId::Atan:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::atan(a[t]);
+        }
+        break;
+      case FunctionId::Sinh:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::sinh(a[t]);
+        }
+        break;
+      case FunctionId::Cosh:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::cosh(a[t]);
+        }
+        break;
+      case FunctionId::Tanh:
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          d[t] = std::tanh(a[t]);
+        }
+        break;
+      default:
+        assert(false && "vector functions are compiled to dedicated opcodes");
+        break;
+    }
+    return invalid;
+  }
+
+  const Program& Prog;
+  vtkDataArray* Result;
+  bool Replace;
+  double Replacement;
+  std::atomic<bool> Invalid;
+  vtkSMPThreadLocal<std::vector<double> > Registers;
+};
+}
 }
 
 vtkStandardNewMacro(vtkPVArrayCalculator);
@@ -78,6 +877,7 @@ vtkPVArrayCalculator::vtkPVArrayCalculator()
   // We'll tell the superclass about all arrays (partial and full) and have it
   // ignore missing arrays when evaluating the calculator.
   this->IgnoreMissingArrays = true;
+  this->UseVectorizedEvaluation = true;
 }
 
 // ----------------------------------------------------------------------------
@@ -254,11 +1054,161 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
+  vtkDataObject* output = vtkDataObject::GetData(outputVector, 0);
+  if (this->UseVectorizedEvaluation && this->RequestDataVectorized(input, output))
+  {
+    return 1;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::RequestDataVectorized(vtkDataObject* input, vtkDataObject* output)
+{
+  if (!input || !output || !this->GetFunction() || !*this->GetFunction() ||
+    this->GetCoordinateResults() || this->GetResultNormals() || this->GetResultTCoords())
+  {
+    return false;
+  }
+
+  auto inputCD = vtkCompositeDataSet::SafeDownCast(input);
+  auto outputCD = vtkCompositeDataSet::SafeDownCast(output);
+  if (!inputCD)
+  {
+    return outputCD == nullptr && this->ExecuteVectorized(input, output);
+  }
+  if (!outputCD)
+  {
+    return false;
+  }
+
+  // evaluate all blocks before touching the output so that we can still fall
+  // back to the superclass if any block is not supported.
+  std::vector<vtkSmartPointer<vtkDataObject> > results;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(inputCD->NewIterator());
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataObject* block = iter->GetCurrentDataObject();
+    auto result = vtkSmartPointer<vtkDataObject>::Take(block->NewInstance());
+    if (!this->ExecuteVectorized(block, result))
+    {
+      return false;
+    }
+    results.push_back(result);
+  }
+
+  outputCD->CopyStructure(inputCD);
+  size_t index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++index)
+  {
+    outputCD->SetDataSet(iter, results[index]);
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::ExecuteVectorized(vtkDataObject* input, vtkDataObject* output)
+{
+  const int attributeType = this->GetAttributeTypeFromInput(input);
+  vtkDataSetAttributes* inAttrs = input->GetAttributes(attributeType);
+  const vtkIdType numTuples = inAttrs ? inAttrs->GetNumberOfTuples() : 0;
+  if (numTuples <= 0)
+  {
+    return false;
+  }
+
+  // bind the variables registered with the superclass to the input arrays.
+  std::map<std::string, vectorized::Binding> variables;
+  for (int cc = 0, max = this->GetNumberOfScalarArrays(); cc < max; ++cc)
+  {
+    vectorized::Binding binding;
+    const int comp = this->GetSelectedScalarComponent(cc);
+    vtkDataArray* array = inAttrs->GetArray(this->GetScalarArrayName(cc));
+    if (array && comp >= 0 && comp < array->GetNumberOfComponents() &&
+      array->GetNumberOfTuples() == numTuples)
+    {
+      binding.Array = array;
+      binding.Components[0] = comp;
+    }
+    variables.insert(std::make_pair(std::string(this->GetScalarVariableName(cc)), binding));
+  }
+  for (int cc = 0, max = this->GetNumberOfVectorArrays(); cc < max; ++cc)
+  {
+    vectorized::Binding binding;
+    binding.Width = 3;
+    const auto comps = this->GetSelectedVectorComponents(cc);
+    vtkDataArray* array = inAttrs->GetArray(this->GetVectorArrayName(cc));
+    bool valid = array && array->GetNumberOfTuples() == numTuples;
+    for (int c = 0; valid && c < 3; ++c)
+    {
+      binding.Components[c] = comps[c];
+      valid = comps[c] >= 0 && comps[c] < array->GetNumberOfComponents();
+    }
+    binding.Array = valid ? array : nullptr;
+    variables.insert(std::make_pair(std::string(this->GetVectorVariableName(cc)), binding));
+  }
+
+  // coordinate variables, see AddCoordinateVariableNames().
+  auto pointSet = vtkPointSet::SafeDownCast(input);
+  vtkDataArray* coords = (attributeType == vtkDataObject::POINT && pointSet &&
+                           pointSet->GetPoints() && pointSet->GetNumberOfPoints() == numTuples)
+    ? pointSet->GetPoints()->GetData()
+    : nullptr;
+  const char* coordNames[3] = { "coordsX", "coordsY", "coordsZ" };
+  for (int c = 0; c < 3; ++c)
+  {
+    vectorized::Binding binding;
+    binding.Array = coords;
+    binding.Components[0] = c;
+    variables[coordNames[c]] = binding;
+  }
+  vectorized::Binding coordsBinding;
+  coordsBinding.Array = coords;
+  coordsBinding.Width = 3;
+  coordsBinding.Components[1] = 1;
+  coordsBinding.Components[2] = 2;
+  variables["coords"] = coordsBinding;
+
+  vectorized::Program program;
+  vectorized::Compiler compiler(this->GetFunction(), variables);
+  if (!compiler.Compile(program))
+  {
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+      "expression not supported by the vectorized evaluation, using vtkFunctionParser");
+    return false;
+  }
+
+  auto result =
+    vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(this->GetResultArrayType()));
+  if (!result)
+  {
+    return false;
+  }
+  const int width = program.Widths[program.Result];
+  result->SetName(this->GetResultArrayName());
+  result->SetNumberOfComponents(width);
+  result->SetNumberOfTuples(numTuples);
+
+  vectorized::Evaluator evaluator(
+    program, result, this->GetReplaceInvalidValues() != 0, this->GetReplacementValue());
+  if (!evaluator.Execute(numTuples))
+  {
+    return false;
+  }
+
+  output->ShallowCopy(input);
+  vtkDataSetAttributes* outAttrs = output->GetAttributes(attributeType);
+  const int idx = outAttrs->AddArray(result);
+  outAttrs->SetActiveAttribute(
+    idx, width == 1 ? vtkDataSetAttributes::SCALARS : vtkDataSetAttributes::VECTORS);
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void vtkPVArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseVectorizedEvaluation: " << this->UseVectorizedEvaluation << endl;
 }
@@ -45,6 +45,19 @@ public:
 
   static vtkPVArrayCalculator* New();
 
+  //@{
+  /**
+   * When set to true (default), the expression is compiled once into a plan
+   * that is evaluated over chunks of tuples in parallel, instead of going
+   * through vtkFunctionParser tuple by tuple. Expressions, inputs or options
+   * the compiled plan does not support transparently fall back to the
+   * vtkArrayCalculator implementation.
+   */
+  vtkSetMacro(UseVectorizedEvaluation, bool);
+  vtkGetMacro(UseVectorizedEvaluation, bool);
+  vtkBooleanMacro(UseVectorizedEvaluation, bool);
+  //@}
+
 protected:
   vtkPVArrayCalculator();
   ~vtkPVArrayCalculator() override;
@@ -76,6 +89,18 @@ protected:
    */
   void AddArrayAndVariableNames(vtkDataObject* theInputObj, vtkDataSetAttributes* inDataAttrs);
 
+  //@{
+  /**
+   * Evaluates the function using the compiled plan. Returns false, leaving
+   * the output untouched, when the plan cannot handle the request in which
+   * case the superclass implementation must be used instead.
+   */
+  bool RequestDataVectorized(vtkDataObject* input, vtkDataObject* output);
+  bool ExecuteVectorized(vtkDataObject* input, vtkDataObject* output);
+  //@}
+
+  bool UseVectorizedEvaluation;
+
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
@@ -14,21 +14,455 @@
 =========================================================================*/
 #include "vtkPVConnectivityFilter.h"
 
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPEquivalenceSet.h"
+#include "vtkPVLogger.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+using PointKey = std::array<double, 3>;
+
+struct PointKeyHash
+{
+  size_t operator()(const PointKey& key) const
+  {
+    size_t seed = 0;
+    for (double value : key)
+    {
+      // -0.0 and 0.0 compare equal, so they must hash the same.
+      const size_t hash = std::hash<double>()(value == 0.0 ? 0.0 : value);
+      seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+bool BoundsAreValid(const double* bds)
+{
+  return bds[0] <= bds[1] && bds[2] <= bds[3] && bds[4] <= bds[5];
+}
+
+bool BoundsOverlap(const double* a, const double* b)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (a[2 * i] > b[2 * i + 1] || b[2 * i] > a[2 * i + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Flags the points lying inside (or on) the given bounds.
+struct PointsInBoundsWorker
+{
+  vtkPoints* Points;
+  const double* Bounds;
+  unsigned char* Inside;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      this->Points->GetPoint(cc, x);
+      this->Inside[cc] = (x[0] >= this->Bounds[0] && x[0] <= this->Bounds[1] &&
+                           x[1] >= this->Bounds[2] && x[1] <= this->Bounds[3] &&
+                           x[2] >= this->Bounds[4] && x[2] <= this->Bounds[5])
+        ? 1
+        : 0;
+    }
+  }
+};
+
+// Replaces region ids with the ones given by Map. Negative ids are left as
+// is.
+struct RelabelWorker
+{
+  vtkIdType* Values;
+  const std::vector<vtkIdType>* Map;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType size = static_cast<vtkIdType>(this->Map->size());
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkIdType region = this->Values[cc];
+      if (region >= 0 && region < size)
+      {
+        this->Values[cc] = (*this->Map)[region];
+      }
+    }
+  }
+};
+
+// Gathers the coordinates and (global) region ids of the points inside
+// bounds.
+void CollectPoints(vtkPointSet* output, vtkIdTypeArray* pointRegions, const double* bounds,
+  vtkIdType offset, std::vector<double>& coords, std::vector<vtkIdType>& regions)
+{
+  coords.clear();
+  regions.clear();
+  const vtkIdType numPts = pointRegions ? output->GetNumberOfPoints() : 0;
+  if (numPts == 0)
+  {
+    return;
+  }
+
+  std::vector<unsigned char> inside(numPts, 0);
+  PointsInBoundsWorker worker{ output->GetPoints(), bounds, inside.data() };
+  vtkSMPTools::For(0, numPts, worker);
+
+  double x[3];
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    const vtkIdType region = pointRegions->GetValue(cc);
+    if (inside[cc] && region >= 0)
+    {
+      output->GetPoint(cc, x);
+      coords.insert(coords.end(), x, x + 3);
+      regions.push_back(offset + region);
+    }
+  }
+}
+
+void SendPoints(vtkMultiProcessController* controller, int remote, int tag,
+  const std::vector<double>& coords, const std::vector<vtkIdType>& regions)
+{
+  vtkIdType count = static_cast<vtkIdType>(regions.size());
+  controller->Send(&count, 1, remote, tag);
+  if (count > 0)
+  {
+    controller->Send(coords.data(), 3 * count, remote, tag + 1);
+    controller->Send(regions.data(), count, remote, tag + 2);
+  }
+}
+
+void ReceivePoints(vtkMultiProcessController* controller, int remote, int tag,
+  std::vector<double>& coords, std::vector<vtkIdType>& regions)
+{
+  vtkIdType count = 0;
+  controller->Receive(&count, 1, remote, tag);
+  coords.resize(3 * count);
+  regions.resize(count);
+  if (count > 0)
+  {
+    controller->Receive(coords.data(), 3 * count, remote, tag + 1);
+    controller->Receive(regions.data(), count, remote, tag + 2);
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVConnectivityFilter);
+vtkCxxSetObjectMacro(vtkPVConnectivityFilter, Controller, vtkMultiProcessController);
 
+//----------------------------------------------------------------------------
 vtkPVConnectivityFilter::vtkPVConnectivityFilter()
 {
   this->ExtractionMode = VTK_EXTRACT_ALL_REGIONS;
   this->ColorRegions = 1;
+  this->ResolveRegionsAcrossProcesses = true;
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkPVConnectivityFilter::~vtkPVConnectivityFilter()
+{
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVConnectivityFilter::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  const int mode = this->ExtractionMode;
+  vtkPointSet* output = vtkPointSet::GetData(outputVector, 0);
+  if (!this->ResolveRegionsAcrossProcesses || !output || !this->Controller ||
+    this->Controller->GetNumberOfProcesses() <= 1 ||
+    (mode != VTK_EXTRACT_ALL_REGIONS && mode != VTK_EXTRACT_LARGEST_REGION &&
+      mode != VTK_EXTRACT_SPECIFIED_REGIONS))
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // Label all regions of the local piece first. These region ids are local to
+  // this process and get remapped to global ones below. The settings are
+  // changed directly to avoid modifying the filter.
+  const int colorRegions = this->ColorRegions;
+  const int assignmentMode = this->RegionIdAssignmentMode;
+  this->ExtractionMode = VTK_EXTRACT_ALL_REGIONS;
+  this->ColorRegions = 1;
+  this->RegionIdAssignmentMode = UNSPECIFIED;
+  int ret = this->Superclass::RequestData(request, inputVector, outputVector);
+  this->RegionIdAssignmentMode = assignmentMode;
+
+  std::vector<vtkIdType> localToGlobal;
+  std::vector<vtkIdType> globalSizes;
+  if (!this->ResolveGlobalRegions(output, localToGlobal, globalSizes))
+  {
+    this->ExtractionMode = mode;
+    this->ColorRegions = colorRegions;
+    output->Initialize();
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  if (mode != VTK_EXTRACT_ALL_REGIONS)
+  {
+    std::vector<bool> selected(globalSizes.size(), false);
+    if (mode == VTK_EXTRACT_LARGEST_REGION)
+    {
+      if (!globalSizes.empty())
+      {
+        selected[std::max_element(globalSizes.begin(), globalSizes.end()) - globalSizes.begin()] =
+          true;
+      }
+    }
+    else
+    {
+      for (vtkIdType cc = 0; cc < this->SpecifiedRegionIds->GetNumberOfIds(); ++cc)
+      {
+        const vtkIdType region = this->SpecifiedRegionIds->GetId(cc);
+        if (region >= 0 && region < static_cast<vtkIdType>(selected.size()))
+        {
+          selected[region] = true;
+        }
+      }
+    }
+
+    // Extract the local regions that are part of the selected global regions.
+    // Labelling is deterministic, so the second pass yields the same local
+    // region ids as the first one.
+    vtkNew<vtkIdList> localRegions;
+    for (size_t cc = 0; cc < localToGlobal.size(); ++cc)
+    {
+      if (selected[localToGlobal[cc]])
+      {
+        localRegions->InsertNextId(static_cast<vtkIdType>(cc));
+      }
+    }
+    vtkIdList* specifiedRegionIds = this->SpecifiedRegionIds;
+    this->SpecifiedRegionIds = localRegions;
+    this->ExtractionMode = VTK_EXTRACT_SPECIFIED_REGIONS;
+    this->RegionIdAssignmentMode = UNSPECIFIED;
+    output->Initialize();
+    ret = this->Superclass::RequestData(request, inputVector, outputVector);
+    this->SpecifiedRegionIds = specifiedRegionIds;
+    this->RegionIdAssignmentMode = assignmentMode;
+  }
+
+  vtkDataSetAttributes* attributes[2] = { output->GetPointData(), output->GetCellData() };
+  for (vtkDataSetAttributes* dsa : attributes)
+  {
+    vtkIdTypeArray* regions = vtkIdTypeArray::SafeDownCast(dsa->GetArray("RegionId"));
+    if (!regions)
+    {
+      continue;
+    }
+    if (!colorRegions)
+    {
+      dsa->RemoveArray("RegionId");
+      continue;
+    }
+    RelabelWorker worker{ regions->GetPointer(0), &localToGlobal };
+    vtkSMPTools::For(0, regions->GetNumberOfTuples(), worker);
+    regions->Modified();
+  }
+
+  this->RegionSizes->SetNumberOfTuples(static_cast<vtkIdType>(globalSizes.size()));
+  for (size_t cc = 0; cc < globalSizes.size(); ++cc)
+  {
+    this->RegionSizes->SetValue(static_cast<vtkIdType>(cc), globalSizes[cc]);
+  }
+
+  this->ExtractionMode = mode;
+  this->ColorRegions = colorRegions;
+  return ret;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVConnectivityFilter::ResolveGlobalRegions(vtkPointSet* output,
+  std::vector<vtkIdType>& localToGlobal, std::vector<vtkIdType>& globalSizes)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myProc = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkIdTypeArray* pointRegions =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("RegionId"));
+  vtkIdTypeArray* cellRegions =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("RegionId"));
+
+  // Number of cells in each local region.
+  std::vector<vtkIdType> localSizes;
+  const vtkIdType numCells = cellRegions ? cellRegions->GetNumberOfTuples() : 0;
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    const vtkIdType region = cellRegions->GetValue(cc);
+    if (region < 0)
+    {
+      continue;
+    }
+    if (region >= static_cast<vtkIdType>(localSizes.size()))
+    {
+      localSizes.resize(region + 1, 0);
+    }
+    ++localSizes[region];
+  }
+
+  // Local region `i` is member `offset + i` of the global equivalence set.
+  const vtkIdType numLocal = static_cast<vtkIdType>(localSizes.size());
+  std::vector<vtkIdType> counts(numProcs, 0);
+  controller->AllGather(&numLocal, counts.data(), 1);
+  vtkIdType offset = 0;
+  for (int cc = 0; cc < myProc; ++cc)
+  {
+    offset += counts[cc];
+  }
+  const vtkIdType total = std::accumulate(counts.begin(), counts.end(), vtkIdType(0));
+  if (total > VTK_INT_MAX)
+  {
+    vtkErrorMacro("Too many regions (" << total << ") to resolve across processes.");
+    return false;
+  }
+  localToGlobal.clear();
+  globalSizes.clear();
+  if (total == 0)
+  {
+    return true;
+  }
+
+  double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+    VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  if (pointRegions && output->GetNumberOfPoints() > 0)
+  {
+    output->GetBounds(bounds);
+  }
+  std::vector<double> allBounds(6 * numProcs);
+  controller->AllGather(bounds, allBounds.data(), 6);
+
+  vtkNew<vtkPEquivalenceSet> equivalences;
+  equivalences->SetController(controller);
+  equivalences->AddEquivalence(static_cast<int>(total - 1), static_cast<int>(total - 1));
+
+  // Exchange the points that may be shared with each overlapping process.
+  // Pairs are processed in increasing order of partner rank, with the lower
+  // rank sending first, which keeps the blocking exchanges deadlock free.
+  const int tag = 473920;
+  const double* myBounds = &allBounds[6 * myProc];
+  std::vector<double> coords, remoteCoords;
+  std::vector<vtkIdType> regions, remoteRegions;
+  std::unordered_map<PointKey, vtkIdType, PointKeyHash> lookup;
+  vtkIdType numMatches = 0;
+  for (int remote = 0; remote < numProcs; ++remote)
+  {
+    const double* remoteBounds = &allBounds[6 * remote];
+    if (remote == myProc || !::BoundsAreValid(myBounds) || !::BoundsAreValid(remoteBounds) ||
+      !::BoundsOverlap(myBounds, remoteBounds))
+    {
+      continue;
+    }
+
+    ::CollectPoints(output, pointRegions, remoteBounds, offset, coords, regions);
+    if (myProc < remote)
+    {
+      ::SendPoints(controller, remote, tag, coords, regions);
+      ::ReceivePoints(controller, remote, tag, remoteCoords, remoteRegions);
+    }
+    else
+    {
+      ::ReceivePoints(controller, remote, tag, remoteCoords, remoteRegions);
+      ::SendPoints(controller, remote, tag, coords, regions);
+    }
+
+    lookup.clear();
+    lookup.reserve(regions.size());
+    for (size_t cc = 0; cc < regions.size(); ++cc)
+    {
+      lookup.emplace(PointKey{ { coords[3 * cc], coords[3 * cc + 1], coords[3 * cc + 2] } },
+        regions[cc]);
+    }
+    for (size_t cc = 0; cc < remoteRegions.size(); ++cc)
+    {
+      auto iter = lookup.find(PointKey{ { remoteCoords[3 * cc], remoteCoords[3 * cc + 1],
+        remoteCoords[3 * cc + 2] } });
+      if (iter != lookup.end() && iter->second != remoteRegions[cc])
+      {
+        equivalences->AddEquivalence(
+          static_cast<int>(iter->second), static_cast<int>(remoteRegions[cc]));
+        ++numMatches;
+      }
+    }
+  }
+
+  equivalences->ResolveEquivalences();
+  const int numGlobal = equivalences->GetNumberOfResolvedSets();
+  localToGlobal.resize(numLocal);
+  std::vector<vtkIdType> sizes(numGlobal, 0);
+  for (vtkIdType cc = 0; cc < numLocal; ++cc)
+  {
+    localToGlobal[cc] = equivalences->GetEquivalentSetId(static_cast<int>(offset + cc));
+    sizes[localToGlobal[cc]] += localSizes[cc];
+  }
+  globalSizes.resize(numGlobal, 0);
+  controller->AllReduce(sizes.data(), globalSizes.data(), numGlobal, vtkCommunicator::SUM_OP);
+
+  if (this->RegionIdAssignmentMode == CELL_COUNT_DESCENDING ||
+    this->RegionIdAssignmentMode == CELL_COUNT_ASCENDING)
+  {
+    const bool descending = this->RegionIdAssignmentMode == CELL_COUNT_DESCENDING;
+    std::vector<vtkIdType> order(numGlobal);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](vtkIdType a, vtkIdType b) {
+      return descending ? globalSizes[a] > globalSizes[b] : globalSizes[a] < globalSizes[b];
+    });
+    std::vector<vtkIdType> newIds(numGlobal);
+    std::vector<vtkIdType> sortedSizes(numGlobal);
+    for (int cc = 0; cc < numGlobal; ++cc)
+    {
+      newIds[order[cc]] = cc;
+      sortedSizes[cc] = globalSizes[order[cc]];
+    }
+    for (vtkIdType& region : localToGlobal)
+    {
+      region = newIds[region];
+    }
+    globalSizes.swap(sortedSizes);
+  }
+
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "resolved %lld local regions (%lld in total) into %d global regions with %lld "
+    "cross-process links",
+    static_cast<long long>(numLocal), static_cast<long long>(total), numGlobal,
+    static_cast<long long>(numMatches));
+  return true;
 }
 
+//----------------------------------------------------------------------------
 void vtkPVConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ResolveRegionsAcrossProcesses: " << this->ResolveRegionsAcrossProcesses
+     << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
@@ -20,6 +20,16 @@
  * changes the default settings.  We want different defaults than
  * vtkConnectivityFilter has, but we don't want the user to have access to
  * these parameters in the UI.
+ *
+ * When running with more than one process, the regions found on each
+ * process are merged across process boundaries so that region ids and
+ * region sizes are globally consistent. Each process first labels its own
+ * cells, then points lying in the bounds of another process are exchanged
+ * with that process and matched by their coordinates. Regions touching the
+ * same point are merged with a vtkPEquivalenceSet. This applies to the
+ * VTK_EXTRACT_ALL_REGIONS, VTK_EXTRACT_LARGEST_REGION and
+ * VTK_EXTRACT_SPECIFIED_REGIONS modes; for the latter, the specified region
+ * ids are global ids. Other extraction modes are executed locally.
 */
 
 #ifndef vtkPVConnectivityFilter_h
@@ -28,6 +38,10 @@
 #include "vtkConnectivityFilter.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
 
+#include <vector> // for std::vector
+
+class vtkMultiProcessController;
+
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVConnectivityFilter : public vtkConnectivityFilter
 {
 public:
@@ -36,9 +50,43 @@ public:
 
   static vtkPVConnectivityFilter* New();
 
+  //@{
+  /**
+   * Get/Set the controller used to resolve regions across processes.
+   * Defaults to the global controller.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  //@{
+  /**
+   * When on (default), regions split between processes are merged so that
+   * region ids and sizes are consistent across all processes. When off, each
+   * process labels its own piece independently.
+   */
+  vtkSetMacro(ResolveRegionsAcrossProcesses, bool);
+  vtkGetMacro(ResolveRegionsAcrossProcesses, bool);
+  vtkBooleanMacro(ResolveRegionsAcrossProcesses, bool);
+  //@}
+
 protected:
   vtkPVConnectivityFilter();
-  ~vtkPVConnectivityFilter() override{};
+  ~vtkPVConnectivityFilter() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Merge the local regions of `output` with the ones of the other processes.
+   * On return, `localToGlobal` maps local region ids to global ones and
+   * `globalSizes` holds the number of cells in each global region. This is a
+   * collective operation.
+   */
+  bool ResolveGlobalRegions(vtkPointSet* output, std::vector<vtkIdType>& localToGlobal,
+    std::vector<vtkIdType>& globalSizes);
+
+  vtkMultiProcessController* Controller;
+  bool ResolveRegionsAcrossProcesses;
 
 private:
   vtkPVConnectivityFilter(const vtkPVConnectivityFilter&) = delete;
@@ -20,7 +20,11 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimerLog.h"
 // PV interface
 #include "vtkCallbackCommand.h"
 #include "vtkDataArraySelection.h"
@@ -1549,15 +1553,13 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
 {
   this->Controller = vtkMultiProcessController::GetGlobalController();
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
-  this->ShareGhostBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
+  this->InitializeBlocksTime = 0.0;
+  this->ShareGhostBlocksTime = 0.0;
   this->NumberOfBlocks = 0;
   this->NumberOfGhostBlocks = 0;
-  this->ProcessBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
-  this->ResolveEquivalencesTimer = vtkSmartPointer<vtkTimerLog>::New();
-#endif
+  this->ProcessBlocksTime = 0.0;
+  this->ResolveEquivalencesTime = 0.0;
 
 #ifdef vtkMaterialInterfaceFilterDEBUG
   int myProcId = this->Controller->GetLocalProcessId();
@@ -1852,10 +1854,8 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
   int numProcs = this->Controller->GetNumberOfProcesses();
   vtkMaterialInterfaceFilterHalfSphere* sphere = 0;
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer->StartTimer();
-#endif
+  double phaseStart = vtkTimerLog::GetUniversalTime();
 
   // leaving this logic alone rather than moving it into the
   // this->ClipFunction conditional because I don't know enough of the class to
@@ -2026,22 +2026,13 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     this->AddBlock(block, this->GetBlockGhostLevel());
   }
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer->StopTimer();
-#endif
-
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->ShareGhostBlocksTimer->StartTimer();
-#endif
+  double phaseEnd = vtkTimerLog::GetUniversalTime();
+  this->InitializeBlocksTime += phaseEnd - phaseStart;
+  phaseStart = phaseEnd;
 
 // cerr << "start ghost blocks\n" << endl;
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
   this->NumberOfBlocks = this->NumberOfInputBlocks;
-#endif
 
   // Broadcast all of the block meta data to all processes.
   // Setup ghost layer blocks.
@@ -2051,10 +2042,7 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     this->ShareGhostBlocks();
   }
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->ShareGhostBlocksTimer->StopTimer();
-#endif
+  this->ShareGhostBlocksTime += vtkTimerLog::GetUniversalTime() - phaseStart;
 
   return VTK_OK;
 }
@@ -2882,10 +2870,7 @@ void vtkMaterialInterfaceFilter::ShareGhostBlocks()
 // Process, extent
 // ...
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->NumberOfGhostBlocks = this->GhostBlocks.size();
-#endif
+  this->NumberOfGhostBlocks = static_cast<long>(this->GhostBlocks.size());
 
   /*
 
@@ -3397,11 +3382,13 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-#ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
+  this->InitializeBlocksTime = 0.0;
+  this->ShareGhostBlocksTime = 0.0;
   this->NumberOfBlocks = 0;
   this->NumberOfGhostBlocks = 0;
-#endif
+  this->ProcessBlocksTime = 0.0;
+  this->ResolveEquivalencesTime = 0.0;
 
   if (this->ClipFunction)
   {
@@ -3589,40 +3576,29 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     //
     this->ProgressBlockInc = this->ProgressMaterialInc / (double)this->NumberOfInputBlocks / 2.0;
 //
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ProcessBlocksTimer->StartTimer();
-#endif
+    double phaseStart = vtkTimerLog::GetUniversalTime();
     int blockId;
     for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
     {
       // build fragments
       this->ProcessBlock(blockId);
     }
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ProcessBlocksTimer->StopTimer();
-#endif
+    double phaseEnd = vtkTimerLog::GetUniversalTime();
+    this->ProcessBlocksTime += phaseEnd - phaseStart;
 // char tmp[128];
 // sprintf(tmp, "C:/Law/tmp/mifSurface%d.vtp", this->Controller->GetLocalProcessId());
 // this->SaveBlockSurfaces(tmp);
 // sprintf(tmp, "C:/Law/tmp/mifGhost%d.vtp", this->Controller->GetLocalProcessId());
 // this->SaveGhostSurfaces(tmp);
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ResolveEquivalencesTimer->StartTimer();
-#endif
+    phaseStart = phaseEnd;
 
     // resolve: Merge local and remote geometry
     // correct integrated attributes, finialize integrations
     this->PrepareForResolveEquivalences();
     this->ResolveEquivalences();
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ResolveEquivalencesTimer->StopTimer();
-#endif
+    this->ResolveEquivalencesTime += vtkTimerLog::GetUniversalTime() - phaseStart;
 
     // update the resolved fragment count, so that next pass will start
     // where we left off here
@@ -3678,65 +3654,11 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
        << " MTime: " << this->GetMTime() << "." << endl;
 #endif
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  double initializeTime, shareGhostBlocksTime, processBlocksTime, resolveEquivalencesTime;
-  unsigned long numberOfBlocks, numberOfGhostBlocks;
-  initializeTime = this->InitializeBlocksTimer->GetElapsedTime();
-  shareGhostBlocksTime = this->ShareGhostBlocksTimer->GetElapsedTime();
-  processBlocksTime = this->ProcessBlocksTimer->GetElapsedTime();
-  resolveEquivalencesTime = this->ResolveEquivalencesTimer->GetElapsedTime();
-  numberOfBlocks = this->NumberOfBlocks;
-  numberOfGhostBlocks = this->NumberOfGhostBlocks;
-  if (this->Controller == 0)
-  {
-    cout << "InitializeTime: " << initializeTime << endl;
-    cout << "ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-    cout << "NumberOfBlocks: " << numberOfBlocks << endl;
-    cout << "NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-    cout << "ProcessBlocksTime: " << processBlocksTime << endl;
-    cout << "ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-  }
-  else
-  {
-    int numProcs = this->Controller->GetNumberOfProcesses();
-    if (this->Controller->GetLocalProcessId() == 0)
-    {
-      cout << "Process 0: \n";
-      cout << "  InitializeTime: " << initializeTime << endl;
-      cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-      cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-      cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-      cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-      cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-      for (int procIdx = 1; procIdx < numProcs; ++procIdx)
-      {
-        this->Controller->Receive(&initializeTime, 1, procIdx, 234908);
-        this->Controller->Receive(&shareGhostBlocksTime, 1, procIdx, 234909);
-        this->Controller->Receive(&processBlocksTime, 1, procIdx, 234910);
-        this->Controller->Receive(&resolveEquivalencesTime, 1, procIdx, 234911);
-        this->Controller->Receive(&numberOfBlocks, 1, procIdx, 234912);
-        this->Controller->Receive(&numberOfGhostBlocks, 1, procIdx, 234913);
-        cout << "Process " << procIdx << ": \n";
-        cout << "  InitializeTime: " << initializeTime << endl;
-        cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-        cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-        cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-        cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-        cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-      }
-    }
-    else
-    {
-      this->Controller->Send(&initializeTime, 1, 0, 234908);
-      this->Controller->Send(&shareGhostBlocksTime, 1, 0, 234909);
-      this->Controller->Send(&processBlocksTime, 1, 0, 234910);
-      this->Controller->Send(&resolveEquivalencesTime, 1, 0, 234911);
-      this->Controller->Send(&numberOfBlocks, 1, 0, 234912);
-      this->Controller->Send(&numberOfGhostBlocks, 1, 0, 234913);
-    }
-  }
-#endif
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "material interface: %ld blocks, %ld ghost blocks; initialize %g s, share ghost blocks %g s, "
+    "process blocks %g s, resolve equivalences %g s",
+    this->NumberOfBlocks, this->NumberOfGhostBlocks, this->InitializeBlocksTime,
+    this->ShareGhostBlocksTime, this->ProcessBlocksTime, this->ResolveEquivalencesTime);
 
   return 1;
 }
@@ -7536,29 +7458,10 @@ int vtkMaterialInterfaceFilter::CollectIntegratedAttributes(
   return 1;
 }
 //----------------------------------------------------------------------------
-// Replaces our own interated attributes with those received
-// from another process.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::ReceiveIntegratedAttributes(const int sourceProcId)
+// Replaces our own interated attributes with those packed in
+// a single block buffer.
+void vtkMaterialInterfaceFilter::UnPackIntegratedAttributes(vtkMaterialInterfaceCommBuffer& buffer)
 {
-  const int msgBase = 200000;
-
-  // prepare the comm buffer to receive attribute data
-  // pertaining to a single block(material)
-  vtkMaterialInterfaceCommBuffer buffer;
-  buffer.SizeHeader(1);
-
-  int thisMsgId = msgBase;
-  // receive buffer's header
-  this->Controller->Receive(buffer.GetHeader(), buffer.GetHeaderSize(), sourceProcId, thisMsgId);
-  ++thisMsgId;
-  // size buffer via on incoming header
-  buffer.SizeBuffer();
-  // receive attribute's data
-  this->Controller->Receive(buffer.GetBuffer(), buffer.GetBufferSize(), sourceProcId, thisMsgId);
-  ++thisMsgId;
-
   // unpack attribute data, with an explicit copy
   // into a local array
   const unsigned int nToUnPack = buffer.GetNumberOfTuples(0);
@@ -7600,19 +7503,43 @@ int vtkMaterialInterfaceFilter::ReceiveIntegratedAttributes(const int sourceProc
     ReNewVtkArrayPointer(this->FragmentSums[i], this->FragmentSums[i]->GetName());
     buffer.UnPack(this->FragmentSums[i], nCompsSum, nToUnPack, true);
   }
-
-  return 1;
 }
 
 //----------------------------------------------------------------------------
-// Send my integrated attributes to another process.
+// Replaces our own interated attributes with those received
+// from another process.
 //
 // return 0 on error.
-int vtkMaterialInterfaceFilter::SendIntegratedAttributes(const int recipientProcId)
+int vtkMaterialInterfaceFilter::ReceiveIntegratedAttributes(const int sourceProcId)
 {
-  const int myProcId = this->Controller->GetLocalProcessId();
   const int msgBase = 200000;
 
+  // prepare the comm buffer to receive attribute data
+  // pertaining to a single block(material)
+  vtkMaterialInterfaceCommBuffer buffer;
+  buffer.SizeHeader(1);
+
+  int thisMsgId = msgBase;
+  // receive buffer's header
+  this->Controller->Receive(buffer.GetHeader(), buffer.GetHeaderSize(), sourceProcId, thisMsgId);
+  ++thisMsgId;
+  // size buffer via on incoming header
+  buffer.SizeBuffer();
+  // receive attribute's data
+  this->Controller->Receive(buffer.GetBuffer(), buffer.GetBufferSize(), sourceProcId, thisMsgId);
+  ++thisMsgId;
+
+  this->UnPackIntegratedAttributes(buffer);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Pack my integrated attributes into a single block buffer.
+void vtkMaterialInterfaceFilter::PackIntegratedAttributes(vtkMaterialInterfaceCommBuffer& buffer)
+{
+  const int myProcId = this->Controller->GetLocalProcessId();
+
   // estimate buffer size (in bytes)
   const vtkIdType nToSend = this->FragmentVolumes->GetNumberOfTuples();
   unsigned int totalNumberOfComps = 1 + (this->ComputeMoments ? 4 : 0); // volume + moments
@@ -7638,7 +7565,6 @@ int vtkMaterialInterfaceFilter::SendIntegratedAttributes(const int recipientProc
   // prepare a comm buffer
   // Will use only a single block(material) of attribute data
   // We size the buffer, and set the number of fragments.
-  vtkMaterialInterfaceCommBuffer buffer;
   buffer.Initialize(myProcId, 1, bufferSize);
   buffer.SetNumberOfTuples(0, nToSend);
 
@@ -7670,6 +7596,18 @@ int vtkMaterialInterfaceFilter::SendIntegratedAttributes(const int recipientProc
   {
     buffer.Pack(this->FragmentSums[i]);
   }
+}
+
+//----------------------------------------------------------------------------
+// Send my integrated attributes to another process.
+//
+// return 0 on error.
+int vtkMaterialInterfaceFilter::SendIntegratedAttributes(const int recipientProcId)
+{
+  const int msgBase = 200000;
+
+  vtkMaterialInterfaceCommBuffer buffer;
+  this->PackIntegratedAttributes(buffer);
 
   // send the buffer in two parts, first the header, followed by
   // the attribute data
@@ -7708,23 +7646,26 @@ int vtkMaterialInterfaceFilter::BroadcastIntegratedAttributes(const int sourcePr
     return 1;
   }
 
-  // send mine to all
+  // The header sizes the buffer on the receiving processes, then
+  // the attribute data follows.
+  vtkMaterialInterfaceCommBuffer buffer;
   if (myProcId == sourceProcId)
   {
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      // skip me
-      if (procId == sourceProcId)
-      {
-        continue;
-      }
-      this->SendIntegratedAttributes(procId);
-    }
+    this->PackIntegratedAttributes(buffer);
   }
-  // receive from source
   else
   {
-    this->ReceiveIntegratedAttributes(sourceProcId);
+    buffer.SizeHeader(1);
+  }
+  this->Controller->Broadcast(buffer.GetHeader(), buffer.GetHeaderSize(), sourceProcId);
+  if (myProcId != sourceProcId)
+  {
+    buffer.SizeBuffer();
+  }
+  this->Controller->Broadcast(buffer.GetBuffer(), buffer.GetBufferSize(), sourceProcId);
+  if (myProcId != sourceProcId)
+  {
+    this->UnPackIntegratedAttributes(buffer);
   }
 
   return 1;
@@ -8280,24 +8221,7 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   const int numLocalMembers = set->GetNumberOfMembers();
 
   // Find a mapping between local fragment id and the global fragment ids.
-  if (myProcId == 0)
-  {
-    this->NumberOfRawFragmentsInProcess[0] = numLocalMembers;
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Receive(this->NumberOfRawFragmentsInProcess + ii, 1, ii, 875034);
-    }
-    // Now send the results back to all processes.
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Send(this->NumberOfRawFragmentsInProcess, numProcs, ii, 875035);
-    }
-  }
-  else
-  {
-    this->Controller->Send(&numLocalMembers, 1, 0, 875034);
-    this->Controller->Receive(this->NumberOfRawFragmentsInProcess, numProcs, 0, 875035);
-  }
+  this->Controller->AllGather(&numLocalMembers, this->NumberOfRawFragmentsInProcess, 1);
   // Compute offsets.
   int totalNumberOfIds = 0;
   for (int ii = 0; ii < numProcs; ++ii)
@@ -8366,54 +8290,48 @@ void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   const int numIds = globalSet->GetNumberOfMembers();
 
   // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
+  // Send all the sets to process 0 to be merged. Process 0 merges them one at
+  // a time so that it never holds more than two sets.
   if (myProcId > 0)
   {
     this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
   }
-
-  // Only process 0 from here out.
-
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
+  else
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    int numProcs = this->Controller->GetNumberOfProcesses();
+    int* tmp;
+    tmp = new int[numIds];
+    for (int ii = 1; ii < numProcs; ++ii)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
+      this->Controller->Receive(tmp, numIds, ii, 342320);
+      // Merge the values.
+      for (int jj = 0; jj < numIds; ++jj)
+      {
+        if (tmp[jj] != jj)
+        { // TODO: Make sure this is efficient.  Avoid n^2.
+          globalSet->AddEquivalence(jj, tmp[jj]);
+        }
       }
     }
-  }
-  delete[] tmp;
+    delete[] tmp;
 
-  // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+    // Make the set ids sequential.
+    this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  }
 
+  // Now all processes get the final equivalences.
   // The pointers should still be valid.
   // The array should not resize here.
   // Number of resolved fragemnts will be smaller
   // than TotalNumberOfRawFragments
-  for (int ii = 1; ii < numProcs; ++ii)
-  {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
-  }
+  this->Controller->Broadcast(&this->NumberOfResolvedFragments, 1, 0);
+  // Domain has numIds,  range has NumberOfResolvedFragments
+  this->Controller->Broadcast(buf, numIds, 0);
+  // We have to mark the set as resolved because the set being
+  // received has been resolved.  If we do not do this then
+  // We cannot get the proper set id.  Using the pointer
+  // here is a bad api.  TODO: Fix the API and make "Resolved" private.
+  globalSet->Resolved = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -9273,54 +9191,52 @@ int vtkMaterialInterfaceFilter::ComputeLocalFragmentOBB()
   int nLocal = static_cast<int>(resolvedFragmentIds.size());
 
   // OBB set up
-  vtkOBBTree* obbCalc;
-  double* pObb;
-  obbCalc = vtkOBBTree::New();
   assert("FragmentOBBs has incorrect size." && this->FragmentOBBs->GetNumberOfTuples() == nLocal);
-  pObb = this->FragmentOBBs->GetPointer(0);
+  double* obbs = this->FragmentOBBs->GetPointer(0);
+  // Fragments are independent, each thread uses its own calculator.
+  vtkSMPThreadLocalObject<vtkOBBTree> obbCalcs;
 
   // Traverse the fragments we own
-  for (int i = 0; i < nLocal; ++i)
-  {
-    // skip split fragments, these have already been
-    // taken care of.
-    if (fragmentSplitMarker[i] == 1)
+  vtkSMPTools::For(0, nLocal, [&](vtkIdType begin, vtkIdType end) {
+    vtkOBBTree* obbCalc = obbCalcs.Local();
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      pObb += 15;
-      continue;
-    }
+      // skip split fragments, these have already been
+      // taken care of.
+      if (fragmentSplitMarker[i] == 1)
+      {
+        continue;
+      }
+      double* pObb = obbs + 15 * i;
 
-    // get fragment mesh
-    int globalId = resolvedFragmentIds[i];
-    vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
+      // get fragment mesh
+      int globalId = resolvedFragmentIds[i];
+      vtkPolyData* thisFragment =
+        dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
 
-    // compute OBB
-    double size[3];
-    // (c_x,c_y,c_z),(max_x,max_y,max_z),(mid_x,mid_y,mid_z),(min_x,min_y,min_z),|max|,|mid|,|min|
-    obbCalc->ComputeOBB(thisFragment, pObb, pObb + 3, pObb + 6, pObb + 9, size);
-    // obbCalc->ComputeOBB(thisFragment->GetPoints(),pObb,pObb+3,pObb+6,pObb+9,size);
+      // compute OBB
+      double size[3];
+      // (c_x,c_y,c_z),(max_x,max_y,max_z),(mid_x,mid_y,mid_z),(min_x,min_y,min_z),|max|,|mid|,|min|
+      obbCalc->ComputeOBB(thisFragment, pObb, pObb + 3, pObb + 6, pObb + 9, size);
+      // obbCalc->ComputeOBB(thisFragment->GetPoints(),pObb,pObb+3,pObb+6,pObb+9,size);
 
-    // compute magnitudes
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12 + q] = 0;
-    }
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12] += pObb[3 + q] * pObb[3 + q];
-      pObb[13] += pObb[6 + q] * pObb[6 + q];
-      pObb[14] += pObb[9 + q] * pObb[9 + q];
-    }
-    for (int q = 0; q < 3; ++q)
-    {
-      pObb[12 + q] = sqrt(pObb[12 + q]);
+      // compute magnitudes
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12 + q] = 0;
+      }
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12] += pObb[3 + q] * pObb[3 + q];
+        pObb[13] += pObb[6 + q] * pObb[6 + q];
+        pObb[14] += pObb[9 + q] * pObb[9 + q];
+      }
+      for (int q = 0; q < 3; ++q)
+      {
+        pObb[12 + q] = sqrt(pObb[12 + q]);
+      }
     }
-
-    pObb += 15;
-  } // fragment traversal
-
-  // OBB clean up
-  obbCalc->Delete();
+  }); // fragment traversal
 
   return 1;
 }
@@ -9343,32 +9259,34 @@ int vtkMaterialInterfaceFilter::ComputeLocalFragmentAABBCenters()
   // AABB set up
   assert("FragmentAABBCenters is expected to be pre-allocated." &&
     this->FragmentAABBCenters->GetNumberOfTuples() == nLocal);
-  double aabb[6];
-  double* pCoaabb = this->FragmentAABBCenters->GetPointer(0);
+  double* coaabbs = this->FragmentAABBCenters->GetPointer(0);
 
   // Traverse the fragments we own
-  for (int i = 0; i < nLocal; ++i)
-  {
-    // skip fragments with geometry split over multiple
-    // processes. These have been already taken care of.
-    if (fragmentSplitMarker[i] == 1)
+  vtkSMPTools::For(0, nLocal, [&](vtkIdType begin, vtkIdType end) {
+    double aabb[6];
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      pCoaabb += 3;
-      continue;
-    }
+      // skip fragments with geometry split over multiple
+      // processes. These have been already taken care of.
+      if (fragmentSplitMarker[i] == 1)
+      {
+        continue;
+      }
+      double* pCoaabb = coaabbs + 3 * i;
 
-    int globalId = resolvedFragmentIds[i];
+      int globalId = resolvedFragmentIds[i];
 
-    vtkPolyData* thisFragment = dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
+      vtkPolyData* thisFragment =
+        dynamic_cast<vtkPolyData*>(resolvedFragments->GetPiece(globalId));
 
-    // AABB calculation
-    thisFragment->GetBounds(aabb);
-    for (int q = 0, k = 0; q < 3; ++q, k += 2)
-    {
-      pCoaabb[q] = (aabb[k] + aabb[k + 1]) / 2.0;
+      // AABB calculation
+      thisFragment->GetBounds(aabb);
+      for (int q = 0, k = 0; q < 3; ++q, k += 2)
+      {
+        pCoaabb[q] = (aabb[k] + aabb[k + 1]) / 2.0;
+      }
     }
-    pCoaabb += 3;
-  } // fragment traversal
+  }); // fragment traversal
 
   return 1;
 }
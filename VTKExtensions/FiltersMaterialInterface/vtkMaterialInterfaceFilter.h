@@ -21,15 +21,14 @@
  * a particle index as part of the cell data of the output.  It computes
  * the volume of each particle from the volume fraction.
  *
+ * The time spent in each phase of the filter is logged with the
+ * `PARAVIEW_LOG_EXECUTION_VERBOSITY()` and can be queried after the execution,
+ * see GetProcessBlocksTime() and friends.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkMaterialInterfaceFilterDEBUG
  * \endcode
- *
- * This will turn on profiling of how long each part of the filter takes
- * \code{.cpp}
- * #define vtkMaterialInterfaceFilterPROFILE
- * \endcode
 */
 
 #ifndef vtkMaterialInterfaceFilter_h
@@ -41,7 +40,6 @@
 #include <vector>                                             // needed for vector
 
 #include "vtkSmartPointer.h" // needed for smart pointer
-#include "vtkTimerLog.h"     // needed for vtkTimerLog.
 
 class vtkDataSet;
 class vtkImageData;
@@ -74,6 +72,17 @@ public:
   vtkTypeMacro(vtkMaterialInterfaceFilter, vtkMultiBlockDataSetAlgorithm);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * Time, in seconds, spent by this process in each phase of the last
+   * execution, summed over the materials.
+   */
+  vtkGetMacro(InitializeBlocksTime, double);
+  vtkGetMacro(ShareGhostBlocksTime, double);
+  vtkGetMacro(ProcessBlocksTime, double);
+  vtkGetMacro(ResolveEquivalencesTime, double);
+  //@}
+
   // PARAVIEW interface stuff
 
   /// Material sellection
@@ -403,6 +412,10 @@ protected:
   // Initialize our attribute arrays to ho9ld resolved attributes
   int PrepareToResolveIntegratedAttributes();
 
+  // Pack my integrated attributes into a single block buffer.
+  void PackIntegratedAttributes(vtkMaterialInterfaceCommBuffer& buffer);
+  // Replace my integrated attributes with the content of a buffer.
+  void UnPackIntegratedAttributes(vtkMaterialInterfaceCommBuffer& buffer);
   // Send my integrated attributes to another process.
   int SendIntegratedAttributes(const int recipientProcId);
   // Receive integrated attributes from another process.
@@ -713,15 +726,13 @@ protected:
   // By default set to 1
   unsigned char BlockGhostLevel;
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
-  vtkSmartPointer<vtkTimerLog> InitializeBlocksTimer;
-  vtkSmartPointer<vtkTimerLog> ShareGhostBlocksTimer;
+  double InitializeBlocksTime;
+  double ShareGhostBlocksTime;
   long NumberOfBlocks;
   long NumberOfGhostBlocks;
-  vtkSmartPointer<vtkTimerLog> ProcessBlocksTimer;
-  vtkSmartPointer<vtkTimerLog> ResolveEquivalencesTimer;
-#endif
+  double ProcessBlocksTime;
+  double ResolveEquivalencesTime;
 
 private:
   vtkMaterialInterfaceFilter(const vtkMaterialInterfaceFilter&) = delete;
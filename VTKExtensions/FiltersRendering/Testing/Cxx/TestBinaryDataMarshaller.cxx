@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestBinaryDataMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBinaryDataMarshaller.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkDataObject> RoundTrip(vtkDataObject* input)
+{
+  vtkNew<vtkBinaryDataMarshaller> marshaller;
+  if (!marshaller->Marshal(input))
+  {
+    return nullptr;
+  }
+  std::vector<char> buffer(marshaller->GetTotalLength());
+  marshaller->CopyTo(buffer.data());
+  return vtkBinaryDataMarshaller::Unmarshal(
+    buffer.data(), static_cast<vtkIdType>(buffer.size()));
+}
+
+// Same fallback as vtkMPIMoveData when the data cannot be marshalled.
+vtkSmartPointer<vtkDataObject> LegacyRoundTrip(vtkDataObject* input)
+{
+  vtkNew<vtkGenericDataObjectWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileTypeToBinary();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkGenericDataObjectReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString(), writer->GetOutputStringLength());
+  reader->Update();
+  return reader->GetOutputDataObject(0);
+}
+
+vtkSmartPointer<vtkPolyData> CreatePolyData()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(1, 1, 0);
+
+  vtkNew<vtkCellArray> polys;
+  vtkIdType tri0[3] = { 0, 1, 2 };
+  vtkIdType tri1[3] = { 1, 3, 2 };
+  polys->InsertNextCell(3, tri0);
+  polys->InsertNextCell(3, tri1);
+
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Temperature");
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    scalars->InsertNextValue(cc * 1.5f);
+  }
+
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetComponentName(0, "U");
+  velocity->SetComponentName(1, "V");
+  velocity->SetComponentName(2, "W");
+  velocity->SetNumberOfTuples(2);
+  velocity->SetTuple3(0, 1, 2, 3);
+  velocity->SetTuple3(1, 4, 5, 6);
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->GetPointData()->SetScalars(scalars);
+  pd->GetCellData()->AddArray(velocity);
+  return pd;
+}
+}
+
+int TestBinaryDataMarshaller(int, char* [])
+{
+  // vtkPolyData
+  auto pd = CreatePolyData();
+  auto pdOut = vtkPolyData::SafeDownCast(RoundTrip(pd));
+  if (!pdOut || pdOut->GetNumberOfPoints() != 4 || pdOut->GetNumberOfPolys() != 2)
+  {
+    cerr << "ERROR: vtkPolyData round trip lost points or cells." << endl;
+    return EXIT_FAILURE;
+  }
+  if (pdOut->GetPoint(3)[0] != 1.0 || pdOut->GetPoint(3)[1] != 1.0)
+  {
+    cerr << "ERROR: vtkPolyData round trip changed point coordinates." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!pdOut->GetPointData()->GetScalars() ||
+    pdOut->GetPointData()->GetScalars()->GetTuple1(3) != 4.5)
+  {
+    cerr << "ERROR: vtkPolyData round trip lost point scalars." << endl;
+    return EXIT_FAILURE;
+  }
+  auto velocity = pdOut->GetCellData()->GetArray("Velocity");
+  if (!velocity || velocity->GetNumberOfComponents() != 3 || velocity->GetComponent(1, 2) != 6.0 ||
+    std::string(velocity->GetComponentName(1)) != "V")
+  {
+    cerr << "ERROR: vtkPolyData round trip lost the 'Velocity' cell array." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkIdList> ptIds;
+  pdOut->GetCellPoints(1, ptIds);
+  if (ptIds->GetNumberOfIds() != 3 || ptIds->GetId(1) != 3)
+  {
+    cerr << "ERROR: vtkPolyData round trip changed the connectivity." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // vtkUnstructuredGrid
+  vtkNew<vtkUnstructuredGrid> ug;
+  ug->SetPoints(pd->GetPoints());
+  vtkIdType quad[4] = { 0, 1, 3, 2 };
+  ug->InsertNextCell(VTK_QUAD, 4, quad);
+  ug->InsertNextCell(VTK_TRIANGLE, 3, quad);
+  auto ugOut = vtkUnstructuredGrid::SafeDownCast(RoundTrip(ug));
+  if (!ugOut || ugOut->GetNumberOfCells() != 2 || ugOut->GetCellType(0) != VTK_QUAD ||
+    ugOut->GetCellType(1) != VTK_TRIANGLE)
+  {
+    cerr << "ERROR: vtkUnstructuredGrid round trip lost cells or cell types." << endl;
+    return EXIT_FAILURE;
+  }
+  ugOut->GetCellPoints(0, ptIds);
+  if (ptIds->GetNumberOfIds() != 4 || ptIds->GetId(2) != 3)
+  {
+    cerr << "ERROR: vtkUnstructuredGrid round trip changed the connectivity." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // vtkImageData: extents and origin must be preserved.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(2, 5, 0, 3, -1, 1);
+  image->SetOrigin(0.5, 1.5, 2.5);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  image->AllocateScalars(VTK_INT, 1);
+  auto imageOut = vtkImageData::SafeDownCast(RoundTrip(image));
+  if (!imageOut || imageOut->GetExtent()[0] != 2 || imageOut->GetExtent()[5] != 1 ||
+    imageOut->GetOrigin()[2] != 2.5 || imageOut->GetSpacing()[1] != 0.2)
+  {
+    cerr << "ERROR: vtkImageData round trip lost the extent, origin or spacing." << endl;
+    return EXIT_FAILURE;
+  }
+  if (imageOut->GetPointData()->GetScalars()->GetNumberOfTuples() != image->GetNumberOfPoints())
+  {
+    cerr << "ERROR: vtkImageData round trip lost point scalars." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // vtkMultiBlockDataSet, with block names and empty blocks.
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(3);
+  mb->SetBlock(0, pd);
+  mb->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  mb->SetBlock(2, ug);
+  auto mbOut = vtkMultiBlockDataSet::SafeDownCast(RoundTrip(mb));
+  if (!mbOut || mbOut->GetNumberOfBlocks() != 3 ||
+    vtkPolyData::SafeDownCast(mbOut->GetBlock(0)) == nullptr || mbOut->GetBlock(1) != nullptr ||
+    vtkUnstructuredGrid::SafeDownCast(mbOut->GetBlock(2)) == nullptr)
+  {
+    cerr << "ERROR: vtkMultiBlockDataSet round trip changed the blocks." << endl;
+    return EXIT_FAILURE;
+  }
+  if (std::string(mbOut->GetMetaData(0u)->Get(vtkCompositeDataSet::NAME())) != "surface")
+  {
+    cerr << "ERROR: vtkMultiBlockDataSet round trip lost the block names." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unsupported arrays must be rejected so that callers fallback to the
+  // legacy writer.
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Mask");
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    bits->InsertNextValue(cc % 3 == 0 ? 1 : 0);
+  }
+  pd->GetPointData()->AddArray(bits);
+  vtkNew<vtkBinaryDataMarshaller> bitsMarshaller;
+  mb->SetBlock(1, pd);
+  if (bitsMarshaller->Marshal(pd) || bitsMarshaller->Marshal(mb))
+  {
+    cerr << "ERROR: vtkBitArray must not be marshalled." << endl;
+    return EXIT_FAILURE;
+  }
+  auto bitsPDOut = vtkPolyData::SafeDownCast(LegacyRoundTrip(pd));
+  auto bitsOut =
+    bitsPDOut ? vtkBitArray::SafeDownCast(bitsPDOut->GetPointData()->GetArray("Mask")) : nullptr;
+  if (!bitsOut || bitsOut->GetNumberOfTuples() != 4 || bitsOut->GetValue(0) != 1 ||
+    bitsOut->GetValue(1) != 0 || bitsOut->GetValue(3) != 1)
+  {
+    cerr << "ERROR: legacy round trip lost the 'Mask' bit array." << endl;
+    return EXIT_FAILURE;
+  }
+  pd->GetPointData()->RemoveArray("Mask");
+
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Labels");
+  strings->InsertNextValue("a");
+  pd->GetFieldData()->AddArray(strings);
+  vtkNew<vtkBinaryDataMarshaller> marshaller;
+  if (marshaller->Marshal(pd))
+  {
+    cerr << "ERROR: vtkStringArray must not be marshalled." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Garbage must not be accepted.
+  const char garbage[] = "vtkPVBM1 not really";
+  if (vtkBinaryDataMarshaller::Unmarshal(garbage, sizeof(garbage)) != nullptr)
+  {
+    cerr << "ERROR: garbage buffer was unmarshalled." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCompactPolyDataCodec.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompactPolyDataCodec.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+// a grid of `dim` x `dim` points triangulated in strips of quads.
+vtkSmartPointer<vtkPolyData> CreatePolyData(int dim)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> elevation;
+  elevation->SetName("Elevation");
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      const double z = std::sin(0.1 * i) * std::cos(0.1 * j);
+      points->InsertNextPoint(0.25 * i, 0.25 * j, z);
+      elevation->InsertNextValue(static_cast<float>(z));
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  for (int j = 0; j + 1 < dim; ++j)
+  {
+    for (int i = 0; i + 1 < dim; ++i)
+    {
+      const vtkIdType p0 = j * dim + i;
+      vtkIdType tri0[3] = { p0, p0 + 1, p0 + dim };
+      vtkIdType tri1[3] = { p0 + 1, p0 + dim + 1, p0 + dim };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+      ids->InsertNextValue(static_cast<int>(2 * p0));
+      ids->InsertNextValue(-static_cast<int>(2 * p0 + 1));
+    }
+  }
+
+  vtkNew<vtkCellArray> verts;
+  vtkIdType vert = dim - 1;
+  verts->InsertNextCell(1, &vert);
+
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("TimeValue");
+  time->InsertNextValue(1.125);
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetVerts(verts);
+  pd->SetPolys(polys);
+  pd->GetPointData()->SetScalars(elevation);
+  pd->GetCellData()->AddArray(ids);
+  pd->GetFieldData()->AddArray(time);
+  return pd;
+}
+
+vtkSmartPointer<vtkPolyData> RoundTrip(vtkPolyData* input, int bits, vtkIdType* size = nullptr)
+{
+  vtkNew<vtkCompactPolyDataCodec> codec;
+  codec->SetCoordinateBits(bits);
+  codec->SetArrayBits(bits);
+  std::vector<char> buffer;
+  if (!codec->Encode(input, buffer))
+  {
+    return nullptr;
+  }
+  if (size)
+  {
+    *size = static_cast<vtkIdType>(buffer.size());
+  }
+  return vtkCompactPolyDataCodec::Decode(buffer.data(), static_cast<vtkIdType>(buffer.size()));
+}
+
+double MaximumDifference(vtkDataArray* a, vtkDataArray* b)
+{
+  double result = 0.0;
+  for (vtkIdType cc = 0; cc < a->GetNumberOfValues(); ++cc)
+  {
+    const int numComps = a->GetNumberOfComponents();
+    result = std::max(result,
+      std::abs(a->GetComponent(cc / numComps, cc % numComps) -
+        b->GetComponent(cc / numComps, cc % numComps)));
+  }
+  return result;
+}
+}
+
+int TestCompactPolyDataCodec(int, char* [])
+{
+  const int dim = 64;
+  auto pd = CreatePolyData(dim);
+
+  // Lossless encoding must reproduce the input exactly.
+  vtkIdType losslessSize = 0;
+  auto out = RoundTrip(pd, 0, &losslessSize);
+  if (!out || out->GetNumberOfPoints() != pd->GetNumberOfPoints() ||
+    out->GetNumberOfPolys() != pd->GetNumberOfPolys() || out->GetNumberOfVerts() != 1 ||
+    out->GetNumberOfLines() != 0)
+  {
+    cerr << "ERROR: lossless round trip lost points or cells." << endl;
+    return EXIT_FAILURE;
+  }
+  if (out->GetPoints()->GetDataType() != VTK_FLOAT ||
+    MaximumDifference(pd->GetPoints()->GetData(), out->GetPoints()->GetData()) != 0.0)
+  {
+    cerr << "ERROR: lossless round trip changed the points." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* scalars = out->GetPointData()->GetScalars();
+  if (!scalars || std::string(scalars->GetName()) != "Elevation" ||
+    MaximumDifference(pd->GetPointData()->GetScalars(), scalars) != 0.0)
+  {
+    cerr << "ERROR: lossless round trip changed the point scalars." << endl;
+    return EXIT_FAILURE;
+  }
+  auto ids = vtkIntArray::SafeDownCast(out->GetCellData()->GetArray("Ids"));
+  if (!ids || ids->GetValue(3) != -3 ||
+    out->GetFieldData()->GetArray("TimeValue")->GetTuple1(0) != 1.125)
+  {
+    cerr << "ERROR: lossless round trip changed the cell or field data." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkIdList> ptIds, expectedIds;
+  for (vtkIdType cellId : { vtkIdType(1), out->GetNumberOfCells() - 1 })
+  {
+    out->GetCellPoints(cellId, ptIds);
+    pd->GetCellPoints(cellId, expectedIds);
+    bool same = ptIds->GetNumberOfIds() == expectedIds->GetNumberOfIds();
+    for (vtkIdType cc = 0; same && cc < ptIds->GetNumberOfIds(); ++cc)
+    {
+      same = ptIds->GetId(cc) == expectedIds->GetId(cc);
+    }
+    if (!same)
+    {
+      cerr << "ERROR: lossless round trip changed the points of cell " << cellId << "." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Delta encoded connectivity must be smaller than the raw 64-bit ids.
+  if (losslessSize >= pd->GetPolys()->GetNumberOfConnectivityIds() * 8)
+  {
+    cerr << "ERROR: lossless encoding is too large: " << losslessSize << " bytes." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Quantized encoding is smaller and within half a quantization step.
+  vtkIdType lossySize = 0;
+  out = RoundTrip(pd, 12, &lossySize);
+  if (!out || lossySize >= losslessSize)
+  {
+    cerr << "ERROR: quantized encoding failed or is not smaller than the lossless one." << endl;
+    return EXIT_FAILURE;
+  }
+  double bounds[6];
+  pd->GetBounds(bounds);
+  const double step = (bounds[1] - bounds[0]) / 4095.0;
+  if (MaximumDifference(pd->GetPoints()->GetData(), out->GetPoints()->GetData()) > step ||
+    MaximumDifference(pd->GetPointData()->GetScalars(), out->GetPointData()->GetScalars()) >
+      2.0 / 4095.0)
+  {
+    cerr << "ERROR: quantized round trip error is larger than the quantization step." << endl;
+    return EXIT_FAILURE;
+  }
+  if (out->GetCellData()->GetArray("Ids")->GetTuple1(3) != -3.0 ||
+    out->GetFieldData()->GetArray("TimeValue")->GetTuple1(0) != 1.125)
+  {
+    cerr << "ERROR: quantized round trip changed integer or field data." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Empty poly data.
+  vtkNew<vtkPolyData> empty;
+  out = RoundTrip(empty, 0);
+  if (!out || out->GetNumberOfPoints() != 0 || out->GetNumberOfCells() != 0)
+  {
+    cerr << "ERROR: empty poly data round trip failed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Buffers carry the byte order of the encoding process, which peers compare
+  // before choosing this encoding; buffers with another byte order are
+  // rejected.
+  vtkNew<vtkCompactPolyDataCodec> codec;
+  std::vector<char> buffer;
+  char marker[vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE];
+  vtkCompactPolyDataCodec::GetByteOrderMarker(marker);
+  if (!codec->Encode(empty, buffer) ||
+    !std::equal(
+      marker, marker + vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE, buffer.begin() + 8))
+  {
+    cerr << "ERROR: encoded buffer does not hold the byte order marker." << endl;
+    return EXIT_FAILURE;
+  }
+  std::reverse(buffer.begin() + 8, buffer.begin() + 8 + sizeof(marker));
+  if (vtkCompactPolyDataCodec::Decode(buffer.data(), static_cast<vtkIdType>(buffer.size())))
+  {
+    cerr << "ERROR: buffer with another byte order was decoded." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unsupported arrays must be rejected so that callers fallback to the
+  // legacy encoding.
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Labels");
+  strings->InsertNextValue("a");
+  pd->GetFieldData()->AddArray(strings);
+  if (RoundTrip(pd, 0) != nullptr)
+  {
+    cerr << "ERROR: vtkStringArray must not be encoded." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Garbage must not be accepted.
+  const char garbage[] = "vtkPVCP1 not really";
+  if (vtkCompactPolyDataCodec::Decode(garbage, sizeof(garbage)) != nullptr)
+  {
+    cerr << "ERROR: garbage buffer was decoded." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
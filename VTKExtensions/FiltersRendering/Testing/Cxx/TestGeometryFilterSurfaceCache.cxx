@@ -0,0 +1,252 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestGeometryFilterSurfaceCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+const int Dim = 6;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Dim + 1) * (j + (Dim + 1) * k);
+}
+
+// hexahedra on a Dim^3 lattice.
+void BuildCells(vtkUnstructuredGrid* grid)
+{
+  grid->Allocate(Dim * Dim * Dim);
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        vtkIdType ids[8] = { PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+          PointId(i, j + 1, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+          PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+      }
+    }
+  }
+}
+
+// points and attributes for time `t`, the points move slightly over time.
+void BuildAttributes(vtkUnstructuredGrid* grid, double t)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> temperature;
+  temperature->SetName("Temperature");
+  for (int k = 0; k <= Dim; ++k)
+  {
+    for (int j = 0; j <= Dim; ++j)
+    {
+      for (int i = 0; i <= Dim; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * t, j, k);
+        temperature->InsertNextValue(std::sin(i + j + k + t));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(temperature);
+
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  for (vtkIdType cc = 0; cc < Dim * Dim * Dim; ++cc)
+  {
+    pressure->InsertNextValue(cc * t);
+  }
+  grid->GetCellData()->AddArray(pressure);
+}
+
+bool SameSurface(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    a->GetPointData()->GetNumberOfArrays() != b->GetPointData()->GetNumberOfArrays() ||
+    a->GetCellData()->GetNumberOfArrays() != b->GetCellData()->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  vtkDataArray* ta = a->GetPointData()->GetArray("Temperature");
+  vtkDataArray* tb = b->GetPointData()->GetArray("Temperature");
+  vtkDataArray* pa = a->GetCellData()->GetArray("Pressure");
+  vtkDataArray* pb = b->GetCellData()->GetArray("Pressure");
+  if (!ta || !tb || !pa || !pb)
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < ta->GetNumberOfTuples(); ++cc)
+  {
+    if (ta->GetTuple1(cc) != tb->GetTuple1(cc))
+    {
+      return false;
+    }
+  }
+  for (vtkIdType cc = 0; cc < pa->GetNumberOfTuples(); ++cc)
+  {
+    if (pa->GetTuple1(cc) != pb->GetTuple1(cc))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> Reference(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetCacheSurfaceTopology(false);
+  filter->SetInputData(grid);
+  filter->Update();
+  return vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+}
+}
+
+int TestGeometryFilterSurfaceCache(int, char* [])
+{
+  // time steps are fed through the same producer, as a reader would, so that
+  // the filter itself is not modified between executions.
+  vtkNew<vtkTrivialProducer> producer;
+  vtkNew<vtkPVGeometryFilter> filter;
+  if (!filter->GetCacheSurfaceTopology())
+  {
+    cerr << "ERROR: surface topology caching must be enabled by default." << endl;
+    return EXIT_FAILURE;
+  }
+  filter->SetInputConnection(producer->GetOutputPort());
+
+  // time step 0 extracts the surface.
+  vtkNew<vtkUnstructuredGrid> step0;
+  BuildCells(step0);
+  BuildAttributes(step0, 0.0);
+  producer->SetOutput(step0);
+  filter->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfCells() != 6 * Dim * Dim ||
+    !SameSurface(output, Reference(step0)))
+  {
+    cerr << "ERROR: unexpected surface for time step 0." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkCellArray> polys = output->GetPolys();
+
+  // time step 1 shares the topology arrays, only points and attributes change.
+  vtkNew<vtkUnstructuredGrid> step1;
+  step1->SetCells(step0->GetCellTypesArray(), step0->GetCells());
+  BuildAttributes(step1, 1.0);
+  producer->SetOutput(step1);
+  filter->Update();
+  output = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  if (output->GetPolys() != polys)
+  {
+    cerr << "ERROR: cached surface was not reused for shared topology arrays." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, Reference(step1)) ||
+    !output->GetPointData()->GetArray("vtkOriginalPointIds") ||
+    !output->GetCellData()->GetArray("vtkOriginalCellIds"))
+  {
+    cerr << "ERROR: unexpected surface for time step 1." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // time step 2 rebuilds identical topology arrays, the content hash matches.
+  vtkNew<vtkUnstructuredGrid> step2;
+  BuildCells(step2);
+  BuildAttributes(step2, 2.0);
+  producer->SetOutput(step2);
+  filter->Update();
+  output = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  if (output->GetPolys() != polys)
+  {
+    cerr << "ERROR: cached surface was not reused for identical topology arrays." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, Reference(step2)))
+  {
+    cerr << "ERROR: unexpected surface for time step 2." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // a different topology must not reuse the cached surface.
+  vtkNew<vtkUnstructuredGrid> step3;
+  BuildCells(step3);
+  BuildAttributes(step3, 3.0);
+  vtkNew<vtkUnstructuredGrid> cropped;
+  cropped->SetPoints(step3->GetPoints());
+  cropped->GetPointData()->ShallowCopy(step3->GetPointData());
+  cropped->Allocate(Dim * Dim * Dim - 1);
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  for (vtkIdType cc = 1; cc < step3->GetNumberOfCells(); ++cc)
+  {
+    vtkNew<vtkIdList> ids;
+    step3->GetCellPoints(cc, ids);
+    cropped->InsertNextCell(VTK_HEXAHEDRON, ids);
+    pressure->InsertNextValue(static_cast<double>(cc));
+  }
+  cropped->GetCellData()->AddArray(pressure);
+  producer->SetOutput(cropped);
+  filter->Update();
+  output = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  if (output->GetPolys() == polys)
+  {
+    cerr << "ERROR: cached surface was reused for a different topology." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!SameSurface(output, Reference(cropped)))
+  {
+    cerr << "ERROR: unexpected surface for the cropped grid." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // changing a setting drops the cache and the output is still correct.
+  filter->SetPassThroughCellIds(0);
+  filter->Modified();
+  producer->SetOutput(step1);
+  filter->Update();
+  output = vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+  if (output->GetCellData()->GetArray("vtkOriginalCellIds") ||
+    output->GetNumberOfCells() != 6 * Dim * Dim)
+  {
+    cerr << "ERROR: unexpected surface after changing PassThroughCellIds." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
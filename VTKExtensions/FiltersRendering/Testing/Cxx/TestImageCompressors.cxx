@@ -26,6 +26,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -48,7 +49,8 @@ public:
 };
 typedef std::map<std::string, Data> MapType;
 
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+bool DoTest(
+  Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input, bool lossless = false)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
   vtkNew<vtkUnsignedCharArray> outputDeCompressed;
@@ -78,6 +80,15 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   data.DecompressTime += timer->GetElapsedTime();
   data.CompressedSize =
     outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
+
+  // lossless modes must reproduce the input exactly, whatever the tiling.
+  if (lossless &&
+    !std::equal(input->GetPointer(0), input->GetPointer(0) + input->GetNumberOfValues(),
+      outputDeCompressed->GetPointer(0)))
+  {
+    cerr << "ERROR: " << compressor->GetClassName() << " did not reproduce the input." << endl;
+    return false;
+  }
   return true;
 }
 
@@ -86,13 +97,17 @@ int TestImageCompressors(int argc, char* argv[])
   int max_count = 10;
   bool test_lossy = true;
   std::string imageFile;
+  int tileSize = 0;
 
-  // Use --image argument to use this for benchmarking.
+  // Use --image argument to use this for benchmarking, and --tile-size to
+  // compare the throughput for different tilings.
   vtksys::CommandLineArguments arg;
   arg.Initialize(argc, argv);
   typedef vtksys::CommandLineArguments argT;
   arg.AddArgument("--image", argT::EQUAL_ARGUMENT, &imageFile,
     "Optionally specify an image to use for compressing.");
+  arg.AddArgument("--tile-size", argT::EQUAL_ARGUMENT, &tileSize,
+    "Optionally specify the minimum number of pixels per tile.");
   arg.StoreUnusedArguments(true);
   if (!arg.Parse())
   {
@@ -109,6 +124,8 @@ int TestImageCompressors(int argc, char* argv[])
     imageFile += "/Testing/Data/NE2_ps_bath.png";
     max_count = 1;
     test_lossy = false;
+    // use small tiles so that the tiled code paths are exercised.
+    tileSize = tileSize > 0 ? tileSize : 4096;
   }
 
   vtkNew<vtkPNGReader> reader;
@@ -120,12 +137,27 @@ int TestImageCompressors(int argc, char* argv[])
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
+  // empty images are compressed as a single zero-byte tile.
+  vtkNew<vtkUnsignedCharArray> emptyInput;
+  emptyInput->SetNumberOfComponents(4);
+  Data emptyData;
+  vtkNew<vtkLZ4Compressor> emptyLZ4;
+  if (!DoTest(emptyData, emptyLZ4.Get(), emptyInput, true))
+  {
+    cerr << "ERROR: LZ4 failed on an empty image." << endl;
+    return TEST_FAILED;
+  }
+
   MapType datas;
   for (int cc = 0; cc < max_count; cc++)
   {
     vtkNew<vtkLZ4Compressor> lz4;
     lz4->SetQuality(0);
-    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input))
+    if (tileSize > 0)
+    {
+      lz4->SetMinimumTileSize(tileSize);
+    }
+    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input, true))
     {
       return TEST_FAILED;
     }
@@ -147,7 +179,11 @@ int TestImageCompressors(int argc, char* argv[])
 
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
-    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
+    if (tileSize > 0)
+    {
+      squirt->SetMinimumTileSize(tileSize);
+    }
+    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input, true))
     {
       return TEST_FAILED;
     }
@@ -198,13 +234,23 @@ int TestImageCompressors(int argc, char* argv[])
   cout << "Input: " << image->GetDimensions()[0] << "x" << image->GetDimensions()[1] << "x"
        << image->GetDimensions()[2] << " (uncompressed size: " << uncompressedSize << ") " << endl;
 
+  // report throughput in MB/s of uncompressed data, and compressed size
+  // relative to the uncompressed size.
+  const double megabytes = uncompressedSize / (1024.0 * 1024.0);
   for (MapType::iterator iter = datas.begin(); iter != datas.end(); ++iter)
   {
+    const double compressTime = iter->second.CompressTime / max_count;
+    const double decompressTime = iter->second.DecompressTime / max_count;
     cout << iter->first.c_str() << " :"
-         << " compress: " << (iter->second.CompressTime / max_count)
-         << " decompress: " << (iter->second.DecompressTime / max_count) << " compression ratio: "
-         << ((uncompressedSize - iter->second.CompressedSize) * 100.0 / uncompressedSize)
-         << "( compressed size: " << iter->second.CompressedSize << ")" << endl;
+         << " compress: " << compressTime << "s ("
+         << (compressTime > 0 ? megabytes / compressTime : 0.0) << " MB/s)"
+         << " decompress: " << decompressTime << "s ("
+         << (decompressTime > 0 ? megabytes / decompressTime : 0.0) << " MB/s)"
+         << " compression ratio: "
+         << (iter->second.CompressedSize > 0
+                ? static_cast<double>(uncompressedSize) / iter->second.CompressedSize
+                : 0.0)
+         << " (compressed size: " << iter->second.CompressedSize << ")" << endl;
   }
   return TEST_SUCCESS;
 }
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestThreadedGeometryFilter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellData.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+vtkSmartPointer<vtkImageData> CreateImage(int dim, double offset)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, dim, 0, dim, 0, dim);
+  image->SetOrigin(offset, 0, 0);
+  return vtkSmartPointer<vtkImageData>(image.GetPointer());
+}
+
+// blocks of very different sizes, some of them nested in a multipiece, and
+// some empty leaves.
+vtkSmartPointer<vtkMultiBlockDataSet> CreateInput()
+{
+  auto mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  mb->SetNumberOfBlocks(12);
+  for (unsigned int cc = 0; cc < 10; ++cc)
+  {
+    mb->SetBlock(cc, CreateImage(2 + 3 * cc, 40.0 * cc));
+  }
+  vtkNew<vtkMultiPieceDataSet> pieces;
+  pieces->SetNumberOfPieces(4);
+  for (unsigned int cc = 0; cc < 4; ++cc)
+  {
+    pieces->SetPiece(cc, CreateImage(5, -20.0 * (cc + 1)));
+  }
+  mb->SetBlock(10, pieces);
+  return mb;
+}
+
+vtkSmartPointer<vtkDataObjectTree> Execute(vtkMultiBlockDataSet* input, bool threaded)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetUseThreadedBlockExecution(threaded);
+  filter->SetInputData(input);
+  filter->Update();
+  return vtkDataObjectTree::SafeDownCast(filter->GetOutputDataObject(0));
+}
+}
+
+int TestThreadedGeometryFilter(int, char* [])
+{
+  auto input = CreateInput();
+  auto serial = Execute(input, false);
+  auto threaded = Execute(input, true);
+  if (!serial || !threaded)
+  {
+    cerr << "ERROR: missing output." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> sIter;
+  sIter.TakeReference(serial->NewTreeIterator());
+  sIter->SkipEmptyNodesOff();
+  vtkSmartPointer<vtkDataObjectTreeIterator> tIter;
+  tIter.TakeReference(threaded->NewTreeIterator());
+  tIter->SkipEmptyNodesOff();
+
+  int numLeaves = 0;
+  for (sIter->InitTraversal(), tIter->InitTraversal(); !sIter->IsDoneWithTraversal();
+       sIter->GoToNextItem(), tIter->GoToNextItem())
+  {
+    if (tIter->IsDoneWithTraversal() ||
+      sIter->GetCurrentFlatIndex() != tIter->GetCurrentFlatIndex())
+    {
+      cerr << "ERROR: threaded output does not have the same structure as the serial one."
+           << endl;
+      return EXIT_FAILURE;
+    }
+    const unsigned int index = sIter->GetCurrentFlatIndex();
+    vtkPolyData* sBlock = vtkPolyData::SafeDownCast(sIter->GetCurrentDataObject());
+    vtkPolyData* tBlock = vtkPolyData::SafeDownCast(tIter->GetCurrentDataObject());
+    if ((sBlock == nullptr) != (tBlock == nullptr))
+    {
+      cerr << "ERROR: block " << index << " is only present in one of the outputs." << endl;
+      return EXIT_FAILURE;
+    }
+    if (!sBlock)
+    {
+      continue;
+    }
+    if (sBlock->GetNumberOfPoints() != tBlock->GetNumberOfPoints() ||
+      sBlock->GetNumberOfCells() != tBlock->GetNumberOfCells())
+    {
+      cerr << "ERROR: block " << index << " has a different number of points or cells." << endl;
+      return EXIT_FAILURE;
+    }
+    if (sBlock->GetPointData()->GetNumberOfArrays() !=
+        tBlock->GetPointData()->GetNumberOfArrays() ||
+      sBlock->GetCellData()->GetNumberOfArrays() != tBlock->GetCellData()->GetNumberOfArrays() ||
+      !tBlock->GetCellData()->GetArray("vtkCompositeIndex") ||
+      !tBlock->GetFieldData()->GetArray("vtkBlockColors"))
+    {
+      cerr << "ERROR: block " << index << " has different arrays." << endl;
+      return EXIT_FAILURE;
+    }
+
+    double sBounds[6], tBounds[6];
+    sBlock->GetBounds(sBounds);
+    tBlock->GetBounds(tBounds);
+    for (int cc = 0; cc < 6; ++cc)
+    {
+      if (sBounds[cc] != tBounds[cc])
+      {
+        cerr << "ERROR: block " << index << " has different bounds." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    ++numLeaves;
+  }
+  if (!tIter->IsDoneWithTraversal() || numLeaves != 11)
+  {
+    cerr << "ERROR: unexpected number of leaves: " << numLeaves << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,825 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkBinaryDataMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBinaryDataMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// 8 bytes signature followed by 8 bytes header length.
+const char vtkBinaryDataMarshallerSignature[] = "vtkPVBM1";
+const vtkIdType vtkBinaryDataMarshallerPreambleSize = 16;
+const vtkTypeUInt32 vtkBinaryDataMarshallerEndianMarker = 0x01020304;
+const vtkTypeUInt32 vtkBinaryDataMarshallerSwappedEndianMarker = 0x04030201;
+
+//----------------------------------------------------------------------------
+class HeaderWriter
+{
+public:
+  std::vector<char> Bytes;
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    const char* ptr = reinterpret_cast<const char*>(&value);
+    this->Bytes.insert(this->Bytes.end(), ptr, ptr + sizeof(T));
+  }
+
+  void WriteString(const char* str)
+  {
+    const vtkTypeInt32 len = str ? static_cast<vtkTypeInt32>(strlen(str)) : -1;
+    this->Write(len);
+    if (len > 0)
+    {
+      this->Bytes.insert(this->Bytes.end(), str, str + len);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+class HeaderReader
+{
+public:
+  const char* Header;
+  vtkIdType HeaderLength;
+  vtkIdType HeaderPos;
+  const char* Payload;
+  vtkIdType PayloadLength;
+  vtkIdType PayloadPos;
+  bool Valid;
+  // set when the buffer was marshalled on a process with another byte order.
+  bool SwapBytes;
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (!this->Valid || this->HeaderPos + static_cast<vtkIdType>(sizeof(T)) > this->HeaderLength)
+    {
+      this->Valid = false;
+      return false;
+    }
+    memcpy(&value, this->Header + this->HeaderPos, sizeof(T));
+    this->HeaderPos += sizeof(T);
+    if (this->SwapBytes)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    return true;
+  }
+
+  // returns false on error; `isNull` is set when a nullptr string was written.
+  bool ReadString(std::string& str, bool& isNull)
+  {
+    vtkTypeInt32 len;
+    if (!this->Read(len))
+    {
+      return false;
+    }
+    isNull = (len < 0);
+    str.clear();
+    if (len > 0)
+    {
+      if (this->HeaderPos + len > this->HeaderLength)
+      {
+        this->Valid = false;
+        return false;
+      }
+      str.assign(this->Header + this->HeaderPos, len);
+      this->HeaderPos += len;
+    }
+    return true;
+  }
+
+  const char* ConsumePayload(vtkIdType length)
+  {
+    if (!this->Valid || this->PayloadPos + length > this->PayloadLength)
+    {
+      this->Valid = false;
+      return nullptr;
+    }
+    const char* ptr = this->Payload + this->PayloadPos;
+    this->PayloadPos += length;
+    return ptr;
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+class vtkBinaryDataMarshaller::vtkInternals
+{
+public:
+  HeaderWriter Header;
+  std::vector<const char*> SegmentPointers;
+  std::vector<vtkIdType> SegmentLengths;
+
+  // Arrays that had to be converted to the standard memory layout. These are
+  // held here so that segments pointing to them remain valid.
+  std::vector<vtkSmartPointer<vtkDataArray> > Temporaries;
+
+  void Reset()
+  {
+    this->Header.Bytes.clear();
+    this->SegmentPointers.clear();
+    this->SegmentLengths.clear();
+    this->Temporaries.clear();
+  }
+
+  //----------------------------------------------------------------------------
+  void AddArray(vtkDataArray* array, int attributeType)
+  {
+    vtkDataArray* source = array;
+    if (!array->HasStandardMemoryLayout())
+    {
+      vtkSmartPointer<vtkDataArray> aos;
+      aos.TakeReference(vtkDataArray::CreateDataArray(array->GetDataType()));
+      aos->DeepCopy(array);
+      this->Temporaries.push_back(aos);
+      source = aos;
+    }
+
+    const int numComps = source->GetNumberOfComponents();
+    const vtkTypeInt64 numTuples = source->GetNumberOfTuples();
+    this->Header.Write(static_cast<vtkTypeInt32>(source->GetDataType()));
+    this->Header.Write(static_cast<vtkTypeInt32>(source->GetDataTypeSize()));
+    this->Header.Write(static_cast<vtkTypeInt32>(numComps));
+    this->Header.Write(numTuples);
+    this->Header.Write(static_cast<vtkTypeInt32>(attributeType));
+    this->Header.WriteString(array->GetName());
+
+    const vtkTypeInt32 numCompNames = array->HasAComponentName() ? numComps : 0;
+    this->Header.Write(numCompNames);
+    for (int cc = 0; cc < numCompNames; ++cc)
+    {
+      this->Header.WriteString(array->GetComponentName(cc));
+    }
+
+    const vtkIdType length =
+      static_cast<vtkIdType>(numTuples * numComps) * source->GetDataTypeSize();
+    if (length > 0)
+    {
+      this->SegmentPointers.push_back(static_cast<const char*>(source->GetVoidPointer(0)));
+      this->SegmentLengths.push_back(length);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool CanMarshalFieldData(vtkFieldData* fd)
+  {
+    for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+    {
+      // bit arrays are not byte addressable: GetDataTypeSize() is 0 for them.
+      vtkDataArray* array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(cc));
+      if (array == nullptr || array->GetDataType() == VTK_BIT)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void AddFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    const vtkTypeInt32 numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    this->Header.Write(numArrays);
+    for (int cc = 0; cc < numArrays; ++cc)
+    {
+      this->AddArray(fd->GetArray(cc), dsa ? dsa->IsArrayAnAttribute(cc) : -1);
+    }
+  }
+
+  void AddCellArray(vtkCellArray* cells)
+  {
+    this->AddArray(cells->GetOffsetsArray(), -1);
+    this->AddArray(cells->GetConnectivityArray(), -1);
+  }
+
+  void AddPoints(vtkPoints* points)
+  {
+    this->Header.Write(static_cast<char>(points ? 1 : 0));
+    if (points)
+    {
+      this->AddArray(points->GetData(), -1);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  bool CanMarshal(vtkDataObject* dobj)
+  {
+    if (dobj == nullptr)
+    {
+      return true;
+    }
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      if (!vtkMultiBlockDataSet::SafeDownCast(cd) && !vtkMultiPieceDataSet::SafeDownCast(cd))
+      {
+        return false;
+      }
+      auto mb = vtkMultiBlockDataSet::SafeDownCast(cd);
+      auto mp = vtkMultiPieceDataSet::SafeDownCast(cd);
+      const unsigned int numBlocks = mb ? mb->GetNumberOfBlocks() : mp->GetNumberOfPieces();
+      for (unsigned int cc = 0; cc < numBlocks; ++cc)
+      {
+        if (!this->CanMarshal(mb ? mb->GetBlock(cc) : mp->GetPieceAsDataObject(cc)))
+        {
+          return false;
+        }
+      }
+      return this->CanMarshalFieldData(dobj->GetFieldData());
+    }
+
+    auto ds = vtkDataSet::SafeDownCast(dobj);
+    if (!vtkPolyData::SafeDownCast(dobj) && !vtkUnstructuredGrid::SafeDownCast(dobj) &&
+      !vtkImageData::SafeDownCast(dobj))
+    {
+      return false;
+    }
+    return this->CanMarshalFieldData(ds->GetPointData()) &&
+      this->CanMarshalFieldData(ds->GetCellData()) &&
+      this->CanMarshalFieldData(ds->GetFieldData());
+  }
+
+  //----------------------------------------------------------------------------
+  void AddDataObject(vtkDataObject* dobj)
+  {
+    if (dobj == nullptr)
+    {
+      this->Header.Write(static_cast<vtkTypeInt32>(-1));
+      return;
+    }
+
+    this->Header.Write(static_cast<vtkTypeInt32>(dobj->GetDataObjectType()));
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      auto mb = vtkMultiBlockDataSet::SafeDownCast(cd);
+      auto mp = vtkMultiPieceDataSet::SafeDownCast(cd);
+      const unsigned int numBlocks = mb ? mb->GetNumberOfBlocks() : mp->GetNumberOfPieces();
+      this->Header.Write(static_cast<vtkTypeUInt32>(numBlocks));
+      for (unsigned int cc = 0; cc < numBlocks; ++cc)
+      {
+        vtkInformation* metadata = nullptr;
+        if (mb ? mb->HasMetaData(cc) : mp->HasMetaData(cc))
+        {
+          metadata = mb ? mb->GetMetaData(cc) : mp->GetMetaData(cc);
+        }
+        const char* name = metadata ? metadata->Get(vtkCompositeDataSet::NAME()) : nullptr;
+        this->Header.WriteString(name);
+        this->AddDataObject(mb ? mb->GetBlock(cc) : mp->GetPieceAsDataObject(cc));
+      }
+      this->AddFieldData(dobj->GetFieldData());
+      return;
+    }
+
+    auto ds = vtkDataSet::SafeDownCast(dobj);
+    if (auto pd = vtkPolyData::SafeDownCast(dobj))
+    {
+      this->AddPoints(pd->GetPoints());
+      this->AddCellArray(pd->GetVerts());
+      this->AddCellArray(pd->GetLines());
+      this->AddCellArray(pd->GetPolys());
+      this->AddCellArray(pd->GetStrips());
+    }
+    else if (auto ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+    {
+      this->AddPoints(ug->GetPoints());
+      const bool hasCells = ug->GetCells() != nullptr && ug->GetCellTypesArray() != nullptr;
+      this->Header.Write(static_cast<char>(hasCells ? 1 : 0));
+      if (hasCells)
+      {
+        this->AddArray(ug->GetCellTypesArray(), -1);
+        this->AddCellArray(ug->GetCells());
+      }
+      const bool hasFaces = ug->GetFaces() != nullptr && ug->GetFaceLocations() != nullptr;
+      this->Header.Write(static_cast<char>(hasFaces ? 1 : 0));
+      if (hasFaces)
+      {
+        this->AddArray(ug->GetFaceLocations(), -1);
+        this->AddArray(ug->GetFaces(), -1);
+      }
+    }
+    else if (auto id = vtkImageData::SafeDownCast(dobj))
+    {
+      int extent[6];
+      double origin[3], spacing[3];
+      id->GetExtent(extent);
+      id->GetOrigin(origin);
+      id->GetSpacing(spacing);
+      for (int cc = 0; cc < 6; ++cc)
+      {
+        this->Header.Write(static_cast<vtkTypeInt32>(extent[cc]));
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Header.Write(origin[cc]);
+        this->Header.Write(spacing[cc]);
+      }
+    }
+    this->AddFieldData(ds->GetPointData());
+    this->AddFieldData(ds->GetCellData());
+    this->AddFieldData(ds->GetFieldData());
+  }
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// vtkIdType and long do not have the same size on all platforms. Returns the
+// fixed size type to use for values of `dataType` that are `size` bytes long
+// on the process that marshalled them, or -1 if they cannot be represented.
+int GetSizedDataType(int dataType, int size)
+{
+  if (dataType != VTK_ID_TYPE && dataType != VTK_LONG && dataType != VTK_UNSIGNED_LONG)
+  {
+    return -1;
+  }
+  const bool isUnsigned = (dataType == VTK_UNSIGNED_LONG);
+  switch (size)
+  {
+    case 4:
+      return isUnsigned ? VTK_TYPE_UINT32 : VTK_TYPE_INT32;
+    case 8:
+      return isUnsigned ? VTK_TYPE_UINT64 : VTK_TYPE_INT64;
+    default:
+      return -1;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> ReadArray(HeaderReader& reader, int* attributeType = nullptr)
+{
+  vtkTypeInt32 dataType, dataTypeSize, numComps, attrType, numCompNames;
+  vtkTypeInt64 numTuples;
+  std::string name;
+  bool nameIsNull;
+  if (!reader.Read(dataType) || !reader.Read(dataTypeSize) || !reader.Read(numComps) ||
+    !reader.Read(numTuples) || !reader.Read(attrType) || !reader.ReadString(name, nameIsNull) ||
+    !reader.Read(numCompNames))
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  if (array && array->GetDataTypeSize() != dataTypeSize)
+  {
+    array.TakeReference(vtkDataArray::CreateDataArray(GetSizedDataType(dataType, dataTypeSize)));
+  }
+  if (!array || dataType == VTK_BIT || numComps <= 0 || numTuples < 0)
+  {
+    reader.Valid = false;
+    return nullptr;
+  }
+  if (!nameIsNull)
+  {
+    array->SetName(name.c_str());
+  }
+  array->SetNumberOfComponents(numComps);
+  for (vtkTypeInt32 cc = 0; cc < numCompNames; ++cc)
+  {
+    std::string compName;
+    bool compNameIsNull;
+    if (!reader.ReadString(compName, compNameIsNull))
+    {
+      return nullptr;
+    }
+    if (!compNameIsNull)
+    {
+      array->SetComponentName(cc, compName.c_str());
+    }
+  }
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+
+  const vtkIdType length =
+    static_cast<vtkIdType>(numTuples * numComps) * array->GetDataTypeSize();
+  if (length > 0)
+  {
+    const char* src = reader.ConsumePayload(length);
+    if (src == nullptr)
+    {
+      return nullptr;
+    }
+    memcpy(array->GetVoidPointer(0), src, length);
+    if (reader.SwapBytes && array->GetDataTypeSize() > 1)
+    {
+      const size_t wordSize = static_cast<size_t>(array->GetDataTypeSize());
+      vtkByteSwap::SwapVoidRange(array->GetVoidPointer(0), length / wordSize, wordSize);
+    }
+  }
+  if (attributeType)
+  {
+    *attributeType = attrType;
+  }
+  return array;
+}
+
+//----------------------------------------------------------------------------
+bool ReadFieldData(HeaderReader& reader, vtkFieldData* fd)
+{
+  vtkTypeInt32 numArrays;
+  if (!reader.Read(numArrays))
+  {
+    return false;
+  }
+  vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+  {
+    int attributeType = -1;
+    auto array = ReadArray(reader, &attributeType);
+    if (!array)
+    {
+      return false;
+    }
+    if (dsa && attributeType >= 0)
+    {
+      dsa->SetAttribute(array, attributeType);
+    }
+    else
+    {
+      fd->AddArray(array);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ReadCellArray(HeaderReader& reader, vtkCellArray* cells)
+{
+  auto offsets = ReadArray(reader);
+  auto connectivity = offsets ? ReadArray(reader) : nullptr;
+  if (!connectivity)
+  {
+    return false;
+  }
+  if (offsets->GetNumberOfTuples() == 0)
+  {
+    // empty vtkCellArray have an empty offsets array, which SetData rejects.
+    cells->Initialize();
+    return true;
+  }
+  return cells->SetData(offsets, connectivity);
+}
+
+//----------------------------------------------------------------------------
+bool ReadPoints(HeaderReader& reader, vtkPointSet* ps)
+{
+  char hasPoints;
+  if (!reader.Read(hasPoints))
+  {
+    return false;
+  }
+  if (hasPoints)
+  {
+    auto array = ReadArray(reader);
+    if (!array)
+    {
+      return false;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetData(array);
+    ps->SetPoints(points);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> ReadDataObject(HeaderReader& reader)
+{
+  vtkTypeInt32 dataType;
+  if (!reader.Read(dataType) || dataType < 0)
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataObject> dobj;
+  dobj.TakeReference(vtkDataObjectTypes::NewDataObject(dataType));
+  if (!dobj)
+  {
+    reader.Valid = false;
+    return nullptr;
+  }
+
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    auto mb = vtkMultiBlockDataSet::SafeDownCast(cd);
+    auto mp = vtkMultiPieceDataSet::SafeDownCast(cd);
+    vtkTypeUInt32 numBlocks;
+    if ((!mb && !mp) || !reader.Read(numBlocks))
+    {
+      reader.Valid = false;
+      return nullptr;
+    }
+    mb ? mb->SetNumberOfBlocks(numBlocks) : mp->SetNumberOfPieces(numBlocks);
+    for (vtkTypeUInt32 cc = 0; cc < numBlocks; ++cc)
+    {
+      std::string name;
+      bool nameIsNull;
+      if (!reader.ReadString(name, nameIsNull))
+      {
+        return nullptr;
+      }
+      auto block = ReadDataObject(reader);
+      if (!reader.Valid)
+      {
+        return nullptr;
+      }
+      mb ? mb->SetBlock(cc, block) : mp->SetPiece(cc, block);
+      if (!nameIsNull)
+      {
+        (mb ? mb->GetMetaData(cc) : mp->GetMetaData(cc))
+          ->Set(vtkCompositeDataSet::NAME(), name.c_str());
+      }
+    }
+    return ReadFieldData(reader, dobj->GetFieldData()) ? dobj : nullptr;
+  }
+
+  auto ds = vtkDataSet::SafeDownCast(dobj);
+  if (auto pd = vtkPolyData::SafeDownCast(dobj))
+  {
+    vtkNew<vtkCellArray> verts, lines, polys, strips;
+    if (!ReadPoints(reader, pd) || !ReadCellArray(reader, verts) ||
+      !ReadCellArray(reader, lines) || !ReadCellArray(reader, polys) ||
+      !ReadCellArray(reader, strips))
+    {
+      return nullptr;
+    }
+    pd->SetVerts(verts);
+    pd->SetLines(lines);
+    pd->SetPolys(polys);
+    pd->SetStrips(strips);
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+  {
+    char hasCells, hasFaces;
+    if (!ReadPoints(reader, ug) || !reader.Read(hasCells))
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataArray> types;
+    vtkNew<vtkCellArray> cells;
+    if (hasCells)
+    {
+      types = ReadArray(reader);
+      if (!types || !ReadCellArray(reader, cells))
+      {
+        return nullptr;
+      }
+    }
+    if (!reader.Read(hasFaces))
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataArray> faceLocations, faces;
+    if (hasFaces)
+    {
+      faceLocations = ReadArray(reader);
+      faces = faceLocations ? ReadArray(reader) : nullptr;
+      if (!faces)
+      {
+        return nullptr;
+      }
+    }
+    auto typesUC = vtkUnsignedCharArray::SafeDownCast(types);
+    if (hasCells && typesUC)
+    {
+      if (hasFaces)
+      {
+        ug->SetCells(typesUC, cells, vtkIdTypeArray::SafeDownCast(faceLocations),
+          vtkIdTypeArray::SafeDownCast(faces));
+      }
+      else
+      {
+        ug->SetCells(typesUC, cells);
+      }
+    }
+  }
+  else if (auto id = vtkImageData::SafeDownCast(dobj))
+  {
+    vtkTypeInt32 extent[6];
+    double origin[3], spacing[3];
+    for (int cc = 0; cc < 6; ++cc)
+    {
+      reader.Read(extent[cc]);
+    }
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      reader.Read(origin[cc]);
+      reader.Read(spacing[cc]);
+    }
+    if (!reader.Valid)
+    {
+      return nullptr;
+    }
+    id->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+    id->SetOrigin(origin);
+    id->SetSpacing(spacing);
+  }
+  else
+  {
+    reader.Valid = false;
+    return nullptr;
+  }
+
+  if (!ReadFieldData(reader, ds->GetPointData()) || !ReadFieldData(reader, ds->GetCellData()) ||
+    !ReadFieldData(reader, ds->GetFieldData()))
+  {
+    return nullptr;
+  }
+  return dobj;
+}
+}
+
+vtkStandardNewMacro(vtkBinaryDataMarshaller);
+//----------------------------------------------------------------------------
+vtkBinaryDataMarshaller::vtkBinaryDataMarshaller()
+  : Internals(new vtkBinaryDataMarshaller::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkBinaryDataMarshaller::~vtkBinaryDataMarshaller()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkBinaryDataMarshaller::Reset()
+{
+  this->Internals->Reset();
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryDataMarshaller::Marshal(vtkDataObject* data)
+{
+  auto& internals = (*this->Internals);
+  internals.Reset();
+  if (data == nullptr || !internals.CanMarshal(data))
+  {
+    return false;
+  }
+
+  // Preamble: signature and header length (filled in once known).
+  internals.Header.Bytes.insert(internals.Header.Bytes.end(), vtkBinaryDataMarshallerSignature,
+    vtkBinaryDataMarshallerSignature + 8);
+  internals.Header.Write(static_cast<vtkTypeInt64>(0));
+  internals.Header.Write(vtkBinaryDataMarshallerEndianMarker);
+
+  // Segment 0 is the header. Its pointer is set once the header is complete
+  // since the vector may be reallocated as the header grows.
+  internals.SegmentPointers.push_back(nullptr);
+  internals.SegmentLengths.push_back(0);
+  internals.AddDataObject(data);
+
+  const vtkTypeInt64 headerLength = static_cast<vtkTypeInt64>(internals.Header.Bytes.size()) -
+    vtkBinaryDataMarshallerPreambleSize;
+  memcpy(&internals.Header.Bytes[8], &headerLength, sizeof(headerLength));
+  internals.SegmentPointers[0] = internals.Header.Bytes.data();
+  internals.SegmentLengths[0] = static_cast<vtkIdType>(internals.Header.Bytes.size());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkBinaryDataMarshaller::GetNumberOfSegments() const
+{
+  return static_cast<int>(this->Internals->SegmentPointers.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkBinaryDataMarshaller::GetSegmentPointer(int index) const
+{
+  return this->Internals->SegmentPointers[index];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBinaryDataMarshaller::GetSegmentLength(int index) const
+{
+  return this->Internals->SegmentLengths[index];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBinaryDataMarshaller::GetTotalLength() const
+{
+  vtkIdType total = 0;
+  for (const auto& length : this->Internals->SegmentLengths)
+  {
+    total += length;
+  }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+void vtkBinaryDataMarshaller::CopyTo(char* buffer) const
+{
+  const auto& internals = (*this->Internals);
+  for (size_t cc = 0; cc < internals.SegmentPointers.size(); ++cc)
+  {
+    memcpy(buffer, internals.SegmentPointers[cc], internals.SegmentLengths[cc]);
+    buffer += internals.SegmentLengths[cc];
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryDataMarshaller::IsMarshalledBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer != nullptr && length >= vtkBinaryDataMarshallerPreambleSize &&
+    strncmp(buffer, vtkBinaryDataMarshallerSignature, 8) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkBinaryDataMarshaller::Unmarshal(
+  const char* buffer, vtkIdType length)
+{
+  if (!vtkBinaryDataMarshaller::IsMarshalledBuffer(buffer, length))
+  {
+    vtkGenericWarningMacro("Buffer was not generated by vtkBinaryDataMarshaller.");
+    return nullptr;
+  }
+
+  // the endian marker starts the header, right after the preamble.
+  vtkTypeUInt32 marker = 0;
+  if (length >= vtkBinaryDataMarshallerPreambleSize + static_cast<vtkIdType>(sizeof(marker)))
+  {
+    memcpy(&marker, buffer + vtkBinaryDataMarshallerPreambleSize, sizeof(marker));
+  }
+  if (marker != vtkBinaryDataMarshallerEndianMarker &&
+    marker != vtkBinaryDataMarshallerSwappedEndianMarker)
+  {
+    vtkGenericWarningMacro("Invalid endian marker.");
+    return nullptr;
+  }
+  const bool swapBytes = (marker == vtkBinaryDataMarshallerSwappedEndianMarker);
+
+  vtkTypeInt64 headerLength;
+  memcpy(&headerLength, buffer + 8, sizeof(headerLength));
+  if (swapBytes)
+  {
+    vtkByteSwap::SwapVoidRange(&headerLength, 1, sizeof(headerLength));
+  }
+  if (headerLength < 0 || vtkBinaryDataMarshallerPreambleSize + headerLength > length)
+  {
+    vtkGenericWarningMacro("Truncated buffer.");
+    return nullptr;
+  }
+
+  HeaderReader reader;
+  reader.Header = buffer + vtkBinaryDataMarshallerPreambleSize;
+  reader.HeaderLength = static_cast<vtkIdType>(headerLength);
+  reader.HeaderPos = 0;
+  reader.Payload = reader.Header + reader.HeaderLength;
+  reader.PayloadLength = length - vtkBinaryDataMarshallerPreambleSize - reader.HeaderLength;
+  reader.PayloadPos = 0;
+  reader.Valid = true;
+  reader.SwapBytes = swapBytes;
+  reader.HeaderPos = sizeof(marker);
+
+  auto result = ReadDataObject(reader);
+  if (!reader.Valid || !result)
+  {
+    vtkGenericWarningMacro("Failed to unmarshal data object.");
+    return nullptr;
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkBinaryDataMarshaller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfSegments: " << this->GetNumberOfSegments() << endl;
+  os << indent << "TotalLength: " << this->GetTotalLength() << endl;
+}
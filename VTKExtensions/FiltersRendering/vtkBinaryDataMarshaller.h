@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkBinaryDataMarshaller.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBinaryDataMarshaller
+ * @brief   native binary marshalling of data objects for data movement.
+ *
+ * vtkBinaryDataMarshaller serializes a data object as a small header that
+ * describes the structure of the dataset followed by the raw bytes of every
+ * array in the dataset. Unlike vtkGenericDataObjectWriter, no intermediate
+ * encoding is done: after a call to `Marshal`, the marshalled data is
+ * available as a list of segments, the first being the header and the rest
+ * pointing directly to the memory of the arrays in the dataset. The segments
+ * can be sent one by one (scatter/gather) or packed into a single contiguous
+ * buffer using `CopyTo`.
+ *
+ * Supported types are vtkPolyData, vtkUnstructuredGrid, vtkImageData
+ * (including vtkUniformGrid and vtkStructuredPoints) and
+ * vtkMultiBlockDataSet/vtkMultiPieceDataSet trees composed of these. Only
+ * vtkDataArray subclasses are supported for attribute arrays. `Marshal`
+ * returns false for everything else, in which case callers are expected to
+ * fallback to the legacy writer.
+ *
+ * The data object passed to `Marshal` must not be modified or released
+ * until the segments are no longer needed.
+ */
+
+#ifndef vtkBinaryDataMarshaller_h
+#define vtkBinaryDataMarshaller_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
+#include "vtkSmartPointer.h"                          // for vtkSmartPointer
+
+class vtkDataObject;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkBinaryDataMarshaller : public vtkObject
+{
+public:
+  static vtkBinaryDataMarshaller* New();
+  vtkTypeMacro(vtkBinaryDataMarshaller, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Marshal the data object. Returns false if the data object (or any of its
+   * arrays) is not supported by this marshaller. Any previously marshalled
+   * state is discarded.
+   */
+  bool Marshal(vtkDataObject* data);
+
+  /**
+   * Discard marshalled state.
+   */
+  void Reset();
+
+  //@{
+  /**
+   * Access the segments generated by the last successful call to `Marshal`.
+   * Segment 0 is the header; the rest point to array memory.
+   */
+  int GetNumberOfSegments() const;
+  const char* GetSegmentPointer(int index) const;
+  vtkIdType GetSegmentLength(int index) const;
+  //@}
+
+  /**
+   * Total number of bytes in all segments.
+   */
+  vtkIdType GetTotalLength() const;
+
+  /**
+   * Copy all segments, in order, to `buffer` which must be at least
+   * `GetTotalLength()` bytes long.
+   */
+  void CopyTo(char* buffer) const;
+
+  /**
+   * Returns true if the buffer starts with the binary marshaller signature.
+   */
+  static bool IsMarshalledBuffer(const char* buffer, vtkIdType length);
+
+  /**
+   * Reconstructs a data object from a contiguous buffer generated by `CopyTo`
+   * (or by receiving all segments back to back). Buffers marshalled on a
+   * process with another byte order or another size for `vtkIdType` and
+   * `long` are converted. Returns nullptr on error.
+   */
+  static vtkSmartPointer<vtkDataObject> Unmarshal(const char* buffer, vtkIdType length);
+
+protected:
+  vtkBinaryDataMarshaller();
+  ~vtkBinaryDataMarshaller() override;
+
+private:
+  vtkBinaryDataMarshaller(const vtkBinaryDataMarshaller&) = delete;
+  void operator=(const vtkBinaryDataMarshaller&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
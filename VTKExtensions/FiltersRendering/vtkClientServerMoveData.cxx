@@ -15,6 +15,7 @@
 #include "vtkClientServerMoveData.h"
 
 #include "vtkCharArray.h"
+#include "vtkCompactPolyDataCodec.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
@@ -23,7 +24,9 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -31,8 +34,24 @@
 #include "vtkSelectionSerializer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Encodings negotiated for each connection, shared by all instances.
+std::vector<std::pair<vtkWeakPointer<vtkMultiProcessController>, int> >&
+GetNegotiatedEncodingsCache()
+{
+  static std::vector<std::pair<vtkWeakPointer<vtkMultiProcessController>, int> > cache;
+  return cache;
+}
+}
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -48,6 +67,10 @@ vtkClientServerMoveData::vtkClientServerMoveData()
   this->WholeExtent[5] = -1;
   this->Controller = 0;
   this->ProcessType = AUTO;
+  this->DeliveryEncoding = COMPACT_ENCODING;
+  this->CoordinateQuantizationBits = 0;
+  this->ArrayQuantizationBits = 0;
+  this->LastDeliveredBytes = -1;
 }
 
 //-----------------------------------------------------------------------------
@@ -211,6 +234,49 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
+  if (this->OutputDataType == VTK_POLY_DATA)
+  {
+    const int encodings = this->NegotiateEncodings(controller, true);
+    vtkPolyData* pd = vtkPolyData::SafeDownCast(input);
+
+    int encoding = LEGACY_ENCODING;
+    std::vector<char> buffer;
+    if (pd && this->DeliveryEncoding == COMPACT_ENCODING &&
+      (encodings & (1 << COMPACT_ENCODING)) != 0)
+    {
+      vtkNew<vtkCompactPolyDataCodec> codec;
+      codec->SetCoordinateBits(this->CoordinateQuantizationBits);
+      codec->SetArrayBits(this->ArrayQuantizationBits);
+      if (codec->Encode(pd, buffer))
+      {
+        encoding = COMPACT_ENCODING;
+      }
+      else
+      {
+        vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+          "poly data has arrays not supported by the compact encoding");
+      }
+    }
+
+    controller->Send(&encoding, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (encoding == COMPACT_ENCODING)
+    {
+      vtkIdType length = static_cast<vtkIdType>(buffer.size());
+      this->LastDeliveredBytes = length;
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+        "sending %lld bytes using compact encoding (%lld bytes in memory)",
+        static_cast<long long>(length), static_cast<long long>(pd->GetActualMemorySize()) * 1024);
+      controller->Send(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+      return controller->Send(
+        buffer.data(), length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    this->LastDeliveredBytes = -1;
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+      "sending data using legacy encoding (%lld bytes in memory)",
+      static_cast<long long>(input ? input->GetActualMemorySize() : 0) * 1024);
+  }
+
   return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
 }
 
@@ -238,6 +304,38 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
     delete[] xml;
     data = sel;
   }
+  else if (this->OutputDataType == VTK_POLY_DATA)
+  {
+    this->NegotiateEncodings(controller, false);
+
+    int encoding = LEGACY_ENCODING;
+    controller->Receive(&encoding, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (encoding == COMPACT_ENCODING)
+    {
+      vtkIdType length = 0;
+      controller->Receive(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+      std::vector<char> buffer(length);
+      controller->Receive(buffer.data(), length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+      this->LastDeliveredBytes = length;
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "received %lld bytes using compact encoding",
+        static_cast<long long>(length));
+
+      auto pd = vtkCompactPolyDataCodec::Decode(buffer.data(), length);
+      if (!pd)
+      {
+        vtkErrorMacro("Failed to decode poly data received from the server.");
+        return NULL;
+      }
+      vtkPolyData* output = vtkPolyData::New();
+      output->ShallowCopy(pd);
+      data = output;
+    }
+    else
+    {
+      this->LastDeliveredBytes = -1;
+      data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+  }
   else
   {
     data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
@@ -245,6 +343,58 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   return data;
 }
 
+//-----------------------------------------------------------------------------
+int vtkClientServerMoveData::NegotiateEncodings(
+  vtkMultiProcessController* controller, bool is_server)
+{
+  auto& cache = GetNegotiatedEncodingsCache();
+  // forget about connections that were closed.
+  cache.erase(std::remove_if(cache.begin(), cache.end(),
+                [](const std::pair<vtkWeakPointer<vtkMultiProcessController>, int>& item) {
+                  return item.first.GetPointer() == nullptr;
+                }),
+    cache.end());
+  for (const auto& item : cache)
+  {
+    if (item.first.GetPointer() == controller)
+    {
+      return item.second;
+    }
+  }
+
+  const int supported = (1 << LEGACY_ENCODING) | (1 << COMPACT_ENCODING);
+  int remote = supported;
+  // the marker is exchanged as raw bytes so that the communicator does not
+  // swap it.
+  char marker[vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE];
+  vtkCompactPolyDataCodec::GetByteOrderMarker(marker);
+  if (is_server)
+  {
+    char remoteMarker[vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE];
+    controller->Receive(&remote, 1, 1, vtkClientServerMoveData::NEGOTIATE_ENCODINGS);
+    controller->Receive(remoteMarker, vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE, 1,
+      vtkClientServerMoveData::NEGOTIATE_ENCODINGS);
+    if (memcmp(marker, remoteMarker, vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE) != 0)
+    {
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+        "client has a different byte order, using legacy encoding");
+      remote &= ~(1 << COMPACT_ENCODING);
+    }
+  }
+  else
+  {
+    controller->Send(&supported, 1, 1, vtkClientServerMoveData::NEGOTIATE_ENCODINGS);
+    controller->Send(marker, vtkCompactPolyDataCodec::BYTE_ORDER_MARKER_SIZE, 1,
+      vtkClientServerMoveData::NEGOTIATE_ENCODINGS);
+  }
+
+  const int encodings = (supported & remote) | (1 << LEGACY_ENCODING);
+  cache.push_back(std::make_pair(vtkWeakPointer<vtkMultiProcessController>(controller), encodings));
+  vtkVLogF(
+    PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "negotiated delivery encodings: %d", encodings);
+  return encodings;
+}
+
 //-----------------------------------------------------------------------------
 void vtkClientServerMoveData::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -255,4 +405,8 @@ void vtkClientServerMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputDataType: " << this->OutputDataType << endl;
   os << indent << "ProcessType: " << this->ProcessType << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "DeliveryEncoding: " << this->DeliveryEncoding << endl;
+  os << indent << "CoordinateQuantizationBits: " << this->CoordinateQuantizationBits << endl;
+  os << indent << "ArrayQuantizationBits: " << this->ArrayQuantizationBits << endl;
+  os << indent << "LastDeliveredBytes: " << this->LastDeliveredBytes << endl;
 }
@@ -22,6 +22,13 @@
  * this filter behaves as a simple pass-through filter.
  * This can work with any data type, the application does not need to set
  * the output type before hand.
+ *
+ * vtkPolyData is delivered using vtkCompactPolyDataCodec when
+ * `DeliveryEncoding` is COMPACT_ENCODING and the client supports it; this is
+ * negotiated once per connection. Coordinates and floating point arrays can
+ * additionally be quantized with `CoordinateQuantizationBits` and
+ * `ArrayQuantizationBits`, trading precision for a smaller payload. The number
+ * of bytes sent is logged under `PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY`.
  * @warning
  * This filter may change the output in RequestData().
 */
@@ -32,7 +39,6 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 
-class vtkMultiProcessController;
 class vtkMultiProcessController;
 
 class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkClientServerMoveData
@@ -96,6 +102,48 @@ public:
     CLIENT = 2
   };
 
+  enum DeliveryEncodings
+  {
+    LEGACY_ENCODING = 0,
+    COMPACT_ENCODING = 1
+  };
+
+  //@{
+  /**
+   * Set/Get the encoding used to deliver vtkPolyData to the client. This only
+   * affects the server; the client decodes whatever it receives. Default is
+   * COMPACT_ENCODING.
+   */
+  vtkSetClampMacro(DeliveryEncoding, int, LEGACY_ENCODING, COMPACT_ENCODING);
+  vtkGetMacro(DeliveryEncoding, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of bits used to quantize point coordinates with the
+   * compact encoding. 0 (default) delivers coordinates without loss.
+   */
+  vtkSetClampMacro(CoordinateQuantizationBits, int, 0, 32);
+  vtkGetMacro(CoordinateQuantizationBits, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of bits used to quantize floating point point and cell
+   * data arrays with the compact encoding. 0 (default) delivers arrays without
+   * loss.
+   */
+  vtkSetClampMacro(ArrayQuantizationBits, int, 0, 32);
+  vtkGetMacro(ArrayQuantizationBits, int);
+  //@}
+
+  /**
+   * Returns the number of bytes sent or received by the last delivery of a
+   * vtkPolyData with the compact encoding, or -1 if the legacy encoding was
+   * used.
+   */
+  vtkGetMacro(LastDeliveredBytes, vtkIdType);
+
 protected:
   vtkClientServerMoveData();
   ~vtkClientServerMoveData() override;
@@ -119,15 +167,29 @@ protected:
   virtual int SendData(vtkDataObject*, vtkMultiProcessController*);
   virtual vtkDataObject* ReceiveData(vtkMultiProcessController*);
 
+  /**
+   * Exchanges the encodings supported by the client with the server the first
+   * time a connection is used by any vtkClientServerMoveData. The result is
+   * cached per `controller`. Returns the encodings both sides support as a
+   * bitmask of `1 << DeliveryEncodings`; the compact encoding is only
+   * supported when both sides have the same byte order.
+   */
+  int NegotiateEncodings(vtkMultiProcessController* controller, bool is_server);
+
   enum Tags
   {
-    TRANSMIT_DATA_OBJECT = 23483
+    TRANSMIT_DATA_OBJECT = 23483,
+    NEGOTIATE_ENCODINGS = 23484
   };
 
   int OutputDataType;
   int WholeExtent[6];
   int ProcessType;
   vtkMultiProcessController* Controller;
+  int DeliveryEncoding;
+  int CoordinateQuantizationBits;
+  int ArrayQuantizationBits;
+  vtkIdType LastDeliveredBytes;
 
 private:
   vtkClientServerMoveData(const vtkClientServerMoveData&) = delete;
@@ -0,0 +1,738 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkCompactPolyDataCodec.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCompactPolyDataCodec.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkTypeInt64Array.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace
+{
+const char vtkCompactPolyDataCodecSignature[] = "vtkPVCP1";
+const vtkIdType vtkCompactPolyDataCodecSignatureSize = 8;
+const vtkTypeUInt32 vtkCompactPolyDataCodecEndianMarker = 0x01020304;
+
+enum ArrayCodecs
+{
+  CODEC_RAW = 0,
+  CODEC_DELTA = 1,
+  CODEC_QUANTIZED = 2
+};
+
+//----------------------------------------------------------------------------
+inline vtkTypeUInt64 ZigZag(vtkTypeInt64 value)
+{
+  return (static_cast<vtkTypeUInt64>(value) << 1) ^ static_cast<vtkTypeUInt64>(value >> 63);
+}
+
+inline vtkTypeInt64 UnZigZag(vtkTypeUInt64 value)
+{
+  return static_cast<vtkTypeInt64>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+//----------------------------------------------------------------------------
+class Writer
+{
+public:
+  std::vector<char>& Bytes;
+
+  Writer(std::vector<char>& bytes)
+    : Bytes(bytes)
+  {
+  }
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    this->WriteRaw(&value, sizeof(T));
+  }
+
+  void WriteRaw(const void* data, size_t length)
+  {
+    const char* ptr = reinterpret_cast<const char*>(data);
+    this->Bytes.insert(this->Bytes.end(), ptr, ptr + length);
+  }
+
+  void WriteVarint(vtkTypeUInt64 value)
+  {
+    while (value >= 0x80)
+    {
+      this->Bytes.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    this->Bytes.push_back(static_cast<char>(value));
+  }
+
+  void WriteSigned(vtkTypeInt64 value) { this->WriteVarint(ZigZag(value)); }
+
+  void WriteString(const char* str)
+  {
+    const vtkTypeInt32 len = str ? static_cast<vtkTypeInt32>(strlen(str)) : -1;
+    this->Write(len);
+    if (len > 0)
+    {
+      this->WriteRaw(str, len);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+class Reader
+{
+public:
+  const char* Position;
+  const char* End;
+  bool Valid;
+
+  Reader(const char* buffer, vtkIdType length)
+    : Position(buffer)
+    , End(buffer + length)
+    , Valid(true)
+  {
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    return this->ReadRaw(&value, sizeof(T));
+  }
+
+  bool ReadRaw(void* data, size_t length)
+  {
+    if (!this->Valid || static_cast<size_t>(this->End - this->Position) < length)
+    {
+      this->Valid = false;
+      return false;
+    }
+    memcpy(data, this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  bool ReadVarint(vtkTypeUInt64& value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64 && this->Position < this->End; shift += 7)
+    {
+      const unsigned char byte = static_cast<unsigned char>(*this->Position++);
+      value |= static_cast<vtkTypeUInt64>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return true;
+      }
+    }
+    this->Valid = false;
+    return false;
+  }
+
+  bool ReadSigned(vtkTypeInt64& value)
+  {
+    vtkTypeUInt64 raw;
+    if (!this->ReadVarint(raw))
+    {
+      return false;
+    }
+    value = UnZigZag(raw);
+    return true;
+  }
+
+  bool ReadString(std::string& str, bool& isNull)
+  {
+    vtkTypeInt32 len;
+    if (!this->Read(len))
+    {
+      return false;
+    }
+    isNull = (len < 0);
+    str.clear();
+    if (len > 0)
+    {
+      if (this->End - this->Position < len)
+      {
+        this->Valid = false;
+        return false;
+      }
+      str.assign(this->Position, len);
+      this->Position += len;
+    }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Integer arrays: difference with the previous value of the same component.
+template <typename T>
+void EncodeDelta(Writer& writer, const T* data, vtkIdType numValues, int numComps)
+{
+  std::vector<vtkTypeUInt64> previous(numComps, 0);
+  for (vtkIdType cc = 0; cc < numValues; ++cc)
+  {
+    vtkTypeUInt64& prev = previous[cc % numComps];
+    const vtkTypeUInt64 value = static_cast<vtkTypeUInt64>(static_cast<vtkTypeInt64>(data[cc]));
+    writer.WriteSigned(static_cast<vtkTypeInt64>(value - prev));
+    prev = value;
+  }
+}
+
+template <typename T>
+bool DecodeDelta(Reader& reader, T* data, vtkIdType numValues, int numComps)
+{
+  std::vector<vtkTypeUInt64> previous(numComps, 0);
+  for (vtkIdType cc = 0; cc < numValues; ++cc)
+  {
+    vtkTypeInt64 delta;
+    if (!reader.ReadSigned(delta))
+    {
+      return false;
+    }
+    vtkTypeUInt64& prev = previous[cc % numComps];
+    prev += static_cast<vtkTypeUInt64>(delta);
+    data[cc] = static_cast<T>(static_cast<vtkTypeInt64>(prev));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Floating point arrays: values are mapped to integers in [0, 2^bits - 1]
+// over the range of each component, then delta encoded.
+template <typename T>
+bool ComputeRanges(const T* data, vtkIdType numTuples, int numComps, std::vector<double>& ranges)
+{
+  ranges.assign(2 * numComps, 0.0);
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    ranges[2 * comp] = VTK_DOUBLE_MAX;
+    ranges[2 * comp + 1] = VTK_DOUBLE_MIN;
+  }
+  for (vtkIdType tuple = 0; tuple < numTuples; ++tuple)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      const double value = static_cast<double>(data[tuple * numComps + comp]);
+      if (!vtkMath::IsFinite(value))
+      {
+        return false;
+      }
+      ranges[2 * comp] = std::min(ranges[2 * comp], value);
+      ranges[2 * comp + 1] = std::max(ranges[2 * comp + 1], value);
+    }
+  }
+  return true;
+}
+
+inline double GetMaximumQuantizedValue(int bits)
+{
+  return static_cast<double>((static_cast<vtkTypeUInt64>(1) << bits) - 1);
+}
+
+template <typename T>
+void EncodeQuantized(Writer& writer, const T* data, vtkIdType numTuples, int numComps, int bits,
+  const std::vector<double>& ranges)
+{
+  writer.Write(static_cast<vtkTypeInt32>(bits));
+  std::vector<double> scales(numComps);
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    writer.Write(ranges[2 * comp]);
+    writer.Write(ranges[2 * comp + 1]);
+    const double delta = ranges[2 * comp + 1] - ranges[2 * comp];
+    scales[comp] = delta > 0 ? GetMaximumQuantizedValue(bits) / delta : 0.0;
+  }
+
+  std::vector<vtkTypeInt64> previous(numComps, 0);
+  for (vtkIdType tuple = 0; tuple < numTuples; ++tuple)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      const double value = static_cast<double>(data[tuple * numComps + comp]);
+      const vtkTypeInt64 quantized =
+        static_cast<vtkTypeInt64>(std::floor((value - ranges[2 * comp]) * scales[comp] + 0.5));
+      writer.WriteSigned(quantized - previous[comp]);
+      previous[comp] = quantized;
+    }
+  }
+}
+
+template <typename T>
+bool DecodeQuantized(Reader& reader, T* data, vtkIdType numTuples, int numComps)
+{
+  vtkTypeInt32 bits;
+  if (!reader.Read(bits) || bits <= 0 || bits > 32)
+  {
+    reader.Valid = false;
+    return false;
+  }
+  std::vector<double> minimums(numComps), steps(numComps);
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    double range[2];
+    if (!reader.Read(range[0]) || !reader.Read(range[1]))
+    {
+      return false;
+    }
+    minimums[comp] = range[0];
+    steps[comp] = (range[1] - range[0]) / GetMaximumQuantizedValue(bits);
+  }
+
+  std::vector<vtkTypeInt64> previous(numComps, 0);
+  for (vtkIdType tuple = 0; tuple < numTuples; ++tuple)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      vtkTypeInt64 delta;
+      if (!reader.ReadSigned(delta))
+      {
+        return false;
+      }
+      previous[comp] += delta;
+      data[tuple * numComps + comp] =
+        static_cast<T>(minimums[comp] + static_cast<double>(previous[comp]) * steps[comp]);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void WriteArray(Writer& writer, vtkDataArray* array, int attributeType, int bits)
+{
+  vtkSmartPointer<vtkDataArray> source = array;
+  if (!array->HasStandardMemoryLayout())
+  {
+    source.TakeReference(vtkDataArray::CreateDataArray(array->GetDataType()));
+    source->DeepCopy(array);
+  }
+
+  const int dataType = source->GetDataType();
+  const int numComps = source->GetNumberOfComponents();
+  const vtkIdType numTuples = source->GetNumberOfTuples();
+  writer.Write(static_cast<vtkTypeInt32>(dataType));
+  writer.Write(static_cast<vtkTypeInt32>(numComps));
+  writer.Write(static_cast<vtkTypeInt64>(numTuples));
+  writer.Write(static_cast<vtkTypeInt32>(attributeType));
+  writer.WriteString(array->GetName());
+
+  const vtkTypeInt32 numCompNames = array->HasAComponentName() ? numComps : 0;
+  writer.Write(numCompNames);
+  for (int cc = 0; cc < numCompNames; ++cc)
+  {
+    writer.WriteString(array->GetComponentName(cc));
+  }
+
+  const bool isFloat = (dataType == VTK_FLOAT || dataType == VTK_DOUBLE);
+  std::vector<double> ranges;
+  char codec = CODEC_RAW;
+  if (isFloat && bits > 0)
+  {
+    bool finite = false;
+    switch (dataType)
+    {
+      vtkTemplateMacro(finite = ComputeRanges(
+                         static_cast<const VTK_TT*>(source->GetVoidPointer(0)), numTuples,
+                         numComps, ranges));
+    }
+    codec = finite ? CODEC_QUANTIZED : CODEC_RAW;
+  }
+  else if (!isFloat && source->GetDataTypeSize() > 1)
+  {
+    codec = CODEC_DELTA;
+  }
+  writer.Write(codec);
+
+  const vtkIdType numValues = numTuples * numComps;
+  switch (codec)
+  {
+    case CODEC_DELTA:
+      switch (dataType)
+      {
+        vtkTemplateMacro(EncodeDelta(
+          writer, static_cast<const VTK_TT*>(source->GetVoidPointer(0)), numValues, numComps));
+      }
+      break;
+
+    case CODEC_QUANTIZED:
+      switch (dataType)
+      {
+        vtkTemplateMacro(
+          EncodeQuantized(writer, static_cast<const VTK_TT*>(source->GetVoidPointer(0)),
+            numTuples, numComps, bits, ranges));
+      }
+      break;
+
+    default:
+      if (numValues > 0)
+      {
+        writer.WriteRaw(source->GetVoidPointer(0), numValues * source->GetDataTypeSize());
+      }
+      break;
+  }
+}
+
+vtkSmartPointer<vtkDataArray> ReadArray(Reader& reader, int* attributeType = nullptr)
+{
+  vtkTypeInt32 dataType, numComps, attrType, numCompNames;
+  vtkTypeInt64 numTuples;
+  std::string name;
+  bool nameIsNull;
+  if (!reader.Read(dataType) || !reader.Read(numComps) || !reader.Read(numTuples) ||
+    !reader.Read(attrType) || !reader.ReadString(name, nameIsNull) || !reader.Read(numCompNames))
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataArray> array;
+  array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  if (!array || numComps <= 0 || numTuples < 0)
+  {
+    reader.Valid = false;
+    return nullptr;
+  }
+  if (!nameIsNull)
+  {
+    array->SetName(name.c_str());
+  }
+  array->SetNumberOfComponents(numComps);
+  for (vtkTypeInt32 cc = 0; cc < numCompNames; ++cc)
+  {
+    std::string compName;
+    bool compNameIsNull;
+    if (!reader.ReadString(compName, compNameIsNull))
+    {
+      return nullptr;
+    }
+    if (!compNameIsNull)
+    {
+      array->SetComponentName(cc, compName.c_str());
+    }
+  }
+
+  char codec;
+  if (!reader.Read(codec))
+  {
+    return nullptr;
+  }
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+
+  const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComps;
+  bool status = false;
+  switch (codec)
+  {
+    case CODEC_RAW:
+      status = numValues == 0 ||
+        reader.ReadRaw(array->GetVoidPointer(0), numValues * array->GetDataTypeSize());
+      break;
+
+    case CODEC_DELTA:
+      switch (dataType)
+      {
+        vtkTemplateMacro(status = DecodeDelta(
+                           reader, static_cast<VTK_TT*>(array->GetVoidPointer(0)), numValues,
+                           numComps));
+      }
+      break;
+
+    case CODEC_QUANTIZED:
+      switch (dataType)
+      {
+        vtkTemplateMacro(status = DecodeQuantized(reader,
+                           static_cast<VTK_TT*>(array->GetVoidPointer(0)),
+                           static_cast<vtkIdType>(numTuples), numComps));
+      }
+      break;
+
+    default:
+      break;
+  }
+  if (!status)
+  {
+    reader.Valid = false;
+    return nullptr;
+  }
+
+  if (attributeType)
+  {
+    *attributeType = attrType;
+  }
+  return array;
+}
+
+//----------------------------------------------------------------------------
+bool CanEncodeFieldData(vtkFieldData* fd)
+{
+  for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+  {
+    vtkDataArray* array = vtkDataArray::SafeDownCast(fd->GetAbstractArray(cc));
+    if (array == nullptr || array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteFieldData(Writer& writer, vtkFieldData* fd, int bits)
+{
+  vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  const vtkTypeInt32 numArrays = fd ? fd->GetNumberOfArrays() : 0;
+  writer.Write(numArrays);
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    WriteArray(writer, fd->GetArray(cc), dsa ? dsa->IsArrayAnAttribute(cc) : -1, bits);
+  }
+}
+
+bool ReadFieldData(Reader& reader, vtkFieldData* fd)
+{
+  vtkTypeInt32 numArrays;
+  if (!reader.Read(numArrays))
+  {
+    return false;
+  }
+  vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+  {
+    int attributeType = -1;
+    auto array = ReadArray(reader, &attributeType);
+    if (!array)
+    {
+      return false;
+    }
+    if (dsa && attributeType >= 0)
+    {
+      dsa->SetAttribute(array, attributeType);
+    }
+    else
+    {
+      fd->AddArray(array);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Cell sizes and point ids are stored as differences with the previous one.
+template <typename T>
+void EncodeCells(Writer& writer, const T* offsets, const T* connectivity, vtkIdType numCells)
+{
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    writer.WriteVarint(static_cast<vtkTypeUInt64>(offsets[cc + 1] - offsets[cc]));
+  }
+  const vtkIdType connectivitySize = numCells > 0 ? static_cast<vtkIdType>(offsets[numCells]) : 0;
+  vtkTypeInt64 previous = 0;
+  for (vtkIdType cc = 0; cc < connectivitySize; ++cc)
+  {
+    writer.WriteSigned(static_cast<vtkTypeInt64>(connectivity[cc]) - previous);
+    previous = static_cast<vtkTypeInt64>(connectivity[cc]);
+  }
+}
+
+void WriteCellArray(Writer& writer, vtkCellArray* cells)
+{
+  const vtkIdType numCells = cells ? cells->GetNumberOfCells() : 0;
+  writer.Write(static_cast<vtkTypeInt64>(numCells));
+  writer.Write(static_cast<vtkTypeInt64>(numCells > 0 ? cells->GetNumberOfConnectivityIds() : 0));
+  if (numCells == 0)
+  {
+    return;
+  }
+  if (cells->IsStorage64Bit())
+  {
+    EncodeCells(writer, cells->GetOffsetsArray64()->GetPointer(0),
+      cells->GetConnectivityArray64()->GetPointer(0), numCells);
+  }
+  else
+  {
+    EncodeCells(writer, cells->GetOffsetsArray32()->GetPointer(0),
+      cells->GetConnectivityArray32()->GetPointer(0), numCells);
+  }
+}
+
+bool ReadCellArray(Reader& reader, vtkCellArray* cells)
+{
+  vtkTypeInt64 numCells, connectivitySize;
+  if (!reader.Read(numCells) || !reader.Read(connectivitySize) || numCells < 0 ||
+    connectivitySize < 0)
+  {
+    reader.Valid = false;
+    return false;
+  }
+  if (numCells == 0)
+  {
+    cells->Initialize();
+    return true;
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfTuples(static_cast<vtkIdType>(numCells + 1));
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  for (vtkTypeInt64 cc = 0; cc < numCells; ++cc)
+  {
+    vtkTypeUInt64 size;
+    if (!reader.ReadVarint(size))
+    {
+      return false;
+    }
+    offsetsPtr[cc + 1] = offsetsPtr[cc] + static_cast<vtkIdType>(size);
+  }
+  if (offsetsPtr[numCells] != connectivitySize)
+  {
+    reader.Valid = false;
+    return false;
+  }
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(static_cast<vtkIdType>(connectivitySize));
+  if (!DecodeDelta(reader, connectivity->GetPointer(0), connectivitySize, 1))
+  {
+    return false;
+  }
+  return cells->SetData(offsets, connectivity);
+}
+}
+
+vtkStandardNewMacro(vtkCompactPolyDataCodec);
+//----------------------------------------------------------------------------
+vtkCompactPolyDataCodec::vtkCompactPolyDataCodec()
+  : CoordinateBits(0)
+  , ArrayBits(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkCompactPolyDataCodec::~vtkCompactPolyDataCodec()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkCompactPolyDataCodec::Encode(vtkPolyData* input, std::vector<char>& buffer)
+{
+  buffer.clear();
+  if (input == nullptr || !CanEncodeFieldData(input->GetPointData()) ||
+    !CanEncodeFieldData(input->GetCellData()) || !CanEncodeFieldData(input->GetFieldData()))
+  {
+    return false;
+  }
+
+  Writer writer(buffer);
+  writer.WriteRaw(vtkCompactPolyDataCodecSignature, vtkCompactPolyDataCodecSignatureSize);
+  writer.Write(vtkCompactPolyDataCodecEndianMarker);
+
+  vtkPoints* points = input->GetPoints();
+  writer.Write(static_cast<char>(points ? 1 : 0));
+  if (points)
+  {
+    WriteArray(writer, points->GetData(), -1, this->CoordinateBits);
+  }
+  WriteCellArray(writer, input->GetVerts());
+  WriteCellArray(writer, input->GetLines());
+  WriteCellArray(writer, input->GetPolys());
+  WriteCellArray(writer, input->GetStrips());
+
+  WriteFieldData(writer, input->GetPointData(), this->ArrayBits);
+  WriteFieldData(writer, input->GetCellData(), this->ArrayBits);
+  // field data is usually small and may hold values that must be exact.
+  WriteFieldData(writer, input->GetFieldData(), 0);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCompactPolyDataCodec::IsEncodedBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer != nullptr && length >= vtkCompactPolyDataCodecSignatureSize &&
+    memcmp(buffer, vtkCompactPolyDataCodecSignature, vtkCompactPolyDataCodecSignatureSize) == 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactPolyDataCodec::GetByteOrderMarker(char marker[BYTE_ORDER_MARKER_SIZE])
+{
+  static_assert(sizeof(vtkCompactPolyDataCodecEndianMarker) == BYTE_ORDER_MARKER_SIZE,
+    "unexpected byte order marker size");
+  memcpy(marker, &vtkCompactPolyDataCodecEndianMarker, BYTE_ORDER_MARKER_SIZE);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkCompactPolyDataCodec::Decode(const char* buffer, vtkIdType length)
+{
+  if (!vtkCompactPolyDataCodec::IsEncodedBuffer(buffer, length))
+  {
+    return nullptr;
+  }
+
+  Reader reader(
+    buffer + vtkCompactPolyDataCodecSignatureSize, length - vtkCompactPolyDataCodecSignatureSize);
+  vtkTypeUInt32 marker;
+  char hasPoints;
+  if (!reader.Read(marker) || marker != vtkCompactPolyDataCodecEndianMarker ||
+    !reader.Read(hasPoints))
+  {
+    return nullptr;
+  }
+
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  if (hasPoints)
+  {
+    auto array = ReadArray(reader);
+    if (!array || array->GetNumberOfComponents() != 3)
+    {
+      return nullptr;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetData(array);
+    output->SetPoints(points);
+  }
+
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  if (!ReadCellArray(reader, verts) || !ReadCellArray(reader, lines) ||
+    !ReadCellArray(reader, polys) || !ReadCellArray(reader, strips))
+  {
+    return nullptr;
+  }
+  output->SetVerts(verts);
+  output->SetLines(lines);
+  output->SetPolys(polys);
+  output->SetStrips(strips);
+
+  if (!ReadFieldData(reader, output->GetPointData()) ||
+    !ReadFieldData(reader, output->GetCellData()) ||
+    !ReadFieldData(reader, output->GetFieldData()) || reader.Position != reader.End)
+  {
+    return nullptr;
+  }
+  return output;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactPolyDataCodec::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CoordinateBits: " << this->CoordinateBits << endl;
+  os << indent << "ArrayBits: " << this->ArrayBits << endl;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkCompactPolyDataCodec.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompactPolyDataCodec
+ * @brief   compact binary encoding of vtkPolyData for delivery to the client.
+ *
+ * vtkCompactPolyDataCodec encodes a vtkPolyData in a compact binary format
+ * meant to reduce the number of bytes sent over slow connections:
+ *
+ * \li cell connectivity is stored as the difference between consecutive
+ *     point ids and cell sizes as the difference between consecutive offsets,
+ *     both as zigzag variable length integers. Since neighboring cells mostly
+ *     reference neighboring points, most ids fit in one or two bytes.
+ * \li integer attribute arrays are delta encoded the same way.
+ * \li point coordinates can optionally be quantized to `CoordinateBits` bits
+ *     over the bounds of the points and delta encoded as well.
+ * \li floating point attribute arrays can optionally be quantized to
+ *     `ArrayBits` bits over the range of each component.
+ *
+ * Quantization is lossy and disabled by default (bits set to 0), in which case
+ * the encoding is lossless. Only vtkDataArray subclasses are supported for
+ * attribute and field data arrays; `Encode` returns false otherwise so
+ * callers can fallback to another encoding. Values are stored in the native
+ * byte order, see `GetByteOrderMarker`.
+ *
+ * @sa vtkBinaryDataMarshaller
+ */
+
+#ifndef vtkCompactPolyDataCodec_h
+#define vtkCompactPolyDataCodec_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
+#include "vtkSmartPointer.h"                          // for vtkSmartPointer
+#include <vector>                                     // for std::vector
+
+class vtkPolyData;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkCompactPolyDataCodec : public vtkObject
+{
+public:
+  static vtkCompactPolyDataCodec* New();
+  vtkTypeMacro(vtkCompactPolyDataCodec, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the number of bits used to quantize point coordinates. Set to 0
+   * (default) to store coordinates without loss.
+   */
+  vtkSetClampMacro(CoordinateBits, int, 0, 32);
+  vtkGetMacro(CoordinateBits, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of bits used to quantize floating point attribute
+   * arrays. Set to 0 (default) to store them without loss.
+   */
+  vtkSetClampMacro(ArrayBits, int, 0, 32);
+  vtkGetMacro(ArrayBits, int);
+  //@}
+
+  /**
+   * Encode `input` into `buffer`, replacing its contents. Returns false if
+   * the poly data has arrays that are not supported.
+   */
+  bool Encode(vtkPolyData* input, std::vector<char>& buffer);
+
+  /**
+   * Returns true if the buffer starts with the signature of this encoding.
+   */
+  static bool IsEncodedBuffer(const char* buffer, vtkIdType length);
+
+  /**
+   * Size in bytes of the byte order marker written by `Encode`.
+   */
+  static const int BYTE_ORDER_MARKER_SIZE = 4;
+
+  /**
+   * Copies the byte order marker of this process to `marker`. Buffers can only
+   * be decoded by processes with the same byte order, so peers compare their
+   * markers before choosing this encoding.
+   */
+  static void GetByteOrderMarker(char marker[BYTE_ORDER_MARKER_SIZE]);
+
+  /**
+   * Reconstructs the poly data from a buffer generated by `Encode`. Returns
+   * nullptr on error.
+   */
+  static vtkSmartPointer<vtkPolyData> Decode(const char* buffer, vtkIdType length);
+
+protected:
+  vtkCompactPolyDataCodec();
+  ~vtkCompactPolyDataCodec() override;
+
+  int CoordinateBits;
+  int ArrayBits;
+
+private:
+  vtkCompactPolyDataCodec(const vtkCompactPolyDataCodec&) = delete;
+  void operator=(const vtkCompactPolyDataCodec&) = delete;
+};
+
+#endif
@@ -17,7 +17,9 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -32,6 +34,7 @@ vtkImageCompressor::vtkImageCompressor()
   : Output(0)
   , Input(0)
   , LossLessMode(0)
+  , MinimumTileSize(65536)
   , Configuration(0)
 {
   // Always allocate output array as a convenience.
@@ -101,11 +104,20 @@ const char* vtkImageCompressor::RestoreConfiguration(const char* stream)
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::ComputeNumberOfTiles(vtkIdType numPixels) const
+{
+  const vtkIdType maxTiles = std::max<vtkIdType>(numPixels / this->MinimumTileSize, 1);
+  return static_cast<int>(
+    std::min<vtkIdType>(maxTiles, std::max(vtkSMPTools::GetEstimatedNumberOfThreads(), 1)));
+}
+
 //-----------------------------------------------------------------------------
 void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Input:          " << this->Input << endl
      << indent << "Output:         " << this->Output << endl
-     << indent << "LossLessMode: " << this->LossLessMode << endl;
+     << indent << "LossLessMode: " << this->LossLessMode << endl
+     << indent << "MinimumTileSize: " << this->MinimumTileSize << endl;
 }
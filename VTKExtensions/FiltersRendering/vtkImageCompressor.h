@@ -24,6 +24,10 @@
  * the LossLessMode ivar, which is used by the composite manager to force
  * loss less compression during a still render. Additionally compressors
  * must be able to seriealize and restore their setting from a stream.
+ *
+ * Compressors may split images in tiles that are compressed and decompressed
+ * independently on multiple threads. `MinimumTileSize` is the smallest number
+ * of pixels worth a tile of its own.
 */
 
 #ifndef vtkImageCompressor_h
@@ -78,6 +82,15 @@ public:
    */
   virtual int Decompress() = 0;
 
+  //@{
+  /**
+   * Set/Get the minimum number of pixels per tile, for compressors that
+   * compress tiles of the image in parallel. Default is 65536.
+   */
+  vtkSetClampMacro(MinimumTileSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(MinimumTileSize, vtkIdType);
+  //@}
+
   /**
    * Communicates the next expected image resolution.
    */
@@ -122,6 +135,13 @@ protected:
   vtkUnsignedCharArray* Input;
 
   int LossLessMode;
+  vtkIdType MinimumTileSize;
+
+  /**
+   * Returns the number of tiles to split an image of `numPixels` pixels in,
+   * based on `MinimumTileSize` and the number of threads available.
+   */
+  int ComputeNumberOfTiles(vtkIdType numPixels) const;
 
   vtkSetStringMacro(Configuration);
   char* Configuration;
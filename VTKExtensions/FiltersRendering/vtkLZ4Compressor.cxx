@@ -16,11 +16,26 @@
 
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Compressed images start with the number of tiles followed by the
+// uncompressed and compressed sizes of each tile, as 32-bit integers.
+// Compressed tiles follow.
+inline vtkIdType GetHeaderSize(vtkIdType numTiles)
+{
+  return static_cast<vtkIdType>(sizeof(vtkTypeInt32)) * (1 + 2 * numTiles);
+}
+}
 
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
@@ -56,27 +71,76 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const bool mask = compress_level > 0 && numComps == 4;
+  if (mask)
+  {
+    this->TemporaryBuffer->SetNumberOfComponents(numComps);
+    this->TemporaryBuffer->SetNumberOfTuples(numPixels);
+  }
+
+  // Tiles are compressed independently, each in the region of the output
+  // sized for its worst case, then moved next to each other after the header.
+  const int numTiles = this->ComputeNumberOfTiles(numPixels);
+  const vtkIdType headerSize = GetHeaderSize(numTiles);
+  std::vector<int> rawSizes(numTiles), compressedSizes(numTiles);
+  std::vector<vtkIdType> offsets(numTiles + 1, headerSize);
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    const vtkIdType first = tile * numPixels / numTiles;
+    const vtkIdType last = (tile + 1) * numPixels / numTiles;
+    rawSizes[tile] = static_cast<int>((last - first) * numComps);
+    offsets[tile + 1] = offsets[tile] + LZ4_compressBound(rawSizes[tile]);
+  }
+
+  char* out = reinterpret_cast<char*>(this->Output->WritePointer(0, offsets[numTiles]));
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      if (rawSizes[tile] == 0)
+      {
+        // empty tiles have no compressed data, see Decompress().
+        compressedSizes[tile] = 0;
+        continue;
+      }
+      const vtkIdType first = (tile * numPixels / numTiles) * numComps;
+      const unsigned char* tileInput = input->GetPointer(first);
+      if (mask)
+      {
+        const unsigned int* in = reinterpret_cast<const unsigned int*>(tileInput);
+        unsigned int* masked =
+          reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(first));
+        for (vtkIdType cc = 0, max = rawSizes[tile] / 4; cc < max; ++cc)
+        {
+          masked[cc] = in[cc] & compress_mask;
+        }
+        tileInput = this->TemporaryBuffer->GetPointer(first);
+      }
+      compressedSizes[tile] = LZ4_compress_fast(reinterpret_cast<const char*>(tileInput),
+        out + offsets[tile], rawSizes[tile],
+        static_cast<int>(offsets[tile + 1] - offsets[tile]), 16);
+    }
+  });
 
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
+  vtkTypeInt32 header[2];
+  header[0] = numTiles;
+  memcpy(out, header, sizeof(vtkTypeInt32));
+  vtkIdType size = headerSize;
+  for (int tile = 0; tile < numTiles; ++tile)
   {
-    this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
-    this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
-    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
-    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
+    if (compressedSizes[tile] <= 0 && rawSizes[tile] > 0)
     {
-      out[cc] = in[cc] & compress_mask;
+      return VTK_ERROR;
     }
-    input = this->TemporaryBuffer.Get();
+    header[0] = rawSizes[tile];
+    header[1] = compressedSizes[tile];
+    memcpy(out + sizeof(vtkTypeInt32) * (1 + 2 * tile), header, sizeof(header));
+    memmove(out + size, out + offsets[tile], compressedSizes[tile]);
+    size += compressedSizes[tile];
   }
-
-  int maxOutputSize = LZ4_compressBound(inputSize);
-  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input->GetPointer(0)),
-    reinterpret_cast<char*>(this->Output->WritePointer(0, maxOutputSize)), inputSize, maxOutputSize,
-    16);
-  this->Output->SetNumberOfTuples(compressedSize);
-  return compressedSize > 0 ? VTK_OK : VTK_ERROR;
+  this->Output->SetNumberOfTuples(size);
+  return VTK_OK;
 }
 
 //----------------------------------------------------------------------------
@@ -88,20 +152,63 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
-  int maxDecompressedSize =
-    this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
-  int decompressedSize =
-    LZ4_decompress_safe(reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-      reinterpret_cast<char*>(this->Output->GetPointer(0)), this->Input->GetNumberOfTuples(),
-      maxDecompressedSize);
-
-  //  // We use LZ4_decompress_safe for now since there seems to be some bug
-  //  // in LZ4_decompress_fast which is causing segfaults on Windows.
-  //  int decompressedSize = LZ4_decompress_fast(
-  //    reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-  //    reinterpret_cast<char*>(this->Output->GetPointer(0)),
-  //    maxDecompressedSize);
-  return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+  const char* in = reinterpret_cast<const char*>(this->Input->GetPointer(0));
+  const vtkIdType inputSize = this->Input->GetNumberOfValues();
+  vtkTypeInt32 numTiles = 0;
+  if (inputSize >= static_cast<vtkIdType>(sizeof(vtkTypeInt32)))
+  {
+    memcpy(&numTiles, in, sizeof(vtkTypeInt32));
+  }
+  if (numTiles <= 0 || GetHeaderSize(numTiles) > inputSize)
+  {
+    vtkErrorMacro("Invalid LZ4 tile header.");
+    return VTK_ERROR;
+  }
+
+  std::vector<vtkIdType> rawOffsets(numTiles + 1, 0);
+  std::vector<vtkIdType> compressedOffsets(numTiles + 1, GetHeaderSize(numTiles));
+  for (vtkTypeInt32 tile = 0; tile < numTiles; ++tile)
+  {
+    vtkTypeInt32 header[2];
+    memcpy(header, in + sizeof(vtkTypeInt32) * (1 + 2 * tile), sizeof(header));
+    if (header[0] < 0 || header[1] < 0)
+    {
+      vtkErrorMacro("Invalid LZ4 tile header.");
+      return VTK_ERROR;
+    }
+    rawOffsets[tile + 1] = rawOffsets[tile] + header[0];
+    compressedOffsets[tile + 1] = compressedOffsets[tile] + header[1];
+  }
+
+  const vtkIdType maxDecompressedSize = this->Output->GetNumberOfValues();
+  if (rawOffsets[numTiles] != maxDecompressedSize || compressedOffsets[numTiles] > inputSize)
+  {
+    vtkErrorMacro("LZ4 tile sizes do not match the image.");
+    return VTK_ERROR;
+  }
+
+  // We use LZ4_decompress_safe since there seems to be some bug in
+  // LZ4_decompress_fast which is causing segfaults on Windows.
+  char* out = reinterpret_cast<char*>(this->Output->GetPointer(0));
+  std::vector<char> status(numTiles, 0);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      const int rawSize = static_cast<int>(rawOffsets[tile + 1] - rawOffsets[tile]);
+      const int compressedSize =
+        static_cast<int>(compressedOffsets[tile + 1] - compressedOffsets[tile]);
+      if (rawSize == 0)
+      {
+        // LZ4_decompress_safe fails when the output capacity is 0.
+        status[tile] = 1;
+        continue;
+      }
+      const int decompressedSize = LZ4_decompress_safe(
+        in + compressedOffsets[tile], out + rawOffsets[tile], compressedSize, rawSize);
+      status[tile] = (decompressedSize == rawSize);
+    }
+  });
+  return std::find(status.begin(), status.end(), 0) == status.end() ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
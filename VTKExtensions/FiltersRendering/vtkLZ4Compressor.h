@@ -18,7 +18,8 @@
  * that uses LZ4 for fast lossless compression.
  *
  * vtkLZ4Compressor uses LZ4 for fast lossless compression and decompression on
- * data.
+ * data. Large images are split in tiles compressed as independent LZ4 blocks
+ * on multiple threads, so that they can be decompressed in parallel as well.
 */
 
 #ifndef vtkLZ4Compressor_h
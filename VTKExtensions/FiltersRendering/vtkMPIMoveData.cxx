@@ -15,6 +15,7 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkBinaryDataMarshaller.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
@@ -28,6 +29,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVConfig.h"
@@ -46,8 +48,6 @@
 #include <sstream>
 #include <vector>
 
-#include <vector>
-
 bool vtkMPIMoveData::UseZLibCompression = false;
 
 namespace
@@ -704,14 +704,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver");
 
-  // int fixme;
-  // We might be able to eliminate this marshal.
-  this->ClearBuffer();
-  this->MarshalDataToBuffer(output);
-
-  com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-  com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->SendDataObject(com, output, 23480);
 }
 
 //-----------------------------------------------------------------------------
@@ -727,24 +720,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
-
-  // int fixme;  // Can we avoid this?
-  this->ReconstructDataFromBuffer(output);
-  this->ClearBuffer();
+  this->ReceiveDataObject(com, output, 23480);
 }
 
 //-----------------------------------------------------------------------------
@@ -765,14 +741,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver-root");
 
-    // int fixme;
-    // We might be able to eliminate this marshal.
-    this->ClearBuffer();
-    this->MarshalDataToBuffer(data);
-    com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
-    com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
-    this->ClearBuffer();
+    this->SendDataObject(com, data, 23480);
   }
 }
 
@@ -793,24 +762,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
 
-    this->ClearBuffer();
-    com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
-    this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-    com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    // Compute additional buffer information.
-    this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-    this->BufferTotalLength = 0;
-    for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-    {
-      this->BufferOffsets[idx] = this->BufferTotalLength;
-      this->BufferTotalLength += this->BufferLengths[idx];
-    }
-    this->Buffers = new char[this->BufferTotalLength];
-    com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
-
-    // int fixme;  // Can we avoid this?
-    this->ReconstructDataFromBuffer(data);
-    this->ClearBuffer();
+    this->ReceiveDataObject(com, data, 23480);
   }
 }
 
@@ -828,13 +780,7 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   {
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
-    this->ClearBuffer();
-    this->MarshalDataToBuffer(output);
-    this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
-    this->ClientDataServerSocketController->Send(
-      this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
-    this->ClearBuffer();
+    this->SendDataObject(this->ClientDataServerSocketController->GetCommunicator(), output, 23490);
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
 }
@@ -852,22 +798,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
-  this->ClearBuffer();
-  com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
-  this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
-  com->Receive(this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-  // Compute additional buffer information.
-  this->BufferOffsets = new vtkIdType[this->NumberOfBuffers];
-  this->BufferTotalLength = 0;
-  for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
-  {
-    this->BufferOffsets[idx] = this->BufferTotalLength;
-    this->BufferTotalLength += this->BufferLengths[idx];
-  }
-  this->Buffers = new char[this->BufferTotalLength];
-  com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
-  this->ReconstructDataFromBuffer(output);
-  this->ClearBuffer();
+  this->ReceiveDataObject(com, output, 23490);
 }
 
 //-----------------------------------------------------------------------------
@@ -959,6 +890,38 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
+  // Use the native binary marshaller when possible. This copies raw array
+  // memory into the buffer without any intermediate encoding.
+  vtkNew<vtkBinaryDataMarshaller> marshaller;
+  if (marshaller->Marshal(data))
+  {
+    const vtkIdType raw_length = marshaller->GetTotalLength();
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "binary marshalled %lld bytes",
+      static_cast<long long>(raw_length));
+    if (vtkMPIMoveData::UseZLibCompression)
+    {
+      std::vector<char> raw(raw_length);
+      marshaller->CopyTo(raw.data());
+      marshaller->Reset();
+      this->CompressToBuffer(raw.data(), raw_length);
+    }
+    else
+    {
+      this->NumberOfBuffers = 1;
+      this->BufferLengths = new vtkIdType[1];
+      this->BufferLengths[0] = raw_length;
+      this->BufferOffsets = new vtkIdType[1];
+      this->BufferOffsets[0] = 0;
+      this->Buffers = new char[raw_length];
+      this->BufferTotalLength = raw_length;
+      marshaller->CopyTo(this->Buffers);
+    }
+    return;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "using legacy writer for '%s'",
+    data->GetClassName());
+
   // Copy input to isolate reader from the pipeline.
   vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
   writer->SetInputData(data);
@@ -979,50 +942,135 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   writer->WriteToOutputStringOn();
   writer->Write();
 
-  char* buffer = NULL;
-  vtkIdType buffer_length = 0;
-
   if (vtkMPIMoveData::UseZLibCompression)
   {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
-
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
-    for (int cc = 0; cc < 4; cc++)
-    {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
-      // the next 4 bytes are the original length since zlib doesn't provide
-      // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
-      in_size = in_size >> 8;
-    }
-    buffer_length = out_size + 8;
+    this->CompressToBuffer(writer->GetOutputString(), writer->GetOutputStringLength());
   }
   else
   {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    // Get string.
+    this->NumberOfBuffers = 1;
+    this->BufferLengths = new vtkIdType[1];
+    this->BufferLengths[0] = writer->GetOutputStringLength();
+    this->BufferOffsets = new vtkIdType[1];
+    this->BufferOffsets[0] = 0;
+    this->Buffers = writer->RegisterAndGetOutputString();
+    this->BufferTotalLength = this->BufferLengths[0];
+  }
+
+  writer->Delete();
+  writer = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::CompressToBuffer(const char* data, vtkIdType length)
+{
+  vtkTimerLog::MarkStartEvent("Zlib compress");
+  // Use z-lib compression.
+  uLongf out_size = compressBound(length);
+  char* buffer = new char[out_size + 8];
+  memcpy(buffer, "zlib0000", 8);
+
+  compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size, reinterpret_cast<const Bytef*>(data),
+    length,
+    /* compression_level */ Z_DEFAULT_COMPRESSION);
+  vtkTimerLog::MarkEndEvent("Zlib compress");
+  int in_size = static_cast<int>(length);
+  for (int cc = 0; cc < 4; cc++)
+  {
+    // the first 4 bytes in the header are "zlib" which helps the receiver
+    // identify that zlib compression has been used.
+    // the next 4 bytes are the original length since zlib doesn't provide
+    // that to the receiver.
+    buffer[4 + cc] = (in_size & 0x0ff);
+    in_size = in_size >> 8;
   }
 
-  // Get string.
   this->NumberOfBuffers = 1;
   this->BufferLengths = new vtkIdType[1];
-  this->BufferLengths[0] = buffer_length;
+  this->BufferLengths[0] = out_size + 8;
   this->BufferOffsets = new vtkIdType[1];
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
+}
 
-  writer->Delete();
-  writer = 0;
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::SendDataObject(vtkCommunicator* com, vtkDataObject* data, int tag)
+{
+  this->ClearBuffer();
+
+  // When not compressing, the segments generated by the binary marshaller are
+  // sent directly from the dataset's arrays, avoiding packing them in an
+  // intermediate buffer. Otherwise, the single marshalled buffer is sent.
+  std::vector<const char*> segments;
+  std::vector<vtkIdType> lengths;
+  vtkNew<vtkBinaryDataMarshaller> marshaller;
+  if (!vtkMPIMoveData::UseZLibCompression && marshaller->Marshal(data))
+  {
+    for (int cc = 0, max = marshaller->GetNumberOfSegments(); cc < max; ++cc)
+    {
+      segments.push_back(marshaller->GetSegmentPointer(cc));
+      lengths.push_back(marshaller->GetSegmentLength(cc));
+    }
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "binary marshalled %lld bytes in %d segments",
+      static_cast<long long>(marshaller->GetTotalLength()), static_cast<int>(segments.size()));
+  }
+  else
+  {
+    this->MarshalDataToBuffer(data);
+    segments.push_back(this->Buffers);
+    lengths.push_back(this->BufferTotalLength);
+  }
+
+  int numSegments = static_cast<int>(segments.size());
+  com->Send(&numSegments, 1, 1, tag);
+  com->Send(lengths.data(), numSegments, 1, tag + 1);
+  for (int cc = 0; cc < numSegments; ++cc)
+  {
+    if (lengths[cc] > 0)
+    {
+      com->Send(segments[cc], lengths[cc], 1, tag + 2);
+    }
+  }
+  this->ClearBuffer();
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ReceiveDataObject(vtkCommunicator* com, vtkDataObject* output, int tag)
+{
+  this->ClearBuffer();
+
+  int numSegments = 0;
+  com->Receive(&numSegments, 1, 1, tag);
+  std::vector<vtkIdType> lengths(numSegments);
+  com->Receive(lengths.data(), numSegments, 1, tag + 1);
+
+  // Gather all segments back to back in a single buffer.
+  this->NumberOfBuffers = 1;
+  this->BufferLengths = new vtkIdType[1];
+  this->BufferOffsets = new vtkIdType[1];
+  this->BufferOffsets[0] = 0;
+  this->BufferTotalLength = 0;
+  for (int cc = 0; cc < numSegments; ++cc)
+  {
+    this->BufferTotalLength += lengths[cc];
+  }
+  this->BufferLengths[0] = this->BufferTotalLength;
+  this->Buffers = new char[this->BufferTotalLength];
+
+  char* cursor = this->Buffers;
+  for (int cc = 0; cc < numSegments; ++cc)
+  {
+    if (lengths[cc] > 0)
+    {
+      com->Receive(cursor, lengths[cc], 1, tag + 2);
+      cursor += lengths[cc];
+    }
+  }
+
+  this->ReconstructDataFromBuffer(output);
+  this->ClearBuffer();
 }
 
 //-----------------------------------------------------------------------------
@@ -1065,6 +1113,24 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (vtkBinaryDataMarshaller::IsMarshalledBuffer(bufferArray, bufferLength))
+    {
+      if (auto piece = vtkBinaryDataMarshaller::Unmarshal(bufferArray, bufferLength))
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(piece);
+        pieces.push_back(piece);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to unmarshal piece "
+          << idx << " (" << bufferLength << " bytes), it is missing from the output.");
+      }
+      delete[] realBuffer;
+      realBuffer = 0;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
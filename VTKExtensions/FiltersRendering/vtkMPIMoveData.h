@@ -29,6 +29,7 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+class vtkCommunicator;
 class vtkMultiProcessController;
 class vtkSocketController;
 class vtkMPIMToNSocketConnection;
@@ -174,6 +175,19 @@ protected:
   void ClearBuffer();
   void MarshalDataToBuffer(vtkDataObject* data);
   void ReconstructDataFromBuffer(vtkDataObject* data);
+  void CompressToBuffer(const char* data, vtkIdType length);
+
+  //@{
+  /**
+   * Point-to-point transfer of a data object to/from remote process 1 on the
+   * communicator. Uses the tags `tag`, `tag + 1` and `tag + 2`. When possible,
+   * the data is sent as a sequence of segments pointing directly to the
+   * dataset's arrays (see vtkBinaryDataMarshaller) which are received back to
+   * back in a single buffer.
+   */
+  void SendDataObject(vtkCommunicator* com, vtkDataObject* data, int tag);
+  void ReceiveDataObject(vtkCommunicator* com, vtkDataObject* output, int tag);
+  //@}
 
   int MoveMode;
   int Server;
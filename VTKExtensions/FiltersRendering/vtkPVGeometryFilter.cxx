@@ -40,6 +40,8 @@
 #include "vtkHierarchicalBoxDataSet.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
@@ -52,12 +54,15 @@
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
 #include "vtkPVRecoverGeometryWireframe.h"
+#include "vtkPVLogger.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -74,8 +79,10 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <cstdint>
 #include <map>
 #include <math.h>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -113,11 +120,21 @@ public:
   // is specified by the Commutative method.
   void Function(const void* A, void* B, vtkIdType length, int datatype) override
   {
-    assert((datatype == VTK_DOUBLE) && (length == 6));
+    assert((datatype == VTK_DOUBLE) && (length % 6 == 0));
     (void)datatype;
-    (void)length;
     const double* bdsA = reinterpret_cast<const double*>(A);
     double* bdsB = reinterpret_cast<double*>(B);
+    for (vtkIdType cc = 0; cc < length; cc += 6)
+    {
+      BoundsReductionOperation::Merge(bdsA + cc, bdsB + cc);
+    }
+  }
+
+  // Description:
+  // Grows \c bdsB to include \c bdsA. The operation keeps no state so it is
+  // safe to use concurrently, e.g. to combine per-thread bounds.
+  static void Merge(const double bdsA[6], double bdsB[6])
+  {
     if (bdsA[0] < bdsB[0])
     {
       bdsB[0] = bdsA[0];
@@ -150,6 +167,265 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+// Caches the surface extracted from linear unstructured grids together with
+// the maps to the original points and cells, so that executions where only
+// the point coordinates or attributes changed can skip the face extraction.
+// Entries are keyed by block and validated against the input topology, first
+// by identity and modification time and then by content hash. The cache is
+// shared with the per-thread block workers, hence the mutex.
+class vtkPVGeometryFilter::SurfaceCache
+{
+public:
+  struct Entry
+  {
+    // the topology arrays are only compared by address together with their
+    // modification time, they are never dereferenced.
+    const void* Topology = nullptr;
+    vtkMTimeType TopologyMTime = 0;
+    vtkIdType NumberOfPoints = 0;
+    vtkIdType NumberOfCells = 0;
+    uint64_t Hash = 0;
+    unsigned long Generation = 0;
+
+    vtkSmartPointer<vtkPolyData> Surface;
+    vtkSmartPointer<vtkIdList> PointIds;
+    vtkSmartPointer<vtkIdList> CellIds;
+    vtkSmartPointer<vtkIdTypeArray> OriginalPointIds;
+    vtkSmartPointer<vtkIdTypeArray> OriginalCellIds;
+  };
+
+  void BeginExecution(vtkMTimeType filterMTime)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (filterMTime != this->FilterMTime)
+    {
+      // extraction settings may have changed.
+      this->Entries.clear();
+      this->FilterMTime = filterMTime;
+    }
+    ++this->Generation;
+  }
+
+  void EndExecution()
+  {
+    // drop blocks that are no longer present in the input.
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      iter = iter->second.Generation != this->Generation ? this->Entries.erase(iter) : ++iter;
+    }
+  }
+
+  /**
+   * Fills `output` from the cached surface for `key` if the topology of
+   * `input` did not change. Returns false on a cache miss.
+   */
+  bool Gather(vtkIdType key, vtkUnstructuredGrid* input, vtkPolyData* output, bool passPointIds,
+    bool passCellIds)
+  {
+    vtkPoints* inPoints = input->GetPoints();
+    if (!inPoints)
+    {
+      return false;
+    }
+
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = this->Entries.find(key);
+      if (iter == this->Entries.end())
+      {
+        return false;
+      }
+      entry = iter->second;
+    }
+
+    if (entry.NumberOfPoints != input->GetNumberOfPoints() ||
+      entry.NumberOfCells != input->GetNumberOfCells())
+    {
+      return false;
+    }
+    if (entry.Topology != SurfaceCache::GetTopology(input) ||
+      entry.TopologyMTime != SurfaceCache::GetTopologyMTime(input))
+    {
+      // the topology arrays were replaced, e.g. by a reader that rebuilds the
+      // mesh for every time step. Compare the content instead.
+      if (entry.Hash != SurfaceCache::ComputeHash(input))
+      {
+        return false;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      Entry& stored = this->Entries[key];
+      stored.Topology = SurfaceCache::GetTopology(input);
+      stored.TopologyMTime = SurfaceCache::GetTopologyMTime(input);
+      stored.Generation = this->Generation;
+    }
+
+    vtkNew<vtkPoints> points;
+    points->SetDataType(inPoints->GetDataType());
+    inPoints->GetPoints(entry.PointIds, points);
+    output->SetPoints(points);
+    output->SetVerts(entry.Surface->GetVerts());
+    output->SetLines(entry.Surface->GetLines());
+    output->SetPolys(entry.Surface->GetPolys());
+    output->SetStrips(entry.Surface->GetStrips());
+
+    // same attribute copy semantics as vtkDataSetSurfaceFilter.
+    const vtkIdType numPoints = entry.PointIds->GetNumberOfIds();
+    vtkNew<vtkIdList> pointDest;
+    pointDest->SetNumberOfIds(numPoints);
+    for (vtkIdType cc = 0; cc < numPoints; ++cc)
+    {
+      pointDest->SetId(cc, cc);
+    }
+    vtkPointData* outPD = output->GetPointData();
+    outPD->CopyGlobalIdsOn();
+    outPD->CopyAllocate(input->GetPointData(), numPoints);
+    outPD->CopyData(input->GetPointData(), entry.PointIds, pointDest);
+
+    const vtkIdType numCells = entry.CellIds->GetNumberOfIds();
+    vtkNew<vtkIdList> cellDest;
+    cellDest->SetNumberOfIds(numCells);
+    for (vtkIdType cc = 0; cc < numCells; ++cc)
+    {
+      cellDest->SetId(cc, cc);
+    }
+    vtkCellData* outCD = output->GetCellData();
+    outCD->CopyGlobalIdsOn();
+    outCD->CopyAllocate(input->GetCellData(), numCells);
+    outCD->CopyData(input->GetCellData(), entry.CellIds, cellDest);
+
+    if (passPointIds)
+    {
+      outPD->AddArray(entry.OriginalPointIds);
+    }
+    if (passCellIds)
+    {
+      outCD->AddArray(entry.OriginalCellIds);
+    }
+
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+      "reused cached surface for block %lld (%lld points, %lld cells)",
+      static_cast<long long>(key), static_cast<long long>(numPoints),
+      static_cast<long long>(numCells));
+    return true;
+  }
+
+  /**
+   * Records the surface extracted from `input`. `output` must have the
+   * vtkOriginalPointIds and vtkOriginalCellIds arrays.
+   */
+  void Store(vtkIdType key, vtkUnstructuredGrid* input, vtkPolyData* output)
+  {
+    auto originalPointIds =
+      vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+    auto originalCellIds =
+      vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+    if (!originalPointIds || !originalCellIds ||
+      originalPointIds->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+      originalCellIds->GetNumberOfTuples() != output->GetNumberOfCells())
+    {
+      return;
+    }
+
+    Entry entry;
+    entry.PointIds = SurfaceCache::ToIdList(originalPointIds);
+    entry.CellIds = SurfaceCache::ToIdList(originalCellIds);
+    if (!entry.PointIds || !entry.CellIds)
+    {
+      // some points or cells were generated rather than passed, e.g. by
+      // subdividing nonlinear cells. These cannot be gathered.
+      return;
+    }
+    entry.Topology = SurfaceCache::GetTopology(input);
+    entry.TopologyMTime = SurfaceCache::GetTopologyMTime(input);
+    entry.NumberOfPoints = input->GetNumberOfPoints();
+    entry.NumberOfCells = input->GetNumberOfCells();
+    entry.Hash = SurfaceCache::ComputeHash(input);
+    entry.Surface = vtkSmartPointer<vtkPolyData>::New();
+    entry.Surface->SetVerts(output->GetVerts());
+    entry.Surface->SetLines(output->GetLines());
+    entry.Surface->SetPolys(output->GetPolys());
+    entry.Surface->SetStrips(output->GetStrips());
+    entry.OriginalPointIds = originalPointIds;
+    entry.OriginalCellIds = originalCellIds;
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    entry.Generation = this->Generation;
+    this->Entries[key] = entry;
+  }
+
+private:
+  static const void* GetTopology(vtkUnstructuredGrid* input) { return input->GetCells(); }
+
+  static vtkMTimeType GetTopologyMTime(vtkUnstructuredGrid* input)
+  {
+    vtkMTimeType mtime = input->GetCells() ? input->GetCells()->GetMTime() : 0;
+    if (auto types = input->GetCellTypesArray())
+    {
+      mtime = std::max(mtime, types->GetMTime());
+    }
+    if (auto ghosts = input->GetCellGhostArray())
+    {
+      mtime = std::max(mtime, ghosts->GetMTime());
+    }
+    return mtime;
+  }
+
+  // FNV-1a over the raw bytes of the arrays that define the extracted faces.
+  static uint64_t ComputeHash(vtkUnstructuredGrid* input)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    auto hashArray = [&hash](vtkDataArray* array) {
+      if (!array)
+      {
+        return;
+      }
+      const unsigned char* bytes = static_cast<const unsigned char*>(array->GetVoidPointer(0));
+      const size_t size =
+        static_cast<size_t>(array->GetDataSize()) * static_cast<size_t>(array->GetDataTypeSize());
+      for (size_t cc = 0; cc < size; ++cc)
+      {
+        hash = (hash ^ bytes[cc]) * 1099511628211ull;
+      }
+    };
+    if (vtkCellArray* cells = input->GetCells())
+    {
+      hashArray(cells->GetOffsetsArray());
+      hashArray(cells->GetConnectivityArray());
+    }
+    hashArray(input->GetCellTypesArray());
+    hashArray(input->GetCellGhostArray());
+    return hash;
+  }
+
+  static vtkSmartPointer<vtkIdList> ToIdList(vtkIdTypeArray* ids)
+  {
+    const vtkIdType count = ids->GetNumberOfTuples();
+    auto list = vtkSmartPointer<vtkIdList>::New();
+    list->SetNumberOfIds(count);
+    for (vtkIdType cc = 0; cc < count; ++cc)
+    {
+      const vtkIdType id = ids->GetValue(cc);
+      if (id < 0)
+      {
+        return nullptr;
+      }
+      list->SetId(cc, id);
+    }
+    return list;
+  }
+
+  std::mutex Mutex;
+  std::map<vtkIdType, Entry> Entries;
+  vtkMTimeType FilterMTime = 0;
+  unsigned long Generation = 0;
+};
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -195,6 +471,9 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
+  this->UseThreadedBlockExecution = true;
+  this->CacheSurfaceTopology = true;
+  this->SurfaceCacheKey = -1;
 }
 
 //----------------------------------------------------------------------------
@@ -548,10 +827,29 @@ int vtkPVGeometryFilter::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  if (this->CacheSurfaceTopology)
+  {
+    if (!this->SurfaceTopologyCache)
+    {
+      this->SurfaceTopologyCache = std::make_shared<SurfaceCache>();
+    }
+    this->SurfaceTopologyCache->BeginExecution(this->GetMTime());
+  }
+  else
+  {
+    this->SurfaceTopologyCache.reset();
+  }
+
   if (vtkCompositeDataSet::SafeDownCast(input))
   {
     vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::RequestData");
-    vtkGarbageCollector::DeferredCollectionPush();
+    // The deferred garbage collection queue is not thread-safe and blocks may
+    // release pipeline objects from worker threads when executing concurrently.
+    const bool deferCollection = !this->UseThreadedBlockExecution;
+    if (deferCollection)
+    {
+      vtkGarbageCollector::DeferredCollectionPush();
+    }
     if (input->IsA("vtkUniformGridAMR"))
     {
       this->RequestAMRData(request, inputVector, outputVector);
@@ -560,10 +858,17 @@ int vtkPVGeometryFilter::RequestData(
     {
       this->RequestDataObjectTree(request, inputVector, outputVector);
     }
-    vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::GarbageCollect");
-    vtkGarbageCollector::DeferredCollectionPop();
-    vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::GarbageCollect");
+    if (deferCollection)
+    {
+      vtkTimerLog::MarkStartEvent("vtkPVGeometryFilter::GarbageCollect");
+      vtkGarbageCollector::DeferredCollectionPop();
+      vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::GarbageCollect");
+    }
     vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::RequestData");
+    if (this->SurfaceTopologyCache)
+    {
+      this->SurfaceTopologyCache->EndExecution();
+    }
     return 1;
   }
 
@@ -579,8 +884,14 @@ int vtkPVGeometryFilter::RequestData(
   }
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
+  this->SurfaceCacheKey = 0;
   this->ExecuteBlock(input, output, 1, procid, numProcs, 0, wholeExtent);
+  this->SurfaceCacheKey = -1;
   this->CleanupOutputData(output, 1);
+  if (this->SurfaceTopologyCache)
+  {
+    this->SurfaceTopologyCache->EndExecution();
+  }
   return 1;
 }
 
@@ -924,6 +1235,93 @@ int vtkPVGeometryFilter::RequestAMRData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Executes leaf blocks concurrently. Each thread lazily creates its own
+// vtkPVGeometryFilter so that the internal filters are never shared between
+// threads. Results are written to pre-allocated per-block slots which are then
+// inserted in the output tree as-is.
+class vtkPVGeometryFilter::BlockWorker
+{
+public:
+  struct Task
+  {
+    vtkDataObject* Input = nullptr;
+    vtkIdType Cost = 0;
+    unsigned int FlatIndex = 0;
+    vtkSmartPointer<vtkPolyData> Output;
+    int OutlineFlag = 0;
+  };
+
+  vtkPVGeometryFilter* Self;
+  const int* WholeExtent;
+  std::vector<Task>& Tasks;
+  std::vector<size_t> Order;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter> > Workers;
+
+  BlockWorker(vtkPVGeometryFilter* self, const int* wholeExtent, std::vector<Task>& tasks)
+    : Self(self)
+    , WholeExtent(wholeExtent)
+    , Tasks(tasks)
+  {
+    // schedule the most expensive blocks first so that small blocks fill in
+    // the gaps at the end instead of a large block becoming the tail.
+    this->Order.resize(tasks.size());
+    for (size_t cc = 0; cc < tasks.size(); ++cc)
+    {
+      this->Order[cc] = cc;
+    }
+    std::stable_sort(this->Order.begin(), this->Order.end(),
+      [&tasks](size_t a, size_t b) { return tasks[a].Cost > tasks[b].Cost; });
+  }
+
+  void Initialize()
+  {
+    vtkPVGeometryFilter* self = this->Self;
+    vtkSmartPointer<vtkPVGeometryFilter>& worker = this->Workers.Local();
+    worker = vtkSmartPointer<vtkPVGeometryFilter>::New();
+    // the controller is only queried for the local process id since blocks
+    // are executed without communication.
+    worker->SetController(self->Controller);
+    worker->SetUseOutline(self->UseOutline);
+    worker->SetGenerateFeatureEdges(self->GenerateFeatureEdges);
+    worker->SetUseStrips(self->UseStrips);
+    worker->SetGenerateCellNormals(self->GenerateCellNormals);
+    worker->SetTriangulate(self->Triangulate);
+    worker->SetNonlinearSubdivisionLevel(self->NonlinearSubdivisionLevel);
+    worker->SetPassThroughCellIds(self->PassThroughCellIds);
+    worker->SetPassThroughPointIds(self->PassThroughPointIds);
+    worker->SetGenerateProcessIds(self->GenerateProcessIds);
+    worker->SetCacheSurfaceTopology(self->CacheSurfaceTopology);
+    worker->SurfaceTopologyCache = self->SurfaceTopologyCache;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPVGeometryFilter* worker = this->Workers.Local();
+    for (vtkIdType cc = begin; cc < end && !this->Self->AbortExecute; ++cc)
+    {
+      Task& task = this->Tasks[this->Order[cc]];
+      if (!task.Input)
+      {
+        continue;
+      }
+      task.Output = vtkSmartPointer<vtkPolyData>::New();
+      worker->SurfaceCacheKey = static_cast<vtkIdType>(task.FlatIndex);
+      worker->ExecuteBlock(task.Input, task.Output, 0, 0, 1, 0, this->WholeExtent);
+      worker->SurfaceCacheKey = -1;
+      worker->CleanupOutputData(task.Output, 0);
+      task.OutlineFlag = worker->OutlineFlag;
+    }
+  }
+
+  void Reduce() {}
+
+  void Execute()
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Tasks.size()), 1, *this);
+  }
+};
+
 //----------------------------------------------------------------------------
 int vtkPVGeometryFilter::RequestDataObjectTree(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -965,35 +1363,76 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
-  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  if (this->UseThreadedBlockExecution && totNumBlocks > 1)
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    std::vector<BlockWorker::Task> tasks;
+    tasks.reserve(totNumBlocks);
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
     {
-      continue;
+      BlockWorker::Task task;
+      task.Input = inIter->GetCurrentDataObject();
+      task.FlatIndex = inIter->GetCurrentFlatIndex();
+      task.Cost = task.Input ? task.Input->GetNumberOfElements(vtkDataObject::CELL) : 0;
+      tasks.push_back(task);
     }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
-    // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
-    {
-      output->SetDataSet(inIter, tmpOut);
-      tmpOut->FastDelete();
+    BlockWorker worker(this, wholeExtent, tasks);
+    worker.Execute();
 
-      const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
-      this->AddCompositeIndex(tmpOut, current_flat_index);
-    }
-    else
+    // the traversal order is the same as above, so tasks map to leaves
+    // one-to-one.
+    // the output is an outline if any non-empty block was outlined.
+    size_t taskIdx = 0;
+    int outlineFlag = 0;
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal();
+         inIter->GoToNextItem(), ++taskIdx)
     {
-      tmpOut->Delete();
-      tmpOut = NULL;
+      BlockWorker::Task& task = tasks[taskIdx];
+      // skip empty nodes.
+      if (task.Output && task.Output->GetNumberOfPoints() > 0)
+      {
+        this->AddCompositeIndex(task.Output, inIter->GetCurrentFlatIndex());
+        output->SetDataSet(inIter, task.Output);
+        outlineFlag |= task.OutlineFlag;
+      }
     }
+    this->OutlineFlag = outlineFlag;
+    this->UpdateProgress(1.0);
+  }
+  else
+  {
+    int numInputs = 0;
+    for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+    {
+      vtkDataObject* block = inIter->GetCurrentDataObject();
+      if (!block)
+      {
+        continue;
+      }
+
+      vtkPolyData* tmpOut = vtkPolyData::New();
+      this->SurfaceCacheKey = static_cast<vtkIdType>(inIter->GetCurrentFlatIndex());
+      this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
+      this->SurfaceCacheKey = -1;
+      this->CleanupOutputData(tmpOut, 0);
+      // skip empty nodes.
+      if (tmpOut->GetNumberOfPoints() > 0)
+      {
+        output->SetDataSet(inIter, tmpOut);
+        tmpOut->FastDelete();
+
+        const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
+        this->AddCompositeIndex(tmpOut, current_flat_index);
+      }
+      else
+      {
+        tmpOut->Delete();
+        tmpOut = NULL;
+      }
 
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+      numInputs++;
+      this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+    }
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
@@ -1434,6 +1873,21 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
       }
     }
 
+    // Only the plain vtkDataSetSurfaceFilter path is cached: subdivision and
+    // triangulation generate points that cannot be gathered from the input.
+    vtkUnstructuredGrid* cacheableInput = nullptr;
+    if (!handleSubdivision && this->SurfaceTopologyCache && this->SurfaceCacheKey >= 0 &&
+      input->GetNumberOfCells() > 0)
+    {
+      cacheableInput = vtkUnstructuredGrid::SafeDownCast(input);
+      if (cacheableInput &&
+        this->SurfaceTopologyCache->Gather(this->SurfaceCacheKey, cacheableInput, output,
+          this->PassThroughPointIds != 0, this->PassThroughCellIds != 0))
+      {
+        return;
+      }
+    }
+
     vtkSmartPointer<vtkIdTypeArray> facePtIds2OriginalPtIds;
 
     vtkSmartPointer<vtkUnstructuredGridBase> inputClone =
@@ -1500,7 +1954,27 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
 
     if (input->GetNumberOfCells() > 0)
     {
+      if (cacheableInput)
+      {
+        // the cache needs the maps to the original points and cells.
+        this->DataSetSurfaceFilter->PassThroughPointIdsOn();
+        this->DataSetSurfaceFilter->PassThroughCellIdsOn();
+      }
       this->DataSetSurfaceFilter->UnstructuredGridExecute(input, output);
+      if (cacheableInput)
+      {
+        this->SurfaceTopologyCache->Store(this->SurfaceCacheKey, cacheableInput, output);
+        this->DataSetSurfaceFilter->SetPassThroughPointIds(this->PassThroughPointIds);
+        this->DataSetSurfaceFilter->SetPassThroughCellIds(this->PassThroughCellIds);
+        if (!this->PassThroughPointIds)
+        {
+          output->GetPointData()->RemoveArray("vtkOriginalPointIds");
+        }
+        if (!this->PassThroughCellIds)
+        {
+          output->GetCellData()->RemoveArray("vtkOriginalCellIds");
+        }
+      }
     }
 
     if (this->Triangulate && (output->GetNumberOfPolys() > 0))
@@ -1807,6 +2281,8 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "UseThreadedBlockExecution: " << this->UseThreadedBlockExecution << endl;
+  os << indent << "CacheSurfaceTopology: " << this->CacheSurfaceTopology << endl;
 }
 
 //----------------------------------------------------------------------------
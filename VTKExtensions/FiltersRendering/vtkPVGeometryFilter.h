@@ -25,6 +25,9 @@
 
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+#include <memory> // for std::shared_ptr
+
 class vtkCallbackCommand;
 class vtkDataSet;
 class vtkDataSetSurfaceFilter;
@@ -207,6 +210,32 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true (default), the leaf blocks of a non-AMR composite dataset
+   * are processed concurrently using vtkSMPTools, largest blocks (by cell
+   * count) first. Each thread uses its own set of internal filters and no
+   * inter-process communication happens while blocks are being processed. Set
+   * to false to process the blocks serially.
+   */
+  vtkSetMacro(UseThreadedBlockExecution, bool);
+  vtkGetMacro(UseThreadedBlockExecution, bool);
+  vtkBooleanMacro(UseThreadedBlockExecution, bool);
+  //@}
+
+  //@{
+  /**
+   * When set to true (default), the surface extracted from linear unstructured
+   * grids is cached per block together with the maps to the original points
+   * and cells. On subsequent executions, e.g. when only the point data changes
+   * between time steps, blocks whose topology is unchanged skip the surface
+   * extraction and only gather points and attributes through the cached maps.
+   */
+  vtkSetMacro(CacheSurfaceTopology, bool);
+  vtkGetMacro(CacheSurfaceTopology, bool);
+  vtkBooleanMacro(CacheSurfaceTopology, bool);
+  //@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -331,6 +360,8 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool UseThreadedBlockExecution;
+  bool CacheSurfaceTopology;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -347,7 +378,15 @@ private:
   void AddBlockColors(vtkDataObject* pd, unsigned int index);
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
+  class BlockWorker;
   //@}
+
+  class SurfaceCache;
+  std::shared_ptr<SurfaceCache> SurfaceTopologyCache;
+
+  // Identifies the block being executed in SurfaceTopologyCache, -1 if the
+  // block must not be cached.
+  vtkIdType SurfaceCacheKey;
 };
 
 #endif
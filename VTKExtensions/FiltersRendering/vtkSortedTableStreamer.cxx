@@ -22,14 +22,17 @@
 #include "vtkEventForwarderCommand.h"
 #include "vtkExtractSelection.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
@@ -51,6 +54,7 @@
 
 #include <algorithm>
 #include <map>
+#include <numeric>
 #include <set>
 #include <vector>
 
@@ -550,13 +554,47 @@ public:
       }
     }
   };
+  struct SortKey
+  {
+    T Value;
+    vtkIdType Index;
+    int Process;
+  };
+  struct KeyCompare
+  {
+    bool Inverted;
+
+    static bool Less(const SortKey& a, const SortKey& b)
+    {
+      if (a.Value != b.Value)
+      {
+        return a.Value < b.Value;
+      }
+      if (a.Process != b.Process)
+      {
+        return a.Process < b.Process;
+      }
+      return a.Index < b.Index;
+    }
+
+    bool operator()(const SortKey& a, const SortKey& b) const
+    {
+      return this->Inverted ? Less(b, a) : Less(a, b);
+    }
+  };
+  // Result of the distributed sort for one component and order.
+  struct PermutationIndex
+  {
+    std::vector<vtkIdType> LocalOrder;  // local row ids in sorted order
+    std::vector<vtkIdType> GlobalRanks; // global rank of each entry in LocalOrder
+    vtkIdType GlobalSize = 0;           // number of rows on all processes
+  };
 
 public:
   Internals()
   {
     // Only used for testing
     this->LocalSorter = 0;
-    this->GlobalHistogram = 0;
     this->Debug = false;
   }
 
@@ -581,15 +619,12 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
   ~Internals() override
   {
     if (this->LocalSorter)
       delete this->LocalSorter;
-    if (this->GlobalHistogram)
-      delete this->GlobalHistogram;
   }
 
   // --------------------------------------------------------------------------
@@ -656,60 +691,15 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  int BuildCache(bool sortableArray, bool invertOrder)
+  // Only used by Extract() which keeps the local order of the rows.
+  int BuildCache()
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
-
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Is there something to sort ???
-    if (!sortableArray)
+    if (this->DataToSort)
     {
-      // Keep the same order as the local one because all the values are equals
-      if (this->DataToSort)
-      {
-        this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
-      }
+      this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
     }
-    else
-    {
-      if (this->DataToSort)
-      {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
-      }
-      else
-      {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
-      }
-
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
-
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
-
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
-      {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    }
-
-    delete[] bufferHistogramValues;
     return 1;
   }
 
@@ -725,7 +715,7 @@ public:
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
-      this->BuildCache(false, revertOrder);
+      this->BuildCache();
     }
 
     // Build empty local table with empty arrays so they stay in the same order
@@ -852,46 +842,37 @@ public:
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
-    // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    // Make sure that the permutation index is built
+    //    This sorts the array across all processes, that's why we only do it
+    //    once per order and component. Changing the requested block is then
+    //    only a lookup.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
-    {
-      this->BuildCache(true, revertOrder);
-    }
+    const PermutationIndex& index = this->GetPermutationIndex(revertOrder);
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
+    // Find the local rows that belong to the requested block. Since the
+    // global ranks of the local rows are increasing, they are contiguous.
     // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
+    const vtkIdType first = vtkMath::Min(block * blockSize, index.GlobalSize);
+    const vtkIdType last = vtkMath::Min(first + blockSize, index.GlobalSize);
+    const auto lower =
+      std::lower_bound(index.GlobalRanks.begin(), index.GlobalRanks.end(), first);
+    const auto upper = std::lower_bound(lower, index.GlobalRanks.end(), last);
+    const vtkIdType localOffset = static_cast<vtkIdType>(lower - index.GlobalRanks.begin());
+    const vtkIdType localSize = static_cast<vtkIdType>(upper - lower);
 
     // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
-
-    // ------------------------------------------------------------------------
-    // Build local subset table
+    // Build local subset table along with the global rank of each row
     // ------------------------------------------------------------------------
     vtkSmartPointer<vtkTable> localSubset;
-    localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
+    localSubset.TakeReference(this->NewSubsetTable(
+      input, localSize ? &index.LocalOrder[localOffset] : nullptr, localSize));
+
+    vtkNew<vtkIdTypeArray> ranks;
+    ranks->SetName("vtkSortedRanks");
+    ranks->SetNumberOfTuples(localSize);
+    std::copy(lower, upper, ranks->GetPointer(0));
+    localSubset->GetRowData()->AddArray(ranks);
 
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
@@ -906,7 +887,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate(blockSize);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -920,127 +901,250 @@ public:
     if (this->Me != mergePid)
     {
       this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+
+      // Ask other processes to provide metadata for table decoration
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
     }
 
     // ------------------------------------------------------------------------
     // Merging procedure only on process mergePid
     // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+    for (int i = 0; i < this->NumProcs; i++)
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
-      for (int i = 0; i < this->NumProcs; i++)
-      {
-        if (i == mergePid)
-          continue;
+      if (i == mergePid)
+        continue;
 
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
-      }
-
-      // Sort new table/array
-      if (!this->DataToSort)
-      {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
-      }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
-      {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
-      }
-
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
-
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
-
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
+      this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
+      this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
     }
-    else
+
+    // Place each row using its global rank, no sorting needed.
+    vtkIdTypeArray* mergedRanks =
+      vtkIdTypeArray::SafeDownCast(localSubset->GetColumnByName("vtkSortedRanks"));
+    const vtkIdType numRows = localSubset->GetNumberOfRows();
+    std::vector<vtkIdType> rows(numRows);
+    for (vtkIdType idx = 0; idx < numRows; ++idx)
     {
-      // Ask other processes to provide metadata for table decoration
-      this->DecorateTable(input, NULL, mergePid);
+      rows[mergedRanks->GetValue(idx) - first] = idx;
     }
+    localSubset->GetRowData()->RemoveArray("vtkSortedRanks");
+    localSubset.TakeReference(
+      this->NewSubsetTable(localSubset.GetPointer(), rows.data(), numRows));
+
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), mergePid);
 
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
     return 1;
   }
 
   // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
+  // Returns the permutation index for the selected component and the given
+  // order, building it if needed. Must be called on all processes.
+  const PermutationIndex& GetPermutationIndex(bool invertOrder)
   {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    const auto key = std::make_pair(this->SelectedComponent, invertOrder);
+    auto iter = this->PermutationIndices.find(key);
+    if (iter == this->PermutationIndices.end())
+    {
+      iter = this->PermutationIndices.insert(std::make_pair(key, PermutationIndex())).first;
+      this->BuildPermutationIndex(invertOrder, iter->second);
+    }
+    return iter->second;
+  }
 
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
+  // --------------------------------------------------------------------------
+  // Distributed sample sort of the array to sort:
+  //  1. each process sorts its keys using all threads,
+  //  2. regular samples of the local keys are gathered on all processes and
+  //     used to pick NumProcs - 1 splitters,
+  //  3. keys are exchanged so that process i gets the keys between splitters
+  //     i - 1 and i, and sorted again,
+  //  4. the global rank of each key is then known and is sent back to the
+  //     process owning the row.
+  // Keys are ordered by value, then process id and row index, which makes
+  // every key unique and the order deterministic.
+  void BuildPermutationIndex(bool invertOrder, PermutationIndex& index)
+  {
+    const KeyCompare compare{ invertOrder };
 
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
+    // Build and sort local keys
+    std::vector<SortKey> keys = this->NewLocalKeys();
+    vtkSMPTools::Sort(keys.begin(), keys.end(), compare);
 
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
+    const vtkIdType numKeys = static_cast<vtkIdType>(keys.size());
+    index.LocalOrder.resize(numKeys);
+    index.GlobalRanks.resize(numKeys);
+    for (vtkIdType cc = 0; cc < numKeys; ++cc)
+    {
+      index.LocalOrder[cc] = keys[cc].Index;
+    }
 
-    do
+    if (this->NumProcs == 1)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
+      std::iota(index.GlobalRanks.begin(), index.GlobalRanks.end(), static_cast<vtkIdType>(0));
+      index.GlobalSize = numKeys;
+      return;
+    }
 
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
+    const int numProcs = this->NumProcs;
+    const vtkIdType keySize = static_cast<vtkIdType>(sizeof(SortKey));
 
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
+    // Gather regular samples from all processes
+    const vtkIdType numSamples = vtkMath::Min(numKeys, static_cast<vtkIdType>(numProcs));
+    std::vector<SortKey> samples(numSamples);
+    for (vtkIdType cc = 0; cc < numSamples; ++cc)
+    {
+      samples[cc] = keys[(cc * numKeys) / numSamples];
+    }
+    std::vector<vtkIdType> sampleCounts(numProcs);
+    this->MPI->AllGather(&numSamples, sampleCounts.data(), 1);
+    std::vector<vtkIdType> lengths(numProcs), offsets(numProcs);
+    vtkIdType totalSamples = 0;
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      lengths[cc] = sampleCounts[cc] * keySize;
+      offsets[cc] = totalSamples * keySize;
+      totalSamples += sampleCounts[cc];
+    }
+    std::vector<SortKey> allSamples(totalSamples);
+    this->MPI->AllGatherV(reinterpret_cast<const char*>(samples.data()),
+      reinterpret_cast<char*>(allSamples.data()), numSamples * keySize, lengths.data(),
+      offsets.data());
+    std::sort(allSamples.begin(), allSamples.end(), compare);
 
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
+    // Split the local keys using the splitters
+    std::vector<vtkIdType> bucketStarts(numProcs + 1, 0);
+    bucketStarts[numProcs] = numKeys;
+    for (int cc = 1; cc < numProcs; ++cc)
+    {
+      if (totalSamples == 0)
       {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
+        bucketStarts[cc] = numKeys;
+        continue;
       }
+      const SortKey& splitter = allSamples[(cc * totalSamples) / numProcs];
+      bucketStarts[cc] = static_cast<vtkIdType>(
+        std::lower_bound(keys.begin(), keys.end(), splitter, compare) - keys.begin());
+    }
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // counts[i * numProcs + j] is the number of keys process i sends to j
+    std::vector<vtkIdType> localCounts(numProcs);
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      localCounts[cc] = bucketStarts[cc + 1] - bucketStarts[cc];
+    }
+    std::vector<vtkIdType> counts(numProcs * numProcs);
+    this->MPI->AllGather(localCounts.data(), counts.data(), numProcs);
+
+    // Exchange keys. vtkCommunicator has no all-to-all, hence each process
+    // scatters its buckets in turn.
+    vtkIdType bucketSize = 0;
+    std::vector<vtkIdType> recvOffsets(numProcs);
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      recvOffsets[cc] = bucketSize;
+      bucketSize += counts[cc * numProcs + this->Me];
+    }
+    std::vector<SortKey> bucket(bucketSize);
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      lengths[cc] = localCounts[cc] * keySize;
+      offsets[cc] = bucketStarts[cc] * keySize;
+    }
+    for (int root = 0; root < numProcs; ++root)
+    {
+      this->MPI->ScatterV(reinterpret_cast<const char*>(keys.data()),
+        reinterpret_cast<char*>(bucket.data() + recvOffsets[root]), lengths.data(),
+        offsets.data(), counts[root * numProcs + this->Me] * keySize, root);
+    }
+    keys.clear();
+    keys.shrink_to_fit();
 
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
+    // Sort the bucket and compute the global rank of each key
+    std::vector<vtkIdType> bucketOrder(bucketSize);
+    std::iota(bucketOrder.begin(), bucketOrder.end(), static_cast<vtkIdType>(0));
+    vtkSMPTools::Sort(bucketOrder.begin(), bucketOrder.end(),
+      [&](vtkIdType a, vtkIdType b) { return compare(bucket[a], bucket[b]); });
 
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
+    std::vector<vtkIdType> bucketSizes(numProcs);
+    this->MPI->AllGather(&bucketSize, bucketSizes.data(), 1);
+    vtkIdType rankOffset = 0;
+    index.GlobalSize = 0;
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      rankOffset += (cc < this->Me) ? bucketSizes[cc] : 0;
+      index.GlobalSize += bucketSizes[cc];
+    }
+    std::vector<vtkIdType> bucketRanks(bucketSize);
+    vtkSMPTools::For(0, bucketSize, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
       {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        bucketRanks[bucketOrder[cc]] = rankOffset + cc;
       }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
+    });
 
-    delete[] bufferHistogramValues;
+    // Send the global ranks back in the order the keys were received, which
+    // matches the local sorted order on the owning process.
+    const vtkIdType rankSize = static_cast<vtkIdType>(sizeof(vtkIdType));
+    for (int cc = 0; cc < numProcs; ++cc)
+    {
+      lengths[cc] = counts[cc * numProcs + this->Me] * rankSize;
+      offsets[cc] = recvOffsets[cc] * rankSize;
+    }
+    for (int root = 0; root < numProcs; ++root)
+    {
+      this->MPI->ScatterV(reinterpret_cast<const char*>(bucketRanks.data()),
+        reinterpret_cast<char*>(index.GlobalRanks.data() + bucketStarts[root]), lengths.data(),
+        offsets.data(), localCounts[root] * rankSize, root);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  std::vector<SortKey> NewLocalKeys()
+  {
+    const vtkIdType numTuples = this->DataToSort ? this->DataToSort->GetNumberOfTuples() : 0;
+    std::vector<SortKey> keys(numTuples);
+    if (numTuples == 0)
+    {
+      return keys;
+    }
+
+    const T* dataPtr = static_cast<T*>(this->DataToSort->GetVoidPointer(0));
+    const int numComponents = this->DataToSort->GetNumberOfComponents();
+    int selectedComponent = this->SelectedComponent;
+    if (numComponents == 1 && selectedComponent < 0)
+    {
+      selectedComponent = 0; // We can not compute magnitude on scalar value
+    }
+    const int me = this->Me;
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        SortKey& key = keys[i];
+        key.Index = i;
+        key.Process = me;
+        if (selectedComponent < 0)
+        {
+          // Compute magnitude
+          double value = 0;
+          for (int k = 0; k < numComponents; k++)
+          {
+            const double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+            value += tmp * tmp;
+          }
+          key.Value = static_cast<T>(sqrt(value) / sqrt(static_cast<double>(numComponents)));
+        }
+        else
+        {
+          key.Value = dataPtr[selectedComponent + i * numComponents];
+        }
+      }
+    });
+    return keys;
   }
 
   // --------------------------------------------------------------------------
@@ -1095,18 +1199,51 @@ public:
     return subTable;
   }
 
+  // --------------------------------------------------------------------------
+  static vtkTable* NewSubsetTable(vtkTable* srcTable, const vtkIdType* rows, vtkIdType size)
+  {
+    vtkTable* subTable = vtkTable::New();
+    vtkNew<vtkIdList> ids;
+    ids->SetNumberOfIds(size);
+    std::copy(rows, rows + size, ids->GetPointer(0));
+
+    // Loop on all column of the table
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      if (auto sinfo = srcArray->GetInformation())
+      {
+        subArray->CopyInformation(sinfo);
+      }
+      subArray->SetNumberOfTuples(size);
+      srcArray->GetTuples(ids, subArray);
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
+    return subTable;
+  }
+
   // --------------------------------------------------------------------------
   void SetSelectedComponent(int newValue) override
   {
     if (this->SelectedComponent != newValue)
     {
-      this->InvalidateCache();
+      // Permutation indices are kept per component, only the local order
+      // used by Extract() must be rebuilt.
+      this->NeedToBuildCache = true;
       this->SelectedComponent = newValue;
     }
   }
 
   // --------------------------------------------------------------------------
-  void InvalidateCache() override { this->NeedToBuildCache = true; }
+  void InvalidateCache() override
+  {
+    this->NeedToBuildCache = true;
+    this->PermutationIndices.clear();
+  }
 
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
@@ -1309,13 +1446,13 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
   int SelectedComponent;      // Component used to sort array
   bool NeedToBuildCache;
+  std::map<std::pair<int, bool>, PermutationIndex> PermutationIndices;
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
@@ -1639,16 +1776,9 @@ void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = 0;
-  }
-
-  if (changed)
+  // The internal object keeps the sorted index for both orders, hence there is
+  // no need to discard it.
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
@@ -19,9 +19,192 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Compressed images start with the number of tiles followed by the number of
+// pixels and runs of each tile, as 32-bit words. Runs of all tiles follow.
+inline vtkIdType GetHeaderSize(vtkIdType numTiles)
+{
+  return 1 + 2 * numTiles;
+}
+
+// Returns a bitmask where bit k is set if the k-th pixel of `pixels` matches
+// `color` once masked. The trip count is fixed for full blocks so compilers
+// vectorize the comparisons.
+template <typename LoadFunctor>
+inline unsigned int MatchBlock(
+  const LoadFunctor& load, vtkIdType first, int blockSize, unsigned int color, unsigned int mask)
+{
+  unsigned int matches = 0;
+  if (blockSize == 16)
+  {
+    for (int k = 0; k < 16; ++k)
+    {
+      matches |= static_cast<unsigned int>((load(first + k) & mask) == color) << k;
+    }
+  }
+  else
+  {
+    for (int k = 0; k < blockSize; ++k)
+    {
+      matches |= static_cast<unsigned int>((load(first + k) & mask) == color) << k;
+    }
+  }
+  return matches;
+}
+
+inline int CountTrailingOnes(unsigned int bits, int max)
+{
+  int count = 0;
+  while (count < max && (bits & (1u << count)) != 0)
+  {
+    ++count;
+  }
+  return count;
+}
+
+// Length of the run of pixels matching the pixel at `index`, excluding it,
+// clamped to `maxRun`. Pixels are always compared in blocks of 16, even when
+// `maxRun` is smaller (RGBA runs are at most 15), so that full blocks use the
+// fixed-size comparison of MatchBlock.
+template <typename LoadFunctor>
+inline int ComputeRun(const LoadFunctor& load, vtkIdType index, vtkIdType numPixels,
+  int maxRun, unsigned int mask)
+{
+  const unsigned int color = load(index) & mask;
+  int run = 0;
+  while (run < maxRun)
+  {
+    const int blockSize = static_cast<int>(std::min<vtkIdType>(16, numPixels - index - 1 - run));
+    if (blockSize <= 0)
+    {
+      break;
+    }
+    const int matched =
+      CountTrailingOnes(MatchBlock(load, index + 1 + run, blockSize, color, mask), blockSize);
+    run += matched;
+    if (matched < blockSize)
+    {
+      break;
+    }
+  }
+  return std::min(run, maxRun);
+}
+
+vtkIdType EncodeRGBA(
+  const unsigned int* in, vtkIdType numPixels, unsigned int mask, unsigned int* out)
+{
+  auto load = [in](vtkIdType idx) { return in[idx]; };
+  vtkIdType numRuns = 0;
+  for (vtkIdType index = 0; index < numPixels; ++numRuns)
+  {
+    const unsigned int color = in[index];
+    const int run = ComputeRun(load, index, numPixels, 0x0F, mask);
+    unsigned char count = static_cast<unsigned char>(run);
+    unsigned char opacity = reinterpret_cast<const unsigned char*>(&color)[3];
+    if (opacity > 0)
+    {
+      // encode 8-bit opacity into 4 bits.
+      count |= static_cast<unsigned char>((opacity / 16) << 4);
+    }
+    out[numRuns] = color;
+    reinterpret_cast<unsigned char*>(out + numRuns)[3] = count;
+    index += run + 1;
+  }
+  return numRuns;
+}
+
+vtkIdType EncodeRGB(
+  const unsigned char* in, vtkIdType numPixels, unsigned int mask, unsigned int* out)
+{
+  auto load = [in](vtkIdType idx) {
+    unsigned int color = 0;
+    memcpy(&color, in + 3 * idx, 3);
+    return color;
+  };
+  vtkIdType numRuns = 0;
+  for (vtkIdType index = 0; index < numPixels; ++numRuns)
+  {
+    const int run = ComputeRun(load, index, numPixels, 255, mask);
+    out[numRuns] = load(index);
+    reinterpret_cast<unsigned char*>(out + numRuns)[3] = static_cast<unsigned char>(run);
+    index += run + 1;
+  }
+  return numRuns;
+}
+
+bool DecodeRGBA(
+  const unsigned int* in, vtkIdType numRuns, unsigned int* out, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType cc = 0; cc < numRuns; ++cc)
+  {
+    unsigned int color = in[cc];
+    unsigned char* colorBytes = reinterpret_cast<unsigned char*>(&color);
+    const unsigned char count = colorBytes[3];
+    // opacity was stored in the high 4 bits.
+    colorBytes[3] = count > 0x0F ? (count & 0xF0) : 0;
+    const vtkIdType length = (count & 0x0F) + 1;
+    if (index + length > numPixels)
+    {
+      return false;
+    }
+    std::fill_n(out + index, length, color);
+    index += length;
+  }
+  return index == numPixels;
+}
+
+bool DecodeRGB(
+  const unsigned int* in, vtkIdType numRuns, unsigned char* out, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType cc = 0; cc < numRuns; ++cc)
+  {
+    const unsigned char* color = reinterpret_cast<const unsigned char*>(in + cc);
+    const vtkIdType length = color[3] + 1;
+    if (index + length > numPixels)
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < length; ++j, ++index)
+    {
+      std::copy(color, color + 3, out + 3 * index);
+    }
+  }
+  return index == numPixels;
+}
+
+// Reads the tile header of a compressed image and computes the offsets of
+// each tile in the compressed runs and in the decompressed pixels.
+bool ReadTiles(vtkUnsignedCharArray* in, vtkIdType numPixels, std::vector<vtkIdType>& pixelOffsets,
+  std::vector<vtkIdType>& runOffsets)
+{
+  const vtkIdType numWords = in->GetNumberOfValues() / 4;
+  const vtkTypeUInt32* words = reinterpret_cast<const vtkTypeUInt32*>(in->GetPointer(0));
+  if (numWords < 1 || GetHeaderSize(words[0]) > numWords)
+  {
+    return false;
+  }
+  const vtkIdType numTiles = words[0];
+  pixelOffsets.assign(numTiles + 1, 0);
+  runOffsets.assign(numTiles + 1, GetHeaderSize(numTiles));
+  for (vtkIdType tile = 0; tile < numTiles; ++tile)
+  {
+    pixelOffsets[tile + 1] = pixelOffsets[tile] + words[1 + 2 * tile];
+    runOffsets[tile + 1] = runOffsets[tile] + words[2 + 2 * tile];
+  }
+  return pixelOffsets[numTiles] == numPixels && runOffsets[numTiles] <= numWords;
+}
+}
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
@@ -46,19 +229,14 @@ int vtkSquirtCompressor::Compress()
   }
 
   vtkUnsignedCharArray* input = this->GetInput();
-
-  if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
+  const int numComps = input->GetNumberOfComponents();
+  if (numComps != 4 && numComps != 3)
   {
     vtkErrorMacro("Squirt only works with RGBA or RGB");
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -73,105 +251,49 @@ int vtkSquirtCompressor::Compress()
   unsigned int compress_mask;
   // I shifted the level by one so that 0 means no compression.
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
-
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
+  if (numComps == 3)
   {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
-    {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
-      {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
-    }
+    // the 4th byte of RGB colors is always 0.
+    reinterpret_cast<unsigned char*>(&compress_mask)[3] = 0;
   }
-  else if (input->GetNumberOfComponents() == 3)
-  {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
 
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
+  // Each tile is run-length encoded independently, in the region of the
+  // output that would hold its pixels if no run was found. Runs are then
+  // moved next to each other.
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const int numTiles = this->ComputeNumberOfTiles(numPixels);
+  const vtkIdType headerSize = GetHeaderSize(numTiles);
+  this->Output->SetNumberOfComponents(1);
+  vtkTypeUInt32* out =
+    reinterpret_cast<vtkTypeUInt32*>(this->Output->WritePointer(0, 4 * (headerSize + numPixels)));
+  std::vector<vtkIdType> numRuns(numTiles);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      const vtkIdType first = tile * numPixels / numTiles;
+      const vtkIdType last = (tile + 1) * numPixels / numTiles;
+      unsigned int* tileOut = out + headerSize + first;
+      numRuns[tile] = numComps == 4
+        ? EncodeRGBA(reinterpret_cast<const unsigned int*>(input->GetPointer(0)) + first,
+            last - first, compress_mask, tileOut)
+        : EncodeRGB(input->GetPointer(0) + 3 * first, last - first, compress_mask, tileOut);
     }
+  });
+
+  out[0] = static_cast<vtkTypeUInt32>(numTiles);
+  vtkIdType size = headerSize;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    const vtkIdType first = tile * numPixels / numTiles;
+    const vtkIdType last = (tile + 1) * numPixels / numTiles;
+    out[1 + 2 * tile] = static_cast<vtkTypeUInt32>(last - first);
+    out[2 + 2 * tile] = static_cast<vtkTypeUInt32>(numRuns[tile]);
+    memmove(out + size, out + headerSize + first, 4 * numRuns[tile]);
+    size += numRuns[tile];
   }
 
   // Back to vtk arrays :)
-  this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
+  this->Output->SetNumberOfTuples(4 * size);
 
   return VTK_OK;
 }
@@ -209,50 +331,29 @@ int vtkSquirtCompressor::DecompressRGBA()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 4);
 
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  std::vector<vtkIdType> pixelOffsets, runOffsets;
+  if (!ReadTiles(in, out->GetNumberOfTuples(), pixelOffsets, runOffsets))
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
+    vtkErrorMacro("Invalid SQUIRT tile header.");
+    return VTK_ERROR;
+  }
 
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
+  const unsigned int* runs = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  unsigned int* pixels = reinterpret_cast<unsigned int*>(out->GetPointer(0));
+  const vtkIdType numTiles = static_cast<vtkIdType>(pixelOffsets.size()) - 1;
+  std::vector<char> status(numTiles, 0);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
     {
-      _rawColorBuffer[index++] = current_color;
+      status[tile] = DecodeRGBA(runs + runOffsets[tile],
+        runOffsets[tile + 1] - runOffsets[tile], pixels + pixelOffsets[tile],
+        pixelOffsets[tile + 1] - pixelOffsets[tile]);
     }
+  });
+  if (std::find(status.begin(), status.end(), 0) != status.end())
+  {
+    vtkErrorMacro("Invalid SQUIRT runs.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
@@ -264,39 +365,29 @@ int vtkSquirtCompressor::DecompressRGB()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 3);
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  std::vector<vtkIdType> pixelOffsets, runOffsets;
+  if (!ReadTiles(in, out->GetNumberOfTuples(), pixelOffsets, runOffsets))
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    *((unsigned char*)&current_color + 3) = 0xff;
+    vtkErrorMacro("Invalid SQUIRT tile header.");
+    return VTK_ERROR;
+  }
 
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
+  const unsigned int* runs = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  unsigned char* pixels = out->GetPointer(0);
+  const vtkIdType numTiles = static_cast<vtkIdType>(pixelOffsets.size()) - 1;
+  std::vector<char> status(numTiles, 0);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
     {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
+      status[tile] = DecodeRGB(runs + runOffsets[tile],
+        runOffsets[tile + 1] - runOffsets[tile], pixels + 3 * pixelOffsets[tile],
+        pixelOffsets[tile + 1] - pixelOffsets[tile]);
     }
+  });
+  if (std::find(status.begin(), status.end(), 0) != status.end())
+  {
+    vtkErrorMacro("Invalid SQUIRT runs.");
+    return VTK_ERROR;
   }
   return VTK_OK;
 }
@@ -44,6 +44,10 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * Large images are split in tiles that are run-length encoded independently
+ * on multiple threads. The tile sizes are stored in front of the runs so that
+ * tiles are decompressed in parallel as well.
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
 */
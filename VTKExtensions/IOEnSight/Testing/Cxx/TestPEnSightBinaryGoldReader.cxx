@@ -1,10 +1,26 @@
 #include "vtkCellTypes.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
+#include "vtkPEnSightGoldBinaryReader.h"
 #include "vtkPGenericEnSightReader.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
 #include "vtkTestUtilities.h"
 #include "vtkUnstructuredGrid.h"
 
+namespace
+{
+vtkSmartPointer<vtkPoints> ReadPoints(const char* fname, bool useMemoryMappedFiles)
+{
+  vtkNew<vtkPEnSightGoldBinaryReader> reader;
+  reader->SetCaseFileName(fname);
+  reader->SetUseMemoryMappedFiles(useMemoryMappedFiles);
+  reader->Update();
+  vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  return ug ? ug->GetPoints() : nullptr;
+}
+}
+
 int TestPEnSightBinaryGoldReader(int argc, char* argv[])
 {
   char* fname =
@@ -43,5 +59,32 @@ int TestPEnSightBinaryGoldReader(int argc, char* argv[])
     }
   }
 
+  // Coordinates decoded from the memory mapped file must match the ones read
+  // through the file stream.
+  vtkSmartPointer<vtkPoints> streamPoints = ReadPoints(fname, false);
+  vtkSmartPointer<vtkPoints> mappedPoints = ReadPoints(fname, true);
+  if (!streamPoints || !mappedPoints ||
+    streamPoints->GetNumberOfPoints() != mappedPoints->GetNumberOfPoints() ||
+    streamPoints->GetNumberOfPoints() != ug->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points with memory mapped files." << std::endl;
+    delete[] fname;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < mappedPoints->GetNumberOfPoints(); i++)
+  {
+    double streamPoint[3], mappedPoint[3];
+    streamPoints->GetPoint(i, streamPoint);
+    mappedPoints->GetPoint(i, mappedPoint);
+    if (streamPoint[0] != mappedPoint[0] || streamPoint[1] != mappedPoint[1] ||
+      streamPoint[2] != mappedPoint[2])
+    {
+      std::cerr << "Point " << i << " differs with memory mapped files." << std::endl;
+      delete[] fname;
+      return EXIT_FAILURE;
+    }
+  }
+
+  delete[] fname;
   return EXIT_SUCCESS;
 }
@@ -11,16 +11,229 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <ctype.h>
+#include <cstring>
 #include <string>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// A read-only stream buffer over a memory mapped file. Reads are plain
+// copies and seeks only move the get pointer, so walking a file with many
+// small reads and seeks doesn't result in any system calls.
+class MappedFileBuffer : public std::streambuf
+{
+public:
+  void SetData(const char* data, size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    this->setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    if ((which & std::ios_base::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    {
+      base = this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      base = this->egptr() - this->eback();
+    }
+    off_type target = base + off;
+    if (target < 0)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    // file streams allow seeking past the end, with subsequent reads
+    // failing. Clamping to the end gives the same behavior for reads.
+    target = std::min<off_type>(target, this->egptr() - this->eback());
+    this->setg(this->eback(), this->eback() + target, this->egptr());
+    return pos_type(target);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+
+  std::streamsize showmanyc() override { return this->egptr() - this->gptr(); }
+
+  std::streamsize xsgetn(char* s, std::streamsize n) override
+  {
+    n = std::min<std::streamsize>(n, this->egptr() - this->gptr());
+    memcpy(s, this->gptr(), static_cast<size_t>(n));
+    this->setg(this->eback(), this->gptr() + n, this->egptr());
+    return n;
+  }
+};
+
+// An input stream reading from a memory mapped file.
+class MappedFileStream : public std::istream
+{
+public:
+  MappedFileStream()
+    : std::istream(nullptr)
+  {
+  }
+
+  ~MappedFileStream() override { this->Close(); }
+
+  bool Open(const char* filename)
+  {
+    this->Close();
+#if defined(_WIN32)
+    std::wstring wfilename = vtksys::Encoding::ToWide(filename);
+    this->File = CreateFileW(wfilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER size;
+    if (this->File == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->File, &size) ||
+      size.QuadPart == 0)
+    {
+      this->Close();
+      return false;
+    }
+    this->Mapping = CreateFileMappingW(this->File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->Mapping == nullptr)
+    {
+      this->Close();
+      return false;
+    }
+    this->Data = static_cast<const char*>(MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0));
+    this->Size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+      if (fd >= 0)
+      {
+        close(fd);
+      }
+      return false;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+    this->Data = static_cast<const char*>(data);
+    this->Size = static_cast<size_t>(st.st_size);
+#endif
+    if (this->Data == nullptr)
+    {
+      this->Close();
+      return false;
+    }
+    this->Buffer.SetData(this->Data, this->Size);
+    this->init(&this->Buffer);
+    return true;
+  }
+
+  void Close()
+  {
+#if defined(_WIN32)
+    if (this->Data)
+    {
+      UnmapViewOfFile(this->Data);
+    }
+    if (this->Mapping)
+    {
+      CloseHandle(this->Mapping);
+    }
+    if (this->File != INVALID_HANDLE_VALUE)
+    {
+      CloseHandle(this->File);
+    }
+    this->Mapping = nullptr;
+    this->File = INVALID_HANDLE_VALUE;
+#else
+    if (this->Data)
+    {
+      munmap(const_cast<char*>(this->Data), this->Size);
+    }
+#endif
+    this->Data = nullptr;
+    this->Size = 0;
+  }
+
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  MappedFileBuffer Buffer;
+  const char* Data = nullptr;
+  size_t Size = 0;
+#if defined(_WIN32)
+  HANDLE File = INVALID_HANDLE_VALUE;
+  HANDLE Mapping = nullptr;
+#endif
+};
+
+// Decodes interleaved coordinates from the x, y and z blocks of a part,
+// scattering them to the local point ids.
+struct DecodeCoordinatesWorker
+{
+  const char* Blocks[3];
+  int ByteOrder;
+  vtkPEnSightReader::vtkPEnSightReaderCellIds* PointIds;
+  float* Points;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const int id = this->PointIds->GetId(static_cast<int>(i));
+      if (id == -1)
+      {
+        continue;
+      }
+      float* point = this->Points + 3 * static_cast<vtkIdType>(id);
+      for (int comp = 0; comp < 3; ++comp)
+      {
+        memcpy(point + comp, this->Blocks[comp] + i * sizeof(float), sizeof(float));
+      }
+      if (this->ByteOrder == vtkPEnSightReader::FILE_LITTLE_ENDIAN)
+      {
+        vtkByteSwap::Swap4LERange(point, 3);
+      }
+      else
+      {
+        vtkByteSwap::Swap4BERange(point, 3);
+      }
+    }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
@@ -34,6 +247,7 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
+  this->UseMemoryMappedFiles = true;
 
   this->FloatBufferSize = 1000;
 
@@ -77,17 +291,33 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
-#ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
-#else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
-#endif
+    if (this->UseMemoryMappedFiles)
+    {
+      MappedFileStream* mapped = new MappedFileStream();
+      if (mapped->Open(filename))
+      {
+        this->IFile = mapped;
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not map " << filename << ", using a file stream instead.");
+        delete mapped;
+      }
+    }
   }
   else
   {
     vtkErrorMacro("stat failed.");
     return 0;
   }
+  if (!this->IFile)
+  {
+#ifdef _WIN32
+    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+#else
+    this->IFile = new vtksys::ifstream(filename, ios::in);
+#endif
+  }
   if (!this->IFile || this->IFile->fail())
   {
     vtkErrorMacro(<< "Could not open file " << filename);
@@ -4366,20 +4596,17 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
       int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
       points->Allocate(localNumberOfIds);
       points->SetNumberOfPoints(localNumberOfIds);
-      int maxId = -1;
-      int minId = -1;
-      for (i = 0; i < numPts; i++)
+      if (!this->DecodeMappedCoordinates(points, currentPositionInFile, numPts, partId))
       {
-        float vec[3];
-        int id = this->GetPointIds(partId)->GetId(i);
-        if (id != -1)
+        for (i = 0; i < numPts; i++)
         {
-          if ((minId == -1) || (minId > id))
-            minId = id;
-          if ((maxId == -1) || (maxId < id))
-            maxId = id;
-          this->GetVectorFromFloatBuffer(i, vec);
-          points->SetPoint(id, vec[0], vec[1], vec[2]);
+          float vec[3];
+          int id = this->GetPointIds(partId)->GetId(i);
+          if (id != -1)
+          {
+            this->GetVectorFromFloatBuffer(i, vec);
+            points->SetPoint(id, vec[0], vec[1], vec[2]);
+          }
         }
       }
 
@@ -4398,6 +4625,37 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPEnSightGoldBinaryReader::DecodeMappedCoordinates(
+  vtkPoints* points, long position, vtkIdType numPts, int partId)
+{
+  MappedFileStream* mapped = dynamic_cast<MappedFileStream*>(this->IFile);
+  if (mapped == nullptr || points->GetDataType() != VTK_FLOAT || position < 0)
+  {
+    return false;
+  }
+
+  // the x, y and z coordinates are stored in consecutive blocks, each one
+  // framed by 4 byte record markers in Fortran files.
+  const size_t header = this->Fortran ? 4 : 0;
+  const size_t blockSize = numPts * sizeof(float) + 2 * header;
+  if (static_cast<size_t>(position) + 3 * blockSize > mapped->GetSize())
+  {
+    return false;
+  }
+
+  DecodeCoordinatesWorker worker;
+  for (int comp = 0; comp < 3; ++comp)
+  {
+    worker.Blocks[comp] = mapped->GetData() + position + header + comp * blockSize;
+  }
+  worker.ByteOrder = this->ByteOrder;
+  worker.PointIds = this->GetPointIds(partId);
+  worker.Points = vtkFloatArray::SafeDownCast(points->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPts, worker);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::InjectCoordinatesAtEnd(
   vtkUnstructuredGrid* output, long coordinatesOffset, int partId)
@@ -4518,4 +4776,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMappedFiles: " << this->UseMemoryMappedFiles << endl;
 }
@@ -46,6 +46,19 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When enabled (default), geometry and variable files are memory mapped
+   * instead of being read through a file stream. This replaces the many small
+   * reads and seeks done while walking parts by plain memory accesses and
+   * lets coordinates be decoded in parallel. The reader falls back to a file
+   * stream if the file cannot be mapped.
+   */
+  vtkSetMacro(UseMemoryMappedFiles, bool);
+  vtkGetMacro(UseMemoryMappedFiles, bool);
+  vtkBooleanMacro(UseMemoryMappedFiles, bool);
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -175,6 +188,14 @@ protected:
    */
   int ReadOrSkipCoordinates(vtkPoints* points, long offset, int partId, bool skip);
 
+  /**
+   * Decode the coordinates of the points of `partId` needed by this process
+   * directly from the mapped file, in parallel. `position` is the offset of
+   * the x coordinates in the file. Returns false if the file is not mapped
+   * or is too short, in which case the buffered path must be used.
+   */
+  bool DecodeMappedCoordinates(vtkPoints* points, long position, vtkIdType numPts, int partId);
+
   /**
    * Internal method to inject Coordinates and Global Ids at the end
    * of a part read for Unstructured data.
@@ -203,6 +224,7 @@ protected:
   int NodeIdsListed;
   int ElementIdsListed;
   int Fortran;
+  bool UseMemoryMappedFiles;
 
   istream* IFile;
   // The size of the file could be used to choose byte order.
@@ -220,11 +220,12 @@ public:
         }
         case SPARSE_MODE:
         {
-          std::map<int, int>::iterator it = this->cellMap->find(id);
+          // only use find() so that concurrent lookups do not modify the map.
+          std::map<int, int>::const_iterator it = this->cellMap->find(id);
           if (it == this->cellMap->end())
             return -1;
           else
-            return (*this->cellMap)[id];
+            return it->second;
           break;
         }
         default:
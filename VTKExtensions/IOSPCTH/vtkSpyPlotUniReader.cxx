@@ -5,6 +5,7 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -12,6 +13,7 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <atomic>
 #include <sstream>
 #include <vector>
 
@@ -214,7 +216,6 @@ int vtkSpyPlotUniReader::MakeCurrent()
     }
   }
 
-  std::vector<unsigned char> arrayBuffer;
   vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
   spis.SetStream(&ifs);
@@ -248,43 +249,44 @@ int vtkSpyPlotUniReader::MakeCurrent()
       }
     }
 
-    // Advance the stream to where the block geometries are
+    // Advance the stream to where the block geometries are. The encoded
+    // geometries are read first and then decoded in parallel.
     spis.Seek(dp->SavedBlocksGeometryOffset);
+    this->EncodedBuffer.clear();
+    this->EncodedSegments.clear();
     for (block = 0; block < dp->NumberOfBlocks; ++block)
     {
       vtkSpyPlotBlock* b = &(this->Blocks[block]);
       if (b->IsAllocated())
       {
-        int numBytes;
-        int component;
-        // vtkDebugMacro( "Block: " << block );
-        for (component = 0; component < 3; ++component)
+        for (int component = 0; component < 3; ++component)
         {
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (!this->ReadEncodedSegment(&spis, block, component, 0))
           {
-            vtkErrorMacro("Problem reading the number of bytes");
+            vtkErrorMacro("Problem reading the geometry of block " << block);
             return 0;
           }
-          // vtkDebugMacro( "  Number of bytes for " << component << ": "
-          // << numBytes );
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
+        }
+      }
+    }
 
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (!b->SetGeometry(component, &*arrayBuffer.begin(), numBytes))
+    std::atomic<bool> failed(false);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->EncodedSegments.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const EncodedSegment& segment = this->EncodedSegments[cc];
+          if (!this->Blocks[segment.Block].SetGeometry(
+                segment.Index, &this->EncodedBuffer[segment.Offset], segment.Size))
           {
-            vtkErrorMacro("Problem RLD decoding rectilinear grid array: " << component);
-            return 0;
+            failed = true;
           }
-          vtkDebugMacro(" " << b << " geometry initialized");
         }
-      }
+      });
+    if (failed)
+    {
+      vtkErrorMacro("Problem RLD decoding rectilinear grid arrays");
+      return 0;
     }
   }
 
@@ -389,8 +391,13 @@ int vtkSpyPlotUniReader::MakeCurrent()
     // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
+    // Only the selected variables are read, using the offsets saved by
+    // ReadDataDumps. The encoded planes of all blocks are read first and
+    // then decoded in parallel.
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
-    int numBytes;
+    this->EncodedBuffer.clear();
+    this->EncodedSegments.clear();
+    const bool downConvert = this->DownConvertVolumeFraction && this->IsVolumeFraction(var);
     int block;
     int actualBlockId = 0;
     for (block = 0; block < dp->NumberOfBlocks; ++block)
@@ -398,27 +405,21 @@ int vtkSpyPlotUniReader::MakeCurrent()
       vtkSpyPlotBlock* bk = this->Blocks + block;
       if (bk->IsAllocated())
       {
-        vtkFloatArray* floatArray = 0;
-        vtkUnsignedCharArray* unsignedCharArray = 0;
         vtkDataArray* dataArray = 0;
         if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
         {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
+          if (downConvert)
           {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
+            dataArray = vtkUnsignedCharArray::New();
           }
           else
           {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
+            dataArray = vtkFloatArray::New();
           }
           dataArray->SetNumberOfComponents(1);
           dataArray->SetNumberOfTuples(
             bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
           dataArray->SetName(var->Name);
-          // vtkDebugMacro( "*** Create data array: "
-          // << dataArray->GetNumberOfTuples() );
         }
         int zax;
         int bdims[3];
@@ -426,37 +427,24 @@ int vtkSpyPlotUniReader::MakeCurrent()
         for (zax = 0; zax < bdims[2]; ++zax)
         {
           int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (dataArray)
           {
-            vtkErrorMacro("Problem reading the number of bytes");
-            return 0;
-          }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
-          {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            if (!this->ReadEncodedSegment(&spis, actualBlockId, zax, planeSize))
             {
-              vtkErrorMacro("Problem RLD decoding float data array");
+              vtkErrorMacro("Problem reading the bytes");
+              dataArray->Delete();
               return 0;
             }
           }
-          if (unsignedCharArray)
+          else
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            int numBytes;
+            if (!spis.ReadInt32s(&numBytes, 1))
             {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
+              vtkErrorMacro("Problem reading the number of bytes");
               return 0;
             }
+            spis.Seek(numBytes, true);
           }
         }
         if (dataArray)
@@ -468,6 +456,38 @@ int vtkSpyPlotUniReader::MakeCurrent()
         }
       }
     }
+
+    std::atomic<bool> failed(false);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->EncodedSegments.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const EncodedSegment& segment = this->EncodedSegments[cc];
+          const unsigned char* in = &this->EncodedBuffer[segment.Offset];
+          vtkDataArray* dataArray = var->DataBlocks[segment.Block];
+          const vtkIdType start = static_cast<vtkIdType>(segment.Index) * segment.Length;
+          int status;
+          if (downConvert)
+          {
+            unsigned char* ptr = static_cast<vtkUnsignedCharArray*>(dataArray)->GetPointer(start);
+            status = this->RunLengthDataDecode(in, segment.Size, ptr, segment.Length);
+          }
+          else
+          {
+            float* ptr = static_cast<vtkFloatArray*>(dataArray)->GetPointer(start);
+            status = this->RunLengthDataDecode(in, segment.Size, ptr, segment.Length);
+          }
+          if (!status)
+          {
+            failed = true;
+          }
+        }
+      });
+    if (failed)
+    {
+      vtkErrorMacro("Problem RLD decoding data array " << var->Name);
+      return 0;
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -483,6 +503,33 @@ int vtkSpyPlotUniReader::MakeCurrent()
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::ReadEncodedSegment(
+  vtkSpyPlotIStream* spis, int block, int index, int length)
+{
+  int numBytes;
+  if (!spis->ReadInt32s(&numBytes, 1) || numBytes < 0)
+  {
+    return 0;
+  }
+
+  EncodedSegment segment;
+  segment.Offset = this->EncodedBuffer.size();
+  segment.Size = numBytes;
+  segment.Block = block;
+  segment.Index = index;
+  segment.Length = length;
+  // the buffer keeps its capacity across calls, so this only allocates for
+  // the largest variable read so far.
+  this->EncodedBuffer.resize(segment.Offset + numBytes);
+  if (numBytes > 0 && !spis->ReadString(&this->EncodedBuffer[segment.Offset], numBytes))
+  {
+    return 0;
+  }
+  this->EncodedSegments.push_back(segment);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSpyPlotUniReader::PrintMemoryUsage()
 {
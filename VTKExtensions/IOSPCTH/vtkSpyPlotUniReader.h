@@ -36,6 +36,8 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsIOSPCTHModule.h" //needed for exports
+
+#include <vector> // for std::vector
 class vtkSpyPlotBlock;
 class vtkDataArraySelection;
 class vtkDataArray;
@@ -249,6 +251,13 @@ private:
   int ReadDataDumps(vtkSpyPlotIStream* spis);
   int ReadMarkerDumps(vtkSpyPlotIStream* spis);
 
+  /**
+   * Reads a run-length encoded segment (its size followed by its bytes) and
+   * appends it to EncodedBuffer so that it can be decoded later. `block`,
+   * `index` and `length` are stored in the EncodedSegment.
+   */
+  int ReadEncodedSegment(vtkSpyPlotIStream* spis, int block, int index, int length);
+
   vtkDataArray* GetMaterialField(const int& block, const int& materialIndex, const char* Id);
 
   // Header information
@@ -311,6 +320,20 @@ private:
 
   vtkDataArraySelection* CellArraySelection;
 
+  // Run-length encoded segments read from the file, waiting to be decoded.
+  // For variables, `Index` is the plane of `Block` and `Length` the number
+  // of values in the plane. For geometry, `Index` is the axis.
+  struct EncodedSegment
+  {
+    size_t Offset;
+    int Size;
+    int Block;
+    int Index;
+    int Length;
+  };
+  std::vector<unsigned char> EncodedBuffer;
+  std::vector<EncodedSegment> EncodedSegments;
+
   Variable* GetCellField(int field);
   int IsVolumeFraction(Variable* var);
 
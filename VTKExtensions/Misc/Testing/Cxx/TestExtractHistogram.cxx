@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestExtractHistogram.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractHistogram.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const vtkIdType NumberOfPoints = 100000;
+
+vtkSmartPointer<vtkPolyData> CreateDataSet()
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+
+  // values cycle through 0, 1, ..., 9.
+  vtkNew<vtkFloatArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(NumberOfPoints);
+
+  vtkNew<vtkIntArray> twice;
+  twice->SetName("twice");
+  twice->SetNumberOfTuples(NumberOfPoints);
+
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(NumberOfPoints);
+
+  for (vtkIdType cc = 0; cc < NumberOfPoints; ++cc)
+  {
+    points->SetPoint(cc, cc, 0, 0);
+    values->SetValue(cc, static_cast<float>(cc % 10));
+    twice->SetValue(cc, static_cast<int>(2 * (cc % 10)));
+    vectors->SetTuple3(cc, 0, 3 * (cc % 10), 4 * (cc % 10));
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->GetPointData()->AddArray(values);
+  pd->GetPointData()->AddArray(twice);
+  pd->GetPointData()->AddArray(vectors);
+  return pd;
+}
+}
+
+int TestExtractHistogram(int, char* [])
+{
+  auto pd = CreateDataSet();
+
+  vtkNew<vtkExtractHistogram> histogram;
+  histogram->SetInputData(pd);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "values");
+  histogram->SetBinCount(10);
+  histogram->SetCalculateAverages(true);
+  histogram->Update();
+
+  vtkTable* output = histogram->GetOutput();
+  vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
+  expect(bin_values != nullptr && bin_values->GetNumberOfTuples() == 10, "missing bin_values");
+  for (vtkIdType bin = 0; bin < 10; ++bin)
+  {
+    expect(bin_values->GetTuple1(bin) == NumberOfPoints / 10, "incorrect bin value");
+  }
+
+  vtkDataArray* averages = output->GetRowData()->GetArray("twice_average");
+  vtkDataArray* totals = output->GetRowData()->GetArray("twice_total");
+  expect(averages != nullptr && totals != nullptr, "missing averages");
+  for (vtkIdType bin = 0; bin < 10; ++bin)
+  {
+    expect(averages->GetTuple1(bin) == 2.0 * bin, "incorrect average");
+    expect(totals->GetTuple1(bin) == 2.0 * bin * (NumberOfPoints / 10), "incorrect total");
+  }
+
+  // Magnitude of a 3 component array, over a multiblock with the same dataset
+  // in two blocks.
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, pd);
+  mb->SetBlock(1, pd);
+  histogram->SetInputData(mb);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "vectors");
+  histogram->SetComponent(3);
+  histogram->SetCalculateAverages(false);
+  histogram->Update();
+
+  output = histogram->GetOutput();
+  bin_values = output->GetRowData()->GetArray("bin_values");
+  vtkDataArray* bin_extents = output->GetRowData()->GetArray("bin_extents");
+  expect(bin_values != nullptr && bin_extents != nullptr, "missing arrays");
+  expect(bin_extents->GetTuple1(9) == 42.75, "incorrect bin extents");
+  for (vtkIdType bin = 0; bin < 10; ++bin)
+  {
+    expect(bin_values->GetTuple1(bin) == 2 * NumberOfPoints / 10, "incorrect magnitude bin value");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPExtractHistogramAllReduce.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+namespace
+{
+// Piece of rank `rank`: 10 * (rank + 1) points with values cycling through
+// 0, 1, ..., 9 so that each of the 10 bins gets rank + 1 points.
+vtkSmartPointer<vtkPolyData> CreatePiece(int rank)
+{
+  const vtkIdType numPoints = 10 * (rank + 1);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPoints);
+
+  vtkNew<vtkFloatArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(numPoints);
+
+  vtkNew<vtkIntArray> twice;
+  twice->SetName("twice");
+  twice->SetNumberOfTuples(numPoints);
+
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    points->SetPoint(cc, cc, rank, 0);
+    values->SetValue(cc, static_cast<float>(cc % 10));
+    twice->SetValue(cc, static_cast<int>(2 * (cc % 10)));
+  }
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->GetPointData()->AddArray(values);
+  pd->GetPointData()->AddArray(twice);
+  return pd;
+}
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "Rank " << myRank << ", line " << __LINE__ << ": " msg << endl;                        \
+    return false;                                                                                  \
+  }
+
+bool TestAllReduce(vtkMultiProcessController* controller)
+{
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkPExtractHistogram> histogram;
+  histogram->SetController(controller);
+  histogram->SetInputData(CreatePiece(myRank));
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "values");
+  histogram->SetBinCount(10);
+  histogram->SetCalculateAverages(true);
+  histogram->SetUseAllReduce(true);
+  histogram->Update();
+
+  // Every rank must have the full histogram.
+  const double pointsPerBin = numRanks * (numRanks + 1) / 2;
+  vtkTable* output = histogram->GetOutput();
+  vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
+  expect(bin_values != nullptr && bin_values->GetNumberOfTuples() == 10, "missing bin_values.");
+  for (vtkIdType bin = 0; bin < 10; ++bin)
+  {
+    expect(bin_values->GetTuple1(bin) == pointsPerBin, "incorrect bin value.");
+  }
+
+  vtkDataArray* totals = output->GetRowData()->GetArray("twice_total");
+  vtkDataArray* averages = output->GetRowData()->GetArray("twice_average");
+  expect(totals != nullptr && averages != nullptr, "missing averages.");
+  for (vtkIdType bin = 0; bin < 10; ++bin)
+  {
+    expect(totals->GetTuple1(bin) == 2.0 * bin * pointsPerBin, "incorrect total.");
+    expect(averages->GetTuple1(bin) == 2.0 * bin, "incorrect average.");
+  }
+  return true;
+}
+}
+
+int TestPExtractHistogramAllReduce(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestAllReduce(contr) ? 1 : 0;
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
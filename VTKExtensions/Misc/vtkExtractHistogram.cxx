@@ -14,9 +14,11 @@
 =========================================================================*/
 #include "vtkExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGraph.h"
@@ -27,10 +29,14 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -283,6 +289,189 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
   return value;
 }
 
+namespace
+{
+// Sums the tuples [Begin, End) of an array in the bins given by BinIndices,
+// one per tuple. Totals holds BinCount x number of components values.
+struct vtkEHTotalsWorker
+{
+  vtkIdType Begin = 0;
+  vtkIdType End = 0;
+  const int* BinIndices = nullptr;
+  double* Totals = nullptr;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, this->Begin, this->End);
+    const int numComps = static_cast<int>(tuples.GetTupleSize());
+    const int* binIndices = this->BinIndices;
+    for (const auto tuple : tuples)
+    {
+      double* totals = this->Totals + *binIndices++ * numComps;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        totals[comp] += static_cast<double>(tuple[comp]);
+      }
+    }
+  }
+};
+
+// Bins the values of a single array. Each thread counts into its own bins
+// which are then merged once all tuples have been processed. This avoids any
+// locking in the inner loop. When averages are requested, each thread also
+// sums the tuples of the other arrays into its own per-bin totals. Tuples are
+// processed in blocks of BlockSize so that the bin indices needed for this
+// are only kept for one block per thread.
+struct vtkEHBinWorker
+{
+  static const vtkIdType BlockSize = 4096;
+
+  // inputs
+  int Component = 0;
+  int BinCount = 1;
+  double Min = 0.0;
+  double BinDelta = 1.0;
+  double Shift = 0.0;
+  std::vector<vtkDataArray*> OtherArrays;
+
+  // outputs. Totals has BinCount x number of components values for each of
+  // the OtherArrays.
+  std::vector<vtkIdType> Counts;
+  std::vector<std::vector<double> > Totals;
+
+  int GetBinIndex(double value) const
+  {
+    int index = static_cast<int>((value - this->Min + this->Shift) / this->BinDelta);
+
+    // If the value is equal to max, include it in the last bin.
+    return ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
+  }
+
+  template <typename ArrayT>
+  class Functor
+  {
+    ArrayT* Array;
+    vtkEHBinWorker& Worker;
+    vtkSMPThreadLocal<std::vector<vtkIdType> > LocalCounts;
+    vtkSMPThreadLocal<std::vector<std::vector<double> > > LocalTotals;
+    vtkSMPThreadLocal<std::vector<int> > LocalBinIndices;
+
+  public:
+    Functor(ArrayT* array, vtkEHBinWorker& worker)
+      : Array(array)
+      , Worker(worker)
+    {
+    }
+
+    void Initialize()
+    {
+      this->LocalCounts.Local().resize(this->Worker.BinCount, 0);
+      auto& totals = this->LocalTotals.Local();
+      totals.resize(this->Worker.OtherArrays.size());
+      for (size_t idx = 0; idx < totals.size(); ++idx)
+      {
+        totals[idx].resize(
+          this->Worker.BinCount * this->Worker.OtherArrays[idx]->GetNumberOfComponents(), 0.0);
+      }
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BlockSize)
+      {
+        this->ProcessBlock(blockBegin, std::min(blockBegin + BlockSize, end));
+      }
+    }
+
+    void ProcessBlock(vtkIdType begin, vtkIdType end)
+    {
+      const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
+      const int numComps = static_cast<int>(tuples.GetTupleSize());
+      const int component = this->Worker.Component;
+      auto& counts = this->LocalCounts.Local();
+      auto& binIndices = this->LocalBinIndices.Local();
+      binIndices.resize(static_cast<size_t>(end - begin));
+      int* binIndex = binIndices.data();
+      for (const auto tuple : tuples)
+      {
+        double value;
+        // if component is equal to the number of components, then the magnitude was requested.
+        if (component == numComps)
+        {
+          value = 0;
+          for (const auto comp : tuple)
+          {
+            value += static_cast<double>(comp) * static_cast<double>(comp);
+          }
+          value = std::sqrt(value);
+        }
+        else
+        {
+          value = static_cast<double>(tuple[component]);
+        }
+
+        const int index = this->Worker.GetBinIndex(value);
+        ++counts[index];
+        *binIndex++ = index;
+      }
+
+      auto& totals = this->LocalTotals.Local();
+      for (size_t idx = 0; idx < totals.size(); ++idx)
+      {
+        vtkEHTotalsWorker totalsWorker;
+        totalsWorker.Begin = begin;
+        totalsWorker.End = end;
+        totalsWorker.BinIndices = binIndices.data();
+        totalsWorker.Totals = totals[idx].data();
+        vtkDataArray* array = this->Worker.OtherArrays[idx];
+        if (!vtkArrayDispatch::Dispatch::Execute(array, totalsWorker))
+        {
+          totalsWorker(array);
+        }
+      }
+    }
+
+    void Reduce()
+    {
+      for (const auto& counts : this->LocalCounts)
+      {
+        for (int bin = 0; bin < this->Worker.BinCount; ++bin)
+        {
+          this->Worker.Counts[bin] += counts[bin];
+        }
+      }
+      for (const auto& totals : this->LocalTotals)
+      {
+        for (size_t idx = 0; idx < totals.size(); ++idx)
+        {
+          auto& result = this->Worker.Totals[idx];
+          for (size_t cc = 0; cc < result.size(); ++cc)
+          {
+            result[cc] += totals[idx][cc];
+          }
+        }
+      }
+    }
+  };
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    this->Counts.assign(this->BinCount, 0);
+    this->Totals.resize(this->OtherArrays.size());
+    for (size_t idx = 0; idx < this->OtherArrays.size(); ++idx)
+    {
+      this->Totals[idx].assign(
+        this->BinCount * this->OtherArrays[idx]->GetNumberOfComponents(), 0.0);
+    }
+
+    Functor<ArrayT> functor(array, *this);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(
   vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
@@ -295,66 +484,69 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
-  double bin_delta =
+  const vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
+  if (num_of_tuples == 0)
+  {
+    return;
+  }
+
+  vtkEHBinWorker worker;
+  worker.Component = this->Component;
+  worker.BinCount = this->BinCount;
+  worker.Min = min;
+  worker.BinDelta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
-  double half_delta = bin_delta / 2.0;
+  worker.Shift = this->CenterBinsAroundMinAndMax ? worker.BinDelta / 2.0 : 0.;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  if (this->CalculateAverages && field)
   {
-    if (i % 1000 == 0)
-    {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
+    // Get all other arrays, add their value to the bin
+    // For each bin, we will need 2 values per array ->
+    // total, num. elements
+    // at the end, divide each total by num. elements
+    int num_arrays = field->GetNumberOfArrays();
+    for (int idx = 0; idx < num_arrays; idx++)
     {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName() &&
+        array->GetNumberOfTuples() >= num_of_tuples)
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
+        worker.OtherArrays.push_back(array);
       }
-      value = sqrt(value);
-    }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
     }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+  }
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
+  this->UpdateProgress(0.10);
+  if (!vtkArrayDispatch::Dispatch::Execute(data_array, worker))
+  {
+    worker(data_array);
+  }
+
+  for (int bin = 0; bin < this->BinCount; ++bin)
+  {
+    bin_values->SetValue(bin, bin_values->GetValue(bin) + static_cast<int>(worker.Counts[bin]));
+  }
 
-    if (this->CalculateAverages)
+  for (size_t idx = 0; idx < worker.OtherArrays.size(); ++idx)
+  {
+    vtkDataArray* array = worker.OtherArrays[idx];
+    vtkEHInternals::ArrayValuesType& arrayValues = this->Internal->ArrayValues[array->GetName()];
+    arrayValues.TotalValues.resize(this->BinCount);
+    const int numComps = array->GetNumberOfComponents();
+    for (int bin = 0; bin < this->BinCount; ++bin)
     {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
+      if (worker.Counts[bin] == 0)
       {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
-        {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
-          for (int comp = 0; comp < numComps; comp++)
-          {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
-          }
-        }
+        continue;
+      }
+      arrayValues.TotalValues[bin].resize(numComps);
+      for (int comp = 0; comp < numComps; comp++)
+      {
+        arrayValues.TotalValues[bin][comp] += worker.Totals[idx][bin * numComps + comp];
       }
     }
   }
+  this->UpdateProgress(1.0);
 }
 
 //-----------------------------------------------------------------------------
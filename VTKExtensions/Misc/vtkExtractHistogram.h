@@ -22,6 +22,9 @@
  * will have contain a vtkDoubleArray named "bin_extents" which contains
  * the boundaries between each histogram bin, and a vtkUnsignedLongArray
  * named "bin_values" which will contain the value for each bin.
+ *
+ * Binning is done in parallel using vtkSMPTools with each thread counting
+ * into its own set of bins that are merged at the end.
 */
 
 #ifndef vtkExtractHistogram_h
@@ -14,29 +14,60 @@
 =========================================================================*/
 #include "vtkPExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <map>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+// Divides the reduced per-bin totals by the reduced bin counts.
+struct vtkPEHAverageWorker
+{
+  template <typename AverageArrayT, typename TotalArrayT, typename CountArrayT>
+  void operator()(AverageArrayT* averages, TotalArrayT* totals, CountArrayT* counts, int numBins)
+  {
+    const auto averageTuples = vtk::DataArrayTupleRange(averages, 0, numBins);
+    const auto totalTuples = vtk::DataArrayTupleRange(totals, 0, numBins);
+    const auto countValues = vtk::DataArrayValueRange<1>(counts, 0, numBins);
+    const int numComps = averages->GetNumberOfComponents();
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+      const double count = static_cast<double>(countValues[bin]);
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        averageTuples[bin][comp] = static_cast<double>(totalTuples[bin][comp]) / count;
+      }
+    }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
 vtkPExtractHistogram::vtkPExtractHistogram()
 {
   this->Controller = 0;
+  this->UseAllReduce = false;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -93,6 +124,12 @@ int vtkPExtractHistogram::RequestData(
     // Nothing to do if there is no data
     return 1;
   }
+
+  if (this->UseAllReduce)
+  {
+    return this->AllReduceHistogram(output) ? 1 : 0;
+  }
+
   // Now we need to collect and reduce data from all nodes on the root.
   vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
   reduceFilter->SetController(this->Controller);
@@ -133,16 +170,16 @@ int vtkPExtractHistogram::RequestData(
         vtkDataArray* array = output->GetRowData()->GetArray(i);
         if (array && reg_ex.find(array->GetName()))
         {
-          int numComps = array->GetNumberOfComponents();
           std::string name = reg_ex.match(1) + "_total";
           vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
-          for (vtkIdType idx = 0; idx < this->BinCount; idx++)
+          // totals and averages are vtkDoubleArray, counts are vtkIntArray.
+          using Doubles = vtkTypeList::Create<vtkDoubleArray>;
+          using Dispatcher =
+            vtkArrayDispatch::Dispatch3ByArray<Doubles, Doubles, vtkTypeList::Create<vtkIntArray> >;
+          vtkPEHAverageWorker worker;
+          if (!Dispatcher::Execute(array, tarray, bin_values, worker, this->BinCount))
           {
-            for (int j = 0; j < numComps; j++)
-            {
-              array->SetComponent(
-                idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
-            }
+            worker(array, tarray, bin_values, this->BinCount);
           }
         }
       }
@@ -156,9 +193,123 @@ int vtkPExtractHistogram::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::AllReduceHistogram(vtkTable* output)
+{
+  vtkDataSetAttributes* rowData = output->GetRowData();
+  vtkDataArray* bin_values = rowData->GetArray("bin_values");
+  const vtkIdType numBins = bin_values->GetNumberOfTuples();
+
+  // Ranks may not have the same set of arrays to average (e.g. when a rank
+  // has no data), hence we first agree on the union of all "*_total" arrays
+  // and their number of components.
+  std::map<std::string, int> totals;
+  if (this->CalculateAverages)
+  {
+    std::vector<std::pair<std::string, int> > localTotals;
+    vtksys::RegularExpression reg_ex("^(.*)_total$");
+    for (int i = 0, numArrays = rowData->GetNumberOfArrays(); i < numArrays; i++)
+    {
+      vtkDataArray* array = rowData->GetArray(i);
+      if (array && array->GetName() && reg_ex.find(array->GetName()))
+      {
+        localTotals.push_back(std::make_pair(reg_ex.match(1), array->GetNumberOfComponents()));
+      }
+    }
+
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(localTotals.size());
+    for (const auto& item : localTotals)
+    {
+      stream << item.first << item.second;
+    }
+
+    std::vector<vtkMultiProcessStream> allStreams;
+    if (!this->Controller->AllGather(stream, allStreams))
+    {
+      vtkErrorMacro("Parallel communication error. Could not gather array names.");
+      return false;
+    }
+    for (auto& rstream : allStreams)
+    {
+      int count;
+      rstream >> count;
+      for (int cc = 0; cc < count; ++cc)
+      {
+        std::string name;
+        int numComps;
+        rstream >> name >> numComps;
+        totals[name] = numComps;
+      }
+    }
+  }
+
+  // Pack the bin counts and all totals in a single buffer so that the
+  // reduction is done with a single collective.
+  std::vector<double> sendBuffer;
+  sendBuffer.reserve(static_cast<size_t>(numBins));
+  for (vtkIdType bin = 0; bin < numBins; ++bin)
+  {
+    sendBuffer.push_back(bin_values->GetTuple1(bin));
+  }
+  for (const auto& item : totals)
+  {
+    const std::string name = item.first + "_total";
+    vtkDataArray* array = rowData->GetArray(name.c_str());
+    const bool valid = (array != nullptr && array->GetNumberOfComponents() == item.second);
+    for (vtkIdType bin = 0; bin < numBins; ++bin)
+    {
+      for (int comp = 0; comp < item.second; ++comp)
+      {
+        sendBuffer.push_back(valid ? array->GetComponent(bin, comp) : 0.0);
+      }
+    }
+  }
+
+  std::vector<double> recvBuffer(sendBuffer.size());
+  if (!this->Controller->AllReduce(sendBuffer.data(), recvBuffer.data(),
+        static_cast<vtkIdType>(sendBuffer.size()), vtkCommunicator::SUM_OP))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce histogram.");
+    return false;
+  }
+
+  size_t offset = 0;
+  for (vtkIdType bin = 0; bin < numBins; ++bin)
+  {
+    bin_values->SetTuple1(bin, recvBuffer[offset++]);
+  }
+  for (const auto& item : totals)
+  {
+    const int numComps = item.second;
+    vtkNew<vtkDoubleArray> total;
+    total->SetName((item.first + "_total").c_str());
+    total->SetNumberOfComponents(numComps);
+    total->SetNumberOfTuples(numBins);
+    vtkNew<vtkDoubleArray> average;
+    average->SetName((item.first + "_average").c_str());
+    average->SetNumberOfComponents(numComps);
+    average->SetNumberOfTuples(numBins);
+    for (vtkIdType bin = 0; bin < numBins; ++bin)
+    {
+      const double count = bin_values->GetTuple1(bin);
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const double value = recvBuffer[offset++];
+        total->SetComponent(bin, comp, value);
+        average->SetComponent(bin, comp, count != 0 ? value / count : 0.0);
+      }
+    }
+    rowData->AddArray(total);
+    rowData->AddArray(average);
+  }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "UseAllReduce: " << this->UseAllReduce << endl;
 }
@@ -17,7 +17,8 @@
  * @brief   Extract histogram for parallel dataset.
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
- * It gathers the histogram data on the root node.
+ * By default, it gathers the histogram data on the root node. When
+ * UseAllReduce is enabled, the histogram is instead reduced on all ranks.
 */
 
 #ifndef vtkPExtractHistogram_h
@@ -27,6 +28,7 @@
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -44,6 +46,18 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   //@}
 
+  //@{
+  /**
+   * When set to true, the histogram is reduced using an all-reduce so that
+   * every rank ends up with the full histogram, instead of only the root
+   * node. This avoids the need to broadcast the result when all ranks need
+   * it. Default is false.
+   */
+  vtkSetMacro(UseAllReduce, bool);
+  vtkGetMacro(UseAllReduce, bool);
+  vtkBooleanMacro(UseAllReduce, bool);
+  //@}
+
 protected:
   vtkPExtractHistogram();
   ~vtkPExtractHistogram() override;
@@ -57,7 +71,13 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Reduces the histogram in `output` across all ranks using all-reduce.
+   */
+  bool AllReduceHistogram(vtkTable* output);
+
   vtkMultiProcessController* Controller;
+  bool UseAllReduce;
 
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&) = delete;
@@ -113,6 +113,7 @@
 #include "vtkPVPlane.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPVPostFilterExecutive.h"
+#include "vtkPVQuerySelector.h"
 #include "vtkPVRecoverGeometryWireframe.h"
 #include "vtkPVScalarBarActor.h"
 #include "vtkPVSelectionSource.h"
@@ -296,6 +297,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char* [])
   PRINT_SELF(vtkPVPlane);
   PRINT_SELF(vtkPVPostFilter);
   PRINT_SELF(vtkPVPostFilterExecutive);
+  PRINT_SELF(vtkPVQuerySelector);
   PRINT_SELF(vtkPVRecoverGeometryWireframe);
   PRINT_SELF(vtkPVScalarBarActor);
   PRINT_SELF(vtkPVSelectionSource);
@@ -129,6 +129,55 @@ int sortWithEpsilonValues(bool debug)
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+int sortBlocksInBothOrders(bool debug)
+{
+  const int size = 10;
+  double dataArray[size] = { 5, 1, 8, 1, 3, 9, 0, 7, 2, 6 };
+  double sortedBlock[3] = { 2, 3, 5 };
+  double invertedBlock[3] = { 2, 1, 1 };
+  double lastBlock[1] = { 9 };
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), dataArray, size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SetBlockSize(3);
+
+  // switching blocks and orders reuses the sorted indices.
+  sortingfilter->SetBlock(1);
+  sortingfilter->Update();
+  if (!compareArray(sortingfilter->GetOutput(), "data", sortedBlock, 3, debug))
+  {
+    return EXIT_FAILURE;
+  }
+
+  sortingfilter->SetInvertOrder(1);
+  sortingfilter->SetBlock(2);
+  sortingfilter->Update();
+  if (!compareArray(sortingfilter->GetOutput(), "data", invertedBlock, 3, debug))
+  {
+    return EXIT_FAILURE;
+  }
+
+  sortingfilter->SetInvertOrder(0);
+  sortingfilter->SetBlock(3);
+  sortingfilter->Update();
+  if (!compareArray(sortingfilter->GetOutput(), "data", lastBlock, 1, debug))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int sortMagnitudeOnUnsignedCharVector()
 {
@@ -180,6 +229,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   cout << "Testing sorting with epsilon values: "
        << ((result += sortWithEpsilonValues(debug)) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  cout << "Testing sorting blocks in both orders: "
+       << ((result += sortBlocksInBothOrders(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   cout << "Testing sorting with magnitude on unsigned char: "
        << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
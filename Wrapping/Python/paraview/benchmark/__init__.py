@@ -5,12 +5,18 @@ logbase contains core routines for collecting and gathering timing logs from
 all nodes.
 logparser contains additional routines for parsing the raw logs and
 calculating statistics across ranks and frames.
+timeline records log scopes on all nodes and saves them as a timeline that
+can be viewed in chrome://tracing or Perfetto.
 
 manyspheres is a geometry rendering benchmark that generates a large number
 of spheres and moves the camera around the scene.  To run the benchmark,
 either explicitly import manyspheres from paraview.benchmark and call it's
 run method, or call the manyspheres.py module directly via pvbatch or pvpython.
 
+compositing renders a distributed sphere with each of the IceT compositing
+strategies for a range of image sizes and reports the frame times for each.
+Run it with pvbatch on the number of ranks of interest.
+
 ::
 
     TODO: this doesn't handle split render/data server mode
@@ -21,5 +27,6 @@ from __future__ import absolute_import
 
 from . import logbase
 from . import logparser
+from . import timeline
 
-__all__ = ['logbase', 'logparser']
+__all__ = ['logbase', 'logparser', 'timeline']
@@ -0,0 +1,131 @@
+'''
+Image compositing benchmark. Renders a distributed sphere with each of the
+IceT compositing strategies exposed on the render view for a range of image
+sizes and reports the frame times for each combination. Run it with pvbatch
+on the number of ranks of interest, e.g.
+
+    mpiexec -n 16 pvbatch --force-offscreen-rendering \\
+        -m paraview.benchmark.compositing -v 1920,1080 -v 3840,2160
+
+When `--adaptive` is given, the adaptive single image strategy is benchmarked
+as well. Since it spends its first frames trying the candidate strategies,
+use enough frames for those to be amortized.
+'''
+
+from __future__ import print_function
+from paraview.simple import *
+import time
+
+# single image strategies, as in vtkIceTCompositePass::SingleImageStrategyModes.
+SINGLE_IMAGE_STRATEGIES = [('automatic', 0), ('bswap', 1), ('radixk', 2),
+                           ('tree', 3), ('bswap-folding', 4)]
+ADAPTIVE_STRATEGY = ('adaptive', 5)
+
+# composite strategies, as in vtkIceTCompositePass::CompositeStrategyModes.
+COMPOSITE_STRATEGIES = [('default', 0), ('sequential', 1), ('direct', 2),
+                        ('reduce', 4)]
+
+
+def _render_frames(view, num_frames):
+    camera = view.GetActiveCamera()
+    times = []
+    for frame in range(num_frames):
+        camera.Azimuth(360.0 / num_frames)
+        t0 = time.time()
+        Render(view)
+        times.append(time.time() - t0)
+    return times
+
+
+def run(view_sizes=((1024, 768), (1920, 1080)), num_frames=20,
+        resolution=512, transparency=False, adaptive=False,
+        composite_strategies=False, output=None):
+    '''Runs the benchmark and returns a list of
+    (view size, composite strategy, single image strategy, median frame time,
+    minimum frame time) tuples.'''
+    from vtkmodules.vtkParallelCore import vtkMultiProcessController
+    controller = vtkMultiProcessController.GetGlobalController()
+    num_ranks = controller.GetNumberOfProcesses() if controller else 1
+
+    sphere = Sphere(ThetaResolution=resolution, PhiResolution=resolution)
+    pids = ProcessIdScalars(Input=sphere)
+
+    view = CreateRenderView()
+    view.RemoteRenderThreshold = 0
+    view.OrientationAxesVisibility = 0
+    display = Show(pids, view)
+    ColorBy(display, ('POINTS', 'ProcessId'))
+    if transparency:
+        # forces ordered compositing.
+        display.Opacity = 0.5
+
+    single_image_strategies = list(SINGLE_IMAGE_STRATEGIES)
+    if adaptive:
+        single_image_strategies.append(ADAPTIVE_STRATEGY)
+    strategies = [(c, s) for c in (COMPOSITE_STRATEGIES if composite_strategies
+                                   else COMPOSITE_STRATEGIES[:1])
+                  for s in single_image_strategies]
+
+    results = []
+    for size in view_sizes:
+        view.ViewSize = list(size)
+        ResetCamera(view)
+        for (cname, cvalue), (sname, svalue) in strategies:
+            view.CompositeStrategy = cvalue
+            view.SingleImageStrategy = svalue
+            # warm up.
+            Render(view)
+            times = sorted(_render_frames(view, num_frames))
+            results.append(('%dx%d' % tuple(size), cname, sname,
+                            times[len(times) // 2], times[0]))
+
+    print('ranks: %d, frames: %d, transparency: %s' %
+          (num_ranks, num_frames, transparency))
+    print('%-12s %-12s %-14s %12s %12s' %
+          ('size', 'composite', 'single image', 'median (ms)', 'min (ms)'))
+    for size, cname, sname, median, minimum in results:
+        print('%-12s %-12s %-14s %12.2f %12.2f' %
+              (size, cname, sname, median * 1000, minimum * 1000))
+
+    if output:
+        with open(output, 'w') as f:
+            f.write('ranks,size,composite,single_image,median,min\n')
+            for result in results:
+                f.write('%d,%s,%s,%s,%f,%f\n' % ((num_ranks,) + result))
+
+    Delete(display)
+    Delete(view)
+    Delete(pids)
+    Delete(sphere)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark ParaView image compositing strategies')
+    parser.add_argument('-v', '--view-size', action='append',
+                        type=lambda s: tuple(int(x) for x in s.split(',')),
+                        help='View size to render, may be repeated')
+    parser.add_argument('-f', '--frames', default=20, type=int,
+                        help='Number of frames per strategy')
+    parser.add_argument('-r', '--resolution', default=512, type=int,
+                        help='Theta and Phi resolution of the sphere')
+    parser.add_argument('-t', '--transparency', action='store_true',
+                        help='Render translucent geometry')
+    parser.add_argument('-a', '--adaptive', action='store_true',
+                        help='Include the adaptive single image strategy')
+    parser.add_argument('-c', '--composite-strategies', action='store_true',
+                        help='Sweep composite strategies as well')
+    parser.add_argument('-o', '--output', type=str,
+                        help='CSV file to save the results to')
+
+    args = parser.parse_args(argv)
+    run(view_sizes=args.view_size or [(1024, 768), (1920, 1080)],
+        num_frames=args.frames, resolution=args.resolution,
+        transparency=args.transparency, adaptive=args.adaptive,
+        composite_strategies=args.composite_strategies, output=args.output)
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
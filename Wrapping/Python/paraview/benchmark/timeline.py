@@ -0,0 +1,79 @@
+"""
+This module records ParaView's log scopes on all processes and saves them as
+a timeline in Chrome trace event format, which can be viewed in
+chrome://tracing or https://ui.perfetto.dev. Do that like so:
+
+1. Elevate the log categories of interest, e.g. by setting the
+   PARAVIEW_LOG_RENDERING_VERBOSITY environment variable to INFO
+2. Call start()
+3. Setup and run your visualization pipeline
+4. Call write('timeline.json')
+
+In batch mode, all ranks are written to a single file. Otherwise, the client
+and each server type are written to separate files with the component name
+added before the extension, e.g. 'timeline.client.json'.
+"""
+
+from __future__ import print_function
+import paraview
+from paraview import servermanager
+import os
+
+recorders = dict()
+
+def _get_components():
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    session = servermanager.ActiveConnection.Session
+    if pm.GetProcessTypeAsInt() == pm.PROCESS_BATCH:
+        return {'': session.CLIENT_AND_SERVERS}
+    elif session.GetRenderClientMode() == session.RENDERING_UNIFIED:
+        return {'client': session.CLIENT, 'server': session.SERVERS}
+    else:
+        return {'client': session.CLIENT,
+                'renderserver': session.RENDER_SERVER,
+                'dataserver': session.DATA_SERVER}
+
+def start(verbosity=0):
+    """
+    Start recording log scopes with the given verbosity or lower on all
+    processes. Any events recorded earlier are discarded.
+    """
+    global recorders
+    if len(recorders) == 0:
+        pxm = servermanager.ProxyManager()
+        for label, component in _get_components().items():
+            recorder = pxm.NewProxy("misc", "LogTimelineRecorder")
+            recorder.SetLocation(component)
+            recorders[label] = recorder
+
+    for recorder in recorders.values():
+        recorder.GetProperty("Verbosity").SetElements1(verbosity)
+        recorder.UpdateVTKObjects()
+        recorder.InvokeCommand("ClearEvents")
+
+def write(filename):
+    """
+    Write the events recorded since start() to `filename`. Recording continues
+    until stop() is called.
+    """
+    global recorders
+    if len(recorders) == 0:
+        print("Timeline recording has not been started.")
+        return
+
+    root, ext = os.path.splitext(filename)
+    for label, recorder in recorders.items():
+        name = root + "." + label + ext if label else filename
+        recorder.GetProperty("FileName").SetElement(0, name)
+        recorder.UpdateVTKObjects()
+        recorder.InvokeCommand("Write")
+
+def stop():
+    """
+    Stop recording and release the recorders on all processes.
+    """
+    global recorders
+    for recorder in recorders.values():
+        recorder.GetProperty("Verbosity").SetElements1(-10)
+        recorder.UpdateVTKObjects()
+    recorders = dict()